@@ -90,12 +90,22 @@
 #define ERR_FILE_READ_FAILED        "Failed to read file\n"
 #define ERR_UNSUPPORTED_FILE_FORMAT "Unsupported file format\n"
 
+/* All macros below report errors through this. By default messages are printed to stderr,
+ * prefixed with name of function they come from. To send them elsewhere, redefine it after
+ * including this header. Prefix is a string literal printed before the message. */
+#ifndef ANVIE_LOG_ERROR
+#    define ANVIE_LOG_ERROR(prefix, ...)                                                           \
+        do {                                                                                       \
+            fputs (__FUNCTION__, stderr);                                                          \
+            fputs (" : " prefix, stderr);                                                          \
+            fprintf (stderr, __VA_ARGS__);                                                         \
+        } while (0)
+#endif
+
 #define RETURN_VALUE_IF(cond, value, ...)                                                          \
     do {                                                                                           \
         if ((cond)) {                                                                              \
-            fputs (__FUNCTION__, stderr);                                                          \
-            fputs (" : ", stderr);                                                                 \
-            fprintf (stderr, __VA_ARGS__);                                                         \
+            ANVIE_LOG_ERROR ("", __VA_ARGS__);                                                     \
             return value;                                                                          \
         }                                                                                          \
     } while (0)
@@ -103,9 +113,7 @@
 #define RETURN_IF(cond, ...)                                                                       \
     do {                                                                                           \
         if ((cond)) {                                                                              \
-            fputs (__FUNCTION__, stderr);                                                          \
-            fputs (" : ", stderr);                                                                 \
-            fprintf (stderr, __VA_ARGS__);                                                         \
+            ANVIE_LOG_ERROR ("", __VA_ARGS__);                                                     \
             return;                                                                                \
         }                                                                                          \
     } while (0)
@@ -113,9 +121,7 @@
 #define GOTO_HANDLER_IF(cond, handler, ...)                                                        \
     do {                                                                                           \
         if ((cond)) {                                                                              \
-            fputs (__FUNCTION__, stderr);                                                          \
-            fputs (" : " #handler " : ", stderr);                                                  \
-            fprintf (stderr, __VA_ARGS__);                                                         \
+            ANVIE_LOG_ERROR (#handler " : ", __VA_ARGS__);                                         \
             goto handler;                                                                          \
         }                                                                                          \
     } while (0)
@@ -123,9 +129,7 @@
 #define CALL_HANDLER_IF(cond, handler, ...)                                                        \
     do {                                                                                           \
         if ((cond)) {                                                                              \
-            fputs (__FUNCTION__, stderr);                                                          \
-            fputs (" : ", stderr);                                                                 \
-            fprintf (stderr, __VA_ARGS__);                                                         \
+            ANVIE_LOG_ERROR ("", __VA_ARGS__);                                                     \
             handler;                                                                               \
         }                                                                                          \
     } while (0)
@@ -133,46 +137,30 @@
 #define ABORT_IF(cond, ...)                                                                        \
     do {                                                                                           \
         if ((cond)) {                                                                              \
-            fputs (__FUNCTION__, stderr);                                                          \
-            fputs (" : ", stderr);                                                                 \
-            fprintf (stderr, __VA_ARGS__);                                                         \
+            ANVIE_LOG_ERROR ("", __VA_ARGS__);                                                     \
             abort();                                                                               \
         }                                                                                          \
     } while (0)
 
 #define RETURN_VALUE_IF_REACHED(val, ...)                                                          \
     do {                                                                                           \
-        fputs (__FUNCTION__, stderr);                                                              \
-        fputs (" : ", stderr);                                                                     \
-        fputs ("unreachable code reached : ", stderr);                                             \
-        fprintf (stderr, __VA_ARGS__);                                                             \
+        ANVIE_LOG_ERROR ("unreachable code reached : ", __VA_ARGS__);                              \
         return val;                                                                                \
     } while (0)
 
 #define RETURN_IF_REACHED(...)                                                                     \
     do {                                                                                           \
-        fputs (__FUNCTION__, stderr);                                                              \
-        fputs (" : ", stderr);                                                                     \
-        fputs ("unreachable code reached : ", stderr);                                             \
-        fprintf (stderr, __VA_ARGS__);                                                             \
+        ANVIE_LOG_ERROR ("unreachable code reached : ", __VA_ARGS__);                              \
         return;                                                                                    \
     } while (0)
 
 #define ABORT_IF_REACHED(...)                                                                      \
     do {                                                                                           \
-        fputs (__FUNCTION__, stderr);                                                              \
-        fputs (" : ", stderr);                                                                     \
-        fputs ("unreachable code reached : ", stderr);                                             \
-        fprintf (stderr, __VA_ARGS__);                                                             \
+        ANVIE_LOG_ERROR ("unreachable code reached : ", __VA_ARGS__);                              \
         abort();                                                                                   \
     } while (0)
 
-#define PRINT_ERR(...)                                                                             \
-    do {                                                                                           \
-        fputs (__FUNCTION__, stderr);                                                              \
-        fputs (" : ", stderr);                                                                     \
-        fprintf (stderr, __VA_ARGS__);                                                             \
-    } while (0)
+#define PRINT_ERR(...) ANVIE_LOG_ERROR ("", __VA_ARGS__)
 
 
 /********************************* ENDIANNESS CONVERSION MACROS ***********************************/
@@ -0,0 +1,91 @@
+/**
+ * @file Allocator.h
+ * @time 18/10/2026 12:25:35
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#ifndef ANVIE_CROSSWINDOW_ALLOCATOR_H
+#define ANVIE_CROSSWINDOW_ALLOCATOR_H
+
+#include <Anvie/Types.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @b What an allocation made by CrossWindow is used for.
+ *
+ * Passed to every allocator callback and used to keep separate allocation counters.
+ * */
+typedef enum XwAllocCategory {
+    XW_ALLOC_CATEGORY_MISC = 0,    /**< @b Anything not covered by other categories. */
+    XW_ALLOC_CATEGORY_WINDOW,      /**< @b Window objects and table of all windows. */
+    XW_ALLOC_CATEGORY_TITLE,       /**< @b Window titles and other window strings. */
+    XW_ALLOC_CATEGORY_KEYMAP,      /**< @b Keycode to @c XwKey mapping. */
+    XW_ALLOC_CATEGORY_QUEUE,       /**< @b Internal event and request queues. */
+    XW_ALLOC_CATEGORY_FRAMEBUFFER, /**< @b Software framebuffers not in shared memory. */
+    XW_ALLOC_CATEGORY_VULKAN,      /**< @b Bookkeeping of Vulkan helpers (swapchains etc...) */
+    XW_ALLOC_CATEGORY_TIMER,       /**< @b Timers and frame pacers. */
+    XW_ALLOC_CATEGORY_MAX
+} XwAllocCategory;
+
+/**
+ * @b Allocation callbacks used by CrossWindow for all memory it owns.
+ *
+ * Memory returned by @c alloc and @c realloc need not be zeroed. Returning @c Null from
+ * @c alloc or @c realloc is treated as out of memory. Callbacks must stay valid till the
+ * library is unloaded, because some internal memory is released only at that point.
+ *
+ * Memory allocated by the display server library (eg: xcb replies), and strings returned to
+ * user (eg: by @c xw_window_get_title) are not allocated through these callbacks.
+ * */
+typedef struct XwAllocator {
+    void *(*alloc) (void *user_data, Size size, XwAllocCategory category);
+    void *(*realloc) (void *user_data, void *ptr, Size size, XwAllocCategory category);
+    void (*free) (void *user_data, void *ptr, XwAllocCategory category);
+    void *user_data; /**< @b Passed as is to all callbacks. */
+} XwAllocator;
+
+/**
+ * @b Allocation counters of a single category, since library was loaded.
+ * */
+typedef struct XwAllocStats {
+    Uint64 alloc_count;     /**< @b Number of new allocations. */
+    Uint64 realloc_count;   /**< @b Number of resizes of existing allocations. */
+    Uint64 free_count;      /**< @b Number of allocations released. */
+    Uint64 live_count;      /**< @b Allocations not yet released. */
+    Uint64 bytes_requested; /**< @b Sum of sizes of all allocations and resizes. */
+} XwAllocStats;
+
+Bool          xw_set_allocator (const XwAllocator *allocator);
+XwAllocStats *xw_get_alloc_stats (XwAllocCategory category, XwAllocStats *stats);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_ALLOCATOR_H
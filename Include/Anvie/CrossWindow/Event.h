@@ -33,8 +33,11 @@
 #ifndef ANVIE_CROSSWINDOW_EVENT_H
 #define ANVIE_CROSSWINDOW_EVENT_H
 
+#include <Anvie/CrossWindow/Timer.h>
 #include <Anvie/CrossWindow/Window.h>
 
+#pragma GCC visibility push(default)
+
 /**
  * @b Various types of events in CrossWindow.
  * */
@@ -68,9 +71,31 @@ typedef enum XwEventType {
     XW_EVENT_TYPE_DROP_FILE,  /**< @b TODO: Dropping a file on the window. */
     XW_EVENT_TYPE_HOVER_FILE, /**< @b TODO: Hovering a file over a window. */
 
+    XW_EVENT_TYPE_ERROR, /**< @b A previously made request failed on display server. */
+
+    XW_EVENT_TYPE_FRAME_COMPLETE, /**< @b A presented frame reached the screen (or was skipped). */
+    XW_EVENT_TYPE_FRAME_IDLE,     /**< @b Display server is done using a presented pixmap. */
+
+    XW_EVENT_TYPE_KEYMAP_CHANGE, /**< @b Keyboard mapping changed. Not tied to any window. */
+
+    XW_EVENT_TYPE_USER,  /**< @b Posted by application using @c xw_event_post. */
+    XW_EVENT_TYPE_TIMER, /**< @b A timer created with @c xw_timer_create expired. */
+
     XW_EVENT_TYPE_MAX
 } XwEventType;
 
+/**
+ * @b Classes of events in event backlog. Each class has it's own limit and overflow policy.
+ *
+ * @sa xw_event_set_backlog_limit
+ * */
+typedef enum XwEventClass {
+    XW_EVENT_CLASS_INPUT = 0, /**< @b Keys, buttons, wheel, touch, focus etc... Never dropped. */
+    XW_EVENT_CLASS_MOTION,    /**< @b Mouse moves. Oldest is dropped when over limit. */
+    XW_EVENT_CLASS_WINDOW,    /**< @b Everything else. Superseded ones are merged. */
+    XW_EVENT_CLASS_MAX
+} XwEventClass;
+
 /**
  * @b Window state change.
  *
@@ -479,6 +504,71 @@ typedef struct XwGamepadEvent {
     Bool digital_button[XW_GAMEPAD_BUTTON_COUNT_MAX];
 } XwGamepadEvent;
 
+/**
+ * @b A request made earlier failed on display server.
+ *
+ * Requests are never checked synchronously, because that costs a round trip each time.
+ * Instead, failures are delivered through the event queue as soon as display server reports
+ * them. @c XwEvent::window is the window failed request was made for, or @c Null if that
+ * cannot be determined.
+ * */
+typedef struct XwErrorEvent {
+    Uint8  error_code;   /**< @b Platform dependent error code. */
+    Uint8  major_opcode; /**< @b Major opcode of failed request. */
+    Uint16 minor_opcode; /**< @b Minor opcode of failed request (for extension requests). */
+    Uint32 sequence;     /**< @b Sequence number of failed request. */
+    Uint32 resource_id;  /**< @b Bad resource id or value that caused the failure. */
+} XwErrorEvent;
+
+/**
+ * @b How display server got a presented frame on screen.
+ * */
+typedef enum XwPresentMode {
+    XW_PRESENT_MODE_COPY = 0,        /**< @b Contents were copied into window. */
+    XW_PRESENT_MODE_FLIP,            /**< @b Pixmap was scanned out directly, without copying. */
+    XW_PRESENT_MODE_SKIP,            /**< @b Frame was replaced by a later one and never shown. */
+    XW_PRESENT_MODE_SUBOPTIMAL_COPY, /**< @b Copied, but flipping would be possible otherwise. */
+    XW_PRESENT_MODE_MAX
+} XwPresentMode;
+
+/**
+ * @b A frame presented to window reached the screen.
+ *
+ * Delivered only for windows with frame events enabled. @c msc and @c ust can be used for
+ * frame pacing and for measuring latency from submission to display.
+ * */
+typedef struct XwFrameCompleteEvent {
+    Uint32        serial; /**< @b Serial of presented frame. */
+    Uint64        msc;    /**< @b Media stream counter (vblank count) when frame was shown. */
+    Uint64        ust;    /**< @b Time in microseconds (CLOCK_MONOTONIC) when frame was shown. */
+    XwPresentMode mode;   /**< @b How the frame was shown. */
+} XwFrameCompleteEvent;
+
+/**
+ * @b Pixmap of a presented frame can be drawn into again.
+ * */
+typedef struct XwFrameIdleEvent {
+    Uint32 serial; /**< @b Serial of frame pixmap was presented with. */
+    Uint32 pixmap; /**< @b Platform pixmap handle that is now idle. */
+} XwFrameIdleEvent;
+
+/**
+ * @b Application defined event, posted from any thread using @c xw_event_post.
+ * */
+typedef struct XwUserEvent {
+    Uint32 code; /**< @b Meaning is up to application. */
+    void  *data; /**< @b Meaning is up to application. CrossWindow never dereferences it. */
+} XwUserEvent;
+
+/**
+ * @b A timer expired. Not tied to any window.
+ * */
+typedef struct XwTimerEvent {
+    XwTimer *timer;       /**< @b Timer that expired. */
+    void    *user;        /**< @b Value given when creating timer. */
+    Uint64   expirations; /**< @b Intervals passed since last event, more than 1 if late. */
+} XwTimerEvent;
+
 /**
  * @b Represents an event in CrossWindow.
  *
@@ -506,11 +596,26 @@ typedef struct XwEvent {
         XwMouseWheelEvent        mouse_wheel;
         XwTouchEvent             touch;
         XwGamepadEvent           gamepad;
+        XwErrorEvent             error;
+        XwFrameCompleteEvent     frame_complete;
+        XwFrameIdleEvent         frame_idle;
+        XwUserEvent              user;
+        XwTimerEvent             timer;
     };
 } XwEvent;
 
 XwEvent *xw_event_poll (XwEvent *event);
 XwEvent *xw_event_wait (XwEvent *event);
+XwEvent *xw_event_wait_until (XwEvent *event, Uint64 deadline_ns);
+XwEvent *xw_event_post (const XwEvent *event);
+void     xw_event_set_idle_blocking (Bool enable);
+void     xw_event_set_priority_mode (Bool enable);
+Bool     xw_event_set_backlog_limit (XwEventClass event_class, Size limit);
+void     xw_event_set_motion_hints (Bool enable);
+Bool     xw_event_get_motion_hints (void);
+
+XwWindow *xw_window_enable_event_queue (XwWindow *win, Size capacity);
+XwEvent  *xw_window_event_poll (XwWindow *win, XwEvent *event);
 
 XwEvent *xw_event_state_change (XwEvent *event, XwWindowState new_state, XwWindow *win);
 XwEvent *xw_event_visibility (XwEvent *event, Bool visible, XwWindow *win);
@@ -565,5 +670,28 @@ XwEvent *xw_event_gamepad (
 );
 XwEvent *xw_event_drop_file (XwEvent *event, XwWindow *win);
 XwEvent *xw_event_hover_file (XwEvent *event, XwWindow *win);
+XwEvent *xw_event_error (
+    XwEvent  *event,
+    Uint8     error_code,
+    Uint8     major_opcode,
+    Uint16    minor_opcode,
+    Uint32    sequence,
+    Uint32    resource_id,
+    XwWindow *win
+);
+XwEvent *xw_event_frame_complete (
+    XwEvent      *event,
+    Uint32        serial,
+    Uint64        msc,
+    Uint64        ust,
+    XwPresentMode mode,
+    XwWindow     *win
+);
+XwEvent *xw_event_frame_idle (XwEvent *event, Uint32 serial, Uint32 pixmap, XwWindow *win);
+XwEvent *xw_event_keymap_change (XwEvent *event);
+XwEvent *xw_event_user (XwEvent *event, Uint32 code, void *data, XwWindow *win);
+XwEvent *xw_event_timer (XwEvent *event, XwTimer *timer, void *user, Uint64 expirations);
+
+#pragma GCC visibility pop
 
 #endif // CROSSWINDOW_EVENT_H
@@ -0,0 +1,78 @@
+/**
+ * @file FramePacer.h
+ * @time 18/10/2026 13:32:58
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_FRAME_PACER_H
+#define ANVIE_CROSSWINDOW_FRAME_PACER_H
+
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Window.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @b Paces a render loop to a target frame rate, sleeping on the event loop between frames
+ *    instead of spinning on @c xw_event_poll :
+ *
+ * @code
+ * while (is_running) {
+ *     while (xw_frame_pacer_wait (pacer, &e)) {
+ *         // handle event
+ *     }
+ *     // draw a frame
+ * }
+ * @endcode
+ * */
+typedef struct XwFramePacer XwFramePacer;
+
+/**
+ * @b How well frames were paced since pacer was created (or stats were reset).
+ * */
+typedef struct XwFramePacerStats {
+    Uint64  frames;           /**< @b Frames started. */
+    Uint64  missed;           /**< @b Frame deadlines skipped because a frame took too long. */
+    Float64 period_ns;        /**< @b Target time between frames. */
+    Float64 mean_interval_ns; /**< @b Mean time between frames, missed deadlines excluded. */
+    Float64 jitter_ns;        /**< @b Mean difference between time between frames and period. */
+    Float64 max_jitter_ns;    /**< @b Largest difference between time between frames and period. */
+    Float64 spin_ns;          /**< @b Time spent spinning before each deadline, after sleeping. */
+} XwFramePacerStats;
+
+XwFramePacer      *xw_frame_pacer_create (XwWindow *win, Float64 rate);
+void               xw_frame_pacer_destroy (XwFramePacer *pacer);
+XwEvent           *xw_frame_pacer_wait (XwFramePacer *pacer, XwEvent *event);
+Float64            xw_frame_pacer_get_rate (XwFramePacer *pacer);
+XwFramePacerStats *xw_frame_pacer_get_stats (XwFramePacer *pacer, XwFramePacerStats *stats);
+void               xw_frame_pacer_reset_stats (XwFramePacer *pacer);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_FRAME_PACER_H
@@ -0,0 +1,127 @@
+/**
+ * @file Framebuffer.h
+ * @time 18/10/2026 12:27:46
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#ifndef ANVIE_CROSSWINDOW_FRAMEBUFFER_H
+#define ANVIE_CROSSWINDOW_FRAMEBUFFER_H
+
+#include <Anvie/CrossWindow/Window.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @b Layout of a single pixel in memory.
+ *
+ * Names list components in order of increasing memory address, so @c BGRX8888 means
+ * first byte is blue and last byte is unused. The format is decided by the display
+ * server, software renderers must write pixels in whatever format the framebuffer has.
+ * */
+typedef enum XwPixelFormat {
+    XW_PIXEL_FORMAT_UNKNOWN = 0,
+    XW_PIXEL_FORMAT_BGRX8888, /**< @b Most common, little endian 24 bit depth TrueColor. */
+    XW_PIXEL_FORMAT_RGBX8888,
+    XW_PIXEL_FORMAT_XRGB8888,
+    XW_PIXEL_FORMAT_XBGR8888,
+    XW_PIXEL_FORMAT_RGB565, /**< @b 16 bit little endian, red in high bits. */
+
+    /* following are never used by framebuffers, only accepted by xw_framebuffer_write */
+    XW_PIXEL_FORMAT_RGBA8888, /**< @b Straight (non-premultiplied) alpha. */
+    XW_PIXEL_FORMAT_RGBA32F,  /**< @b 32 bit float per component, premultiplied alpha. */
+    XW_PIXEL_FORMAT_MAX
+} XwPixelFormat;
+
+/**
+ * @b Rectangular region of a window in pixels, relative to top-left corner.
+ * */
+typedef struct XwRect {
+    Uint32 x;
+    Uint32 y;
+    Uint32 width;
+    Uint32 height;
+} XwRect;
+
+/**
+ * @b CPU accessible pixel buffer of a window.
+ *
+ * Pixel at (x, y) starts at byte offset @c y*stride+x*bytes_per_pixel from @c pixels.
+ * */
+typedef struct XwFramebuffer {
+    void         *pixels;          /**< @b First byte of top-left pixel. */
+    Uint32        width;           /**< @b Width in pixels, same as window width. */
+    Uint32        height;          /**< @b Height in pixels, same as window height. */
+    Uint32        stride;          /**< @b Distance between rows in bytes. */
+    Uint32        bytes_per_pixel; /**< @b Size of a single pixel in bytes. */
+    XwPixelFormat format;          /**< @b Layout of each pixel. */
+} XwFramebuffer;
+
+/**
+ * @b Made from bitwise OR of @c XwConvertFlagBits
+ * */
+typedef Uint32 XwConvertFlags;
+
+/**
+ * @b Options for @c xw_framebuffer_write.
+ * */
+typedef enum XwConvertFlagBits : XwConvertFlags {
+    XW_CONVERT_FLAG_NONE        = 0,
+    XW_CONVERT_FLAG_PREMULTIPLY = (1 << 0), /* multiply color with alpha of RGBA8888 source */
+} XwConvertFlagBits;
+
+/**
+ * @b Instruction set used by pixel conversion kernels.
+ * */
+typedef enum XwSimdLevel {
+    XW_SIMD_LEVEL_AUTO = 0, /**< @b Best one supported by CPU. */
+    XW_SIMD_LEVEL_SCALAR,   /**< @b Plain C, always supported. */
+    XW_SIMD_LEVEL_SSE2,
+    XW_SIMD_LEVEL_AVX2,
+    XW_SIMD_LEVEL_NEON,
+    XW_SIMD_LEVEL_MAX
+} XwSimdLevel;
+
+XwFramebuffer *xw_window_get_framebuffer (XwWindow *self, XwFramebuffer *fb);
+XwWindow      *xw_window_present_region (XwWindow *self, const XwRect *rects, Size n);
+
+XwFramebuffer *xw_framebuffer_write (
+    XwFramebuffer *fb,
+    XwRect         rect,
+    const void    *pixels,
+    Size           stride,
+    XwPixelFormat  format,
+    XwConvertFlags flags
+);
+Bool        xw_set_simd_level (XwSimdLevel level);
+XwSimdLevel xw_get_simd_level (void);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_FRAMEBUFFER_H
@@ -0,0 +1,73 @@
+/**
+ * @file Log.h
+ * @time 18/10/2026 13:00:27
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_LOG_H
+#define ANVIE_CROSSWINDOW_LOG_H
+
+#include <Anvie/Types.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @b Severity of a log message.
+ *
+ * Messages less severe than the level CrossWindow was built with (@c CROSSWINDOW_LOG_LEVEL)
+ * are removed at compile time. Of the rest, messages less severe than the level set with
+ * @c xw_log_set_level are dropped before being formatted.
+ * */
+typedef enum XwLogLevel {
+    XW_LOG_LEVEL_DEBUG   = 0, /**< @b Expected conditions, useful only when debugging. */
+    XW_LOG_LEVEL_INFO    = 1, /**< @b Notable but normal events. */
+    XW_LOG_LEVEL_WARNING = 2, /**< @b Something unexpected, that CrossWindow worked around. */
+    XW_LOG_LEVEL_ERROR   = 3, /**< @b An operation failed. */
+    XW_LOG_LEVEL_NONE    = 4, /**< @b Used as minimum level to disable logging. */
+} XwLogLevel;
+
+/**
+ * @b Receives every log message that passed level checks and rate limiting.
+ *
+ * Can be called from any thread that calls into CrossWindow.
+ *
+ * @param user_data Value given to @c xw_log_set_sink.
+ * @param level Severity of message.
+ * @param function Name of function message comes from.
+ * @param message Formatted message, without trailing newline. Valid only during the call.
+ * */
+typedef void (*XwLogSink) (void *user_data, XwLogLevel level, CString function, CString message);
+
+void       xw_log_set_sink (XwLogSink sink, void *user_data);
+void       xw_log_set_level (XwLogLevel level);
+XwLogLevel xw_log_get_level (void);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_LOG_H
@@ -0,0 +1,56 @@
+/**
+ * @file Null.h
+ * @time 18/10/2026 12:48:40
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_NULL_H
+#define ANVIE_CROSSWINDOW_NULL_H
+
+#include <Anvie/CrossWindow/Event.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * Functions in this header are only available when linked with the headless Null
+ * backend (@c crosswindow_null). The Null backend implements complete CrossWindow API
+ * in memory, without any display server, and every event it delivers is either injected
+ * using @c xw_null_inject_event, or generated by a window function where a real display
+ * server would have sent one (mapping a window, changing window state, presenting a frame).
+ *
+ * This makes event handling and rendering code of applications testable and benchmarkable
+ * in a completely deterministic way. Vulkan surfaces are created using
+ * @c VK_EXT_headless_surface, which is supported by Mesa's lavapipe.
+ * */
+
+XwEvent *xw_null_inject_event (const XwEvent *event);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_NULL_H
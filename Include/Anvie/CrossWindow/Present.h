@@ -0,0 +1,65 @@
+/**
+ * @file Present.h
+ * @time 18/10/2026 12:33:35
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#ifndef ANVIE_CROSSWINDOW_PRESENT_H
+#define ANVIE_CROSSWINDOW_PRESENT_H
+
+#include <Anvie/CrossWindow/Window.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @b Made from bitwise OR of @c XwPresentFlagBits
+ * */
+typedef Uint32 XwPresentFlags;
+
+/**
+ * @b Options for @c xw_window_present_pixmap.
+ * */
+typedef enum XwPresentFlagBits : XwPresentFlags {
+    XW_PRESENT_FLAG_NONE  = 0,
+    XW_PRESENT_FLAG_ASYNC = (1 << 0), /* show right away if target msc already passed, may tear */
+    XW_PRESENT_FLAG_COPY  = (1 << 1), /* always copy, pixmap becomes idle as soon as it's shown */
+} XwPresentFlagBits;
+
+Bool   xw_window_enable_frame_events (XwWindow *self);
+Uint32 xw_window_present_pixmap (
+    XwWindow      *self,
+    Uint32         pixmap,
+    Uint64         target_msc,
+    XwPresentFlags flags
+);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_PRESENT_H
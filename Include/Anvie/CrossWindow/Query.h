@@ -0,0 +1,114 @@
+/**
+ * @file Query.h
+ * @time 18/10/2026 12:19:56
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#ifndef ANVIE_CROSSWINDOW_QUERY_H
+#define ANVIE_CROSSWINDOW_QUERY_H
+
+#include <Anvie/CrossWindow/Window.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @b Type of property a @c XwQuery is fetching.
+ * */
+typedef enum XwQueryType {
+    XW_QUERY_TYPE_NONE = 0,           /**< @b Invalid, finished or discarded query. */
+    XW_QUERY_TYPE_GEOMETRY,           /**< @b Position, size and border width. */
+    XW_QUERY_TYPE_STATE,              /**< @b Window state as set by window manager. */
+    XW_QUERY_TYPE_FRAME_EXTENTS,      /**< @b Size of decorations added by window manager. */
+    XW_QUERY_TYPE_ACTION_PERMISSIONS, /**< @b Actions allowed by window manager. */
+    XW_QUERY_TYPE_MAX
+} XwQueryType;
+
+/**
+ * @b Handle to a pending request sent to the display server.
+ *
+ * Creating a query only queues a request, it never waits for the display server. This means
+ * any number of queries on any number of windows can be created first and then waited upon,
+ * and all of them will be answered in a single round trip.
+ *
+ * A query is a plain value and can be stored anywhere. Every query must either be waited on,
+ * polled till completion or discarded, otherwise the reply will stay in memory forever.
+ * */
+typedef struct XwQuery {
+    XwQueryType type;     /**< @b What this query is fetching. */
+    XwWindow   *window;   /**< @b Window this query was made for. */
+    Uint32      sequence; /**< @b Platform dependent request identifier. */
+} XwQuery;
+
+/**
+ * @b Geometry of a window, relative to it's parent.
+ * */
+typedef struct XwWindowGeometry {
+    XwWindowPos  pos;
+    XwWindowSize size;
+    Uint32       border_width;
+} XwWindowGeometry;
+
+/**
+ * @b Width of decorations added by window manager on each side of window.
+ * */
+typedef struct XwFrameExtents {
+    Uint32 left;
+    Uint32 right;
+    Uint32 top;
+    Uint32 bottom;
+} XwFrameExtents;
+
+/**
+ * @b Result of a completed @c XwQuery.
+ * */
+typedef struct XwQueryResult {
+    XwQueryType type;   /**< @b Type of query that produced this result. */
+    XwWindow   *window; /**< @b Window the query was made for. */
+
+    union {
+        XwWindowGeometry          geometry;
+        XwWindowState             state;
+        XwFrameExtents            frame_extents;
+        XwWindowActionPermissions action_permissions;
+    };
+} XwQueryResult;
+
+XwQuery xw_window_query_geometry (XwWindow *self);
+XwQuery xw_window_query_state (XwWindow *self);
+XwQuery xw_window_query_frame_extents (XwWindow *self);
+XwQuery xw_window_query_action_permissions (XwWindow *self);
+
+XwQueryResult *xw_query_wait (XwQuery *query, XwQueryResult *result);
+XwQueryResult *xw_query_poll (XwQuery *query, XwQueryResult *result);
+void           xw_query_discard (XwQuery *query);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_QUERY_H
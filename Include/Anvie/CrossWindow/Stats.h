@@ -0,0 +1,94 @@
+/**
+ * @file Stats.h
+ * @time 18/10/2026 12:58:02
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_STATS_H
+#define ANVIE_CROSSWINDOW_STATS_H
+
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/Types.h>
+
+#pragma GCC visibility push(default)
+
+/** @b Most call sites tracked separately. Round trips from any more sites are only counted. */
+#define XW_ROUND_TRIP_MAX_SITES 64
+
+/**
+ * @b Round trips made from a single place inside CrossWindow.
+ * */
+typedef struct XwRoundTripSite {
+    CString name;           /**< @b What was waited for (eg: "xcb_intern_atom_reply"). */
+    CString function;       /**< @b Function inside CrossWindow that waited. */
+    Uint32  line;           /**< @b Line in source file of @c function. */
+    Uint64  count;          /**< @b Number of round trips. */
+    Uint64  poll_count;     /**< @b Number of round trips made inside event pump. */
+    Uint64  blocked_ns;     /**< @b Total time spent waiting for display server. */
+    Uint64  max_blocked_ns; /**< @b Longest single wait. */
+} XwRoundTripSite;
+
+/**
+ * @b Blocking round trips to display server since library was loaded (or stats were reset).
+ *
+ * A round trip is any call that waits for the display server to answer : replies,
+ * checked requests and extension queries. Event pump is @c xw_event_poll, @c xw_event_wait
+ * and @c xw_event_wait_until, sleeping till an event arrives is not a round trip.
+ * */
+typedef struct XwRoundTripStats {
+    Uint64          count;      /**< @b Total number of round trips. */
+    Uint64          poll_count; /**< @b Round trips made inside event pump. */
+    Uint64          blocked_ns; /**< @b Total time spent waiting for display server. */
+    Size            site_count; /**< @b Number of valid entries in @c sites. */
+    XwRoundTripSite sites[XW_ROUND_TRIP_MAX_SITES];
+} XwRoundTripStats;
+
+XwRoundTripStats *xw_stats_round_trips (XwRoundTripStats *stats);
+void              xw_stats_reset_round_trips (void);
+void              xw_stats_set_strict_round_trips (Bool strict);
+
+/**
+ * @b Events read from display server but not yet returned, and what was done to keep their
+ *    number within limits. Arrays are indexed by @c XwEventClass.
+ *
+ * @sa xw_event_set_backlog_limit
+ * */
+typedef struct XwEventBacklogStats {
+    Size   depth[XW_EVENT_CLASS_MAX];     /**< @b Events waiting to be returned right now. */
+    Size   max_depth[XW_EVENT_CLASS_MAX]; /**< @b Most events that were ever waiting at once. */
+    Uint64 overflow[XW_EVENT_CLASS_MAX];  /**< @b Events dropped because class was at it's limit. */
+    Uint64 collapsed; /**< @b Events replaced by a newer one of same window and type. */
+} XwEventBacklogStats;
+
+XwEventBacklogStats *xw_stats_event_backlog (XwEventBacklogStats *stats);
+void                 xw_stats_reset_event_backlog (void);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_STATS_H
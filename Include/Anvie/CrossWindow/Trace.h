@@ -0,0 +1,59 @@
+/**
+ * @file Trace.h
+ * @time 18/10/2026 12:54:32
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_TRACE_H
+#define ANVIE_CROSSWINDOW_TRACE_H
+
+#include <Anvie/Types.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * Built-in tracing.
+ *
+ * When CrossWindow is built with @c CROSSWINDOW_ENABLE_TRACING, initialization, atom interning,
+ * keymap creation, event polling, conversion of each event and every flush and blocking
+ * round trip to the display server are recorded as begin/end pairs into a ring buffer per
+ * thread, which keeps its latest records. Recorded data can be written out at any time (eg:
+ * right after a hitch) and loaded in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Without tracing support these functions do nothing and return False.
+ * */
+
+Bool xw_trace_is_enabled (void);
+Bool xw_trace_dump_chrome_json (CString path);
+Bool xw_trace_dump_perfetto (CString path);
+void xw_trace_clear (void);
+
+#pragma GCC visibility pop
+
+#endif // ANVIE_CROSSWINDOW_TRACE_H
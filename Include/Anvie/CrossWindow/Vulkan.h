@@ -33,11 +33,219 @@
 #ifndef ANVIE_CROSSWINDOW_VULKAN_H
 #define ANVIE_CROSSWINDOW_VULKAN_H
 
+#include <Anvie/CrossWindow/Event.h>
 #include <Anvie/CrossWindow/Window.h>
 #include <vulkan/vulkan.h>
 
+#pragma GCC visibility push(default)
+
 /* vulkan specific methods */
 CString *xw_get_required_extension_names (Size *ext_count);
 VkResult xw_window_create_vulkan_surface (XwWindow *window, VkInstance inst, VkSurfaceKHR *surf);
 
+/**
+ * @b How to trade latency against tearing and power when choosing a present mode. FIFO is the
+ *    last fallback of every policy, because that's the only mode guaranteed to be supported.
+ * */
+typedef enum XwVkLatencyPolicy {
+    XW_VK_LATENCY_POLICY_POWER_SAVING = 0,       /**< @b FIFO. Never renders more than shown. */
+    XW_VK_LATENCY_POLICY_LOWEST_LATENCY,         /**< @b MAILBOX, then IMMEDIATE (tears). */
+    XW_VK_LATENCY_POLICY_TEAR_FREE_LOW_LATENCY,  /**< @b MAILBOX, then FIFO_RELAXED. */
+    XW_VK_LATENCY_POLICY_MAX
+} XwVkLatencyPolicy;
+
+/**
+ * @b Surface formats and present modes supported by a window surface.
+ *
+ * These are queried once and reused until invalidated. Passing events to
+ * @c xw_vk_surface_info_handle_event invalidates them when window is resized or moves to a
+ * monitor with different DPI, because both can change what's supported.
+ * */
+typedef struct XwVkSurfaceInfo {
+    VkPhysicalDevice gpu;
+    VkSurfaceKHR     surface;
+    XwWindow        *window;
+
+    Bool                valid; /**< @b False if needs to be queried again. */
+    Uint32              format_count;
+    VkSurfaceFormatKHR *formats;
+    Uint32              present_mode_count;
+    VkPresentModeKHR   *present_modes;
+} XwVkSurfaceInfo;
+
+XwVkSurfaceInfo *
+    xw_vk_surface_info_create (VkPhysicalDevice gpu, VkSurfaceKHR surface, XwWindow *window);
+XwVkSurfaceInfo *xw_vk_surface_info_init (
+    XwVkSurfaceInfo *self,
+    VkPhysicalDevice gpu,
+    VkSurfaceKHR     surface,
+    XwWindow        *window
+);
+XwVkSurfaceInfo *xw_vk_surface_info_deinit (XwVkSurfaceInfo *self);
+void             xw_vk_surface_info_destroy (XwVkSurfaceInfo *self);
+VkResult         xw_vk_surface_info_query (XwVkSurfaceInfo *self);
+XwVkSurfaceInfo *xw_vk_surface_info_invalidate (XwVkSurfaceInfo *self);
+XwVkSurfaceInfo *xw_vk_surface_info_handle_event (XwVkSurfaceInfo *self, const XwEvent *event);
+
+VkPresentModeKHR xw_vk_choose_present_mode (XwVkSurfaceInfo *info, XwVkLatencyPolicy policy);
+VkSurfaceFormatKHR
+    xw_vk_choose_surface_format (XwVkSurfaceInfo *info, VkSurfaceFormatKHR preferred);
+
+/**
+ * @b Parameters used to create a @c XwVkSwapchain, and to recreate it later on.
+ * */
+typedef struct XwVkSwapchainCreateInfo {
+    VkPhysicalDevice gpu;     /**< @b GPU used to query surface capabilities. */
+    VkDevice         device;  /**< @b Device that owns swapchain and everything created for it. */
+    VkSurfaceKHR     surface; /**< @b Surface created using @c xw_window_create_vulkan_surface. */
+    XwWindow        *window;  /**< @b Window of @c surface. Used to filter events. */
+
+    /**
+     * @b Size of @c window, used when surface lets swapchain decide its size. Resize events
+     *    passed to @c xw_vk_swapchain_handle_event keep it up to date for later recreates.
+     * */
+    VkExtent2D extent;
+
+    /**
+     * @b Supported formats and present modes of @c surface, shared with whoever else needs them
+     *    (eg: for creating a render pass). If @c Null then swapchain creates one of it's own.
+     * */
+    XwVkSurfaceInfo *surface_info;
+
+    /** @b Preferred surface format. @c VK_FORMAT_UNDEFINED selects first supported format. */
+    VkSurfaceFormatKHR surface_format;
+    XwVkLatencyPolicy  latency_policy;  /**< @b Used to choose present mode. */
+    Uint32             min_image_count; /**< @b Zero selects one more than surface minimum. */
+    VkImageUsageFlags  image_usage;     /**< @b Zero selects color attachment usage. */
+
+    /**
+     * @b If not @c VK_NULL_HANDLE then one framebuffer per swapchain image is also created using
+     *    this render pass. These get retired along with the image views they use.
+     * */
+    VkRenderPass render_pass;
+} XwVkSwapchainCreateInfo;
+
+/**
+ * @b Swapchain and per image objects that were replaced by a recreate, but may still be in use
+ *    by GPU. These are destroyed once all @c fences signal.
+ * */
+typedef struct XwVkRetiredSwapchain {
+    VkSwapchainKHR swapchain;
+    Uint32         image_count;
+    VkImageView   *image_views;
+    VkFramebuffer *framebuffers;
+    Uint32         fence_count;
+    VkFence       *fences; /**< @b Fences of last submissions that used images of @c swapchain */
+} XwVkRetiredSwapchain;
+
+/**
+ * @b A swapchain managed by CrossWindow.
+ *
+ * Recreating passes current swapchain as @c oldSwapchain of the new one and does not wait for
+ * device to become idle. Old swapchain, along with it's image views and framebuffers, is retired
+ * and destroyed only after fences of the last submissions that rendered to it's images signal.
+ *
+ * Resize events only mark swapchain as out of date, so any number of resize events between two
+ * frames cause at-most one recreate, and that happens in next @c xw_vk_swapchain_acquire.
+ *
+ * All fields are read only. Handles to images, views and framebuffers change after a recreate,
+ * @c generation is incremented each time that happens.
+ * */
+typedef struct XwVkSwapchain {
+    XwVkSwapchainCreateInfo info;
+    XwVkSurfaceInfo        *surface_info;      /**< @b Same as @c info.surface_info if given. */
+    Bool                    owns_surface_info; /**< @b Created by swapchain itself. */
+
+    VkSwapchainKHR     swapchain;
+    VkSurfaceFormatKHR surface_format;
+    VkPresentModeKHR   present_mode;
+    VkExtent2D         extent;
+    Uint32             image_count;
+    VkImage           *images;
+    VkImageView       *image_views;
+    VkFramebuffer     *framebuffers; /**< @b Only when @c info.render_pass is given. */
+    VkFence           *image_fences; /**< @b Fence of last submission rendering to each image. */
+    Uint64             generation;   /**< @b Incremented every time swapchain is recreated. */
+    Bool               out_of_date;  /**< @b Recreate on next acquire. */
+
+    XwVkRetiredSwapchain *retired;
+    Size                  retired_count;
+    Size                  retired_capacity;
+} XwVkSwapchain;
+
+XwVkSwapchain *xw_vk_swapchain_create (const XwVkSwapchainCreateInfo *info);
+XwVkSwapchain *xw_vk_swapchain_init (XwVkSwapchain *self, const XwVkSwapchainCreateInfo *info);
+XwVkSwapchain *xw_vk_swapchain_deinit (XwVkSwapchain *self);
+void           xw_vk_swapchain_destroy (XwVkSwapchain *self);
+XwVkSwapchain *xw_vk_swapchain_handle_event (XwVkSwapchain *self, const XwEvent *event);
+XwVkSwapchain *xw_vk_swapchain_collect_retired (XwVkSwapchain *self);
+
+VkResult xw_vk_swapchain_acquire (
+    XwVkSwapchain *self,
+    VkSemaphore    image_available,
+    Uint64         timeout,
+    Uint32        *image_index
+);
+VkResult xw_vk_swapchain_present (
+    XwVkSwapchain *self,
+    VkQueue        queue,
+    VkSemaphore    render_finished,
+    VkFence        render_fence,
+    Uint32         image_index
+);
+
+/**
+ * @b Objects used to record and submit one frame. A frame ring cycles through these.
+ * */
+typedef struct XwVkFrame {
+    VkCommandPool   cmd_pool;        /**< @b Reset as a whole when frame begins. */
+    VkCommandBuffer cmd_buffer;      /**< @b In recording state between frame begin and end. */
+    VkFence         fence;           /**< @b Signalled when GPU is done with this frame. */
+    VkSemaphore     image_available; /**< @b Signalled when acquired image can be rendered to. */
+    Uint32          image_index;     /**< @b Swapchain image acquired for this frame. */
+} XwVkFrame;
+
+typedef struct XwVkFrameRingCreateInfo {
+    XwVkSwapchain *swapchain;          /**< @b Swapchain to acquire images from and present to. */
+    VkQueue        queue;              /**< @b Queue to submit and present on. */
+    Uint32         queue_family_index; /**< @b Family of @c queue, used for command pools. */
+    Uint32         frame_count;        /**< @b Frames in flight. Zero selects 2. */
+
+    /** @b Stage that waits for acquired image. Zero selects color attachment output. */
+    VkPipelineStageFlags wait_stage;
+} XwVkFrameRingCreateInfo;
+
+/**
+ * @b Ring of frames in flight.
+ *
+ * CPU records frame N while GPU still executes upto @c frame_count - 1 previous frames, and waits
+ * only when it gets a full ring ahead. Acquire semaphores are per frame, because image index is
+ * not known before acquiring. Render finished semaphores are per swapchain image, because one is
+ * released only when that image is acquired again.
+ *
+ * All fields are read only.
+ * */
+typedef struct XwVkFrameRing {
+    XwVkFrameRingCreateInfo info;
+    VkDevice                device;
+
+    XwVkFrame *frames;
+    Uint32     frame_count;
+    Uint32     current;      /**< @b Index of frame to be used by next begin. */
+    Uint64     frame_number; /**< @b Number of frames submitted so far. */
+
+    VkSemaphore *render_finished; /**< @b One per swapchain image. */
+    Uint32       render_finished_count;
+} XwVkFrameRing;
+
+XwVkFrameRing *xw_vk_frame_ring_create (const XwVkFrameRingCreateInfo *info);
+XwVkFrameRing *xw_vk_frame_ring_init (XwVkFrameRing *self, const XwVkFrameRingCreateInfo *info);
+XwVkFrameRing *xw_vk_frame_ring_deinit (XwVkFrameRing *self);
+void           xw_vk_frame_ring_destroy (XwVkFrameRing *self);
+
+VkResult xw_vk_frame_begin (XwVkFrameRing *ring, XwVkFrame **frame);
+VkResult xw_vk_frame_end (XwVkFrameRing *ring, XwVkFrame *frame);
+
+#pragma GCC visibility pop
+
 #endif // CROSSWINDOW_VULKAN_H
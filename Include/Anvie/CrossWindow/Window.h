@@ -35,6 +35,8 @@
 
 #include <Anvie/Types.h>
 
+#pragma GCC visibility push(default)
+
 typedef struct XwWindowSize {
     Uint32 width;
     Uint32 height;
@@ -124,7 +126,24 @@ typedef enum XwWindowActionPermissionMask : XwWindowActionPermissions {
  * */
 typedef struct XwWindow XwWindow;
 
-XwWindow *xw_window_create (CString title, Uint32 width, Uint32 height, Uint32 xpos, Uint32 ypos);
+/**
+ * @b Arguments for creating a single window with @c xw_window_create_many.
+ *
+ * Fields have same meaning as arguments of @c xw_window_create.
+ * */
+typedef struct XwWindowCreateInfo {
+    CString title;  /**< @b Can be @c Null. */
+    Uint32  width;  /**< @b Cannot be 0. */
+    Uint32  height; /**< @b Cannot be 0. */
+    Uint32  xpos;
+    Uint32  ypos;
+} XwWindowCreateInfo;
+
+Bool xw_init (void);
+Bool xw_deinit (void);
+
+XwWindow  *xw_window_create (CString title, Uint32 width, Uint32 height, Uint32 xpos, Uint32 ypos);
+XwWindow **xw_window_create_many (const XwWindowCreateInfo *infos, Size n, XwWindow **out);
 XwWindow *xw_window_init (
     XwWindow *self,
     CString   title,
@@ -146,6 +165,8 @@ XwWindowSize              xw_window_get_min_size (XwWindow *self);
 XwWindowPos               xw_window_get_pos (XwWindow *self);
 XwWindowState             xw_window_get_state (XwWindow *self);
 XwWindowActionPermissions xw_window_get_action_permissions (XwWindow *self);
+Float64                   xw_window_get_refresh_rate (XwWindow *self);
+Bool                      xw_should_render (XwWindow *win);
 
 CString      xw_window_set_title (XwWindow *self, CString title);
 XwWindowSize xw_window_set_size (XwWindow *self, XwWindowSize size);
@@ -158,4 +179,6 @@ XwWindowActionPermissions
           xw_window_set_action_permissions (XwWindow *self, XwWindowActionPermissions permissions);
 XwWindow *xw_window_set_bordered (XwWindow *self, Bool border);
 
+#pragma GCC visibility pop
+
 #endif // CROSSWINDOW_WINDOW_H
@@ -0,0 +1,147 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Null.h>
+#include <Anvie/CrossWindow/Stats.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <time.h>
+
+#define STALL_EVENTS 100000 /* events that arrive while application is stalled */
+#define BUTTON_EVERY 100    /* every n-th event is a button press or release */
+#define RESIZE_EVERY 50     /* every n-th event is a resize */
+#define MOTION_LIMIT 64
+#define WINDOW_LIMIT 256
+#define HANDLING_NS  1000 /* time application spends on each event */
+
+typedef struct StallResult {
+    Size    returned;      /**< @b Events returned after stall. */
+    Size    buttons;       /**< @b Button events returned, in injected order. */
+    Int64   motion_dx;     /**< @b Sum of dx of all mouse moves returned. */
+    Int64   injected_dx;   /**< @b Sum of dx of all mouse moves injected. */
+    Float64 recovery;      /**< @b Seconds till all events after stall were handled. */
+    Bool    final_size_ok; /**< @b Last resize returned had size injected last. */
+} StallResult;
+
+static Float64     get_time_seconds (void);
+static void        spin_for (Float64 seconds);
+static StallResult run_stall (XwWindow *win);
+
+int main() {
+    XwWindow *win = xw_window_create ("Stalled", 64, 64, 0, 0);
+    RETURN_VALUE_IF (!win, EXIT_FAILURE, "Failed to create window\n");
+
+    /* drop events generated while creating window */
+    XwEvent e;
+    while (xw_event_poll (&e)) {}
+
+    printf (
+        "%8s %10s %10s %12s %12s %12s %14s\n",
+        "limits",
+        "returned",
+        "buttons",
+        "motion dx",
+        "overflow",
+        "max depth",
+        "recovery (ms)"
+    );
+
+    Bool failed = False;
+    for (Size limited = 0; limited < 2; limited++) {
+        xw_event_set_backlog_limit (XW_EVENT_CLASS_MOTION, limited ? MOTION_LIMIT : 0);
+        xw_event_set_backlog_limit (XW_EVENT_CLASS_WINDOW, limited ? WINDOW_LIMIT : 0);
+        xw_stats_reset_event_backlog();
+
+        StallResult result = run_stall (win);
+
+        XwEventBacklogStats stats;
+        xw_stats_event_backlog (&stats);
+
+        printf (
+            "%8s %10zu %10zu %12lld %12llu %12zu %14.2f\n",
+            limited ? "on" : "off",
+            result.returned,
+            result.buttons,
+            (long long)result.motion_dx,
+            (unsigned long long)stats.overflow[XW_EVENT_CLASS_MOTION],
+            stats.max_depth[XW_EVENT_CLASS_MOTION],
+            result.recovery * 1e3
+        );
+
+        /* nothing that matters may be lost, and backlog must stay within limits */
+        failed |= result.buttons != STALL_EVENTS / BUTTON_EVERY;
+        failed |= result.motion_dx != result.injected_dx;
+        failed |= !result.final_size_ok;
+        failed |= limited && stats.max_depth[XW_EVENT_CLASS_MOTION] > MOTION_LIMIT;
+        failed |= limited && stats.max_depth[XW_EVENT_CLASS_WINDOW] > WINDOW_LIMIT;
+        failed |= stats.depth[XW_EVENT_CLASS_MOTION] || stats.depth[XW_EVENT_CLASS_INPUT];
+    }
+
+    xw_event_set_backlog_limit (XW_EVENT_CLASS_MOTION, 0);
+    xw_event_set_backlog_limit (XW_EVENT_CLASS_WINDOW, 0);
+    xw_window_destroy (win);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Busy wait, standing in for work application does for an event.
+ * */
+static void spin_for (Float64 seconds) {
+    Float64 until = get_time_seconds() + seconds;
+    while (get_time_seconds() < until) {}
+}
+
+/**
+ * @b Inject what a display server would send while application is stalled : mostly mouse
+ *    moves, with some button presses and resizes in between. Then handle all of it.
+ *
+ * @param win
+ * */
+static StallResult run_stall (XwWindow *win) {
+    StallResult result = {0};
+    XwEvent     e;
+
+    XwWindowSize last_size = {0};
+    for (Size s = 1; s <= STALL_EVENTS; s++) {
+        if (!(s % BUTTON_EVERY)) {
+            XwMouseButtonState state = (s / BUTTON_EVERY) % 2 ? XW_MOUSE_BUTTON_MASK_LEFT : 0;
+            xw_null_inject_event (
+                xw_event_mouse_input (&e, state, s / BUTTON_EVERY, 0, (XwModifierState) {0}, win)
+            );
+        } else if (!(s % RESIZE_EVERY)) {
+            last_size = (XwWindowSize) {100 + s % 500, 100 + s % 300};
+            xw_null_inject_event (xw_event_resize (&e, last_size.width, last_size.height, win));
+        } else {
+            xw_null_inject_event (xw_event_mouse_move (&e, s % 640, s % 480, 1, 0, win));
+            result.injected_dx++;
+        }
+    }
+
+    Float64 start = get_time_seconds();
+    while (xw_event_poll (&e)) {
+        result.returned++;
+
+        if (e.type == XW_EVENT_TYPE_MOUSE_INPUT) {
+            /* x of button events counts them, so order can be checked */
+            result.buttons += e.mouse_input.x == result.buttons + 1;
+        } else if (e.type == XW_EVENT_TYPE_MOUSE_MOVE) {
+            result.motion_dx += e.mouse_move.dx;
+        } else if (e.type == XW_EVENT_TYPE_RESIZE) {
+            result.final_size_ok = e.resize.width == last_size.width &&
+                                   e.resize.height == last_size.height;
+        }
+
+        spin_for (HANDLING_NS * 1e-9);
+    }
+    result.recovery = get_time_seconds() - start;
+
+    return result;
+}
@@ -0,0 +1,224 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Framebuffer.h>
+
+/* libc */
+#include <string.h>
+#include <time.h>
+
+/* a full-hd frame */
+#define FRAME_WIDTH  1920
+#define FRAME_HEIGHT 1080
+
+/* not a multiple of any vector width, so row tails are compared against scalar too */
+#define ODD_FRAME_WIDTH (FRAME_WIDTH + 1)
+
+/* run each conversion for at least this long */
+#define MIN_SECONDS 0.25
+
+typedef struct Conversion {
+    CString        name;
+    XwPixelFormat  format;
+    Size           pixel_size;
+    XwConvertFlags flags;
+} Conversion;
+
+static Conversion conversions[] = {
+    {"swizzle RGBA8888", XW_PIXEL_FORMAT_RGBA8888, 4, XW_CONVERT_FLAG_NONE},
+    {"premultiply RGBA8888", XW_PIXEL_FORMAT_RGBA8888, 4, XW_CONVERT_FLAG_PREMULTIPLY},
+    {"expand RGB565", XW_PIXEL_FORMAT_RGB565, 2, XW_CONVERT_FLAG_NONE},
+    {"unorm RGBA32F", XW_PIXEL_FORMAT_RGBA32F, 4 * sizeof (Float32), XW_CONVERT_FLAG_NONE},
+};
+
+/* SIMD kernels swap red and blue for first one, and keep them in place for second */
+static struct {
+    CString       name;
+    XwPixelFormat format;
+} targets[] = {
+    {"BGRX8888", XW_PIXEL_FORMAT_BGRX8888},
+    {"RGBX8888", XW_PIXEL_FORMAT_RGBX8888},
+};
+
+static Size widths[] = {FRAME_WIDTH, ODD_FRAME_WIDTH};
+
+static CString level_names[] = {
+    [XW_SIMD_LEVEL_SCALAR] = "scalar",
+    [XW_SIMD_LEVEL_SSE2]   = "sse2",
+    [XW_SIMD_LEVEL_AVX2]   = "avx2",
+    [XW_SIMD_LEVEL_NEON]   = "neon",
+};
+
+static Float64 get_time_seconds (void);
+static void    fill_source (Uint8 *src, Size size, XwPixelFormat format);
+static Float64 bench_conversion (XwFramebuffer *fb, const Uint8 *src, Conversion *conv);
+static Bool    matches_scalar (
+    XwFramebuffer *fb,
+    const Uint8   *src,
+    Uint8         *reference,
+    Conversion    *conv,
+    XwSimdLevel    level
+);
+
+/**
+ * Output of every simd level is compared against scalar for every conversion, target format
+ * and frame width, and only full-hd frames are timed. Exits with failure on any mismatch.
+ * */
+int main() {
+    XwFramebuffer fb = {
+        .width           = FRAME_WIDTH,
+        .height          = FRAME_HEIGHT,
+        .stride          = FRAME_WIDTH * 4,
+        .bytes_per_pixel = 4,
+    };
+
+    Size   frame_size = (Size)ODD_FRAME_WIDTH * FRAME_HEIGHT;
+    Uint8 *src        = ALLOCATE (Uint8, frame_size * 4 * sizeof (Float32));
+    Uint8 *reference  = ALLOCATE (Uint8, frame_size * 4);
+    fb.pixels         = ALLOCATE (Uint8, frame_size * 4);
+    GOTO_HANDLER_IF (!src || !reference || !fb.pixels, ALLOC_FAILED, ERR_OUT_OF_MEMORY);
+
+    Bool all_same = True;
+
+    printf (
+        "%-22s %-10s %-8s %12s %12s %s\n",
+        "conversion",
+        "target",
+        "simd",
+        "GB/s",
+        "speedup",
+        "result"
+    );
+    for (Size t = 0; t < ARRAY_SIZE (targets); t++) {
+        fb.format = targets[t].format;
+
+        for (Size c = 0; c < ARRAY_SIZE (conversions); c++) {
+            Conversion *conv = conversions + c;
+            fill_source (src, frame_size * conv->pixel_size, conv->format);
+
+            Float64 scalar_rate = 0;
+            for (XwSimdLevel level = XW_SIMD_LEVEL_SCALAR; level < XW_SIMD_LEVEL_MAX; level++) {
+                if (!xw_set_simd_level (level)) {
+                    continue;
+                }
+
+                Bool same = matches_scalar (&fb, src, reference, conv, level);
+                all_same  = all_same && same;
+
+                Float64 rate = bench_conversion (&fb, src, conv);
+                if (level == XW_SIMD_LEVEL_SCALAR) {
+                    scalar_rate = rate;
+                }
+
+                printf (
+                    "%-22s %-10s %-8s %12.2f %11.2fx %s\n",
+                    conv->name,
+                    targets[t].name,
+                    level_names[level],
+                    rate,
+                    rate / scalar_rate,
+                    same ? "ok" : "MISMATCH"
+                );
+            }
+        }
+    }
+
+    xw_set_simd_level (XW_SIMD_LEVEL_AUTO);
+
+    FREE (src);
+    FREE (reference);
+    FREE (fb.pixels);
+    return all_same ? EXIT_SUCCESS : EXIT_FAILURE;
+
+ALLOC_FAILED: {
+    FREE (src);
+    FREE (reference);
+    FREE (fb.pixels);
+    return EXIT_FAILURE;
+}
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Fill source with deterministic pseudo-random pixels.
+ * */
+static void fill_source (Uint8 *src, Size size, XwPixelFormat format) {
+    Uint32 state = 0x12345678;
+
+    if (format == XW_PIXEL_FORMAT_RGBA32F) {
+        Float32 *f = (Float32 *)src;
+        for (Size s = 0; s < size / sizeof (Float32); s++) {
+            state = state * 1664525 + 1013904223;
+            /* slightly out of [0, 1] range to exercise clamping */
+            f[s] = (Float32)(state >> 8) / (1 << 24) * 1.2f - 0.1f;
+        }
+        return;
+    }
+
+    for (Size s = 0; s < size; s++) {
+        state  = state * 1664525 + 1013904223;
+        src[s] = state >> 24;
+    }
+}
+
+/**
+ * @b Convert full frames repeatedly with current simd level.
+ *
+ * @return Throughput in GB of framebuffer memory written per second.
+ * */
+static Float64 bench_conversion (XwFramebuffer *fb, const Uint8 *src, Conversion *conv) {
+    XwRect  rect       = {0, 0, fb->width, fb->height};
+    Size    src_stride = fb->width * conv->pixel_size;
+    Size    frames     = 0;
+    Float64 start      = get_time_seconds();
+    Float64 elapsed    = 0;
+
+    do {
+        xw_framebuffer_write (fb, rect, src, src_stride, conv->format, conv->flags);
+        frames++;
+        elapsed = get_time_seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    return (Float64)frames * fb->stride * fb->height / elapsed / 1e9;
+}
+
+/**
+ * @b Compare output of given simd level against scalar one, for every frame width.
+ * Framebuffer is left with a full-hd frame converted with given simd level.
+ *
+ * @return True if output is identical for every width.
+ * @return False otherwise.
+ * */
+static Bool matches_scalar (
+    XwFramebuffer *fb,
+    const Uint8   *src,
+    Uint8         *reference,
+    Conversion    *conv,
+    XwSimdLevel    level
+) {
+    Bool same = True;
+
+    for (Size w = ARRAY_SIZE (widths); w--;) {
+        fb->width  = widths[w];
+        fb->stride = widths[w] * 4;
+
+        XwRect rect       = {0, 0, fb->width, fb->height};
+        Size   src_stride = fb->width * conv->pixel_size;
+        Size   size       = fb->stride * fb->height;
+
+        xw_set_simd_level (XW_SIMD_LEVEL_SCALAR);
+        xw_framebuffer_write (fb, rect, src, src_stride, conv->format, conv->flags);
+        memcpy (reference, fb->pixels, size);
+
+        xw_set_simd_level (level);
+        xw_framebuffer_write (fb, rect, src, src_stride, conv->format, conv->flags);
+        same = same && !memcmp (reference, fb->pixels, size);
+    }
+
+    return same;
+}
@@ -0,0 +1,137 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/FramePacer.h>
+#include <Anvie/CrossWindow/Timer.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <time.h>
+
+#define FRAME_RATE  60.0
+#define RUN_SECONDS 1.0
+#define TIMER_NS    5000000ull
+
+static Float64 get_time_seconds (clockid_t clock);
+
+int main() {
+    XwWindow *win = xw_window_create ("Paced", 64, 64, 0, 0);
+    RETURN_VALUE_IF (!win, EXIT_FAILURE, "Failed to create window\n");
+
+    /* a timer keeps events arriving in between frames, like input would */
+    XwTimer *timer = xw_timer_create (TIMER_NS, True, Null);
+    GOTO_HANDLER_IF (!timer, TIMER_FAILED, "Failed to create timer\n");
+
+    XwFramePacer *pacer = xw_frame_pacer_create (win, FRAME_RATE);
+    GOTO_HANDLER_IF (!pacer, PACER_FAILED, "Failed to create frame pacer\n");
+
+    /* render loop spinning on xw_event_poll, as render loops without a pacer do */
+    XwEvent e;
+    Size    busy_frames = 0;
+    Float64 wall_start  = get_time_seconds (CLOCK_MONOTONIC);
+    Float64 cpu_start   = get_time_seconds (CLOCK_PROCESS_CPUTIME_ID);
+    Float64 next_frame  = wall_start;
+    while (get_time_seconds (CLOCK_MONOTONIC) - wall_start < RUN_SECONDS) {
+        while (xw_event_poll (&e)) {}
+
+        if (get_time_seconds (CLOCK_MONOTONIC) >= next_frame) {
+            next_frame += 1 / FRAME_RATE;
+            busy_frames++;
+        }
+    }
+    Float64 busy_cpu = (get_time_seconds (CLOCK_PROCESS_CPUTIME_ID) - cpu_start) / RUN_SECONDS;
+
+    /* same loop, paced */
+    Size paced_frames = 0, timer_events = 0;
+    wall_start        = get_time_seconds (CLOCK_MONOTONIC);
+    cpu_start         = get_time_seconds (CLOCK_PROCESS_CPUTIME_ID);
+    while (get_time_seconds (CLOCK_MONOTONIC) - wall_start < RUN_SECONDS) {
+        while (xw_frame_pacer_wait (pacer, &e)) {
+            timer_events += e.type == XW_EVENT_TYPE_TIMER;
+        }
+        paced_frames++;
+    }
+    Float64 paced_cpu = (get_time_seconds (CLOCK_PROCESS_CPUTIME_ID) - cpu_start) / RUN_SECONDS;
+
+    XwFramePacerStats stats;
+    xw_frame_pacer_get_stats (pacer, &stats);
+
+    /* same loop with window minimized and idle blocking, only a timer ends the wait */
+    xw_timer_destroy (timer);
+    timer = xw_timer_create (RUN_SECONDS * 1e9, False, Null);
+    GOTO_HANDLER_IF (!timer, PACER_FAILED, "Failed to create timer\n");
+
+    xw_event_set_idle_blocking (True);
+    xw_window_hide (win);
+
+    Size idle_frames = 0, idle_wakeups = 0;
+    wall_start       = get_time_seconds (CLOCK_MONOTONIC);
+    cpu_start        = get_time_seconds (CLOCK_PROCESS_CPUTIME_ID);
+    while (get_time_seconds (CLOCK_MONOTONIC) - wall_start < RUN_SECONDS) {
+        while (xw_frame_pacer_wait (pacer, &e)) {
+            idle_wakeups++;
+            if (e.type == XW_EVENT_TYPE_TIMER) {
+                break;
+            }
+        }
+        idle_frames += xw_should_render (win);
+    }
+    Float64 idle_cpu = (get_time_seconds (CLOCK_PROCESS_CPUTIME_ID) - cpu_start) / RUN_SECONDS;
+
+    /* drawing resumes as soon as window is shown again */
+    xw_window_show (win);
+    Bool resumed = False;
+    while (!resumed) {
+        resumed = !xw_frame_pacer_wait (pacer, &e);
+    }
+    xw_event_set_idle_blocking (False);
+
+    printf ("%8s %10s %10s\n", "loop", "frames", "cpu %");
+    printf ("%8s %10zu %10.1f\n", "busy", busy_frames, busy_cpu * 100);
+    printf ("%8s %10zu %10.1f\n", "paced", paced_frames, paced_cpu * 100);
+    printf ("%8s %10zu %10.1f\n", "hidden", idle_frames, idle_cpu * 100);
+    printf (
+        "\n%12s %12s %12s %12s %12s %10s\n",
+        "interval us",
+        "jitter us",
+        "max jit us",
+        "spin us",
+        "missed",
+        "timers"
+    );
+    printf (
+        "%12.1f %12.1f %12.1f %12.1f %12llu %10zu\n",
+        stats.mean_interval_ns / 1e3,
+        stats.jitter_ns / 1e3,
+        stats.max_jitter_ns / 1e3,
+        stats.spin_ns / 1e3,
+        (unsigned long long)stats.missed,
+        timer_events
+    );
+
+    xw_frame_pacer_destroy (pacer);
+    xw_timer_destroy (timer);
+    xw_window_destroy (win);
+
+    /* a paced loop must keep the rate and deliver events, without burning a core */
+    Size expected = FRAME_RATE * RUN_SECONDS;
+    Bool failed   = paced_frames + stats.missed + 2 < expected || paced_frames > expected + 2 ||
+                  !timer_events || paced_cpu > 0.5;
+
+    /* and must sleep through while window cannot be seen */
+    failed = failed || idle_frames || idle_wakeups > 4 || idle_cpu > 0.05;
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+
+PACER_FAILED:
+    xw_timer_destroy (timer);
+TIMER_FAILED:
+    xw_window_destroy (win);
+    return EXIT_FAILURE;
+}
+
+static Float64 get_time_seconds (clockid_t clock) {
+    struct timespec ts;
+    clock_gettime (clock, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
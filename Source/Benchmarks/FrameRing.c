@@ -0,0 +1,352 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Vulkan.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <string.h>
+#include <time.h>
+
+#define WINDOW_WIDTH  960
+#define WINDOW_HEIGHT 540
+
+/* frames rendered for each ring size, after a few warmup frames */
+#define WARMUP_FRAMES 30
+#define BENCH_FRAMES  300
+
+/* simulated per-frame work on CPU (game logic etc...) and GPU (render passes clearing image) */
+#define CPU_WORK_SECONDS 0.002
+#define GPU_PASSES       16
+
+typedef struct Bench {
+    XwWindow        *win;
+    VkInstance       instance;
+    VkSurfaceKHR     surface;
+    VkPhysicalDevice gpu;
+    Uint32           queue_family_index;
+    VkDevice         device;
+    VkQueue          queue;
+    VkRenderPass     render_pass;
+    XwVkSwapchain   *swapchain;
+} Bench;
+
+static Uint32 frame_counts[] = {1, 2, 3};
+
+static Float64 get_time_seconds (void);
+static Bench  *bench_init (Bench *bench);
+static void    bench_deinit (Bench *bench);
+static Bool    bench_select_gpu (Bench *bench);
+static Bool    bench_create_render_pass (Bench *bench);
+static Float64 bench_frames (Bench *bench, Uint32 frame_count);
+
+int main() {
+    Bench bench = {0};
+    RETURN_VALUE_IF (!bench_init (&bench), EXIT_FAILURE, "Failed to initialize Vulkan\n");
+
+    printf (
+        "cpu work per frame : %.1f ms, gpu work per frame : %u render passes\n",
+        CPU_WORK_SECONDS * 1e3,
+        GPU_PASSES
+    );
+    printf ("%16s %16s %12s %12s\n", "frames in flight", "frame time (ms)", "fps", "speedup");
+
+    Float64 single_frame_time = 0;
+    for (Size c = 0; c < ARRAY_SIZE (frame_counts); c++) {
+        Float64 frame_time = bench_frames (&bench, frame_counts[c]);
+        GOTO_HANDLER_IF (frame_time <= 0, BENCH_FAILED, "Failed to render frames\n");
+
+        if (!c) {
+            single_frame_time = frame_time;
+        }
+
+        printf (
+            "%16u %16.3f %12.1f %11.2fx\n",
+            frame_counts[c],
+            frame_time * 1e3,
+            1 / frame_time,
+            single_frame_time / frame_time
+        );
+    }
+
+    bench_deinit (&bench);
+    return EXIT_SUCCESS;
+
+BENCH_FAILED:
+    bench_deinit (&bench);
+    return EXIT_FAILURE;
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Create window, Vulkan instance, device, render pass and swapchain.
+ * */
+static Bench *bench_init (Bench *bench) {
+    bench->win = xw_window_create ("bench_frame_ring", WINDOW_WIDTH, WINDOW_HEIGHT, 0, 0);
+    RETURN_VALUE_IF (!bench->win, Null, "Failed to create window\n");
+
+    Size     ext_count = 0;
+    CString *exts      = xw_get_required_extension_names (&ext_count);
+
+    VkApplicationInfo app_info = {
+        .sType      = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+        .pNext      = Null,
+        .apiVersion = VK_API_VERSION_1_0,
+    };
+
+    VkInstanceCreateInfo instance_create_info = {
+        .sType                   = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+        .pNext                   = Null,
+        .pApplicationInfo        = &app_info,
+        .enabledExtensionCount   = ext_count,
+        .ppEnabledExtensionNames = exts,
+    };
+
+    VkResult res = vkCreateInstance (&instance_create_info, Null, &bench->instance);
+    GOTO_HANDLER_IF (res != VK_SUCCESS, INIT_FAILED, "Failed to create instance. RET = %d\n", res);
+
+    res = xw_window_create_vulkan_surface (bench->win, bench->instance, &bench->surface);
+    GOTO_HANDLER_IF (res != VK_SUCCESS, INIT_FAILED, "Failed to create surface. RET = %d\n", res);
+
+    GOTO_HANDLER_IF (!bench_select_gpu (bench), INIT_FAILED, "No GPU can present to window\n");
+
+    CString device_exts[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+    Float32 priority      = 1.f;
+
+    VkDeviceQueueCreateInfo queue_create_info = {
+        .sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .pNext            = Null,
+        .queueFamilyIndex = bench->queue_family_index,
+        .queueCount       = 1,
+        .pQueuePriorities = &priority,
+    };
+
+    VkDeviceCreateInfo device_create_info = {
+        .sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext                   = Null,
+        .queueCreateInfoCount    = 1,
+        .pQueueCreateInfos       = &queue_create_info,
+        .enabledExtensionCount   = ARRAY_SIZE (device_exts),
+        .ppEnabledExtensionNames = device_exts,
+    };
+
+    res = vkCreateDevice (bench->gpu, &device_create_info, Null, &bench->device);
+    GOTO_HANDLER_IF (res != VK_SUCCESS, INIT_FAILED, "Failed to create device. RET = %d\n", res);
+    vkGetDeviceQueue (bench->device, bench->queue_family_index, 0, &bench->queue);
+
+    GOTO_HANDLER_IF (
+        !bench_create_render_pass (bench),
+        INIT_FAILED,
+        "Failed to create render pass\n"
+    );
+
+    /* don't let vsync hide the difference */
+    XwWindowSize            size                  = xw_window_get_size (bench->win);
+    XwVkSwapchainCreateInfo swapchain_create_info = {
+        .gpu            = bench->gpu,
+        .device         = bench->device,
+        .surface        = bench->surface,
+        .window         = bench->win,
+        .extent         = {size.width, size.height},
+        .surface_format = {VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR},
+        .latency_policy = XW_VK_LATENCY_POLICY_LOWEST_LATENCY,
+        .render_pass    = bench->render_pass,
+    };
+
+    bench->swapchain = xw_vk_swapchain_create (&swapchain_create_info);
+    GOTO_HANDLER_IF (!bench->swapchain, INIT_FAILED, "Failed to create swapchain\n");
+
+    /* render pass is created before swapchain, with this format */
+    GOTO_HANDLER_IF (
+        bench->swapchain->surface_format.format != VK_FORMAT_B8G8R8A8_UNORM,
+        INIT_FAILED,
+        "Surface does not support B8G8R8A8_UNORM format\n"
+    );
+
+    return bench;
+
+INIT_FAILED:
+    bench_deinit (bench);
+    return Null;
+}
+
+static void bench_deinit (Bench *bench) {
+    if (bench->device) {
+        vkDeviceWaitIdle (bench->device);
+
+        if (bench->swapchain) {
+            xw_vk_swapchain_destroy (bench->swapchain);
+        }
+
+        if (bench->render_pass) {
+            vkDestroyRenderPass (bench->device, bench->render_pass, Null);
+        }
+
+        vkDestroyDevice (bench->device, Null);
+    }
+
+    if (bench->surface) {
+        vkDestroySurfaceKHR (bench->instance, bench->surface, Null);
+    }
+
+    if (bench->instance) {
+        vkDestroyInstance (bench->instance, Null);
+    }
+
+    if (bench->win) {
+        xw_window_destroy (bench->win);
+    }
+
+    memset (bench, 0, sizeof (Bench));
+}
+
+/**
+ * @b Select first GPU having a queue family that supports both graphics and presenting.
+ * */
+static Bool bench_select_gpu (Bench *bench) {
+    Uint32 gpu_count = 0;
+    vkEnumeratePhysicalDevices (bench->instance, &gpu_count, Null);
+    RETURN_VALUE_IF (!gpu_count, False, "No Vulkan devices found\n");
+
+    VkPhysicalDevice gpus[gpu_count];
+    vkEnumeratePhysicalDevices (bench->instance, &gpu_count, gpus);
+
+    for (Uint32 g = 0; g < gpu_count; g++) {
+        Uint32 family_count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties (gpus[g], &family_count, Null);
+
+        VkQueueFamilyProperties families[family_count + 1];
+        vkGetPhysicalDeviceQueueFamilyProperties (gpus[g], &family_count, families);
+
+        for (Uint32 f = 0; f < family_count; f++) {
+            VkBool32 can_present = VK_FALSE;
+            vkGetPhysicalDeviceSurfaceSupportKHR (gpus[g], f, bench->surface, &can_present);
+
+            if (can_present && (families[f].queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+                bench->gpu                = gpus[g];
+                bench->queue_family_index = f;
+                return True;
+            }
+        }
+    }
+
+    return False;
+}
+
+/**
+ * @b Render pass with a single color attachment that's cleared and then presented.
+ * */
+static Bool bench_create_render_pass (Bench *bench) {
+    VkAttachmentDescription color_attachment = {
+        .format         = VK_FORMAT_B8G8R8A8_UNORM,
+        .samples        = VK_SAMPLE_COUNT_1_BIT,
+        .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
+        .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        .initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED,
+        .finalLayout    = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+    };
+
+    VkAttachmentReference color_reference = {
+        .attachment = 0,
+        .layout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+    };
+
+    VkSubpassDescription subpass = {
+        .pipelineBindPoint    = VK_PIPELINE_BIND_POINT_GRAPHICS,
+        .colorAttachmentCount = 1,
+        .pColorAttachments    = &color_reference,
+    };
+
+    VkRenderPassCreateInfo render_pass_create_info = {
+        .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+        .pNext           = Null,
+        .attachmentCount = 1,
+        .pAttachments    = &color_attachment,
+        .subpassCount    = 1,
+        .pSubpasses      = &subpass,
+    };
+
+    VkResult res =
+        vkCreateRenderPass (bench->device, &render_pass_create_info, Null, &bench->render_pass);
+    return res == VK_SUCCESS;
+}
+
+/**
+ * @b Render frames using a ring of given size.
+ *
+ * @return Mean frame time in seconds.
+ * @return Zero on failure.
+ * */
+static Float64 bench_frames (Bench *bench, Uint32 frame_count) {
+    XwVkFrameRingCreateInfo ring_create_info = {
+        .swapchain          = bench->swapchain,
+        .queue              = bench->queue,
+        .queue_family_index = bench->queue_family_index,
+        .frame_count        = frame_count,
+    };
+
+    XwVkFrameRing *ring = xw_vk_frame_ring_create (&ring_create_info);
+    RETURN_VALUE_IF (!ring, 0, "Failed to create frame ring\n");
+
+    Float64 start = 0;
+    for (Size f = 0; f < WARMUP_FRAMES + BENCH_FRAMES; f++) {
+        if (f == WARMUP_FRAMES) {
+            start = get_time_seconds();
+        }
+
+        XwEvent e;
+        while (xw_event_poll (&e)) {
+            xw_vk_swapchain_handle_event (bench->swapchain, &e);
+        }
+
+        XwVkFrame *frame = Null;
+        VkResult   res   = xw_vk_frame_begin (ring, &frame);
+        if (res == VK_NOT_READY || res == VK_ERROR_OUT_OF_DATE_KHR) {
+            continue;
+        }
+        GOTO_HANDLER_IF (res != VK_SUCCESS, FRAME_FAILED, "Failed to begin frame\n");
+
+        /* CPU side of the frame, overlaps with GPU work of previous frames when ring allows it */
+        Float64 cpu_end = get_time_seconds() + CPU_WORK_SECONDS;
+        while (get_time_seconds() < cpu_end) {}
+
+        VkClearValue          clear_value = {.color = {{0.1f, 0.2f, 0.3f, 1.f}}};
+        VkRenderPassBeginInfo begin_info  = {
+             .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+             .pNext           = Null,
+             .renderPass      = bench->render_pass,
+             .framebuffer     = bench->swapchain->framebuffers[frame->image_index],
+             .renderArea      = {.offset = {0, 0}, .extent = bench->swapchain->extent},
+             .clearValueCount = 1,
+             .pClearValues    = &clear_value,
+        };
+
+        for (Size p = 0; p < GPU_PASSES; p++) {
+            vkCmdBeginRenderPass (frame->cmd_buffer, &begin_info, VK_SUBPASS_CONTENTS_INLINE);
+            vkCmdEndRenderPass (frame->cmd_buffer);
+        }
+
+        res = xw_vk_frame_end (ring, frame);
+        GOTO_HANDLER_IF (res != VK_SUCCESS, FRAME_FAILED, "Failed to end frame\n");
+    }
+
+    /* frame time includes waiting for the last frames to finish */
+    vkDeviceWaitIdle (bench->device);
+    Float64 elapsed = get_time_seconds() - start;
+
+    xw_vk_frame_ring_destroy (ring);
+    return elapsed / BENCH_FRAMES;
+
+FRAME_FAILED:
+    vkDeviceWaitIdle (bench->device);
+    xw_vk_frame_ring_destroy (ring);
+    return 0;
+}
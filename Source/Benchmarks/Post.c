@@ -0,0 +1,130 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+
+/* libc */
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define POSTER_COUNT     4
+#define POSTS_PER_THREAD 200000
+#define BATCH_SIZE       4096
+
+typedef struct Poster {
+    pthread_t thread;
+    Uint32    code;    /**< @b Tells events of this poster apart. */
+    Size      retries; /**< @b Posts that failed because queue was full. */
+} Poster;
+
+static Float64 get_time_seconds (void);
+static void   *poster_main (void *arg);
+
+int main() {
+    XwEvent e;
+
+    /* cost of posting when nothing is waiting, which should not make a system call */
+    Float64 post_ns = 0;
+    for (Size r = 0; r < 16; r++) {
+        Float64 start = get_time_seconds();
+        for (Size s = 0; s < BATCH_SIZE; s++) {
+            xw_event_post (xw_event_user (&e, 0, (void *)s, Null));
+        }
+        post_ns += (get_time_seconds() - start) * 1e9 / BATCH_SIZE;
+
+        while (xw_event_poll (&e)) {}
+    }
+    post_ns /= 16;
+
+    /* many threads posting while main thread polls, every event must arrive once and in order */
+    Poster posters[POSTER_COUNT] = {0};
+    Size   started               = 0;
+
+    Float64 start = get_time_seconds();
+    for (; started < POSTER_COUNT; started++) {
+        posters[started].code = started;
+        GOTO_HANDLER_IF (
+            pthread_create (&posters[started].thread, Null, poster_main, &posters[started]),
+            THREAD_CREATE_FAILED,
+            "Failed to create poster thread\n"
+        );
+    }
+
+    Size next[POSTER_COUNT] = {0};
+    Size received           = 0;
+    Size out_of_order       = 0;
+    while (received < POSTER_COUNT * POSTS_PER_THREAD) {
+        if (!xw_event_poll (&e)) {
+            continue;
+        }
+
+        if (e.type != XW_EVENT_TYPE_USER || e.user.code >= POSTER_COUNT ||
+            (Size)e.user.data != next[e.user.code]) {
+            out_of_order++;
+        } else {
+            next[e.user.code]++;
+        }
+        received++;
+    }
+    Float64 elapsed = get_time_seconds() - start;
+
+    Size retries = 0;
+    for (Size s = 0; s < POSTER_COUNT; s++) {
+        pthread_join (posters[s].thread, Null);
+        retries += posters[s].retries;
+    }
+
+    printf (
+        "%12s %8s %16s %10s %14s\n",
+        "ns/post",
+        "threads",
+        "events/s",
+        "retries",
+        "out of order"
+    );
+    printf (
+        "%12.1f %8d %16.1f %10zu %14zu\n",
+        post_ns,
+        POSTER_COUNT,
+        received / elapsed,
+        retries,
+        out_of_order
+    );
+
+    return out_of_order ? EXIT_FAILURE : EXIT_SUCCESS;
+
+THREAD_CREATE_FAILED: {
+    for (Size s = 0; s < started; s++) {
+        pthread_join (posters[s].thread, Null);
+    }
+    return EXIT_FAILURE;
+}
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Post numbered user events, retrying whenever queue of posted events is full.
+ *
+ * @param arg Poster.
+ * */
+static void *poster_main (void *arg) {
+    Poster *self = arg;
+
+    XwEvent e;
+    for (Size s = 0; s < POSTS_PER_THREAD; s++) {
+        xw_event_user (&e, self->code, (void *)s, Null);
+        while (!xw_event_post (&e)) {
+            /* queue is full, let main thread poll */
+            self->retries++;
+            sched_yield();
+        }
+    }
+
+    return Null;
+}
@@ -0,0 +1,155 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Null.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <time.h>
+
+#define ROUNDS      50
+#define STORM_SIZE  3000
+#define HANDLING_NS 2000 /* time application spends on each window management event */
+
+typedef struct RoundResult {
+    Size    returned;      /**< @b Events returned by pump in this round. */
+    Size    before_press;  /**< @b Events returned before key press. */
+    Float64 press_latency; /**< @b Seconds from start of pumping to getting key press. */
+    Bool    keys_in_order; /**< @b Both key events arrived, press before release. */
+    Bool    final_size_ok; /**< @b Last resize returned had size injected last. */
+} RoundResult;
+
+static Float64     get_time_seconds (void);
+static void        spin_for (Float64 seconds);
+static RoundResult run_round (XwWindow *win, Size round);
+
+int main() {
+    XwWindow *win = xw_window_create ("Storm", 64, 64, 0, 0);
+    RETURN_VALUE_IF (!win, EXIT_FAILURE, "Failed to create window\n");
+
+    /* drop events generated while creating window */
+    XwEvent e;
+    while (xw_event_poll (&e)) {}
+
+    printf (
+        "%10s %12s %14s %18s %18s\n",
+        "priority",
+        "returned",
+        "before press",
+        "mean latency (us)",
+        "max latency (us)"
+    );
+
+    Bool failed = False;
+    for (Size mode = 0; mode < 2; mode++) {
+        xw_event_set_priority_mode (mode);
+
+        Size    returned = 0, before_press = 0;
+        Float64 latency = 0, max_latency = 0;
+        for (Size r = 0; r < ROUNDS; r++) {
+            RoundResult result  = run_round (win, r);
+            returned           += result.returned;
+            before_press       += result.before_press;
+            latency            += result.press_latency;
+            max_latency         = MAX (max_latency, result.press_latency);
+
+            failed |= !result.keys_in_order || !result.final_size_ok;
+            failed |= mode && result.before_press;
+        }
+
+        printf (
+            "%10s %12zu %14zu %18.1f %18.1f\n",
+            mode ? "on" : "off",
+            returned / ROUNDS,
+            before_press / ROUNDS,
+            latency / ROUNDS * 1e6,
+            max_latency * 1e6
+        );
+    }
+
+    xw_event_set_priority_mode (False);
+    xw_window_destroy (win);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Busy wait, standing in for work application does for an event.
+ * */
+static void spin_for (Float64 seconds) {
+    Float64 until = get_time_seconds() + seconds;
+    while (get_time_seconds() < until) {}
+}
+
+/**
+ * @b Inject a storm of resize, reposition and paint events like an interactive resize makes,
+ *    with a key press in it's middle and a key release at it's end, and pump all of it.
+ *
+ * @param win
+ * @param round Makes injected sizes differ between rounds.
+ * */
+static RoundResult run_round (XwWindow *win, Size round) {
+    RoundResult result = {0};
+    XwEvent     e;
+
+    XwWindowSize last_size = {0};
+    for (Size s = 0; s < STORM_SIZE; s++) {
+        if (s == STORM_SIZE / 2) {
+            xw_null_inject_event (xw_event_keyboard_input (
+                &e,
+                XWK_SPACE,
+                XW_BUTTON_STATE_PRESSED,
+                (XwModifierState) {0},
+                win
+            ));
+        }
+
+        last_size = (XwWindowSize) {100 + (round + s) % 500, 100 + s % 300};
+        xw_null_inject_event (xw_event_resize (&e, last_size.width, last_size.height, win));
+        xw_null_inject_event (xw_event_reposition (&e, s % 50, s % 70, win));
+        xw_null_inject_event (xw_event_paint (&e, win));
+    }
+    xw_null_inject_event (xw_event_keyboard_input (
+        &e,
+        XWK_SPACE,
+        XW_BUTTON_STATE_RELEASED,
+        (XwModifierState) {0},
+        win
+    ));
+
+    /* whole storm is waiting already, like it would be in display server connection */
+    Bool    pressed = False, released = False;
+    Float64 start   = get_time_seconds();
+    while (xw_event_poll (&e)) {
+        result.returned++;
+
+        if (e.type == XW_EVENT_TYPE_KEYBOARD_INPUT) {
+            if (e.keyboard_input.state == XW_BUTTON_STATE_PRESSED) {
+                pressed              = True;
+                result.press_latency = get_time_seconds() - start;
+            } else {
+                released = pressed;
+            }
+            continue;
+        }
+
+        if (!pressed) {
+            result.before_press++;
+        }
+
+        if (e.type == XW_EVENT_TYPE_RESIZE) {
+            result.final_size_ok = e.resize.width == last_size.width &&
+                                   e.resize.height == last_size.height;
+        }
+        spin_for (HANDLING_NS * 1e-9);
+    }
+
+    result.keys_in_order = pressed && released;
+    return result;
+}
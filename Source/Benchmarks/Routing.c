@@ -0,0 +1,166 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Null.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define WINDOW_COUNT   4
+#define QUEUE_CAPACITY 1024
+#define ROUNDS         2000
+#define BATCH_SIZE     64
+
+typedef struct Consumer {
+    XwWindow *window;
+    pthread_t thread;
+
+    Size received;       /**< @b Mouse move events popped from window queue. */
+    Size keymap_changes; /**< @b Broadcast events popped from window queue. */
+    Size misrouted;      /**< @b Events of other windows, or out of order events. */
+} Consumer;
+
+/* set by main thread once it has pumped all injected events */
+static Bool pumping_done = False;
+
+static Float64 get_time_seconds (void);
+static void   *consumer_main (void *arg);
+
+int main() {
+    Consumer consumers[WINDOW_COUNT] = {0};
+    Size     started                 = 0;
+
+    for (Size w = 0; w < WINDOW_COUNT; w++) {
+        consumers[w].window = xw_window_create ("Routed", 64, 64, 0, 0);
+        RETURN_VALUE_IF (!consumers[w].window, EXIT_FAILURE, "Failed to create window\n");
+    }
+
+    /* drop events generated while creating windows, so that queues get only injected ones */
+    XwEvent e;
+    while (xw_event_poll (&e)) {}
+
+    for (Size w = 0; w < WINDOW_COUNT; w++) {
+        RETURN_VALUE_IF (
+            !xw_window_enable_event_queue (consumers[w].window, QUEUE_CAPACITY),
+            EXIT_FAILURE,
+            "Failed to enable event queue\n"
+        );
+    }
+
+    for (; started < WINDOW_COUNT; started++) {
+        GOTO_HANDLER_IF (
+            pthread_create (&consumers[started].thread, Null, consumer_main, &consumers[started]),
+            THREAD_CREATE_FAILED,
+            "Failed to create consumer thread\n"
+        );
+    }
+
+    /* main thread plays display server and event pump, consumers only see their own events */
+    Size    returned = 0;
+    Float64 start    = get_time_seconds();
+    for (Size r = 0; r < ROUNDS; r++) {
+        for (Size w = 0; w < WINDOW_COUNT; w++) {
+            for (Size b = 0; b < BATCH_SIZE; b++) {
+                Uint32 seq = r * BATCH_SIZE + b + 1;
+                xw_null_inject_event (xw_event_mouse_move (&e, seq, 0, 1, 0, consumers[w].window));
+            }
+        }
+        xw_null_inject_event (xw_event_keymap_change (&e));
+
+        while (xw_event_poll (&e)) {
+            returned++;
+        }
+    }
+    Float64 elapsed = get_time_seconds() - start;
+
+    __atomic_store_n (&pumping_done, True, __ATOMIC_RELEASE);
+
+    Size received = 0, misrouted = 0, dropped = 0;
+    for (Size w = 0; w < WINDOW_COUNT; w++) {
+        pthread_join (consumers[w].thread, Null);
+
+        received  += consumers[w].received;
+        misrouted += consumers[w].misrouted;
+        dropped   += ROUNDS * BATCH_SIZE - consumers[w].received;
+    }
+
+    printf (
+        "%8s %16s %16s %10s %10s\n",
+        "windows",
+        "events/s",
+        "pump returned",
+        "dropped",
+        "misrouted"
+    );
+    printf (
+        "%8d %16.1f %16zu %10zu %10zu\n",
+        WINDOW_COUNT,
+        received / elapsed,
+        returned,
+        dropped,
+        misrouted
+    );
+
+    for (Size w = 0; w < WINDOW_COUNT; w++) {
+        xw_window_destroy (consumers[w].window);
+    }
+    return misrouted || returned != ROUNDS ? EXIT_FAILURE : EXIT_SUCCESS;
+
+THREAD_CREATE_FAILED: {
+    __atomic_store_n (&pumping_done, True, __ATOMIC_RELEASE);
+    for (Size s = 0; s < started; s++) {
+        pthread_join (consumers[s].thread, Null);
+    }
+    for (Size w = 0; w < WINDOW_COUNT; w++) {
+        xw_window_destroy (consumers[w].window);
+    }
+    return EXIT_FAILURE;
+}
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Pop events from queue of one window till main thread is done pumping and queue is empty.
+ *    Every event must belong to this window (or to no window), and arrive in injected order.
+ *
+ * @param arg Consumer of a window.
+ * */
+static void *consumer_main (void *arg) {
+    Consumer *self     = arg;
+    Uint32    last_seq = 0;
+
+    XwEvent e;
+    while (True) {
+        Bool done = __atomic_load_n (&pumping_done, __ATOMIC_ACQUIRE);
+
+        while (xw_window_event_poll (self->window, &e)) {
+            if (e.type == XW_EVENT_TYPE_KEYMAP_CHANGE) {
+                self->keymap_changes++;
+            } else if (e.type != XW_EVENT_TYPE_MOUSE_MOVE || e.window != self->window ||
+                       e.mouse_move.x <= last_seq) {
+                self->misrouted++;
+            } else {
+                last_seq = e.mouse_move.x;
+                self->received++;
+            }
+        }
+
+        if (done) {
+            break;
+        }
+
+        /* queue is empty, let pump (or other consumers) run */
+        sched_yield();
+    }
+
+    return Null;
+}
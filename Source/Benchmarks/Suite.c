@@ -0,0 +1,727 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Present.h>
+#include <Anvie/CrossWindow/Query.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* posix */
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* xcb, only to inject input and create pixmaps the way another client would */
+#include <xcb/xcb.h>
+#include <xcb/xproto.h>
+#include <xcb/xtest.h>
+
+#define INIT_ITERATIONS        20
+#define CREATE_DESTROY_WINDOWS 500
+#define REQUEST_ITERATIONS     5000
+#define LATENCY_ITERATIONS     1000
+#define THROUGHPUT_EVENTS      10000
+#define EVENT_WAIT_TIMEOUT     2.0 /* seconds without any event before giving up */
+#define MOTION_HINT_SETTLE     0.25 /* seconds to keep polling after a burst in motion hint mode */
+#define BENCH_WINDOW_SIZE      256
+#define PRESENT_FRAMES         120
+#define PRESENT_PIXMAPS        2
+#define BENCH_KEYCODE          38 /* 'a' in Xvfb's default keymap, any key would do */
+#define MAX_XVFB_DISPLAY_NAME  32
+
+typedef enum BenchRequest {
+    BENCH_REQUEST_SET_STATE = 0,
+    BENCH_REQUEST_SET_SIZE,
+    BENCH_REQUEST_SET_TITLE,
+} BenchRequest;
+
+typedef struct LatencyStats {
+    Float64 mean;
+    Float64 p50;
+    Float64 p99;
+    Float64 max;
+} LatencyStats;
+
+typedef struct InputResult {
+    Size         sent;              /**< @b Events injected for throughput measurement. */
+    Size         received;          /**< @b Events polled, less than sent on timeout. */
+    Float64      events_per_second; /**< @b Throughput from injecting first to polling last. */
+    LatencyStats latency_us;        /**< @b Time from injecting one event to polling it. */
+} InputResult;
+
+typedef struct HintResult {
+    Size sent;              /**< @b Motion events injected in a single burst. */
+    Size received;          /**< @b Mouse moves polled for it in motion hint mode. */
+    Bool final_position_ok; /**< @b Last mouse move had position injected last. */
+} HintResult;
+
+typedef struct PresentResult {
+    Bool    available;         /**< @b Display server supports Present extension. */
+    Size    sent;              /**< @b Frames presented with @c xw_window_present_pixmap. */
+    Size    completed;         /**< @b Frame complete events polled. */
+    Size    idle;              /**< @b Frame idle events polled. */
+    Bool    in_order;          /**< @b Frame complete events came in order of serials. */
+    Float64 frame_interval_us; /**< @b Mean time between frames reaching the screen. */
+} PresentResult;
+
+typedef struct Results {
+    CString display;
+
+    Float64 init_mean_ms;
+    Float64 init_min_ms;
+    Float64 init_max_ms;
+
+    Float64 create_destroy_per_second;
+    Float64 set_state_per_second;
+    Float64 set_size_per_second;
+    Float64 set_title_per_second;
+
+    InputResult   key;
+    InputResult   motion;
+    HintResult    motion_hints;
+    PresentResult present;
+} Results;
+
+typedef struct Injector {
+    xcb_connection_t *conn;
+    xcb_window_t      root;
+    Uint8             root_depth;
+} Injector;
+
+static Float64 get_time_seconds (void);
+static pid_t   start_xvfb (char *display, Size display_size);
+static void    stop_xvfb (pid_t pid);
+static Bool    bench_init_time (Results *results);
+static Float64 bench_create_destroy (XwWindow *probe);
+static Float64 bench_requests (XwWindow *probe, BenchRequest request);
+static Bool    bench_key_input (Injector *inj, InputResult *result);
+static Bool    bench_motion_input (Injector *inj, InputResult *result);
+static void    bench_motion_hints (Injector *inj, XwWindow *probe, HintResult *result);
+static Bool    bench_present (Injector *inj, XwWindow *probe, PresentResult *result);
+static Bool    present_frames (XwWindow *probe, xcb_pixmap_t *pixmaps, PresentResult *result);
+static Size    wait_for_events (XwEventType type, Size count, Float64 timeout);
+static void    wait_for_display_server (XwWindow *win);
+static void    compute_latency_stats (Float64 *samples, Size n, LatencyStats *stats);
+static void    write_input_result (FILE *out, CString name, InputResult *result, Bool last);
+static void    write_results (FILE *out, Results *results);
+
+/**
+ * Usage : crosswindow_bench [--no-xvfb] [output.json]
+ *
+ * By default a private Xvfb server is started, so results don't depend on what else is
+ * running on desktop. With --no-xvfb the display in DISPLAY environment variable is used.
+ * Results are written as JSON to given file, or to stdout.
+ * */
+int main (int argc, char **argv) {
+    Bool    use_xvfb    = True;
+    CString output_path = Null;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp (argv[i], "--no-xvfb")) {
+            use_xvfb = False;
+        } else {
+            output_path = argv[i];
+        }
+    }
+
+    Results   results = {0};
+    Injector  inj     = {0};
+    XwWindow *probe   = Null;
+    pid_t     xvfb    = -1;
+
+    char display[MAX_XVFB_DISPLAY_NAME] = {0};
+
+    if (use_xvfb) {
+        xvfb = start_xvfb (display, sizeof (display));
+        RETURN_VALUE_IF (xvfb < 0, EXIT_FAILURE, "Failed to start Xvfb\n");
+        setenv ("DISPLAY", display, 1);
+    }
+    results.display = getenv ("DISPLAY");
+
+    /* library initialized itself with whatever display was there before Xvfb started */
+    xw_deinit();
+    GOTO_HANDLER_IF (!bench_init_time (&results), BENCH_FAILED, "Failed to initialize\n");
+    GOTO_HANDLER_IF (!xw_init(), BENCH_FAILED, "Failed to initialize\n");
+
+    probe = xw_window_create ("Benchmark", BENCH_WINDOW_SIZE, BENCH_WINDOW_SIZE, 0, 0);
+    GOTO_HANDLER_IF (!probe, BENCH_FAILED, "Failed to create window\n");
+    GOTO_HANDLER_IF (
+        !wait_for_events (XW_EVENT_TYPE_VISIBILITY, 1, EVENT_WAIT_TIMEOUT),
+        BENCH_FAILED,
+        "Window never got mapped\n"
+    );
+
+    fprintf (stderr, "measuring window create/destroy...\n");
+    results.create_destroy_per_second = bench_create_destroy (probe);
+
+    fprintf (stderr, "measuring request rates...\n");
+    results.set_state_per_second = bench_requests (probe, BENCH_REQUEST_SET_STATE);
+    results.set_size_per_second  = bench_requests (probe, BENCH_REQUEST_SET_SIZE);
+    results.set_title_per_second = bench_requests (probe, BENCH_REQUEST_SET_TITLE);
+
+    /* injected input is sent through a separate connection, exactly like a real device */
+    inj.conn = xcb_connect (Null, Null);
+    GOTO_HANDLER_IF (
+        xcb_connection_has_error (inj.conn),
+        BENCH_FAILED,
+        "Failed to connect to display\n"
+    );
+    const xcb_query_extension_reply_t *xtest = xcb_get_extension_data (inj.conn, &xcb_test_id);
+    GOTO_HANDLER_IF (!xtest || !xtest->present, BENCH_FAILED, "XTest is not available\n");
+    xcb_screen_t *screen = xcb_setup_roots_iterator (xcb_get_setup (inj.conn)).data;
+    inj.root             = screen->root;
+    inj.root_depth       = screen->root_depth;
+
+    fprintf (stderr, "measuring motion events...\n");
+    GOTO_HANDLER_IF (
+        !bench_motion_input (&inj, &results.motion),
+        BENCH_FAILED,
+        "Failed to measure motion events\n"
+    );
+
+    fprintf (stderr, "measuring motion events with motion hints...\n");
+    bench_motion_hints (&inj, probe, &results.motion_hints);
+
+    fprintf (stderr, "measuring key events...\n");
+    GOTO_HANDLER_IF (
+        !bench_key_input (&inj, &results.key),
+        BENCH_FAILED,
+        "Failed to measure key events\n"
+    );
+
+    fprintf (stderr, "measuring presented frames...\n");
+    GOTO_HANDLER_IF (
+        !bench_present (&inj, probe, &results.present),
+        BENCH_FAILED,
+        "Failed to measure presented frames\n"
+    );
+
+    FILE *out = output_path ? fopen (output_path, "w") : stdout;
+    GOTO_HANDLER_IF (!out, BENCH_FAILED, "Failed to open %s\n", output_path);
+    write_results (out, &results);
+    if (out != stdout) {
+        fclose (out);
+    }
+
+    xcb_disconnect (inj.conn);
+    xw_window_destroy (probe);
+    xw_deinit();
+    stop_xvfb (xvfb);
+
+    return EXIT_SUCCESS;
+
+BENCH_FAILED: {
+    if (inj.conn) {
+        xcb_disconnect (inj.conn);
+    }
+    if (probe) {
+        xw_window_destroy (probe);
+    }
+    xw_deinit();
+    stop_xvfb (xvfb);
+    return EXIT_FAILURE;
+}
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Start Xvfb on first free display number.
+ *
+ * Xvfb picks the display itself and reports it through -displayfd once it's ready to
+ * accept connections, so there's no race with other servers and no polling.
+ *
+ * @param display Where display name (eg: ":1") will be stored.
+ * @param display_size
+ *
+ * @return Process id of Xvfb on success.
+ * @return -1 otherwise.
+ * */
+static pid_t start_xvfb (char *display, Size display_size) {
+    int fds[2];
+    RETURN_VALUE_IF (pipe (fds), -1, "Failed to create pipe\n");
+
+    pid_t pid = fork();
+    if (!pid) {
+        close (fds[0]);
+
+        char fd_str[16];
+        snprintf (fd_str, sizeof (fd_str), "%d", fds[1]);
+
+        /* keep Xvfb's complaints about missing fonts etc... out of results */
+        int devnull = open ("/dev/null", O_WRONLY);
+        dup2 (devnull, STDOUT_FILENO);
+        dup2 (devnull, STDERR_FILENO);
+
+        execlp (
+            "Xvfb",
+            "Xvfb",
+            "-displayfd",
+            fd_str,
+            "-screen",
+            "0",
+            "1280x1024x24",
+            "-nolisten",
+            "tcp",
+            (char *)Null
+        );
+        _exit (127);
+    }
+    close (fds[1]);
+
+    if (pid < 0) {
+        close (fds[0]);
+        return -1;
+    }
+
+    /* Xvfb writes display number followed by a newline, EOF means it died */
+    char    number[MAX_XVFB_DISPLAY_NAME] = {0};
+    ssize_t len                           = 0;
+    while (len < (ssize_t)sizeof (number) - 1) {
+        ssize_t r = read (fds[0], number + len, 1);
+        if (r <= 0 || number[len] == '\n') {
+            break;
+        }
+        len++;
+    }
+    number[len] = 0;
+    close (fds[0]);
+
+    if (!len) {
+        stop_xvfb (pid);
+        return -1;
+    }
+
+    snprintf (display, display_size, ":%s", number);
+    return pid;
+}
+
+static void stop_xvfb (pid_t pid) {
+    if (pid > 0) {
+        kill (pid, SIGTERM);
+        waitpid (pid, Null, 0);
+    }
+}
+
+/**
+ * @b Time taken by @c xw_init, which opens display connection and interns atoms.
+ * */
+static Bool bench_init_time (Results *results) {
+    results->init_min_ms = 1e9;
+
+    for (Size s = 0; s < INIT_ITERATIONS; s++) {
+        Float64 start = get_time_seconds();
+        RETURN_VALUE_IF (!xw_init(), False, "xw_init failed\n");
+        Float64 elapsed = (get_time_seconds() - start) * 1e3;
+        xw_deinit();
+
+        results->init_min_ms = MIN (results->init_min_ms, elapsed);
+        results->init_max_ms = MAX (results->init_max_ms, elapsed);
+        results->init_mean_ms += elapsed / INIT_ITERATIONS;
+    }
+
+    return True;
+}
+
+/**
+ * @b Windows created and destroyed per second, till display server has processed all of it.
+ * */
+static Float64 bench_create_destroy (XwWindow *probe) {
+    Float64 start = get_time_seconds();
+    for (Size s = 0; s < CREATE_DESTROY_WINDOWS; s++) {
+        XwWindow *win = xw_window_create ("Benchmark", 64, 64, 0, 0);
+        RETURN_VALUE_IF (!win, 0, "Failed to create window\n");
+        xw_window_destroy (win);
+    }
+    wait_for_display_server (probe);
+    Float64 elapsed = get_time_seconds() - start;
+
+    /* throw away events of created windows */
+    XwEvent e;
+    while (xw_event_poll (&e)) {}
+
+    return CREATE_DESTROY_WINDOWS / elapsed;
+}
+
+/**
+ * @b Calls per second of a window setter, till display server has processed all of them.
+ * */
+static Float64 bench_requests (XwWindow *probe, BenchRequest request) {
+    CString titles[] = {"Benchmark A", "Benchmark B"};
+
+    Float64 start = get_time_seconds();
+    for (Size s = 0; s < REQUEST_ITERATIONS; s++) {
+        switch (request) {
+            case BENCH_REQUEST_SET_STATE :
+                xw_window_set_state (
+                    probe,
+                    (s & 1) ? XW_WINDOW_STATE_MASK_ABOVE : XW_WINDOW_STATE_MASK_CLEAR
+                );
+                break;
+            case BENCH_REQUEST_SET_SIZE :
+                xw_window_set_size (
+                    probe,
+                    (XwWindowSize) {BENCH_WINDOW_SIZE - (s & 1), BENCH_WINDOW_SIZE}
+                );
+                break;
+            case BENCH_REQUEST_SET_TITLE :
+                xw_window_set_title (probe, titles[s & 1]);
+                break;
+        }
+    }
+    wait_for_display_server (probe);
+    Float64 elapsed = get_time_seconds() - start;
+
+    XwEvent e;
+    while (xw_event_poll (&e)) {}
+
+    return REQUEST_ITERATIONS / elapsed;
+}
+
+/**
+ * @b Latency of single motion events, then throughput of a burst of them.
+ *
+ * Pointer is moved inside window, so every injected motion is delivered to it.
+ * */
+static Bool bench_motion_input (Injector *inj, InputResult *result) {
+    Float64 *samples = ALLOCATE (Float64, LATENCY_ITERATIONS);
+    RETURN_VALUE_IF (!samples, False, ERR_OUT_OF_MEMORY);
+
+    /* alternate between two points, motion to same point generates nothing */
+    for (Size s = 0; s < LATENCY_ITERATIONS; s++) {
+        Float64 start = get_time_seconds();
+        xcb_test_fake_input (inj->conn, XCB_MOTION_NOTIFY, 0, 0, inj->root, 16 + (s & 1), 16, 0);
+        xcb_flush (inj->conn);
+
+        GOTO_HANDLER_IF (
+            !wait_for_events (XW_EVENT_TYPE_MOUSE_MOVE, 1, EVENT_WAIT_TIMEOUT),
+            TIMED_OUT,
+            "Motion event never arrived\n"
+        );
+        samples[s] = (get_time_seconds() - start) * 1e6;
+    }
+    compute_latency_stats (samples, LATENCY_ITERATIONS, &result->latency_us);
+    FREE (samples);
+
+    Float64 start = get_time_seconds();
+    for (Size s = 0; s < THROUGHPUT_EVENTS; s++) {
+        xcb_test_fake_input (inj->conn, XCB_MOTION_NOTIFY, 0, 0, inj->root, 16 + (s & 1), 32, 0);
+    }
+    xcb_flush (inj->conn);
+
+    Size received =
+        wait_for_events (XW_EVENT_TYPE_MOUSE_MOVE, THROUGHPUT_EVENTS, EVENT_WAIT_TIMEOUT);
+
+    result->sent              = THROUGHPUT_EVENTS;
+    result->received          = received;
+    result->events_per_second = received / (get_time_seconds() - start);
+
+    return True;
+
+TIMED_OUT: {
+    FREE (samples);
+    return False;
+}
+}
+
+/**
+ * @b Mouse moves delivered for a burst of motion in motion hint mode, where display server
+ *    sends a hint instead of every motion, and CrossWindow queries pointer once a frame.
+ *    Last mouse move must still have position of last injected motion.
+ * */
+static void bench_motion_hints (Injector *inj, XwWindow *probe, HintResult *result) {
+    xw_event_set_motion_hints (True);
+    wait_for_display_server (probe);
+
+    for (Size s = 0; s < THROUGHPUT_EVENTS; s++) {
+        xcb_test_fake_input (inj->conn, XCB_MOTION_NOTIFY, 0, 0, inj->root, 16 + (s & 1), 48, 0);
+    }
+    xcb_test_fake_input (inj->conn, XCB_MOTION_NOTIFY, 0, 0, inj->root, 40, 40, 0);
+    xcb_flush (inj->conn);
+
+    XwEvent e;
+    Float64 start = get_time_seconds();
+    while (get_time_seconds() - start < MOTION_HINT_SETTLE) {
+        if (xw_event_poll (&e) && e.type == XW_EVENT_TYPE_MOUSE_MOVE) {
+            result->received++;
+            result->final_position_ok = e.mouse_move.x == 40 && e.mouse_move.y == 40;
+        }
+    }
+
+    result->sent = THROUGHPUT_EVENTS + 1;
+    xw_event_set_motion_hints (False);
+}
+
+/**
+ * @b Latency of single key presses and releases, then throughput of a burst of them.
+ *
+ * Without a window manager, keyboard focus follows pointer, which is already inside
+ * window after motion benchmark.
+ * */
+static Bool bench_key_input (Injector *inj, InputResult *result) {
+    Float64 *samples = ALLOCATE (Float64, LATENCY_ITERATIONS);
+    RETURN_VALUE_IF (!samples, False, ERR_OUT_OF_MEMORY);
+
+    /* every sample is either a press or a release, so that no key is left pressed */
+    for (Size s = 0; s < LATENCY_ITERATIONS; s++) {
+        Uint8 type = (s & 1) ? XCB_KEY_RELEASE : XCB_KEY_PRESS;
+
+        Float64 start = get_time_seconds();
+        xcb_test_fake_input (inj->conn, type, BENCH_KEYCODE, 0, inj->root, 0, 0, 0);
+        xcb_flush (inj->conn);
+
+        GOTO_HANDLER_IF (
+            !wait_for_events (XW_EVENT_TYPE_KEYBOARD_INPUT, 1, EVENT_WAIT_TIMEOUT),
+            TIMED_OUT,
+            "Key event never arrived\n"
+        );
+        samples[s] = (get_time_seconds() - start) * 1e6;
+    }
+    compute_latency_stats (samples, LATENCY_ITERATIONS, &result->latency_us);
+    FREE (samples);
+
+    Float64 start = get_time_seconds();
+    for (Size s = 0; s < THROUGHPUT_EVENTS; s++) {
+        Uint8 type = (s & 1) ? XCB_KEY_RELEASE : XCB_KEY_PRESS;
+        xcb_test_fake_input (inj->conn, type, BENCH_KEYCODE, 0, inj->root, 0, 0, 0);
+    }
+    xcb_flush (inj->conn);
+
+    Size received =
+        wait_for_events (XW_EVENT_TYPE_KEYBOARD_INPUT, THROUGHPUT_EVENTS, EVENT_WAIT_TIMEOUT);
+
+    result->sent              = THROUGHPUT_EVENTS;
+    result->received          = received;
+    result->events_per_second = received / (get_time_seconds() - start);
+
+    return True;
+
+TIMED_OUT: {
+    FREE (samples);
+    return False;
+}
+}
+
+/**
+ * @b Presented frames, from pixmaps created through injector's connection just like a
+ *    renderer in another client would. Without Present extension, presenting must fail
+ *    without sending anything.
+ *
+ * @return True if every frame completed and every pixmap became idle again, or if Present is
+ *         unavailable and presenting failed cleanly.
+ * @return False otherwise.
+ * */
+static Bool bench_present (Injector *inj, XwWindow *probe, PresentResult *result) {
+    xcb_pixmap_t pixmaps[PRESENT_PIXMAPS] = {0};
+    Size         created                  = 0;
+    Bool         ok                       = False;
+
+    /* creation must be processed before other connection refers to pixmaps */
+    for (; created < PRESENT_PIXMAPS; created++) {
+        pixmaps[created]         = xcb_generate_id (inj->conn);
+        xcb_void_cookie_t cookie = xcb_create_pixmap_checked (
+            inj->conn,
+            inj->root_depth,
+            pixmaps[created],
+            inj->root,
+            BENCH_WINDOW_SIZE,
+            BENCH_WINDOW_SIZE
+        );
+
+        xcb_generic_error_t *error = xcb_request_check (inj->conn, cookie);
+        if (error) {
+            FREE (error);
+            break;
+        }
+    }
+    GOTO_HANDLER_IF (created < PRESENT_PIXMAPS, FREE_PIXMAPS, "Failed to create pixmap\n");
+
+    result->available = xw_window_enable_frame_events (probe);
+    if (result->available) {
+        ok = present_frames (probe, pixmaps, result);
+    } else {
+        ok = !xw_window_present_pixmap (probe, pixmaps[0], 0, XW_PRESENT_FLAG_NONE);
+    }
+
+FREE_PIXMAPS: {
+    for (Size p = 0; p < created; p++) {
+        xcb_free_pixmap (inj->conn, pixmaps[p]);
+    }
+    xcb_flush (inj->conn);
+    return ok;
+}
+}
+
+/**
+ * @b Present frames from given pixmaps in turn, drawing into a pixmap again only after it's
+ *    frame idle event, till a frame complete event arrived for every frame.
+ * */
+static Bool present_frames (XwWindow *probe, xcb_pixmap_t *pixmaps, PresentResult *result) {
+    Bool    busy[PRESENT_PIXMAPS] = {0};
+    Uint32  last_serial           = 0;
+    Uint64  first_ust             = 0;
+    Uint64  last_ust              = 0;
+    Float64 last_progress         = get_time_seconds();
+
+    result->in_order = True;
+    while (result->completed < PRESENT_FRAMES || result->idle < result->sent) {
+        Size next = result->sent % PRESENT_PIXMAPS;
+        if (result->sent < PRESENT_FRAMES && !busy[next]) {
+            /* a flipped pixmap stays busy till next present, so last frame is copied */
+            XwPresentFlags flags =
+                result->sent == PRESENT_FRAMES - 1 ? XW_PRESENT_FLAG_COPY : XW_PRESENT_FLAG_NONE;
+            RETURN_VALUE_IF (
+                !xw_window_present_pixmap (probe, pixmaps[next], 0, flags),
+                False,
+                "Failed to present pixmap\n"
+            );
+            busy[next] = True;
+            result->sent++;
+        }
+
+        XwEvent e;
+        if (!xw_event_poll (&e)) {
+            RETURN_VALUE_IF (
+                get_time_seconds() - last_progress > EVENT_WAIT_TIMEOUT,
+                False,
+                "Frame events never arrived\n"
+            );
+            continue;
+        }
+        last_progress = get_time_seconds();
+
+        if (e.type == XW_EVENT_TYPE_FRAME_COMPLETE && e.window == probe) {
+            result->in_order = result->in_order && e.frame_complete.serial > last_serial;
+            last_serial      = e.frame_complete.serial;
+            first_ust        = result->completed ? first_ust : e.frame_complete.ust;
+            last_ust         = e.frame_complete.ust;
+            result->completed++;
+        } else if (e.type == XW_EVENT_TYPE_FRAME_IDLE && e.window == probe) {
+            for (Size p = 0; p < PRESENT_PIXMAPS; p++) {
+                if (pixmaps[p] == e.frame_idle.pixmap) {
+                    busy[p] = False;
+                }
+            }
+            result->idle++;
+        }
+    }
+
+    result->frame_interval_us =
+        result->completed > 1 ? (Float64)(last_ust - first_ust) / (result->completed - 1) : 0;
+
+    return result->in_order;
+}
+
+/**
+ * @b Poll events till given number of events of given type arrive, or till no event
+ * arrives for given time. Events of other types are thrown away.
+ *
+ * @return Number of events of given type received.
+ * */
+static Size wait_for_events (XwEventType type, Size count, Float64 timeout) {
+    Size    received      = 0;
+    Float64 last_progress = get_time_seconds();
+
+    while (received < count) {
+        XwEvent e;
+        if (xw_event_poll (&e)) {
+            if (e.type == type) {
+                received++;
+            }
+            last_progress = get_time_seconds();
+        } else if (get_time_seconds() - last_progress > timeout) {
+            break;
+        }
+    }
+
+    return received;
+}
+
+/**
+ * @b Block until display server has processed all requests sent till now.
+ * */
+static void wait_for_display_server (XwWindow *win) {
+    XwQuery       query = xw_window_query_geometry (win);
+    XwQueryResult result;
+    xw_query_wait (&query, &result);
+}
+
+static int compare_float64 (const void *a, const void *b) {
+    Float64 x = *(const Float64 *)a;
+    Float64 y = *(const Float64 *)b;
+    return (x > y) - (x < y);
+}
+
+static void compute_latency_stats (Float64 *samples, Size n, LatencyStats *stats) {
+    qsort (samples, n, sizeof (Float64), compare_float64);
+
+    stats->mean = 0;
+    for (Size s = 0; s < n; s++) {
+        stats->mean += samples[s] / n;
+    }
+    stats->p50 = samples[n / 2];
+    stats->p99 = samples[(n * 99) / 100];
+    stats->max = samples[n - 1];
+}
+
+static void write_input_result (FILE *out, CString name, InputResult *result, Bool last) {
+    fprintf (out, "  \"%s\": {\n", name);
+    fprintf (out, "    \"sent\": %zu,\n", result->sent);
+    fprintf (out, "    \"received\": %zu,\n", result->received);
+    fprintf (out, "    \"events_per_second\": %.1f,\n", result->events_per_second);
+    fprintf (out, "    \"latency_us\": {\n");
+    fprintf (out, "      \"mean\": %.2f,\n", result->latency_us.mean);
+    fprintf (out, "      \"p50\": %.2f,\n", result->latency_us.p50);
+    fprintf (out, "      \"p99\": %.2f,\n", result->latency_us.p99);
+    fprintf (out, "      \"max\": %.2f\n", result->latency_us.max);
+    fprintf (out, "    }\n");
+    fprintf (out, "  }%s\n", last ? "" : ",");
+}
+
+static void write_results (FILE *out, Results *results) {
+    fprintf (out, "{\n");
+    fprintf (out, "  \"display\": \"%s\",\n", results->display ? results->display : "");
+    fprintf (out, "  \"xw_init_ms\": {\n");
+    fprintf (out, "    \"iterations\": %d,\n", INIT_ITERATIONS);
+    fprintf (out, "    \"mean\": %.3f,\n", results->init_mean_ms);
+    fprintf (out, "    \"min\": %.3f,\n", results->init_min_ms);
+    fprintf (out, "    \"max\": %.3f\n", results->init_max_ms);
+    fprintf (out, "  },\n");
+    fprintf (
+        out,
+        "  \"window_create_destroy_per_second\": %.1f,\n",
+        results->create_destroy_per_second
+    );
+    fprintf (out, "  \"set_state_per_second\": %.1f,\n", results->set_state_per_second);
+    fprintf (out, "  \"set_size_per_second\": %.1f,\n", results->set_size_per_second);
+    fprintf (out, "  \"set_title_per_second\": %.1f,\n", results->set_title_per_second);
+    write_input_result (out, "motion_events", &results->motion, False);
+    fprintf (out, "  \"motion_hint_events\": {\n");
+    fprintf (out, "    \"sent\": %zu,\n", results->motion_hints.sent);
+    fprintf (out, "    \"received\": %zu,\n", results->motion_hints.received);
+    fprintf (
+        out,
+        "    \"final_position_ok\": %s\n",
+        results->motion_hints.final_position_ok ? "true" : "false"
+    );
+    fprintf (out, "  },\n");
+    write_input_result (out, "key_events", &results->key, False);
+    fprintf (out, "  \"present\": {\n");
+    fprintf (out, "    \"available\": %s,\n", results->present.available ? "true" : "false");
+    fprintf (out, "    \"sent\": %zu,\n", results->present.sent);
+    fprintf (out, "    \"completed\": %zu,\n", results->present.completed);
+    fprintf (out, "    \"idle\": %zu,\n", results->present.idle);
+    fprintf (out, "    \"in_order\": %s,\n", results->present.in_order ? "true" : "false");
+    fprintf (out, "    \"frame_interval_us\": %.1f\n", results->present.frame_interval_us);
+    fprintf (out, "  }\n");
+    fprintf (out, "}\n");
+}
@@ -0,0 +1,125 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <pthread.h>
+#include <time.h>
+
+#define WORKER_COUNT      4
+#define ITERATIONS        2000
+#define TITLES_PER_WINDOW 4
+
+/* every worker also changes this one, so titles and geometry of a single window are raced */
+static XwWindow *shared_window = Null;
+
+/* incremented by each worker when it's done */
+static Size workers_finished = 0;
+
+static Float64 get_time_seconds (void);
+static void   *worker_main (void *arg);
+
+int main() {
+    shared_window = xw_window_create ("Shared", 64, 64, 0, 0);
+    RETURN_VALUE_IF (!shared_window, EXIT_FAILURE, "Failed to create shared window\n");
+
+    pthread_t workers[WORKER_COUNT];
+    Size      failures[WORKER_COUNT] = {0};
+    Size      started                = 0;
+
+    Float64 start = get_time_seconds();
+    for (; started < WORKER_COUNT; started++) {
+        GOTO_HANDLER_IF (
+            pthread_create (&workers[started], Null, worker_main, &failures[started]),
+            THREAD_CREATE_FAILED,
+            "Failed to create worker thread\n"
+        );
+    }
+
+    /* main thread keeps polling while workers create, change and destroy windows */
+    Size    events_polled = 0;
+    XwEvent e;
+    while (__atomic_load_n (&workers_finished, __ATOMIC_ACQUIRE) < WORKER_COUNT) {
+        while (xw_event_poll (&e)) {
+            events_polled++;
+        }
+    }
+    Float64 elapsed = get_time_seconds() - start;
+
+    for (Size s = 0; s < WORKER_COUNT; s++) {
+        pthread_join (workers[s], Null);
+    }
+
+    Size total_failures = 0;
+    for (Size s = 0; s < WORKER_COUNT; s++) {
+        total_failures += failures[s];
+    }
+
+    printf ("%8s %16s %16s %10s\n", "threads", "windows/s", "events polled", "failures");
+    printf (
+        "%8d %16.1f %16zu %10zu\n",
+        WORKER_COUNT,
+        (WORKER_COUNT * ITERATIONS) / elapsed,
+        events_polled,
+        total_failures
+    );
+
+    xw_window_destroy (shared_window);
+    return total_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+
+THREAD_CREATE_FAILED: {
+    for (Size s = 0; s < started; s++) {
+        pthread_join (workers[s], Null);
+    }
+    xw_window_destroy (shared_window);
+    return EXIT_FAILURE;
+}
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Create a window, change it's title and size a few times, read them back and destroy it.
+ *    Shared window gets same treatment on every iteration.
+ *
+ * @param arg Where number of failed calls is stored.
+ * */
+static void *worker_main (void *arg) {
+    Size *failures = arg;
+
+    for (Size i = 0; i < ITERATIONS; i++) {
+        XwWindow *win = xw_window_create ("Worker", 32 + i % 32, 32, i % 64, 0);
+        if (!win) {
+            (*failures)++;
+            continue;
+        }
+
+        for (Size t = 0; t < TITLES_PER_WINDOW; t++) {
+            *failures += !xw_window_set_title (win, t % 2 ? "Odd" : "Even");
+            *failures += !xw_window_set_title (shared_window, t % 2 ? "Odd" : "Even");
+        }
+
+        XwWindowSize size = {48, 48 + i % 16};
+        xw_window_set_size (shared_window, size);
+        xw_window_set_size (win, size);
+        *failures += !xw_window_get_size (shared_window).width;
+
+        CString title = xw_window_get_title (shared_window);
+        if (title) {
+            FREE (title);
+        } else {
+            (*failures)++;
+        }
+
+        xw_window_destroy (win);
+    }
+
+    __atomic_add_fetch (&workers_finished, 1, __ATOMIC_RELEASE);
+    return Null;
+}
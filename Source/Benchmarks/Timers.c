@@ -0,0 +1,93 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Timer.h>
+
+/* libc */
+#include <time.h>
+
+#define MAX_TIMER_COUNT 100000
+#define REPEAT_COUNT    4
+#define REPEAT_NS       2000000ull
+#define ONE_SHOT_NS     50000000ull
+
+static XwTimer *timers[MAX_TIMER_COUNT];
+
+static Float64 get_time_seconds (void);
+
+int main() {
+    printf ("%10s %12s %12s\n", "timers", "arm ns", "cancel ns");
+
+    /* arming and cancelling must not get slower as more timers are running */
+    for (Size count = 1000; count <= MAX_TIMER_COUNT; count *= 10) {
+        Float64 start = get_time_seconds();
+        for (Size t = 0; t < count; t++) {
+            /* spread from a millisecond to several revolutions of wheel away */
+            timers[t] = xw_timer_create ((t % 4096 + 1) * 1000000ull, t % 2, Null);
+            RETURN_VALUE_IF (!timers[t], EXIT_FAILURE, "Failed to create timer\n");
+        }
+        Float64 arm_ns = (get_time_seconds() - start) * 1e9 / count;
+
+        /* cancel from middle of slots, in an order different from creation */
+        start = get_time_seconds();
+        for (Size t = 0; t < count; t++) {
+            xw_timer_destroy (timers[(t * 7919) % count]);
+        }
+        Float64 cancel_ns = (get_time_seconds() - start) * 1e9 / count;
+
+        printf ("%10zu %12.1f %12.1f\n", count, arm_ns, cancel_ns);
+    }
+
+    /* a few repeating timers and one one-shot timer, waited on with no other events around */
+    XwTimer *repeating[REPEAT_COUNT];
+    Uint64   expirations[REPEAT_COUNT] = {0};
+    for (Size r = 0; r < REPEAT_COUNT; r++) {
+        repeating[r] = xw_timer_create (REPEAT_NS, True, &expirations[r]);
+        RETURN_VALUE_IF (!repeating[r], EXIT_FAILURE, "Failed to create timer\n");
+    }
+
+    Float64  start    = get_time_seconds();
+    XwTimer *one_shot = xw_timer_create (ONE_SHOT_NS, False, Null);
+    RETURN_VALUE_IF (!one_shot, EXIT_FAILURE, "Failed to create timer\n");
+
+    Float64 fired_at = 0;
+    Size    wakeups  = 0;
+    XwEvent e;
+    while (!fired_at && xw_event_wait (&e)) {
+        wakeups++;
+        if (e.type != XW_EVENT_TYPE_TIMER) {
+            continue;
+        }
+
+        if (e.timer.timer == one_shot) {
+            fired_at = get_time_seconds() - start;
+        } else {
+            *(Uint64 *)e.timer.user += e.timer.expirations;
+        }
+    }
+
+    for (Size r = 0; r < REPEAT_COUNT; r++) {
+        xw_timer_destroy (repeating[r]);
+    }
+    xw_timer_destroy (one_shot);
+
+    /* repeating timers must neither miss nor invent expirations while waiting */
+    Size   wrong    = 0;
+    Uint64 expected = ONE_SHOT_NS / REPEAT_NS;
+    for (Size r = 0; r < REPEAT_COUNT; r++) {
+        wrong += expirations[r] + 2 < expected || expirations[r] > expected + 1;
+    }
+
+    Float64 late_us = (fired_at - ONE_SHOT_NS * 1e-9) * 1e6;
+    printf ("\n%12s %12s %12s %16s\n", "wakeups", "late us", "expected", "wrong counts");
+    printf ("%12zu %12.1f %12llu %16zu\n", wakeups, late_us, (unsigned long long)expected, wrong);
+
+    return !fired_at || late_us < 0 || wrong ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
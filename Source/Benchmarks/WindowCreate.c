@@ -0,0 +1,129 @@
+#include <Anvie/Common.h>
+
+/* crosswindow */
+#include <Anvie/CrossWindow/Query.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* libc */
+#include <time.h>
+
+/* total number of windows created for each measurement, to keep timings comparable */
+#define WINDOWS_PER_MEASUREMENT 2000
+
+static Float64 get_time_seconds (void);
+static void    wait_for_display_server (XwWindow *win);
+static Float64 bench_create_loop (XwWindowCreateInfo *infos, XwWindow **windows, Size n);
+static Float64 bench_create_many (XwWindowCreateInfo *infos, XwWindow **windows, Size n);
+
+int main() {
+    Size window_counts[] = {1, 100, 1000};
+    Size max_count       = window_counts[ARRAY_SIZE (window_counts) - 1];
+
+    XwWindowCreateInfo *infos   = ALLOCATE (XwWindowCreateInfo, max_count);
+    XwWindow          **windows = ALLOCATE (XwWindow *, max_count);
+    GOTO_HANDLER_IF (!infos || !windows, ALLOC_FAILED, ERR_OUT_OF_MEMORY);
+
+    for (Size s = 0; s < max_count; s++) {
+        infos[s] = (XwWindowCreateInfo) {
+            .title  = "Benchmark",
+            .width  = 64,
+            .height = 64,
+            .xpos   = (s % 32) * 16,
+            .ypos   = (s / 32) * 16,
+        };
+    }
+
+    printf ("%8s %24s %24s\n", "windows", "xw_window_create (w/s)", "create_many (w/s)");
+    for (Size c = 0; c < ARRAY_SIZE (window_counts); c++) {
+        Size n = window_counts[c];
+
+        Float64 loop_rate = bench_create_loop (infos, windows, n);
+        Float64 many_rate = bench_create_many (infos, windows, n);
+
+        printf ("%8zu %24.1f %24.1f\n", n, loop_rate, many_rate);
+    }
+
+    FREE (infos);
+    FREE (windows);
+    return EXIT_SUCCESS;
+
+ALLOC_FAILED: {
+    if (infos) {
+        FREE (infos);
+    }
+    if (windows) {
+        FREE (windows);
+    }
+    return EXIT_FAILURE;
+}
+}
+
+static Float64 get_time_seconds (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @b Block until display server has processed all requests sent till now.
+ *
+ * Requests are processed in order, so reply of a request made after everything
+ * else means all windows really exist on server side.
+ * */
+static void wait_for_display_server (XwWindow *win) {
+    XwQuery       query = xw_window_query_geometry (win);
+    XwQueryResult result;
+    xw_query_wait (&query, &result);
+}
+
+/**
+ * @b Windows created per second when using @c xw_window_create for each window.
+ * */
+static Float64 bench_create_loop (XwWindowCreateInfo *infos, XwWindow **windows, Size n) {
+    Size    repeat  = MAX (WINDOWS_PER_MEASUREMENT / n, 1);
+    Float64 elapsed = 0;
+
+    for (Size r = 0; r < repeat; r++) {
+        Float64 start = get_time_seconds();
+        for (Size s = 0; s < n; s++) {
+            windows[s] = xw_window_create (
+                infos[s].title,
+                infos[s].width,
+                infos[s].height,
+                infos[s].xpos,
+                infos[s].ypos
+            );
+            RETURN_VALUE_IF (!windows[s], 0, "Failed to create window\n");
+        }
+        wait_for_display_server (windows[n - 1]);
+        elapsed += get_time_seconds() - start;
+
+        for (Size s = 0; s < n; s++) {
+            xw_window_destroy (windows[s]);
+        }
+    }
+
+    return (repeat * n) / elapsed;
+}
+
+/**
+ * @b Windows created per second when using @c xw_window_create_many.
+ * */
+static Float64 bench_create_many (XwWindowCreateInfo *infos, XwWindow **windows, Size n) {
+    Size    repeat  = MAX (WINDOWS_PER_MEASUREMENT / n, 1);
+    Float64 elapsed = 0;
+
+    for (Size r = 0; r < repeat; r++) {
+        Float64 start = get_time_seconds();
+        XwWindow **created = xw_window_create_many (infos, n, windows);
+        RETURN_VALUE_IF (!created, 0, "Failed to create windows\n");
+        wait_for_display_server (windows[n - 1]);
+        elapsed += get_time_seconds() - start;
+
+        for (Size s = 0; s < n; s++) {
+            xw_window_destroy (windows[s]);
+        }
+    }
+
+    return (repeat * n) / elapsed;
+}
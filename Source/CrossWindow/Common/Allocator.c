@@ -0,0 +1,252 @@
+/**
+ * @file Allocator.c
+ * @time 18/10/2026 12:25:56
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Allocator.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+
+/* libc headers */
+#include <string.h>
+
+static void *xw_default_alloc (void *user_data, Size size, XwAllocCategory category);
+static void *xw_default_realloc (void *user_data, void *ptr, Size size, XwAllocCategory category);
+static void  xw_default_free (void *user_data, void *ptr, XwAllocCategory category);
+
+static XwAllocator xw_allocator = {
+    .alloc     = xw_default_alloc,
+    .realloc   = xw_default_realloc,
+    .free      = xw_default_free,
+    .user_data = Null,
+};
+
+/* counters are updated atomically, so they can be read at any time */
+static XwAllocStats xw_alloc_stats[XW_ALLOC_CATEGORY_MAX] = {0};
+
+#define COUNT(category, field, n)                                                                  \
+    __atomic_fetch_add (&xw_alloc_stats[category].field, n, __ATOMIC_RELAXED)
+
+/**
+ * @b Make all CrossWindow allocations go through given allocator.
+ *
+ * Allocator can be changed only while CrossWindow does not own any memory, that is
+ * before creating first window (or after destroying all of them and releasing everything
+ * else), otherwise memory allocated by one allocator would be released by another.
+ *
+ * @param allocator Allocation callbacks. Contents are copied. Pass @c Null to switch back
+ *        to the default allocator, which uses @c malloc, @c realloc and @c free.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_set_allocator (const XwAllocator *allocator) {
+    RETURN_VALUE_IF (
+        allocator && (!allocator->alloc || !allocator->realloc || !allocator->free),
+        False,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    for (XwAllocCategory c = 0; c < XW_ALLOC_CATEGORY_MAX; c++) {
+        RETURN_VALUE_IF (
+            __atomic_load_n (&xw_alloc_stats[c].live_count, __ATOMIC_RELAXED),
+            False,
+            "Cannot change allocator while CrossWindow memory is still allocated\n"
+        );
+    }
+
+    if (allocator) {
+        xw_allocator = *allocator;
+    } else {
+        xw_allocator = (XwAllocator) {
+            .alloc     = xw_default_alloc,
+            .realloc   = xw_default_realloc,
+            .free      = xw_default_free,
+            .user_data = Null,
+        };
+    }
+
+    return True;
+}
+
+/**
+ * @b Get allocation counters of given category.
+ *
+ * Comparing stats taken at two points in time tells how many allocations were made in between.
+ *
+ * @param category
+ * @param stats Where stats will be stored.
+ *
+ * @return @c stats on success.
+ * @return Null otherwise.
+ * */
+XwAllocStats *xw_get_alloc_stats (XwAllocCategory category, XwAllocStats *stats) {
+    RETURN_VALUE_IF (category >= XW_ALLOC_CATEGORY_MAX || !stats, Null, ERR_INVALID_ARGUMENTS);
+
+    XwAllocStats *s        = xw_alloc_stats + category;
+    stats->alloc_count     = __atomic_load_n (&s->alloc_count, __ATOMIC_RELAXED);
+    stats->realloc_count   = __atomic_load_n (&s->realloc_count, __ATOMIC_RELAXED);
+    stats->free_count      = __atomic_load_n (&s->free_count, __ATOMIC_RELAXED);
+    stats->live_count      = __atomic_load_n (&s->live_count, __ATOMIC_RELAXED);
+    stats->bytes_requested = __atomic_load_n (&s->bytes_requested, __ATOMIC_RELAXED);
+
+    return stats;
+}
+
+/**
+ * @b Allocate zeroed memory for an array using currently set allocator.
+ *
+ * @param category
+ * @param count Number of elements. Cannot be 0.
+ * @param size Size of each element. Cannot be 0.
+ *
+ * @return Pointer to allocated memory on success.
+ * @return Null otherwise, including when total size does not fit in @c Size.
+ * */
+void *xw_allocate (XwAllocCategory category, Size count, Size size) {
+    RETURN_VALUE_IF (
+        category >= XW_ALLOC_CATEGORY_MAX || !count || !size,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+    RETURN_VALUE_IF (__builtin_mul_overflow (count, size, &size), Null, ERR_OUT_OF_MEMORY);
+
+    void *ptr = xw_allocator.alloc (xw_allocator.user_data, size, category);
+    RETURN_VALUE_IF (!ptr, Null, ERR_OUT_OF_MEMORY);
+    memset (ptr, 0, size);
+
+    COUNT (category, alloc_count, 1);
+    COUNT (category, live_count, 1);
+    COUNT (category, bytes_requested, size);
+
+    return ptr;
+}
+
+/**
+ * @b Resize memory allocated by @c xw_allocate.
+ *
+ * Unlike @c xw_allocate, the newly added part of memory is not zeroed, because
+ * previous size is not known here.
+ *
+ * @param category Must be same as the one used when allocating @c ptr.
+ * @param ptr Can be @c Null, in which case this is same as @c xw_allocate.
+ * @param count Number of elements. Cannot be 0.
+ * @param size Size of each element. Cannot be 0.
+ *
+ * @return Pointer to resized memory on success.
+ * @return Null otherwise, including when total size does not fit in @c Size. @c ptr remains
+ *         valid in this case.
+ * */
+void *xw_reallocate (XwAllocCategory category, void *ptr, Size count, Size size) {
+    RETURN_VALUE_IF (
+        category >= XW_ALLOC_CATEGORY_MAX || !count || !size,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    if (!ptr) {
+        return xw_allocate (category, count, size);
+    }
+
+    RETURN_VALUE_IF (__builtin_mul_overflow (count, size, &size), Null, ERR_OUT_OF_MEMORY);
+
+    void *new_ptr = xw_allocator.realloc (xw_allocator.user_data, ptr, size, category);
+    RETURN_VALUE_IF (!new_ptr, Null, ERR_OUT_OF_MEMORY);
+
+    COUNT (category, realloc_count, 1);
+    COUNT (category, bytes_requested, size);
+
+    return new_ptr;
+}
+
+/**
+ * @b Release memory allocated by @c xw_allocate or @c xw_reallocate.
+ *
+ * @param category Must be same as the one used when allocating @c ptr.
+ * @param ptr Can be @c Null, in which case nothing is done.
+ * */
+void xw_free (XwAllocCategory category, void *ptr) {
+    RETURN_IF (category >= XW_ALLOC_CATEGORY_MAX, ERR_INVALID_ARGUMENTS);
+
+    if (!ptr) {
+        return;
+    }
+
+    xw_allocator.free (xw_allocator.user_data, ptr, category);
+
+    COUNT (category, free_count, 1);
+    __atomic_fetch_sub (&xw_alloc_stats[category].live_count, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @b Duplicate given string using currently set allocator.
+ *
+ * Returned string must be released using @c XW_FREE with same category.
+ *
+ * @param category
+ * @param str
+ *
+ * @return Duplicated string on success.
+ * @return Null otherwise.
+ * */
+CString xw_strdup (XwAllocCategory category, CString str) {
+    RETURN_VALUE_IF (!str, Null, ERR_INVALID_ARGUMENTS);
+
+    Size  size = strlen (str) + 1;
+    char *dup  = xw_allocate (category, 1, size);
+    RETURN_VALUE_IF (!dup, Null, ERR_OUT_OF_MEMORY);
+    memcpy (dup, str, size);
+
+    return dup;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+static void *xw_default_alloc (void *user_data, Size size, XwAllocCategory category) {
+    UNUSED (user_data);
+    UNUSED (category);
+    return malloc (size);
+}
+
+static void *xw_default_realloc (void *user_data, void *ptr, Size size, XwAllocCategory category) {
+    UNUSED (user_data);
+    UNUSED (category);
+    return realloc (ptr, size);
+}
+
+static void xw_default_free (void *user_data, void *ptr, XwAllocCategory category) {
+    UNUSED (user_data);
+    UNUSED (category);
+    free (ptr);
+}
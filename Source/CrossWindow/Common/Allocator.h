@@ -0,0 +1,55 @@
+/**
+ * @file Allocator.h
+ * @time 18/10/2026 12:25:56
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_ALLOCATOR_H
+#define ANVIE_CROSSWINDOW_COMMON_ALLOCATOR_H
+
+#include <Anvie/CrossWindow/Allocator.h>
+
+/* Same as NEW, ALLOCATE, REALLOCATE and FREE from Common.h, but these go through the allocator
+ * set using xw_set_allocator and are counted under given category. Memory from XW_NEW and
+ * XW_ALLOCATE is zeroed, memory added by XW_REALLOCATE is not. Sizes that overflow fail the
+ * allocation, like calloc. */
+#define XW_NEW(category, type)         (type *)xw_allocate (category, 1, sizeof (type))
+#define XW_ALLOCATE(category, type, n) (type *)xw_allocate (category, n, sizeof (type))
+#define XW_REALLOCATE(category, ptr, type, n)                                                      \
+    (type *)xw_reallocate (category, ptr, n, sizeof (type))
+#define XW_FREE(category, x)     xw_free (category, (void *)(x))
+#define XW_STRDUP(category, str) xw_strdup (category, str)
+
+void   *xw_allocate (XwAllocCategory category, Size count, Size size);
+void   *xw_reallocate (XwAllocCategory category, void *ptr, Size count, Size size);
+void    xw_free (XwAllocCategory category, void *ptr);
+CString xw_strdup (XwAllocCategory category, CString str);
+
+#endif // ANVIE_CROSSWINDOW_COMMON_ALLOCATOR_H
@@ -0,0 +1,666 @@
+/**
+ * @file Backlog.c
+ * @time 18/10/2026 13:40:36
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Stats.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Backlog.h"
+#include "Lock.h"
+#include "Log.h"
+
+/* libc headers */
+#include <string.h>
+
+/** @b Number of slots a ring gets when first event is pushed to it. */
+#define XW_EVENT_RING_INITIAL_CAPACITY 64
+
+/** @b Least number of slots in table of pending collapsible events of a ring. */
+#define XW_EVENT_RING_INITIAL_PENDING_CAPACITY 16
+
+static struct {
+    Bool priority_mode;
+    Size limits[XW_EVENT_CLASS_MAX]; /**< @b Most events of each class. 0 means no limit. */
+} xw_backlog = {0};
+
+/* written only with event lock of backend held, but read and reset from any thread */
+static XwEventBacklogStats xw_backlog_stats = {0};
+
+static XwEventClass    xw_event_class_of (XwEventType type);
+static Bool            xw_event_is_collapsible (XwEventType type);
+static void            xw_event_backlog_make_room (XwEventBacklog *self, XwEvent *incoming);
+static void            xw_event_backlog_update_depth (XwEventBacklog *self, XwEventClass cls);
+static XwEventRing    *xw_event_backlog_next_ring (XwEventBacklog *self);
+static Bool            xw_event_ring_push (XwEventRing *ring, const XwBacklogEntry *entry);
+static XwBacklogEntry *xw_event_ring_at (XwEventRing *ring, Size index);
+static XwEvent        *xw_event_ring_next_move (XwEventRing *ring, Size index, XwEvent *incoming);
+static void            xw_event_ring_remove (XwEventRing *ring, Size index);
+static Size            xw_event_ring_find (XwEventRing *ring, Uint64 sequence);
+static XwPendingEntry *xw_event_ring_pending (XwEventRing *ring, XwWindow *win, XwEventType type);
+static Bool            xw_event_ring_rebuild_pending (XwEventRing *ring);
+static void            xw_event_ring_track (XwEventRing *ring, const XwBacklogEntry *entry);
+static Bool            xw_event_ring_collapse (XwEventRing *ring, const XwEvent *event);
+static void            xw_event_ring_forget_window (XwEventRing *ring, XwWindow *win);
+static void            xw_event_ring_deinit (XwEventRing *ring);
+static void            xw_stats_increment (Uint64 *counter);
+
+/**
+ * @b Make @c xw_event_poll and @c xw_event_wait return input before window management events.
+ *
+ * Before returning an event, everything display server sent so far is read into backlog.
+ * Input and mouse moves are returned first, in the order they arrived. Window events come
+ * after, in the order they arrived, except that of resize, reposition, paint, restack, border
+ * width, DPI and state changes of a window waiting to be returned, only the latest of each
+ * type is kept, in place of the first one. These events describe latest state of the window,
+ * so nothing is lost by this.
+ *
+ * This keeps a key press from waiting behind hundreds of expose and configure events while a
+ * window is being resized. Disabled by default.
+ *
+ * @param enable
+ * */
+void xw_event_set_priority_mode (Bool enable) {
+    XW_STORE (&xw_backlog.priority_mode, !!enable);
+}
+
+/**
+ * @b Limit number of events of a class waiting in backlog.
+ *
+ * Once a class has a limit, everything display server sent so far is read into backlog
+ * before an event is returned (same as in priority mode, but keeping arrival order unless
+ * priority mode is enabled too). A class at it's limit makes room for a new event as per it's
+ * policy :
+ * - @c XW_EVENT_CLASS_MOTION : Oldest mouse move that has a later one of same window is
+ *   dropped. It's @c dx and @c dy are added to that later move, so relative motion adds up
+ *   the same.
+ * - @c XW_EVENT_CLASS_WINDOW : Oldest resize, reposition, paint, restack, border width, DPI or
+ *   state change is dropped. Close requests, visibility, frame, error events etc... are never
+ *   dropped, as nothing that comes later tells the same.
+ * - @c XW_EVENT_CLASS_INPUT : Keys and buttons are never dropped, this class cannot be limited.
+ *
+ * An application that stalls for a while then gets at most that many stale events of each
+ * class, no matter how long the stall was. Dropped events are counted in
+ * @c XwEventBacklogStats::overflow.
+ *
+ * @param event_class
+ * @param limit Most events of class kept in backlog. 0 removes the limit.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_event_set_backlog_limit (XwEventClass event_class, Size limit) {
+    RETURN_VALUE_IF (event_class >= XW_EVENT_CLASS_MAX, False, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        event_class == XW_EVENT_CLASS_INPUT && limit,
+        False,
+        "Input events are never dropped, their class cannot be limited\n"
+    );
+
+    XW_STORE (&xw_backlog.limits[event_class], limit);
+    return True;
+}
+
+/**
+ * @b Get a snapshot of event backlog depth and overflow counters.
+ *
+ * @param stats Where snapshot will be stored.
+ *
+ * @return @c stats on success.
+ * @return @c Null otherwise.
+ * */
+XwEventBacklogStats *xw_stats_event_backlog (XwEventBacklogStats *stats) {
+    RETURN_VALUE_IF (!stats, Null, ERR_INVALID_ARGUMENTS);
+
+    for (Size c = 0; c < XW_EVENT_CLASS_MAX; c++) {
+        stats->depth[c]     = XW_LOAD (&xw_backlog_stats.depth[c]);
+        stats->max_depth[c] = XW_LOAD (&xw_backlog_stats.max_depth[c]);
+        stats->overflow[c]  = XW_LOAD (&xw_backlog_stats.overflow[c]);
+    }
+    stats->collapsed = XW_LOAD (&xw_backlog_stats.collapsed);
+
+    return stats;
+}
+
+/**
+ * @b Reset event backlog counters. Max depth starts again from current depth.
+ * */
+void xw_stats_reset_event_backlog (void) {
+    for (Size c = 0; c < XW_EVENT_CLASS_MAX; c++) {
+        XW_STORE (&xw_backlog_stats.max_depth[c], XW_LOAD (&xw_backlog_stats.depth[c]));
+        XW_STORE (&xw_backlog_stats.overflow[c], 0);
+    }
+    XW_STORE (&xw_backlog_stats.collapsed, 0);
+}
+
+/**
+ * @b Check whether priority mode is enabled.
+ * */
+Bool xw_event_priority_mode (void) {
+    return XW_LOAD (&xw_backlog.priority_mode);
+}
+
+/**
+ * @b Check whether backends must drain display server into backlog before returning an
+ *    event. True while priority mode is enabled or any class has a limit.
+ * */
+Bool xw_event_backlog_enabled (void) {
+    return xw_event_priority_mode() || XW_LOAD (&xw_backlog.limits[XW_EVENT_CLASS_MOTION]) ||
+           XW_LOAD (&xw_backlog.limits[XW_EVENT_CLASS_WINDOW]);
+}
+
+/**
+ * @b Free memory held by backlog, dropping events still in it.
+ *
+ * @param self
+ * */
+void xw_event_backlog_deinit (XwEventBacklog *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    for (Size c = 0; c < XW_EVENT_CLASS_MAX; c++) {
+        xw_event_ring_deinit (self->rings + c);
+        xw_event_backlog_update_depth (self, c);
+    }
+    self->sequence = 0;
+}
+
+/**
+ * @b Add a copy of converted event to backlog, replacing an older event it supersedes, and
+ *    making room for it if it's class is at it's limit.
+ *
+ * @param self
+ * @param event Events of type @c XW_EVENT_TYPE_NONE are ignored.
+ *
+ * @return True on success.
+ * @return False otherwise. Event is dropped in this case.
+ * */
+Bool xw_event_backlog_push (XwEventBacklog *self, const XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, False, ERR_INVALID_ARGUMENTS);
+
+    if (event->type == XW_EVENT_TYPE_NONE) {
+        return True;
+    }
+
+    XwEventClass cls  = xw_event_class_of (event->type);
+    XwEventRing *ring = self->rings + cls;
+
+    if (cls == XW_EVENT_CLASS_WINDOW && xw_event_ring_collapse (ring, event)) {
+        xw_stats_increment (&xw_backlog_stats.collapsed);
+        return True;
+    }
+
+    XwBacklogEntry entry = {.sequence = self->sequence++, .event = *event};
+    xw_event_backlog_make_room (self, &entry.event);
+
+    Bool pushed = xw_event_ring_push (ring, &entry);
+    if (pushed && cls == XW_EVENT_CLASS_WINDOW && xw_event_is_collapsible (event->type)) {
+        xw_event_ring_track (ring, &entry);
+    }
+    xw_event_backlog_update_depth (self, cls);
+
+    return pushed;
+}
+
+/**
+ * @b Remove next event from backlog. That's the oldest one, or with priority mode enabled,
+ *    the oldest input or motion event if there is one.
+ *
+ * @param self
+ * @param event Where removed event is stored.
+ *
+ * @return True if an event was removed.
+ * @return False if backlog is empty.
+ * */
+Bool xw_event_backlog_pop (XwEventBacklog *self, XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, False, ERR_INVALID_ARGUMENTS);
+
+    XwEventRing *ring = xw_event_backlog_next_ring (self);
+    if (!ring) {
+        return False;
+    }
+
+    *event     = ring->entries[ring->head].event;
+    ring->head = (ring->head + 1) & (ring->capacity - 1);
+    ring->count--;
+
+    xw_event_backlog_update_depth (self, ring - self->rings);
+    return True;
+}
+
+/**
+ * @b Remove all events of given window from backlog.
+ *
+ * Must be called when window is being destroyed, so that popped events never refer to a
+ * dangling window. Order of remaining events is preserved.
+ *
+ * @param self
+ * @param win
+ * */
+void xw_event_backlog_forget_window (XwEventBacklog *self, XwWindow *win) {
+    RETURN_IF (!self || !win, ERR_INVALID_ARGUMENTS);
+
+    for (Size c = 0; c < XW_EVENT_CLASS_MAX; c++) {
+        xw_event_ring_forget_window (self->rings + c, win);
+        xw_event_backlog_update_depth (self, c);
+    }
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Get class of events of given type.
+ *
+ * Keymap changes count as input, as key events that follow them depend on new mapping.
+ * */
+static XwEventClass xw_event_class_of (XwEventType type) {
+    switch (type) {
+        case XW_EVENT_TYPE_ENTER :
+        case XW_EVENT_TYPE_LEAVE :
+        case XW_EVENT_TYPE_FOCUS :
+        case XW_EVENT_TYPE_KEYBOARD_INPUT :
+        case XW_EVENT_TYPE_MOUSE_WHEEL :
+        case XW_EVENT_TYPE_MOUSE_INPUT :
+        case XW_EVENT_TYPE_TOUCH :
+        case XW_EVENT_TYPE_GAMEPAD :
+        case XW_EVENT_TYPE_KEYMAP_CHANGE :
+            return XW_EVENT_CLASS_INPUT;
+        case XW_EVENT_TYPE_MOUSE_MOVE :
+            return XW_EVENT_CLASS_MOTION;
+        default :
+            return XW_EVENT_CLASS_WINDOW;
+    }
+}
+
+/**
+ * @b Check whether a newer event of given type makes an older one of same window useless.
+ * */
+static Bool xw_event_is_collapsible (XwEventType type) {
+    switch (type) {
+        case XW_EVENT_TYPE_STATE_CHANGE :
+        case XW_EVENT_TYPE_PAINT :
+        case XW_EVENT_TYPE_BORDER_WIDTH_CHANGE :
+        case XW_EVENT_TYPE_REPOSITION :
+        case XW_EVENT_TYPE_RESIZE :
+        case XW_EVENT_TYPE_RESTACK :
+        case XW_EVENT_TYPE_DPI_CHANGE :
+            return True;
+        default :
+            return False;
+    }
+}
+
+/**
+ * @b Drop events from ring of given event's class till there's room for it under limit of
+ *    class, as per policy of class. See @c xw_event_set_backlog_limit.
+ *
+ * @param self
+ * @param incoming Event about to be pushed. Motion of dropped mouse moves may be added to it.
+ * */
+static void xw_event_backlog_make_room (XwEventBacklog *self, XwEvent *incoming) {
+    XwEventClass cls   = xw_event_class_of (incoming->type);
+    XwEventRing *ring  = self->rings + cls;
+    Size         limit = XW_LOAD (&xw_backlog.limits[cls]);
+
+    while (limit && ring->count >= limit) {
+        Size victim = 0;
+
+        if (cls == XW_EVENT_CLASS_MOTION) {
+            /* relative motion of dropped move goes to next move of same window, so a move that
+             * is last of it's window is never dropped */
+            XwEvent *next = xw_event_ring_next_move (ring, victim, incoming);
+            while (!next && ++victim < ring->count) {
+                next = xw_event_ring_next_move (ring, victim, incoming);
+            }
+            if (!next) {
+                return;
+            }
+
+            XwEvent *dropped = &xw_event_ring_at (ring, victim)->event;
+            next->mouse_move.dx += dropped->mouse_move.dx;
+            next->mouse_move.dy += dropped->mouse_move.dy;
+        } else {
+            /* only events a later one of same window and type would replace can be dropped,
+             * close requests, frame, visibility and error events etc... must not be missed */
+            while (victim < ring->count &&
+                   !xw_event_is_collapsible (xw_event_ring_at (ring, victim)->event.type)) {
+                victim++;
+            }
+            if (victim == ring->count) {
+                return;
+            }
+        }
+
+        xw_event_ring_remove (ring, victim);
+        xw_stats_increment (&xw_backlog_stats.overflow[cls]);
+    }
+}
+
+/**
+ * @b Publish depth of ring of given class, and raise max depth if needed.
+ * */
+static void xw_event_backlog_update_depth (XwEventBacklog *self, XwEventClass cls) {
+    Size depth = self->rings[cls].count;
+
+    XW_STORE (&xw_backlog_stats.depth[cls], depth);
+    if (depth > XW_LOAD (&xw_backlog_stats.max_depth[cls])) {
+        XW_STORE (&xw_backlog_stats.max_depth[cls], depth);
+    }
+}
+
+/**
+ * @b Find ring holding event to be popped next.
+ *
+ * @return Ring on success.
+ * @return Null if all rings are empty.
+ * */
+static XwEventRing *xw_event_backlog_next_ring (XwEventBacklog *self) {
+    Bool         priority = xw_event_priority_mode();
+    XwEventRing *next     = Null;
+
+    for (Size c = 0; c < XW_EVENT_CLASS_MAX; c++) {
+        XwEventRing *ring = self->rings + c;
+        if (!ring->count) {
+            continue;
+        }
+
+        /* window events wait till there's no input or motion left */
+        if (priority && next && c == XW_EVENT_CLASS_WINDOW) {
+            break;
+        }
+
+        if (!next || ring->entries[ring->head].sequence < next->entries[next->head].sequence) {
+            next = ring;
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @b Add a copy of entry at end of ring, doubling it's capacity if it's full.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+static Bool xw_event_ring_push (XwEventRing *ring, const XwBacklogEntry *entry) {
+    if (ring->count == ring->capacity) {
+        Size new_capacity =
+            ring->capacity ? ring->capacity * 2 : XW_EVENT_RING_INITIAL_CAPACITY;
+
+        XwBacklogEntry *entries =
+            XW_ALLOCATE (XW_ALLOC_CATEGORY_QUEUE, XwBacklogEntry, new_capacity);
+        RETURN_VALUE_IF (!entries, False, ERR_OUT_OF_MEMORY);
+
+        /* unwrap the ring while copying, so head starts at 0 again */
+        for (Size s = 0; s < ring->count; s++) {
+            entries[s] = *xw_event_ring_at (ring, s);
+        }
+
+        if (ring->entries) {
+            XW_FREE (XW_ALLOC_CATEGORY_QUEUE, ring->entries);
+        }
+        ring->entries  = entries;
+        ring->capacity = new_capacity;
+        ring->head     = 0;
+    }
+
+    ring->entries[(ring->head + ring->count) & (ring->capacity - 1)] = *entry;
+    ring->count++;
+
+    return True;
+}
+
+/**
+ * @b Get entry at given position from oldest one.
+ * */
+static XwBacklogEntry *xw_event_ring_at (XwEventRing *ring, Size index) {
+    return ring->entries + ((ring->head + index) & (ring->capacity - 1));
+}
+
+/**
+ * @b Find mouse move of same window that comes after mouse move at given position.
+ *
+ * @param incoming Mouse move about to be pushed, which comes after all in ring.
+ *
+ * @return @c XwEvent* on success.
+ * @return @c Null if there's no later move of that window.
+ * */
+static XwEvent *xw_event_ring_next_move (XwEventRing *ring, Size index, XwEvent *incoming) {
+    XwWindow *win = xw_event_ring_at (ring, index)->event.window;
+
+    for (Size s = index + 1; s < ring->count; s++) {
+        XwEvent *e = &xw_event_ring_at (ring, s)->event;
+        if (e->window == win) {
+            return e;
+        }
+    }
+
+    return incoming->window == win ? incoming : Null;
+}
+
+/**
+ * @b Remove entry at given position from oldest one, keeping order of rest.
+ * */
+static void xw_event_ring_remove (XwEventRing *ring, Size index) {
+    for (Size s = index; s; s--) {
+        *xw_event_ring_at (ring, s) = *xw_event_ring_at (ring, s - 1);
+    }
+
+    ring->head = (ring->head + 1) & (ring->capacity - 1);
+    ring->count--;
+}
+
+/**
+ * @b Get position of entry with given sequence from oldest one.
+ *
+ * @return Position on success.
+ * @return @c SIZE_MAX if entry already left the ring.
+ * */
+static Size xw_event_ring_find (XwEventRing *ring, Uint64 sequence) {
+    Size low  = 0;
+    Size high = ring->count;
+
+    while (low < high) {
+        Size   mid   = low + (high - low) / 2;
+        Uint64 found = xw_event_ring_at (ring, mid)->sequence;
+        if (found == sequence) {
+            return mid;
+        } else if (found < sequence) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * @b Get entry of pending table for given window and type, or the unused one where it goes.
+ *
+ * @return @c XwPendingEntry* if ring has a pending table.
+ * @return @c Null otherwise.
+ * */
+static XwPendingEntry *xw_event_ring_pending (XwEventRing *ring, XwWindow *win, XwEventType type) {
+    if (!ring->pending_capacity) {
+        return Null;
+    }
+
+    /* table is never more than half full, so probing always ends */
+    Size mask = ring->pending_capacity - 1;
+    Size hash = (Size)(((Uint64)(Size)win ^ type) * 0x9e3779b97f4a7c15ull >> 32);
+    for (Size s = hash & mask;; s = (s + 1) & mask) {
+        XwPendingEntry *pending = ring->pending + s;
+        if (!pending->window || (pending->window == win && pending->type == type)) {
+            return pending;
+        }
+    }
+}
+
+/**
+ * @b Replace pending table of ring with one that has room for as many entries again as there
+ *    are events still in ring, dropping entries of events that left it.
+ *
+ * @return True on success.
+ * @return False otherwise. Old table is kept in this case.
+ * */
+static Bool xw_event_ring_rebuild_pending (XwEventRing *ring) {
+    Size live = 0;
+    for (Size s = 0; s < ring->pending_capacity; s++) {
+        XwPendingEntry *old = ring->pending + s;
+        live += old->window && xw_event_ring_find (ring, old->sequence) != SIZE_MAX;
+    }
+
+    Size capacity = XW_EVENT_RING_INITIAL_PENDING_CAPACITY;
+    while (capacity < 4 * (live + 1)) {
+        capacity *= 2;
+    }
+
+    XwPendingEntry *pending = XW_ALLOCATE (XW_ALLOC_CATEGORY_QUEUE, XwPendingEntry, capacity);
+    RETURN_VALUE_IF (!pending, False, ERR_OUT_OF_MEMORY);
+
+    XwPendingEntry *old_pending  = ring->pending;
+    Size            old_capacity = ring->pending_capacity;
+
+    ring->pending          = pending;
+    ring->pending_capacity = capacity;
+    ring->pending_count    = 0;
+
+    for (Size s = 0; s < old_capacity; s++) {
+        XwPendingEntry *old = old_pending + s;
+        if (old->window && xw_event_ring_find (ring, old->sequence) != SIZE_MAX) {
+            *xw_event_ring_pending (ring, old->window, old->type) = *old;
+            ring->pending_count++;
+        }
+    }
+
+    if (old_pending) {
+        XW_FREE (XW_ALLOC_CATEGORY_QUEUE, old_pending);
+    }
+
+    return True;
+}
+
+/**
+ * @b Remember entry just pushed to ring as the pending collapsible event of it's window and
+ *    type. Events that aren't remembered because of allocation failure are just not
+ *    collapsed.
+ * */
+static void xw_event_ring_track (XwEventRing *ring, const XwBacklogEntry *entry) {
+    if (!entry->event.window) {
+        return;
+    }
+
+    if ((ring->pending_count + 1) * 2 > ring->pending_capacity &&
+        !xw_event_ring_rebuild_pending (ring)) {
+        return;
+    }
+
+    XwPendingEntry *pending = xw_event_ring_pending (ring, entry->event.window, entry->event.type);
+    if (!pending->window) {
+        ring->pending_count++;
+    }
+
+    pending->window   = entry->event.window;
+    pending->type     = entry->event.type;
+    pending->sequence = entry->sequence;
+}
+
+/**
+ * @b Overwrite an older event of same window and type with given one, if it's type can be
+ *    collapsed. Overwritten event keeps it's place in arrival order.
+ *
+ * Older event is found through pending table of ring, in time logarithmic in number of
+ * events in ring, however many events that can't be collapsed are waiting with it.
+ *
+ * @return True if an older event was overwritten.
+ * @return False if given event must be pushed instead.
+ * */
+static Bool xw_event_ring_collapse (XwEventRing *ring, const XwEvent *event) {
+    if (!xw_event_is_collapsible (event->type) || !event->window) {
+        return False;
+    }
+
+    XwPendingEntry *pending = xw_event_ring_pending (ring, event->window, event->type);
+    if (!pending || !pending->window) {
+        return False;
+    }
+
+    Size index = xw_event_ring_find (ring, pending->sequence);
+    if (index == SIZE_MAX) {
+        return False;
+    }
+
+    xw_event_ring_at (ring, index)->event = *event;
+    return True;
+}
+
+/**
+ * @b Remove events of given window from ring, and restacks above it, keeping order of rest.
+ * */
+static void xw_event_ring_forget_window (XwEventRing *ring, XwWindow *win) {
+    Size kept = 0;
+
+    for (Size s = 0; s < ring->count; s++) {
+        XwBacklogEntry *entry = xw_event_ring_at (ring, s);
+        XwEvent        *e     = &entry->event;
+        if (e->window == win || (e->type == XW_EVENT_TYPE_RESTACK && e->restack.above == win)) {
+            continue;
+        }
+
+        *xw_event_ring_at (ring, kept) = *entry;
+        kept++;
+    }
+
+    ring->count = kept;
+}
+
+/**
+ * @b Free entries of ring and reset it to empty.
+ * */
+static void xw_event_ring_deinit (XwEventRing *ring) {
+    if (ring->entries) {
+        XW_FREE (XW_ALLOC_CATEGORY_QUEUE, ring->entries);
+    }
+    if (ring->pending) {
+        XW_FREE (XW_ALLOC_CATEGORY_QUEUE, ring->pending);
+    }
+    memset (ring, 0, sizeof (*ring));
+}
+
+/**
+ * @b Add one to a counter that other threads may read or reset meanwhile.
+ * */
+static void xw_stats_increment (Uint64 *counter) {
+    XW_STORE (counter, XW_LOAD (counter) + 1);
+}
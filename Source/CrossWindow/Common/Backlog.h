@@ -0,0 +1,95 @@
+/**
+ * @file Backlog.h
+ * @time 18/10/2026 13:40:36
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_BACKLOG_H
+#define ANVIE_CROSSWINDOW_COMMON_BACKLOG_H
+
+#include <Anvie/CrossWindow/Event.h>
+
+/* While backlog is enabled (priority mode is on, or a class has a limit), the thread pumping
+ * events first drains everything display server sent so far into a backlog, and only then
+ * returns one. Backlog keeps each event class apart, and keeps only the latest of superseded
+ * window management events (resize, reposition etc...) of a window. A class that reached it's
+ * limit makes room as per it's policy, so a stalled application catches up at once instead of
+ * going through seconds of stale events.
+ *
+ * Events are returned in the order they arrived, or with priority mode on, input and motion
+ * first (in the order they arrived) and window events after them.
+ *
+ * Backlog is not thread safe, backends guard it with their event lock. */
+
+/** @b An event in backlog, and when it arrived relative to others. */
+typedef struct XwBacklogEntry {
+    Uint64  sequence;
+    XwEvent event;
+} XwBacklogEntry;
+
+/** @b Sequence of last pushed collapsible event of a window and type. */
+typedef struct XwPendingEntry {
+    XwWindow   *window; /**< @b Null for an unused entry. */
+    XwEventType type;
+    Uint64      sequence;
+} XwPendingEntry;
+
+/**
+ * @b Growable ring of events, popped in pushed order.
+ *
+ * Sequences of entries increase from head to tail, so an entry is found from it's sequence
+ * by a binary search. @c pending maps window and type of collapsible events to sequence of
+ * their entry, so that a newer event is collapsed without going through whole ring. Entries
+ * of @c pending aren't removed when their event leaves the ring. Such an entry just fails to
+ * find it's sequence, and is overwritten by next push or dropped when table is rebuilt.
+ * */
+typedef struct XwEventRing {
+    XwBacklogEntry *entries;
+    Size            capacity; /**< @b Number of slots in @c entries. Always a power of two. */
+    Size            head;     /**< @b Slot of oldest event. */
+    Size            count;    /**< @b Number of events in ring. */
+
+    XwPendingEntry *pending;          /**< @b Open addressed table, kept at most half full. */
+    Size            pending_capacity; /**< @b Number of slots in @c pending. Power of two. */
+    Size            pending_count;    /**< @b Number of used slots in @c pending. */
+} XwEventRing;
+
+typedef struct XwEventBacklog {
+    XwEventRing rings[XW_EVENT_CLASS_MAX]; /**< @b One ring per @c XwEventClass. */
+    Uint64      sequence;                  /**< @b Sequence of next pushed event. */
+} XwEventBacklog;
+
+Bool xw_event_priority_mode (void);
+Bool xw_event_backlog_enabled (void);
+void xw_event_backlog_deinit (XwEventBacklog *self);
+Bool xw_event_backlog_push (XwEventBacklog *self, const XwEvent *event);
+Bool xw_event_backlog_pop (XwEventBacklog *self, XwEvent *event);
+void xw_event_backlog_forget_window (XwEventBacklog *self, XwWindow *win);
+
+#endif // ANVIE_CROSSWINDOW_COMMON_BACKLOG_H
@@ -0,0 +1,767 @@
+/**
+ * @file Convert.c
+ * @time 18/10/2026 12:31:38
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Framebuffer.h>
+
+/* local headers */
+#include "Log.h"
+
+/* libc headers */
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    define XW_HAS_X86_KERNELS 1
+#    include <immintrin.h>
+#    define TARGET_SSE2 __attribute__ ((target ("sse2")))
+#    define TARGET_AVX2 __attribute__ ((target ("avx2")))
+#elif defined(__aarch64__)
+/* NEON is part of base aarch64, so it never needs a runtime check */
+#    define XW_HAS_NEON_KERNELS 1
+#    include <arm_neon.h>
+#endif
+
+/**
+ * @b Convert first pixels of a row, using SIMD.
+ *
+ * Each kernel converts from one source format to BGRX8888 (when @c swap_rb is True) or
+ * RGBX8888 (otherwise), and processes only as many pixels as fit in it's vector width.
+ * Remaining pixels are converted by scalar code.
+ *
+ * @return Number of pixels converted.
+ * */
+typedef Size (*XwConvertRowFn) (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+
+typedef struct XwConvertKernels {
+    XwConvertRowFn swizzle;        /**< @b RGBA8888/RGBX8888 source. */
+    XwConvertRowFn premultiply;    /**< @b RGBA8888 source with @c XW_CONVERT_FLAG_PREMULTIPLY. */
+    XwConvertRowFn expand_565;     /**< @b RGB565 source. */
+    XwConvertRowFn float_to_unorm; /**< @b RGBA32F source. */
+} XwConvertKernels;
+
+#if XW_HAS_X86_KERNELS
+static Size xw_swizzle_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_premultiply_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_expand_565_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_float_to_unorm_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_swizzle_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_premultiply_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_expand_565_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_float_to_unorm_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+#endif
+
+#if XW_HAS_NEON_KERNELS
+static Size xw_swizzle_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_premultiply_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_expand_565_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+static Size xw_float_to_unorm_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb);
+#endif
+
+/* scalar level has no kernels, everything is done by xw_convert_row_scalar */
+static const XwConvertKernels xw_convert_kernels[XW_SIMD_LEVEL_MAX] = {
+#if XW_HAS_X86_KERNELS
+    [XW_SIMD_LEVEL_SSE2] =
+        {xw_swizzle_sse2, xw_premultiply_sse2, xw_expand_565_sse2, xw_float_to_unorm_sse2},
+    [XW_SIMD_LEVEL_AVX2] =
+        {xw_swizzle_avx2, xw_premultiply_avx2, xw_expand_565_avx2, xw_float_to_unorm_avx2},
+#endif
+#if XW_HAS_NEON_KERNELS
+    [XW_SIMD_LEVEL_NEON] =
+        {xw_swizzle_neon, xw_premultiply_neon, xw_expand_565_neon, xw_float_to_unorm_neon},
+#endif
+};
+
+/* resolved on first use */
+static XwSimdLevel xw_simd_level = XW_SIMD_LEVEL_AUTO;
+
+static XwSimdLevel    xw_detect_simd_level (void);
+static Bool           xw_is_simd_level_supported (XwSimdLevel level);
+static Size           xw_pixel_format_size (XwPixelFormat format);
+static XwConvertRowFn xw_select_kernel (
+    XwPixelFormat  src_format,
+    XwPixelFormat  dst_format,
+    XwConvertFlags flags,
+    Bool          *swap_rb
+);
+static void xw_convert_row_scalar (
+    Uint8        *dst,
+    XwPixelFormat dst_format,
+    const Uint8  *src,
+    XwPixelFormat src_format,
+    Bool          premultiply,
+    Size          n
+);
+
+/**
+ * @b Convert pixels to framebuffer's format and write them into given region of it.
+ *
+ * Conversion to BGRX8888 and RGBX8888 framebuffers uses SIMD kernels selected at runtime
+ * (see @c xw_set_simd_level). Every other combination is converted with plain C.
+ *
+ * @param fb Framebuffer from @c xw_window_get_framebuffer.
+ * @param rect Region of framebuffer to write to. Parts outside of framebuffer are skipped.
+ * @param pixels Source pixels, @c rect.width x @c rect.height of them.
+ * @param stride Distance between rows of source pixels in bytes.
+ * @param format Format of source pixels.
+ * @param flags Bitwise OR of @c XwConvertFlagBits.
+ *
+ * @return @c fb on success.
+ * @return Null otherwise.
+ * */
+XwFramebuffer *xw_framebuffer_write (
+    XwFramebuffer *fb,
+    XwRect         rect,
+    const void    *pixels,
+    Size           stride,
+    XwPixelFormat  format,
+    XwConvertFlags flags
+) {
+    RETURN_VALUE_IF (!fb || !fb->pixels || !pixels, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        format == XW_PIXEL_FORMAT_UNKNOWN || format >= XW_PIXEL_FORMAT_MAX,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+    RETURN_VALUE_IF (
+        fb->format == XW_PIXEL_FORMAT_UNKNOWN || fb->format > XW_PIXEL_FORMAT_RGB565,
+        Null,
+        "Invalid framebuffer format\n"
+    );
+
+    if (rect.x >= fb->width || rect.y >= fb->height) {
+        return fb;
+    }
+
+    Uint32 width  = MIN (rect.width, fb->width - rect.x);
+    Uint32 height = MIN (rect.height, fb->height - rect.y);
+
+    Bool premultiply = (flags & XW_CONVERT_FLAG_PREMULTIPLY) && format == XW_PIXEL_FORMAT_RGBA8888;
+
+    Size src_pixel_size = xw_pixel_format_size (format);
+    Size dst_pixel_size = fb->bytes_per_pixel;
+
+    Bool           swap_rb = False;
+    XwConvertRowFn kernel  = xw_select_kernel (format, fb->format, flags, &swap_rb);
+
+    for (Uint32 row = 0; row < height; row++) {
+        const Uint8 *src = (const Uint8 *)pixels + row * stride;
+        Uint8       *dst = (Uint8 *)fb->pixels + (Size)(rect.y + row) * fb->stride +
+                     (Size)rect.x * dst_pixel_size;
+
+        if (format == fb->format) {
+            memcpy (dst, src, width * dst_pixel_size);
+            continue;
+        }
+
+        Size done = kernel ? kernel (dst, src, width, swap_rb) : 0;
+        xw_convert_row_scalar (
+            dst + done * dst_pixel_size,
+            fb->format,
+            src + done * src_pixel_size,
+            format,
+            premultiply,
+            width - done
+        );
+    }
+
+    return fb;
+}
+
+/**
+ * @b Force pixel conversion kernels to use given instruction set.
+ *
+ * This exists mainly for benchmarking and testing kernels against each other. By default
+ * best instruction set supported by CPU is used, which is detected at runtime.
+ *
+ * @param level Pass @c XW_SIMD_LEVEL_AUTO to go back to automatic selection.
+ *
+ * @return True on success.
+ * @return False if CPU (or the build) does not support given level.
+ * */
+Bool xw_set_simd_level (XwSimdLevel level) {
+    RETURN_VALUE_IF (level >= XW_SIMD_LEVEL_MAX, False, ERR_INVALID_ARGUMENTS);
+
+    if (level == XW_SIMD_LEVEL_AUTO) {
+        xw_simd_level = xw_detect_simd_level();
+        return True;
+    }
+
+    if (!xw_is_simd_level_supported (level)) {
+        return False;
+    }
+
+    xw_simd_level = level;
+    return True;
+}
+
+/**
+ * @b Get instruction set currently used by pixel conversion kernels.
+ *
+ * @return XwSimdLevel (never @c XW_SIMD_LEVEL_AUTO).
+ * */
+XwSimdLevel xw_get_simd_level (void) {
+    if (xw_simd_level == XW_SIMD_LEVEL_AUTO) {
+        xw_simd_level = xw_detect_simd_level();
+    }
+
+    return xw_simd_level;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+static XwSimdLevel xw_detect_simd_level (void) {
+    for (XwSimdLevel level = XW_SIMD_LEVEL_MAX - 1; level > XW_SIMD_LEVEL_SCALAR; level--) {
+        if (xw_is_simd_level_supported (level)) {
+            return level;
+        }
+    }
+
+    return XW_SIMD_LEVEL_SCALAR;
+}
+
+static Bool xw_is_simd_level_supported (XwSimdLevel level) {
+    switch (level) {
+        case XW_SIMD_LEVEL_SCALAR :
+            return True;
+#if XW_HAS_X86_KERNELS
+        /* checked using CPUID */
+        case XW_SIMD_LEVEL_SSE2 :
+            __builtin_cpu_init();
+            return !!__builtin_cpu_supports ("sse2");
+        case XW_SIMD_LEVEL_AVX2 :
+            __builtin_cpu_init();
+            return !!__builtin_cpu_supports ("avx2");
+#endif
+#if XW_HAS_NEON_KERNELS
+        case XW_SIMD_LEVEL_NEON :
+            return True;
+#endif
+        default :
+            return False;
+    }
+}
+
+static Size xw_pixel_format_size (XwPixelFormat format) {
+    switch (format) {
+        case XW_PIXEL_FORMAT_RGB565 :
+            return 2;
+        case XW_PIXEL_FORMAT_RGBA32F :
+            return 4 * sizeof (Float32);
+        default :
+            return 4;
+    }
+}
+
+/**
+ * @b Select SIMD kernel for given conversion.
+ *
+ * @param swap_rb Set to True if kernel must write BGRX8888 instead of RGBX8888.
+ *
+ * @return Kernel if there's one for this conversion and current simd level.
+ * @return Null if whole conversion must be done by scalar code.
+ * */
+static XwConvertRowFn xw_select_kernel (
+    XwPixelFormat  src_format,
+    XwPixelFormat  dst_format,
+    XwConvertFlags flags,
+    Bool          *swap_rb
+) {
+    if (dst_format != XW_PIXEL_FORMAT_BGRX8888 && dst_format != XW_PIXEL_FORMAT_RGBX8888) {
+        return Null;
+    }
+
+    *swap_rb                  = dst_format == XW_PIXEL_FORMAT_BGRX8888;
+    const XwConvertKernels *k = &xw_convert_kernels[xw_get_simd_level()];
+
+    switch (src_format) {
+        case XW_PIXEL_FORMAT_RGBA8888 :
+            return (flags & XW_CONVERT_FLAG_PREMULTIPLY) ? k->premultiply : k->swizzle;
+        case XW_PIXEL_FORMAT_RGBX8888 :
+            return k->swizzle;
+        case XW_PIXEL_FORMAT_RGB565 :
+            return k->expand_565;
+        case XW_PIXEL_FORMAT_RGBA32F :
+            return k->float_to_unorm;
+        default :
+            return Null;
+    }
+}
+
+/* exact round(c * a / 255), same formula is used by all kernels */
+static inline Uint8 xw_mul_div255 (Uint32 c, Uint32 a) {
+    Uint32 t = c * a + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+/* NaN is mapped to 0, same as max/min instructions used by kernels */
+static inline Uint8 xw_float_to_unorm (Float32 f) {
+    f = f > 0.f ? f : 0.f;
+    f = f < 1.f ? f : 1.f;
+    return (Uint8)(f * 255.f + 0.5f);
+}
+
+/**
+ * @b Reference implementation of all conversions. Also used for leftover pixels of kernels.
+ * */
+static void xw_convert_row_scalar (
+    Uint8        *dst,
+    XwPixelFormat dst_format,
+    const Uint8  *src,
+    XwPixelFormat src_format,
+    Bool          premultiply,
+    Size          n
+) {
+    Size src_pixel_size = xw_pixel_format_size (src_format);
+    Size dst_pixel_size = xw_pixel_format_size (dst_format);
+
+    for (Size i = 0; i < n; i++, src += src_pixel_size, dst += dst_pixel_size) {
+        Uint8 r = 0, g = 0, b = 0;
+
+        switch (src_format) {
+            case XW_PIXEL_FORMAT_BGRX8888 :
+                r = src[2], g = src[1], b = src[0];
+                break;
+            case XW_PIXEL_FORMAT_RGBX8888 :
+                r = src[0], g = src[1], b = src[2];
+                break;
+            case XW_PIXEL_FORMAT_XRGB8888 :
+                r = src[1], g = src[2], b = src[3];
+                break;
+            case XW_PIXEL_FORMAT_XBGR8888 :
+                r = src[3], g = src[2], b = src[1];
+                break;
+            case XW_PIXEL_FORMAT_RGBA8888 :
+                r = src[0], g = src[1], b = src[2];
+                if (premultiply) {
+                    r = xw_mul_div255 (r, src[3]);
+                    g = xw_mul_div255 (g, src[3]);
+                    b = xw_mul_div255 (b, src[3]);
+                }
+                break;
+            case XW_PIXEL_FORMAT_RGB565 : {
+                Uint16 p  = src[0] | (src[1] << 8);
+                Uint8  r5 = p >> 11, g6 = (p >> 5) & 0x3f, b5 = p & 0x1f;
+                r         = (r5 << 3) | (r5 >> 2);
+                g         = (g6 << 2) | (g6 >> 4);
+                b         = (b5 << 3) | (b5 >> 2);
+                break;
+            }
+            case XW_PIXEL_FORMAT_RGBA32F : {
+                Float32 f[4];
+                memcpy (f, src, sizeof (f));
+                r = xw_float_to_unorm (f[0]);
+                g = xw_float_to_unorm (f[1]);
+                b = xw_float_to_unorm (f[2]);
+                break;
+            }
+            default :
+                break;
+        }
+
+        /* unused X byte is always written as 0xff */
+        switch (dst_format) {
+            case XW_PIXEL_FORMAT_BGRX8888 :
+                dst[0] = b, dst[1] = g, dst[2] = r, dst[3] = 0xff;
+                break;
+            case XW_PIXEL_FORMAT_RGBX8888 :
+                dst[0] = r, dst[1] = g, dst[2] = b, dst[3] = 0xff;
+                break;
+            case XW_PIXEL_FORMAT_XRGB8888 :
+                dst[0] = 0xff, dst[1] = r, dst[2] = g, dst[3] = b;
+                break;
+            case XW_PIXEL_FORMAT_XBGR8888 :
+                dst[0] = 0xff, dst[1] = b, dst[2] = g, dst[3] = r;
+                break;
+            case XW_PIXEL_FORMAT_RGB565 : {
+                Uint16 p = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+                dst[0]   = p & 0xff;
+                dst[1]   = p >> 8;
+                break;
+            }
+            default :
+                break;
+        }
+    }
+}
+
+/*********************************** x86 (SSE2 and AVX2) ***********************************/
+
+#if XW_HAS_X86_KERNELS
+
+/* swap first and third byte of each 32 bit pixel */
+TARGET_SSE2 static inline __m128i xw_swap_rb_sse2 (__m128i p) {
+    const __m128i low   = _mm_set1_epi32 (0xff);
+    const __m128i green = _mm_set1_epi32 (0xff00);
+    return _mm_or_si128 (
+        _mm_and_si128 (p, green),
+        _mm_or_si128 (
+            _mm_and_si128 (_mm_srli_epi32 (p, 16), low),
+            _mm_slli_epi32 (_mm_and_si128 (p, low), 16)
+        )
+    );
+}
+
+/* round(c * a / 255) for each 16 bit lane */
+TARGET_SSE2 static inline __m128i xw_mul_div255_sse2 (__m128i c, __m128i a) {
+    __m128i t = _mm_add_epi16 (_mm_mullo_epi16 (c, a), _mm_set1_epi16 (128));
+    return _mm_srli_epi16 (_mm_add_epi16 (t, _mm_srli_epi16 (t, 8)), 8);
+}
+
+/* expand four RGB565 pixels, each zero extended to 32 bits */
+TARGET_SSE2 static inline __m128i xw_expand_565_x4_sse2 (__m128i p, Bool swap_rb) {
+    __m128i r = _mm_srli_epi32 (p, 11);
+    __m128i g = _mm_and_si128 (_mm_srli_epi32 (p, 5), _mm_set1_epi32 (0x3f));
+    __m128i b = _mm_and_si128 (p, _mm_set1_epi32 (0x1f));
+
+    r = _mm_or_si128 (_mm_slli_epi32 (r, 3), _mm_srli_epi32 (r, 2));
+    g = _mm_or_si128 (_mm_slli_epi32 (g, 2), _mm_srli_epi32 (g, 4));
+    b = _mm_or_si128 (_mm_slli_epi32 (b, 3), _mm_srli_epi32 (b, 2));
+
+    __m128i lo = swap_rb ? b : r;
+    __m128i hi = swap_rb ? r : b;
+    return _mm_or_si128 (
+        _mm_or_si128 (lo, _mm_slli_epi32 (g, 8)),
+        _mm_or_si128 (_mm_slli_epi32 (hi, 16), _mm_set1_epi32 ((Int32)0xff000000))
+    );
+}
+
+/* one RGBA32F pixel to four 32 bit unorm lanes */
+TARGET_SSE2 static inline __m128i xw_float_to_unorm_x1_sse2 (const Uint8 *src) {
+    __m128 f = _mm_loadu_ps ((const Float32 *)src);
+    f        = _mm_min_ps (_mm_max_ps (f, _mm_setzero_ps()), _mm_set1_ps (1.f));
+    return _mm_cvttps_epi32 (_mm_add_ps (_mm_mul_ps (f, _mm_set1_ps (255.f)), _mm_set1_ps (0.5f)));
+}
+
+TARGET_SSE2 static Size xw_swizzle_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m128i alpha = _mm_set1_epi32 ((Int32)0xff000000);
+
+    Size i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128 ((const __m128i *)(src + i * 4));
+        p         = swap_rb ? xw_swap_rb_sse2 (p) : p;
+        _mm_storeu_si128 ((__m128i *)(dst + i * 4), _mm_or_si128 (p, alpha));
+    }
+
+    return i;
+}
+
+TARGET_SSE2 static Size xw_premultiply_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m128i alpha = _mm_set1_epi32 ((Int32)0xff000000);
+    const __m128i zero  = _mm_setzero_si128();
+
+    Size i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i p = _mm_loadu_si128 ((const __m128i *)(src + i * 4));
+
+        /* two pixels in each, as 16 bit r, g, b, a */
+        __m128i lo = _mm_unpacklo_epi8 (p, zero);
+        __m128i hi = _mm_unpackhi_epi8 (p, zero);
+
+        /* broadcast alpha of each pixel to all of it's lanes */
+        __m128i lo_a = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (lo, 0xff), 0xff);
+        __m128i hi_a = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (hi, 0xff), 0xff);
+
+        lo = xw_mul_div255_sse2 (lo, lo_a);
+        hi = xw_mul_div255_sse2 (hi, hi_a);
+
+        p = _mm_packus_epi16 (lo, hi);
+        p = swap_rb ? xw_swap_rb_sse2 (p) : p;
+        _mm_storeu_si128 ((__m128i *)(dst + i * 4), _mm_or_si128 (p, alpha));
+    }
+
+    return i;
+}
+
+TARGET_SSE2 static Size xw_expand_565_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m128i zero = _mm_setzero_si128();
+
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i p  = _mm_loadu_si128 ((const __m128i *)(src + i * 2));
+        __m128i lo = xw_expand_565_x4_sse2 (_mm_unpacklo_epi16 (p, zero), swap_rb);
+        __m128i hi = xw_expand_565_x4_sse2 (_mm_unpackhi_epi16 (p, zero), swap_rb);
+        _mm_storeu_si128 ((__m128i *)(dst + i * 4), lo);
+        _mm_storeu_si128 ((__m128i *)(dst + i * 4 + 16), hi);
+    }
+
+    return i;
+}
+
+TARGET_SSE2 static Size
+    xw_float_to_unorm_sse2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m128i alpha = _mm_set1_epi32 ((Int32)0xff000000);
+
+    Size i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const Uint8 *s  = src + i * 16;
+        __m128i      p0 = xw_float_to_unorm_x1_sse2 (s);
+        __m128i      p1 = xw_float_to_unorm_x1_sse2 (s + 16);
+        __m128i      p2 = xw_float_to_unorm_x1_sse2 (s + 32);
+        __m128i      p3 = xw_float_to_unorm_x1_sse2 (s + 48);
+
+        __m128i p = _mm_packus_epi16 (_mm_packs_epi32 (p0, p1), _mm_packs_epi32 (p2, p3));
+        p         = swap_rb ? xw_swap_rb_sse2 (p) : p;
+        _mm_storeu_si128 ((__m128i *)(dst + i * 4), _mm_or_si128 (p, alpha));
+    }
+
+    return i;
+}
+
+/* Same as SSE2 versions, with twice the width. Unpack and pack instructions work within
+ * 128 bit lanes, so pixel order is preserved everywhere except in float to unorm. */
+
+TARGET_AVX2 static inline __m256i xw_swap_rb_avx2 (__m256i p) {
+    const __m256i low   = _mm256_set1_epi32 (0xff);
+    const __m256i green = _mm256_set1_epi32 (0xff00);
+    return _mm256_or_si256 (
+        _mm256_and_si256 (p, green),
+        _mm256_or_si256 (
+            _mm256_and_si256 (_mm256_srli_epi32 (p, 16), low),
+            _mm256_slli_epi32 (_mm256_and_si256 (p, low), 16)
+        )
+    );
+}
+
+TARGET_AVX2 static inline __m256i xw_mul_div255_avx2 (__m256i c, __m256i a) {
+    __m256i t = _mm256_add_epi16 (_mm256_mullo_epi16 (c, a), _mm256_set1_epi16 (128));
+    return _mm256_srli_epi16 (_mm256_add_epi16 (t, _mm256_srli_epi16 (t, 8)), 8);
+}
+
+TARGET_AVX2 static inline __m256i xw_expand_565_x8_avx2 (__m256i p, Bool swap_rb) {
+    __m256i r = _mm256_srli_epi32 (p, 11);
+    __m256i g = _mm256_and_si256 (_mm256_srli_epi32 (p, 5), _mm256_set1_epi32 (0x3f));
+    __m256i b = _mm256_and_si256 (p, _mm256_set1_epi32 (0x1f));
+
+    r = _mm256_or_si256 (_mm256_slli_epi32 (r, 3), _mm256_srli_epi32 (r, 2));
+    g = _mm256_or_si256 (_mm256_slli_epi32 (g, 2), _mm256_srli_epi32 (g, 4));
+    b = _mm256_or_si256 (_mm256_slli_epi32 (b, 3), _mm256_srli_epi32 (b, 2));
+
+    __m256i lo = swap_rb ? b : r;
+    __m256i hi = swap_rb ? r : b;
+    return _mm256_or_si256 (
+        _mm256_or_si256 (lo, _mm256_slli_epi32 (g, 8)),
+        _mm256_or_si256 (_mm256_slli_epi32 (hi, 16), _mm256_set1_epi32 ((Int32)0xff000000))
+    );
+}
+
+/* two RGBA32F pixels to eight 32 bit unorm lanes */
+TARGET_AVX2 static inline __m256i xw_float_to_unorm_x2_avx2 (const Uint8 *src) {
+    __m256 f = _mm256_loadu_ps ((const Float32 *)src);
+    f        = _mm256_min_ps (_mm256_max_ps (f, _mm256_setzero_ps()), _mm256_set1_ps (1.f));
+    return _mm256_cvttps_epi32 (
+        _mm256_add_ps (_mm256_mul_ps (f, _mm256_set1_ps (255.f)), _mm256_set1_ps (0.5f))
+    );
+}
+
+TARGET_AVX2 static Size xw_swizzle_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m256i alpha = _mm256_set1_epi32 ((Int32)0xff000000);
+
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = _mm256_loadu_si256 ((const __m256i *)(src + i * 4));
+        p         = swap_rb ? xw_swap_rb_avx2 (p) : p;
+        _mm256_storeu_si256 ((__m256i *)(dst + i * 4), _mm256_or_si256 (p, alpha));
+    }
+
+    return i;
+}
+
+TARGET_AVX2 static Size xw_premultiply_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m256i alpha = _mm256_set1_epi32 ((Int32)0xff000000);
+    const __m256i zero  = _mm256_setzero_si256();
+
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = _mm256_loadu_si256 ((const __m256i *)(src + i * 4));
+
+        __m256i lo = _mm256_unpacklo_epi8 (p, zero);
+        __m256i hi = _mm256_unpackhi_epi8 (p, zero);
+
+        __m256i lo_a = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (lo, 0xff), 0xff);
+        __m256i hi_a = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (hi, 0xff), 0xff);
+
+        lo = xw_mul_div255_avx2 (lo, lo_a);
+        hi = xw_mul_div255_avx2 (hi, hi_a);
+
+        p = _mm256_packus_epi16 (lo, hi);
+        p = swap_rb ? xw_swap_rb_avx2 (p) : p;
+        _mm256_storeu_si256 ((__m256i *)(dst + i * 4), _mm256_or_si256 (p, alpha));
+    }
+
+    return i;
+}
+
+TARGET_AVX2 static Size xw_expand_565_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    Size i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i p  = _mm256_loadu_si256 ((const __m256i *)(src + i * 2));
+        __m256i lo = _mm256_cvtepu16_epi32 (_mm256_castsi256_si128 (p));
+        __m256i hi = _mm256_cvtepu16_epi32 (_mm256_extracti128_si256 (p, 1));
+        _mm256_storeu_si256 ((__m256i *)(dst + i * 4), xw_expand_565_x8_avx2 (lo, swap_rb));
+        _mm256_storeu_si256 ((__m256i *)(dst + i * 4 + 32), xw_expand_565_x8_avx2 (hi, swap_rb));
+    }
+
+    return i;
+}
+
+TARGET_AVX2 static Size
+    xw_float_to_unorm_avx2 (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    const __m256i alpha = _mm256_set1_epi32 ((Int32)0xff000000);
+
+    /* packing leaves pixels in order 0, 2, 4, 6, 1, 3, 5, 7 */
+    const __m256i order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const Uint8 *s   = src + i * 16;
+        __m256i      p01 = xw_float_to_unorm_x2_avx2 (s);
+        __m256i      p23 = xw_float_to_unorm_x2_avx2 (s + 32);
+        __m256i      p45 = xw_float_to_unorm_x2_avx2 (s + 64);
+        __m256i      p67 = xw_float_to_unorm_x2_avx2 (s + 96);
+
+        __m256i p = _mm256_packus_epi16 (
+            _mm256_packs_epi32 (p01, p23),
+            _mm256_packs_epi32 (p45, p67)
+        );
+        p = _mm256_permutevar8x32_epi32 (p, order);
+        p = swap_rb ? xw_swap_rb_avx2 (p) : p;
+        _mm256_storeu_si256 ((__m256i *)(dst + i * 4), _mm256_or_si256 (p, alpha));
+    }
+
+    return i;
+}
+
+#endif // XW_HAS_X86_KERNELS
+
+/****************************************** NEON *******************************************/
+
+#if XW_HAS_NEON_KERNELS
+
+/* round(c * a / 255) for eight 8 bit lanes */
+static inline uint8x8_t xw_mul_div255_neon (uint8x8_t c, uint8x8_t a) {
+    uint16x8_t t = vmull_u8 (c, a);
+    return vraddhn_u16 (t, vrshrq_n_u16 (t, 8));
+}
+
+static inline uint8x8_t xw_float_to_unorm_x8_neon (float32x4_t lo, float32x4_t hi) {
+    const float32x4_t zero  = vdupq_n_f32 (0.f);
+    const float32x4_t one   = vdupq_n_f32 (1.f);
+    const float32x4_t scale = vdupq_n_f32 (255.f);
+    const float32x4_t half  = vdupq_n_f32 (0.5f);
+
+    /* vmaxnm returns the number when other operand is NaN */
+    lo = vminq_f32 (vmaxnmq_f32 (lo, zero), one);
+    hi = vminq_f32 (vmaxnmq_f32 (hi, zero), one);
+
+    uint32x4_t ulo = vcvtq_u32_f32 (vaddq_f32 (vmulq_f32 (lo, scale), half));
+    uint32x4_t uhi = vcvtq_u32_f32 (vaddq_f32 (vmulq_f32 (hi, scale), half));
+    return vmovn_u16 (vcombine_u16 (vmovn_u32 (ulo), vmovn_u32 (uhi)));
+}
+
+static Size xw_swizzle_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    Size i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16x4_t p = vld4q_u8 (src + i * 4);
+        if (swap_rb) {
+            uint8x16_t r = p.val[0];
+            p.val[0]     = p.val[2];
+            p.val[2]     = r;
+        }
+        p.val[3] = vdupq_n_u8 (0xff);
+        vst4q_u8 (dst + i * 4, p);
+    }
+
+    return i;
+}
+
+static Size xw_premultiply_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x8x4_t p = vld4_u8 (src + i * 4);
+
+        uint8x8_t r = xw_mul_div255_neon (p.val[0], p.val[3]);
+        uint8x8_t g = xw_mul_div255_neon (p.val[1], p.val[3]);
+        uint8x8_t b = xw_mul_div255_neon (p.val[2], p.val[3]);
+
+        p.val[0] = swap_rb ? b : r;
+        p.val[1] = g;
+        p.val[2] = swap_rb ? r : b;
+        p.val[3] = vdup_n_u8 (0xff);
+        vst4_u8 (dst + i * 4, p);
+    }
+
+    return i;
+}
+
+static Size xw_expand_565_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t p = vreinterpretq_u16_u8 (vld1q_u8 (src + i * 2));
+
+        uint16x8_t r = vshrq_n_u16 (p, 11);
+        uint16x8_t g = vandq_u16 (vshrq_n_u16 (p, 5), vdupq_n_u16 (0x3f));
+        uint16x8_t b = vandq_u16 (p, vdupq_n_u16 (0x1f));
+
+        uint8x8_t r8 = vmovn_u16 (vorrq_u16 (vshlq_n_u16 (r, 3), vshrq_n_u16 (r, 2)));
+        uint8x8_t g8 = vmovn_u16 (vorrq_u16 (vshlq_n_u16 (g, 2), vshrq_n_u16 (g, 4)));
+        uint8x8_t b8 = vmovn_u16 (vorrq_u16 (vshlq_n_u16 (b, 3), vshrq_n_u16 (b, 2)));
+
+        uint8x8x4_t out = {
+            {swap_rb ? b8 : r8, g8, swap_rb ? r8 : b8, vdup_n_u8 (0xff)}
+        };
+        vst4_u8 (dst + i * 4, out);
+    }
+
+    return i;
+}
+
+static Size xw_float_to_unorm_neon (Uint8 *dst, const Uint8 *src, Size n, Bool swap_rb) {
+    Size i = 0;
+    for (; i + 8 <= n; i += 8) {
+        float32x4x4_t lo = vld4q_f32 ((const Float32 *)(src + i * 16));
+        float32x4x4_t hi = vld4q_f32 ((const Float32 *)(src + i * 16 + 64));
+
+        uint8x8_t r = xw_float_to_unorm_x8_neon (lo.val[0], hi.val[0]);
+        uint8x8_t g = xw_float_to_unorm_x8_neon (lo.val[1], hi.val[1]);
+        uint8x8_t b = xw_float_to_unorm_x8_neon (lo.val[2], hi.val[2]);
+
+        uint8x8x4_t out = {
+            {swap_rb ? b : r, g, swap_rb ? r : b, vdup_n_u8 (0xff)}
+        };
+        vst4_u8 (dst + i * 4, out);
+    }
+
+    return i;
+}
+
+#endif // XW_HAS_NEON_KERNELS
@@ -34,10 +34,14 @@
 #include <Anvie/Common.h>
 #include <Anvie/CrossWindow/Event.h>
 
+/* local headers */
+#include "Allocator.h"
+#include "Event.h"
+#include "Log.h"
+
 /* headers from libc */
 #include <string.h>
 
-static XwEvent       *xw_event_init (XwEvent *e, XwEventType type, XwWindow *win);
 static inline CString xw_key_to_cstr (XwKey key);
 
 /**
@@ -78,12 +82,7 @@ CString xw_key_cstr (XwKey key, Bool caps_case) {
 XwEvent *xw_event_state_change (XwEvent *e, XwWindowState new_state, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_STATE_CHANGE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->state_change.new_state = new_state;
-
-    return e;
+    return xw_event_make_state_change (e, new_state, win);
 }
 
 /**
@@ -98,10 +97,7 @@ XwEvent *xw_event_state_change (XwEvent *e, XwWindowState new_state, XwWindow *w
 XwEvent *xw_event_close_window (XwEvent *e, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_CLOSE_WINDOW, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    return e;
+    return xw_event_make_close_window (e, win);
 }
 
 /**
@@ -117,12 +113,7 @@ XwEvent *xw_event_close_window (XwEvent *e, XwWindow *win) {
 XwEvent *xw_event_visibility (XwEvent *e, Bool visible, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_VISIBILITY, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->visibility.visible = visible;
-
-    return e;
+    return xw_event_make_visibility (e, visible, win);
 }
 
 /** 
@@ -139,13 +130,7 @@ XwEvent *xw_event_visibility (XwEvent *e, Bool visible, XwWindow *win) {
 XwEvent *xw_event_enter (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_ENTER, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->enter.x = x;
-    e->enter.y = y;
-
-    return e;
+    return xw_event_make_enter (e, x, y, win);
 }
 
 /** 
@@ -162,13 +147,7 @@ XwEvent *xw_event_enter (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
 XwEvent *xw_event_leave (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_LEAVE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->leave.x = x;
-    e->leave.y = y;
-
-    return e;
+    return xw_event_make_leave (e, x, y, win);
 }
 
 /** 
@@ -184,12 +163,7 @@ XwEvent *xw_event_leave (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
 XwEvent *xw_event_focus (XwEvent *e, Bool focused, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_FOCUS, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->focus.focused = focused;
-
-    return e;
+    return xw_event_make_focus (e, focused, win);
 }
 
 /** 
@@ -205,10 +179,7 @@ XwEvent *xw_event_focus (XwEvent *e, Bool focused, XwWindow *win) {
 XwEvent *xw_event_paint (XwEvent *e, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_PAINT, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    return e;
+    return xw_event_make_paint (e, win);
 }
 
 /** 
@@ -225,13 +196,7 @@ XwEvent *xw_event_paint (XwEvent *e, XwWindow *win) {
 XwEvent *xw_event_reposition (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_REPOSITION, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->reposition.x = x;
-    e->reposition.y = y;
-
-    return e;
+    return xw_event_make_reposition (e, x, y, win);
 }
 
 /** 
@@ -247,12 +212,7 @@ XwEvent *xw_event_reposition (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
 XwEvent *xw_event_border_width_change (XwEvent *e, Uint32 border_width, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_BORDER_WIDTH_CHANGE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->border_width_change.border_width = border_width;
-
-    return e;
+    return xw_event_make_border_width_change (e, border_width, win);
 }
 
 /** 
@@ -268,12 +228,7 @@ XwEvent *xw_event_border_width_change (XwEvent *e, Uint32 border_width, XwWindow
 XwEvent *xw_event_restack (XwEvent *e, XwWindow *above_window, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_RESTACK, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->restack.above = above_window;
-
-    return e;
+    return xw_event_make_restack (e, above_window, win);
 }
 
 /** 
@@ -290,13 +245,7 @@ XwEvent *xw_event_restack (XwEvent *e, XwWindow *above_window, XwWindow *win) {
 XwEvent *xw_event_resize (XwEvent *e, Uint32 width, Uint32 height, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_RESIZE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->resize.width  = width;
-    e->resize.height = height;
-
-    return e;
+    return xw_event_make_resize (e, width, height, win);
 }
 
 /** 
@@ -312,12 +261,7 @@ XwEvent *xw_event_resize (XwEvent *e, Uint32 width, Uint32 height, XwWindow *win
 XwEvent *xw_event_dpi_change (XwEvent *e, Float32 scale, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_DPI_CHANGE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->dpi_change.scale = scale;
-
-    return e;
+    return xw_event_make_dpi_change (e, scale, win);
 }
 
 /** 
@@ -341,14 +285,7 @@ XwEvent *xw_event_keyboard_input (
 ) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_KEYBOARD_INPUT, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->keyboard_input.key   = key;
-    e->keyboard_input.state = state;
-    e->keyboard_input.mod   = mod;
-
-    return e;
+    return xw_event_make_keyboard_input (e, key, state, mod, win);
 }
 
 /** 
@@ -369,15 +306,7 @@ XwEvent *xw_event_keyboard_input (
 XwEvent *xw_event_mouse_move (XwEvent *e, Uint32 x, Uint32 y, Int32 dx, Int32 dy, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_MOUSE_MOVE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->mouse_move.x  = x;
-    e->mouse_move.y  = y;
-    e->mouse_move.dx = dx;
-    e->mouse_move.dy = dy;
-
-    return e;
+    return xw_event_make_mouse_move (e, x, y, dx, dy, win);
 }
 
 /** 
@@ -402,15 +331,7 @@ XwEvent *xw_event_mouse_input (
 ) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_MOUSE_INPUT, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->mouse_input.button_state = state;
-    e->mouse_input.x            = posx;
-    e->mouse_input.y            = posy;
-    e->mouse_input.mod          = mod;
-
-    return e;
+    return xw_event_make_mouse_input (e, state, posx, posy, mod, win);
 }
 
 /** 
@@ -434,15 +355,7 @@ XwEvent *xw_event_mouse_wheel (
 ) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_MOUSE_WHEEL, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    e->mouse_wheel.x         = x;
-    e->mouse_wheel.y         = y;
-    e->mouse_wheel.direction = direction;
-    e->mouse_wheel.mod       = mod;
-
-    return e;
+    return xw_event_make_mouse_wheel (e, x, y, direction, mod, win);
 }
 
 /** 
@@ -459,8 +372,7 @@ XwEvent *xw_event_mouse_wheel (
 XwEvent *xw_event_touch (XwEvent *e, Size touch_count, XwTouchPoint *points, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_TOUCH, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
+    xw_event_make (e, XW_EVENT_TYPE_TOUCH, win);
 
     RETURN_VALUE_IF (
         touch_count > XW_TOUCH_COUNT_MAX,
@@ -501,8 +413,7 @@ XwEvent *xw_event_gamepad (
 ) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_GAMEPAD, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
+    xw_event_make (e, XW_EVENT_TYPE_GAMEPAD, win);
 
     RETURN_VALUE_IF (
         axes_count > XW_GAMEPAD_AXES_COUNT_MAX,
@@ -555,10 +466,7 @@ XwEvent *xw_event_gamepad (
 XwEvent *xw_event_drop_file (XwEvent *e, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_DROP_FILE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    return e;
+    return xw_event_make_drop_file (e, win);
 }
 
 /** 
@@ -573,142 +481,144 @@ XwEvent *xw_event_drop_file (XwEvent *e, XwWindow *win) {
 XwEvent *xw_event_hover_file (XwEvent *e, XwWindow *win) {
     RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    e = xw_event_init (e, XW_EVENT_TYPE_HOVER_FILE, win);
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_OBJECT_REF);
-
-    return e;
+    return xw_event_make_hover_file (e, win);
 }
 
-/************************************* XwEventQueue ***************************************/
-
-#if 0
-
-typedef struct XwEventQueue {
-    Size      count;
-    Size      capacity;
-    XwEvent **events;
-} XwEventQueue;
-
-/**
- * @b Create a new XwEventQueue object.
+/** 
+ * @b Create a new event of type @c XW_EVENT_TYPE_ERROR
  *
- * @return XwEventQueue* on success.
- * @return Null otherwise.
+ * Unlike other events, window is allowed to be @c Null here, because it's not always
+ * possible to know which window a failed request was made for.
+ *
+ * @param e Event
+ * @param error_code Platform dependent error code.
+ * @param major_opcode Major opcode of failed request.
+ * @param minor_opcode Minor opcode of failed request.
+ * @param sequence Sequence number of failed request.
+ * @param resource_id Bad resource id or value.
+ * @param win Window (can be @c Null).
+ *
+ * @return XwEvent* on successs,
+ * @return Null otherwise
  * */
-XwEventQueue *xw_event_queue_create (void) {
-    XwEventQueue *eq = NEW (XwEventQueue);
-    RETURN_VALUE_IF (!eq, Null, ERR_OUT_OF_MEMORY);
-
-    eq->capacity = 32;
-    eq->events   = ALLOCATE (XwEvent *, eq->capacity);
-    GOTO_HANDLER_IF (!eq->events, ALLOC_FAILED, ERR_OUT_OF_MEMORY);
-
-    return eq;
+XwEvent *xw_event_error (
+    XwEvent  *e,
+    Uint8     error_code,
+    Uint8     major_opcode,
+    Uint16    minor_opcode,
+    Uint32    sequence,
+    Uint32    resource_id,
+    XwWindow *win
+) {
+    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
 
-ALLOC_FAILED: {
-    FREE (eq);
-    return Null;
-}
+    return xw_event_make_error (
+        e,
+        error_code,
+        major_opcode,
+        minor_opcode,
+        sequence,
+        resource_id,
+        win
+    );
 }
 
-/* Definition of xw_event_queue_update is platform dependent. */
-
-/** 
- * @b Get reference to front element of queue.
+/**
+ * @b Create a frame complete event.
  *
- * @param eq 
+ * @param e
+ * @param serial Serial of presented frame.
+ * @param msc Media stream counter at which frame was shown.
+ * @param ust Time in microseconds at which frame was shown.
+ * @param mode How the frame was shown.
+ * @param win
  *
- * @return XwEvent* on success.
- * @return Null otherwise.
+ * @return XwEvent* on successs,
+ * @return Null otherwise
  * */
-const XwEvent *xw_event_queue_front (const XwEventQueue *eq) {
-    RETURN_VALUE_IF (!eq, Null, ERR_INVALID_ARGUMENTS);
+XwEvent *xw_event_frame_complete (
+    XwEvent      *e,
+    Uint32        serial,
+    Uint64        msc,
+    Uint64        ust,
+    XwPresentMode mode,
+    XwWindow     *win
+) {
+    RETURN_VALUE_IF (!e || !win || mode >= XW_PRESENT_MODE_MAX, Null, ERR_INVALID_ARGUMENTS);
 
-    return eq->events[0];
+    return xw_event_make_frame_complete (e, serial, msc, ust, mode, win);
 }
 
-/** 
- * @b Pop an event from the front of queue.
- *
- * Popping results in permanent removal of event from queue.
+/**
+ * @b Create a frame idle event.
  *
- * @param eq 
+ * @param e
+ * @param serial Serial of frame the pixmap was presented with.
+ * @param pixmap Platform pixmap handle that is now idle.
+ * @param win
  *
- * @return XwEvent* on success.
- * @return Null otherwise.
+ * @return XwEvent* on successs,
+ * @return Null otherwise
  * */
-XwEvent *xw_event_queue_pop (XwEventQueue *eq) {
-    RETURN_VALUE_IF (!eq, Null, ERR_INVALID_ARGUMENTS);
+XwEvent *xw_event_frame_idle (XwEvent *e, Uint32 serial, Uint32 pixmap, XwWindow *win) {
+    RETURN_VALUE_IF (!e || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    XwEvent *popped = eq->events[0];
-    for (Size s = 0; s < eq->count - 1; s++) {
-        eq->events[s] = eq->events[s + 1];
-    }
-    eq->events[eq->count--] = Null;
-    return popped;
+    return xw_event_make_frame_idle (e, serial, pixmap, win);
 }
 
-/** 
- * @b Push an event into the event queue. 
+/**
+ * @b Create a keymap change event.
  *
- * Ownership of @c XwEvent object is transferred to provided @c XwEventQueue 
- * on success. This means, given @c XwEventQueue would store the same pointer
- * as provided without making another copy of it, and will free it when the
- * queue is being destroyed!
+ * Keymap is shared by all windows, so event has no window.
  *
- * @param eq 
+ * @param e
  *
- * @return XwEvent* on success.
- * @return Null otherwise.
+ * @return XwEvent* on successs,
+ * @return Null otherwise
  * */
-const XwEvent *xw_event_queue_push (XwEventQueue *eq, XwEvent *event) {
-    RETURN_VALUE_IF (!eq && event, Null, ERR_INVALID_ARGUMENTS);
-
-    for (Size s = eq->count - 1; s; s--) {
-        eq->events[s + 1] = eq->events[s];
-    }
-    eq->events[0] = event;
-    eq->count++;
+XwEvent *xw_event_keymap_change (XwEvent *e) {
+    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
 
-    return event;
+    return xw_event_make_keymap_change (e);
 }
 
-/** 
- * @b Check if given event queue is empty or not.
+/**
+ * @b Create a user event, to be posted using @c xw_event_post.
  *
- * @param eq
+ * @param e
+ * @param code Meaning is up to application.
+ * @param data Meaning is up to application.
+ * @param win Window event is meant for. Can be Null.
  *
- * @return True if empty or if @c eq is @c Null
- * @return False otherwise.
+ * @return XwEvent* on successs,
+ * @return Null otherwise
  * */
-Bool xw_event_queue_is_empty (const XwEventQueue *eq) {
-    RETURN_VALUE_IF (!eq, True, ERR_INVALID_ARGUMENTS);
+XwEvent *xw_event_user (XwEvent *e, Uint32 code, void *data, XwWindow *win) {
+    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
 
-    return !eq->count;
+    return xw_event_make_user (e, code, data, win);
 }
 
-#endif
-
-/******************************************* PRIVATE METHODS *****************************************/
-
 /**
- * @b Set type and window to given @c XwEvent object.
+ * @b Create a timer event. Timer events are generated by CrossWindow when a timer expires,
+ *    this is mostly useful to simulate them.
  *
- * @param type 
- * @param win Window
+ * @param e
+ * @param timer Timer that expired.
+ * @param user Value timer was created with.
+ * @param expirations Times timer expired since it's last event.
  *
- * @return XwEvent on success,
- * @return Null on failure.
+ * @return XwEvent* on successs,
+ * @return Null otherwise
  * */
-static XwEvent *xw_event_init (XwEvent *e, XwEventType type, XwWindow *win) {
-    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
-
-    e->type   = type;
-    e->window = win;
+XwEvent *xw_event_timer (XwEvent *e, XwTimer *timer, void *user, Uint64 expirations) {
+    RETURN_VALUE_IF (!e || !timer || !expirations, Null, ERR_INVALID_ARGUMENTS);
 
-    return e;
+    return xw_event_make_timer (e, timer, user, expirations);
 }
 
+/******************************************* PRIVATE METHODS *****************************************/
+
 static CString xwkey_to_cstr_map[XWK_MAX] = {
     [XWK_UNKNOWN] = "UNKNOWN",
 
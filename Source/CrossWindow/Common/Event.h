@@ -0,0 +1,250 @@
+/**
+ * @file Event.h
+ * @time 18/10/2026 13:02:37
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_EVENT_H
+#define ANVIE_CROSSWINDOW_COMMON_EVENT_H
+
+#include <Anvie/CrossWindow/Event.h>
+
+/* Event constructors used by platform code while converting events. These are the same as
+ * public xw_event_* constructors, minus argument validation, which platform code never needs.
+ * Being inline, converting an event does not cost a call into another library per event.
+ * Window can be Null only for error, keymap change, user and timer events. */
+
+static inline XwEvent *xw_event_make (XwEvent *e, XwEventType type, XwWindow *win) {
+    e->type   = type;
+    e->window = win;
+    return e;
+}
+
+static inline XwEvent *
+    xw_event_make_state_change (XwEvent *e, XwWindowState new_state, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_STATE_CHANGE, win);
+    e->state_change.new_state = new_state;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_close_window (XwEvent *e, XwWindow *win) {
+    return xw_event_make (e, XW_EVENT_TYPE_CLOSE_WINDOW, win);
+}
+
+static inline XwEvent *xw_event_make_visibility (XwEvent *e, Bool visible, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_VISIBILITY, win);
+    e->visibility.visible = visible;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_enter (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_ENTER, win);
+    e->enter.x = x;
+    e->enter.y = y;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_leave (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_LEAVE, win);
+    e->leave.x = x;
+    e->leave.y = y;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_focus (XwEvent *e, Bool focused, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_FOCUS, win);
+    e->focus.focused = focused;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_paint (XwEvent *e, XwWindow *win) {
+    return xw_event_make (e, XW_EVENT_TYPE_PAINT, win);
+}
+
+static inline XwEvent *xw_event_make_reposition (XwEvent *e, Uint32 x, Uint32 y, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_REPOSITION, win);
+    e->reposition.x = x;
+    e->reposition.y = y;
+    return e;
+}
+
+static inline XwEvent *
+    xw_event_make_border_width_change (XwEvent *e, Uint32 border_width, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_BORDER_WIDTH_CHANGE, win);
+    e->border_width_change.border_width = border_width;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_restack (XwEvent *e, XwWindow *above_window, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_RESTACK, win);
+    e->restack.above = above_window;
+    return e;
+}
+
+static inline XwEvent *
+    xw_event_make_resize (XwEvent *e, Uint32 width, Uint32 height, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_RESIZE, win);
+    e->resize.width  = width;
+    e->resize.height = height;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_dpi_change (XwEvent *e, Float32 scale, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_DPI_CHANGE, win);
+    e->dpi_change.scale = scale;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_keyboard_input (
+    XwEvent        *e,
+    XwKey           key,
+    XwButtonState   state,
+    XwModifierState mod,
+    XwWindow       *win
+) {
+    xw_event_make (e, XW_EVENT_TYPE_KEYBOARD_INPUT, win);
+    e->keyboard_input.key   = key;
+    e->keyboard_input.state = state;
+    e->keyboard_input.mod   = mod;
+    return e;
+}
+
+static inline XwEvent *
+    xw_event_make_mouse_move (XwEvent *e, Uint32 x, Uint32 y, Int32 dx, Int32 dy, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_MOUSE_MOVE, win);
+    e->mouse_move.x  = x;
+    e->mouse_move.y  = y;
+    e->mouse_move.dx = dx;
+    e->mouse_move.dy = dy;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_mouse_input (
+    XwEvent           *e,
+    XwMouseButtonState state,
+    Uint32             posx,
+    Uint32             posy,
+    XwModifierState    mod,
+    XwWindow          *win
+) {
+    xw_event_make (e, XW_EVENT_TYPE_MOUSE_INPUT, win);
+    e->mouse_input.button_state = state;
+    e->mouse_input.x            = posx;
+    e->mouse_input.y            = posy;
+    e->mouse_input.mod          = mod;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_mouse_wheel (
+    XwEvent        *e,
+    Uint32          x,
+    Uint32          y,
+    Bool            direction,
+    XwModifierState mod,
+    XwWindow       *win
+) {
+    xw_event_make (e, XW_EVENT_TYPE_MOUSE_WHEEL, win);
+    e->mouse_wheel.x         = x;
+    e->mouse_wheel.y         = y;
+    e->mouse_wheel.direction = direction;
+    e->mouse_wheel.mod       = mod;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_drop_file (XwEvent *e, XwWindow *win) {
+    return xw_event_make (e, XW_EVENT_TYPE_DROP_FILE, win);
+}
+
+static inline XwEvent *xw_event_make_hover_file (XwEvent *e, XwWindow *win) {
+    return xw_event_make (e, XW_EVENT_TYPE_HOVER_FILE, win);
+}
+
+static inline XwEvent *xw_event_make_error (
+    XwEvent  *e,
+    Uint8     error_code,
+    Uint8     major_opcode,
+    Uint16    minor_opcode,
+    Uint32    sequence,
+    Uint32    resource_id,
+    XwWindow *win
+) {
+    xw_event_make (e, XW_EVENT_TYPE_ERROR, win);
+    e->error.error_code   = error_code;
+    e->error.major_opcode = major_opcode;
+    e->error.minor_opcode = minor_opcode;
+    e->error.sequence     = sequence;
+    e->error.resource_id  = resource_id;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_frame_complete (
+    XwEvent      *e,
+    Uint32        serial,
+    Uint64        msc,
+    Uint64        ust,
+    XwPresentMode mode,
+    XwWindow     *win
+) {
+    xw_event_make (e, XW_EVENT_TYPE_FRAME_COMPLETE, win);
+    e->frame_complete.serial = serial;
+    e->frame_complete.msc    = msc;
+    e->frame_complete.ust    = ust;
+    e->frame_complete.mode   = mode;
+    return e;
+}
+
+static inline XwEvent *
+    xw_event_make_frame_idle (XwEvent *e, Uint32 serial, Uint32 pixmap, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_FRAME_IDLE, win);
+    e->frame_idle.serial = serial;
+    e->frame_idle.pixmap = pixmap;
+    return e;
+}
+
+static inline XwEvent *xw_event_make_keymap_change (XwEvent *e) {
+    return xw_event_make (e, XW_EVENT_TYPE_KEYMAP_CHANGE, Null);
+}
+
+static inline XwEvent *xw_event_make_user (XwEvent *e, Uint32 code, void *data, XwWindow *win) {
+    xw_event_make (e, XW_EVENT_TYPE_USER, win);
+    e->user.code = code;
+    e->user.data = data;
+    return e;
+}
+
+static inline XwEvent *
+    xw_event_make_timer (XwEvent *e, XwTimer *timer, void *user, Uint64 expirations) {
+    xw_event_make (e, XW_EVENT_TYPE_TIMER, Null);
+    e->timer.timer       = timer;
+    e->timer.user        = user;
+    e->timer.expirations = expirations;
+    return e;
+}
+
+#endif // ANVIE_CROSSWINDOW_COMMON_EVENT_H
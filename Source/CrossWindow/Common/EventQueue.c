@@ -0,0 +1,281 @@
+/**
+ * @file EventQueue.c
+ * @time 18/10/2026 13:12:41
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* local headers */
+#include "Allocator.h"
+#include "EventQueue.h"
+#include "Log.h"
+
+static Size xw_round_up_pow2 (Size value);
+
+/**
+ * @b Create an empty event queue.
+ *
+ * @param capacity Most events queue can hold. Rounded up to a power of two.
+ *
+ * @return @c XwEventQueue* on success.
+ * @return @c Null otherwise.
+ * */
+XwEventQueue *xw_event_queue_create (Size capacity) {
+    RETURN_VALUE_IF (!capacity || capacity > (SIZE_MAX >> 1), Null, ERR_INVALID_ARGUMENTS);
+
+    Size rounded = xw_round_up_pow2 (capacity);
+
+    XwEventQueue *self = XW_NEW (XW_ALLOC_CATEGORY_QUEUE, XwEventQueue);
+    RETURN_VALUE_IF (!self, Null, ERR_OUT_OF_MEMORY);
+
+    self->events = XW_ALLOCATE (XW_ALLOC_CATEGORY_QUEUE, XwEvent, rounded);
+    GOTO_HANDLER_IF (!self->events, EVENTS_ALLOC_FAILED, ERR_OUT_OF_MEMORY);
+    self->capacity = rounded;
+
+    return self;
+
+EVENTS_ALLOC_FAILED:
+    XW_FREE (XW_ALLOC_CATEGORY_QUEUE, self);
+    return Null;
+}
+
+/**
+ * @b Destroy event queue along with all events still in it.
+ *
+ * Neither producer nor consumer must be using it anymore.
+ *
+ * @param self
+ * */
+void xw_event_queue_destroy (XwEventQueue *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    XW_FREE (XW_ALLOC_CATEGORY_QUEUE, self->events);
+    XW_FREE (XW_ALLOC_CATEGORY_QUEUE, self);
+}
+
+/**
+ * @b Add a copy of event at end of queue. Called only by producer.
+ *
+ * @param self
+ * @param event
+ *
+ * @return True on success.
+ * @return False if queue is full. Event is dropped in this case.
+ * */
+Bool xw_event_queue_push (XwEventQueue *self, const XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, False, ERR_INVALID_ARGUMENTS);
+
+    Size tail = __atomic_load_n (&self->tail, __ATOMIC_RELAXED);
+    Size head = __atomic_load_n (&self->head, __ATOMIC_ACQUIRE);
+
+    if (tail - head == self->capacity) {
+        __atomic_fetch_add (&self->dropped, 1, __ATOMIC_RELAXED);
+        return False;
+    }
+
+    self->events[tail & (self->capacity - 1)] = *event;
+    __atomic_store_n (&self->tail, tail + 1, __ATOMIC_RELEASE);
+
+    return True;
+}
+
+/**
+ * @b Remove oldest event from queue. Called only by consumer.
+ *
+ * @param self
+ * @param event Where removed event is stored.
+ *
+ * @return True if an event was removed.
+ * @return False if queue is empty.
+ * */
+Bool xw_event_queue_pop (XwEventQueue *self, XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, False, ERR_INVALID_ARGUMENTS);
+
+    Size head = __atomic_load_n (&self->head, __ATOMIC_RELAXED);
+    Size tail = __atomic_load_n (&self->tail, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return False;
+    }
+
+    *event = self->events[head & (self->capacity - 1)];
+    __atomic_store_n (&self->head, head + 1, __ATOMIC_RELEASE);
+
+    return True;
+}
+
+/**
+ * @b Create an empty shared event queue.
+ *
+ * @param capacity Most events queue can hold. Rounded up to a power of two.
+ *
+ * @return @c XwSharedEventQueue* on success.
+ * @return @c Null otherwise.
+ * */
+XwSharedEventQueue *xw_shared_event_queue_create (Size capacity) {
+    RETURN_VALUE_IF (!capacity || capacity > (SIZE_MAX >> 1), Null, ERR_INVALID_ARGUMENTS);
+
+    Size rounded = xw_round_up_pow2 (capacity);
+
+    XwSharedEventQueue *self = XW_NEW (XW_ALLOC_CATEGORY_QUEUE, XwSharedEventQueue);
+    RETURN_VALUE_IF (!self, Null, ERR_OUT_OF_MEMORY);
+
+    self->slots = XW_ALLOCATE (XW_ALLOC_CATEGORY_QUEUE, XwSharedEventSlot, rounded);
+    GOTO_HANDLER_IF (!self->slots, SLOTS_ALLOC_FAILED, ERR_OUT_OF_MEMORY);
+    self->capacity = rounded;
+
+    /* slot n is free to be pushed to when tail is n */
+    for (Size s = 0; s < rounded; s++) {
+        self->slots[s].sequence = s;
+    }
+
+    return self;
+
+SLOTS_ALLOC_FAILED:
+    XW_FREE (XW_ALLOC_CATEGORY_QUEUE, self);
+    return Null;
+}
+
+/**
+ * @b Destroy shared event queue along with all events still in it.
+ *
+ * No thread must be using it anymore.
+ *
+ * @param self
+ * */
+void xw_shared_event_queue_destroy (XwSharedEventQueue *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    XW_FREE (XW_ALLOC_CATEGORY_QUEUE, self->slots);
+    XW_FREE (XW_ALLOC_CATEGORY_QUEUE, self);
+}
+
+/**
+ * @b Add a copy of event at end of queue. Can be called from any thread.
+ *
+ * @param self
+ * @param event
+ *
+ * @return True on success.
+ * @return False if queue is full.
+ * */
+Bool xw_shared_event_queue_push (XwSharedEventQueue *self, const XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, False, ERR_INVALID_ARGUMENTS);
+
+    Size               tail = __atomic_load_n (&self->tail, __ATOMIC_RELAXED);
+    XwSharedEventSlot *slot = Null;
+    while (True) {
+        slot       = &self->slots[tail & (self->capacity - 1)];
+        Int64 diff = (Int64)(__atomic_load_n (&slot->sequence, __ATOMIC_ACQUIRE) - tail);
+
+        if (!diff) {
+            /* slot is free, claim it. On failure tail is updated to latest value. */
+            if (__atomic_compare_exchange_n (
+                    &self->tail,
+                    &tail,
+                    tail + 1,
+                    True,
+                    __ATOMIC_RELAXED,
+                    __ATOMIC_RELAXED
+                )) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* slot still holds an event from last round */
+            return False;
+        } else {
+            /* another producer already claimed this slot */
+            tail = __atomic_load_n (&self->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->event = *event;
+    __atomic_store_n (&slot->sequence, tail + 1, __ATOMIC_RELEASE);
+
+    return True;
+}
+
+/**
+ * @b Remove oldest event from queue. Can be called from any thread.
+ *
+ * @param self
+ * @param event Where removed event is stored.
+ *
+ * @return True if an event was removed.
+ * @return False if queue is empty.
+ * */
+Bool xw_shared_event_queue_pop (XwSharedEventQueue *self, XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, False, ERR_INVALID_ARGUMENTS);
+
+    Size               head = __atomic_load_n (&self->head, __ATOMIC_RELAXED);
+    XwSharedEventSlot *slot = Null;
+    while (True) {
+        slot       = &self->slots[head & (self->capacity - 1)];
+        Int64 diff = (Int64)(__atomic_load_n (&slot->sequence, __ATOMIC_ACQUIRE) - (head + 1));
+
+        if (!diff) {
+            /* event is published, claim it. On failure head is updated to latest value. */
+            if (__atomic_compare_exchange_n (
+                    &self->head,
+                    &head,
+                    head + 1,
+                    True,
+                    __ATOMIC_RELAXED,
+                    __ATOMIC_RELAXED
+                )) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* event for this slot is not published yet */
+            return False;
+        } else {
+            /* another consumer already claimed this slot */
+            head = __atomic_load_n (&self->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    *event = slot->event;
+
+    /* free slot for the push that comes one round later */
+    __atomic_store_n (&slot->sequence, head + self->capacity, __ATOMIC_RELEASE);
+
+    return True;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Smallest power of two not less than given value.
+ * */
+static Size xw_round_up_pow2 (Size value) {
+    Size rounded = 1;
+    while (rounded < value) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
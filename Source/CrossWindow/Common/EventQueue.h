@@ -0,0 +1,96 @@
+/**
+ * @file EventQueue.h
+ * @time 18/10/2026 13:12:41
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_EVENT_QUEUE_H
+#define ANVIE_CROSSWINDOW_COMMON_EVENT_QUEUE_H
+
+#include <Anvie/CrossWindow/Event.h>
+
+/* local includes */
+#include "Lock.h"
+
+/**
+ * @b Bounded single producer, single consumer queue of events.
+ *
+ * One thread pushes and one thread pops, without any locks. Producer may change from one
+ * thread to another only if something else (a mutex for example) orders the two.
+ * */
+typedef struct XwEventQueue {
+    Size head; /**< @b Next slot to pop from. Written only by consumer. */
+    Uint8 head_padding[XW_CACHE_LINE_SIZE - sizeof (Size)];
+
+    Size tail; /**< @b Next slot to push to. Written only by producer. */
+    Uint8 tail_padding[XW_CACHE_LINE_SIZE - sizeof (Size)];
+
+    Size     dropped;  /**< @b Events that didn't fit in queue. */
+    Size     capacity; /**< @b Always a power of two. */
+    XwEvent *events;
+} XwEventQueue;
+
+XwEventQueue *xw_event_queue_create (Size capacity);
+void          xw_event_queue_destroy (XwEventQueue *self);
+Bool          xw_event_queue_push (XwEventQueue *self, const XwEvent *event);
+Bool          xw_event_queue_pop (XwEventQueue *self, XwEvent *event);
+
+/**
+ * @b Slot of a shared event queue. Sequence tells whether slot is ready to be pushed to or
+ *    popped from, and for which round of the ring.
+ * */
+typedef struct XwSharedEventSlot {
+    Size    sequence;
+    XwEvent event;
+} XwSharedEventSlot;
+
+/**
+ * @b Bounded queue of events with any number of producers and consumers, without locks.
+ *
+ * Producers claim a slot by advancing @c tail, and publish event by advancing sequence of
+ * the slot, consumers do the same with @c head. A thread never waits for another thread,
+ * except to retry when it lost the race for a slot.
+ * */
+typedef struct XwSharedEventQueue {
+    Size head; /**< @b Next slot to pop from. */
+    Uint8 head_padding[XW_CACHE_LINE_SIZE - sizeof (Size)];
+
+    Size tail; /**< @b Next slot to push to. */
+    Uint8 tail_padding[XW_CACHE_LINE_SIZE - sizeof (Size)];
+
+    Size               capacity; /**< @b Always a power of two. */
+    XwSharedEventSlot *slots;
+} XwSharedEventQueue;
+
+XwSharedEventQueue *xw_shared_event_queue_create (Size capacity);
+void                xw_shared_event_queue_destroy (XwSharedEventQueue *self);
+Bool xw_shared_event_queue_push (XwSharedEventQueue *self, const XwEvent *event);
+Bool xw_shared_event_queue_pop (XwSharedEventQueue *self, XwEvent *event);
+
+#endif // ANVIE_CROSSWINDOW_COMMON_EVENT_QUEUE_H
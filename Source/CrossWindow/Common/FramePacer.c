@@ -0,0 +1,271 @@
+/**
+ * @file FramePacer.c
+ * @time 18/10/2026 13:32:58
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/FramePacer.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+#include "Timer.h"
+
+/* libc headers */
+#include <string.h>
+#include <time.h>
+
+/** @b Used when no rate is given and refresh rate of monitor is not known. */
+#define XW_FRAME_PACER_DEFAULT_RATE 60.0
+
+/** @b Bounds of time spent spinning before a deadline, adapted to how late sleeps wake. */
+#define XW_FRAME_PACER_MIN_SPIN_NS 50000ull
+#define XW_FRAME_PACER_MAX_SPIN_NS 2000000ull
+
+struct XwFramePacer {
+    XwWindow *window; /**< @b Frames are skipped while this is not presentable. */
+
+    Uint64 period_ns;
+    Uint64 deadline_ns;   /**< @b When next frame is due, CLOCK_MONOTONIC. */
+    Uint64 last_frame_ns; /**< @b When last frame started, 0 before first frame. */
+
+    Uint64  spin_ns;      /**< @b Sleep ends this long before deadline, rest is spun. */
+    Float64 oversleep_ns; /**< @b Moving average of how late sleeps wake up. */
+
+    XwFramePacerStats stats;
+    Uint64            intervals; /**< @b Intervals counted in mean and jitter. */
+};
+
+static void xw_frame_pacer_adapt_spin (XwFramePacer *self, Uint64 oversleep_ns);
+static void xw_frame_pacer_begin_frame (XwFramePacer *self, Uint64 now);
+
+/**
+ * @b Create a frame pacer. First frame is due right away.
+ *
+ * @param win Window frames are drawn to. It's monitor refresh rate is used when @c rate is
+ *        0. Can be Null if @c rate is given, frames are then paced for all windows.
+ * @param rate Frames per second. 0 uses refresh rate of monitor showing @c win, or 60 if
+ *        that's not known.
+ *
+ * @return @c XwFramePacer* on success.
+ * @return @c Null otherwise.
+ * */
+XwFramePacer *xw_frame_pacer_create (XwWindow *win, Float64 rate) {
+    RETURN_VALUE_IF (rate < 0 || (!rate && !win), Null, ERR_INVALID_ARGUMENTS);
+
+    if (!rate) {
+        rate = xw_window_get_refresh_rate (win);
+    }
+    if (!rate) {
+        rate = XW_FRAME_PACER_DEFAULT_RATE;
+        XW_LOG_INFO ("Refresh rate is not known, pacing frames at %.0f Hz\n", rate);
+    }
+
+    XwFramePacer *self = XW_NEW (XW_ALLOC_CATEGORY_TIMER, XwFramePacer);
+    RETURN_VALUE_IF (!self, Null, ERR_OUT_OF_MEMORY);
+
+    self->window      = win;
+    self->period_ns   = 1e9 / rate;
+    self->deadline_ns = xw_timer_now_ns();
+    self->spin_ns     = (XW_FRAME_PACER_MIN_SPIN_NS + XW_FRAME_PACER_MAX_SPIN_NS) / 4;
+
+    xw_frame_pacer_reset_stats (self);
+    return self;
+}
+
+/**
+ * @b Destroy given frame pacer.
+ *
+ * @param pacer
+ * */
+void xw_frame_pacer_destroy (XwFramePacer *pacer) {
+    RETURN_IF (!pacer, ERR_INVALID_ARGUMENTS);
+    XW_FREE (XW_ALLOC_CATEGORY_TIMER, pacer);
+}
+
+/**
+ * @b Wait for next event, or for next frame to be due, whichever comes first.
+ *
+ * Pacer sleeps in @c xw_event_wait_until, so events are handled as soon as they arrive and
+ * no CPU is used between them. Waking up from sleep is late by however long scheduler
+ * takes, so sleep ends a little before deadline and rest is spent spinning on the clock.
+ * How long to spin is adapted to how late sleeps actually wake up.
+ *
+ * Deadlines keep their phase, a frame taking longer than a period skips to the next deadline
+ * instead of shifting all later ones. Events never delay a due frame, they are returned
+ * after it.
+ *
+ * No frame is due while window of pacer (or every window, if pacer has none) is not
+ * presentable, see @c xw_should_render. Pacer then sleeps through deadlines without spinning,
+ * or till next event if @c xw_event_set_idle_blocking is enabled.
+ *
+ * @param pacer
+ * @param event Where event is stored.
+ *
+ * @return @c event if an event arrived before next frame was due.
+ * @return @c Null when it's time to draw next frame.
+ * */
+XwEvent *xw_frame_pacer_wait (XwFramePacer *pacer, XwEvent *event) {
+    RETURN_VALUE_IF (!pacer || !event, Null, ERR_INVALID_ARGUMENTS);
+
+    Uint64 now = xw_timer_now_ns();
+    while (True) {
+        Bool   render  = xw_should_render (pacer->window);
+        Uint64 spin_ns = render ? pacer->spin_ns : 0;
+
+        if (now + spin_ns < pacer->deadline_ns) {
+            Uint64 wake_ns = pacer->deadline_ns - spin_ns;
+            if (xw_event_wait_until (event, wake_ns)) {
+                return event;
+            }
+
+            /* wait gives up early only if it failed (lost connection for example), keep pacing */
+            now = xw_timer_now_ns();
+            if (now < wake_ns) {
+                struct timespec wake = {
+                    .tv_sec  = wake_ns / 1000000000ull,
+                    .tv_nsec = wake_ns % 1000000000ull
+                };
+                clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, Null);
+                now = xw_timer_now_ns();
+            }
+
+            if (render) {
+                xw_frame_pacer_adapt_spin (pacer, now > wake_ns ? now - wake_ns : 0);
+            }
+        }
+
+        if (render) {
+            break;
+        }
+
+        /* skipped deadlines are not missed frames, next drawn frame starts phase afresh */
+        pacer->last_frame_ns = 0;
+        pacer->deadline_ns   = now + pacer->period_ns;
+    }
+
+    while (now < pacer->deadline_ns) {
+        now = xw_timer_now_ns();
+    }
+
+    xw_frame_pacer_begin_frame (pacer, now);
+    return Null;
+}
+
+/**
+ * @b Get frames per second given pacer is pacing at.
+ *
+ * @param pacer
+ *
+ * @return Rate in Hz on success.
+ * @return 0 otherwise.
+ * */
+Float64 xw_frame_pacer_get_rate (XwFramePacer *pacer) {
+    RETURN_VALUE_IF (!pacer, 0, ERR_INVALID_ARGUMENTS);
+    return 1e9 / pacer->period_ns;
+}
+
+/**
+ * @b Get how well frames were paced.
+ *
+ * @param pacer
+ * @param stats Where stats are stored.
+ *
+ * @return @c stats on success.
+ * @return @c Null otherwise.
+ * */
+XwFramePacerStats *xw_frame_pacer_get_stats (XwFramePacer *pacer, XwFramePacerStats *stats) {
+    RETURN_VALUE_IF (!pacer || !stats, Null, ERR_INVALID_ARGUMENTS);
+
+    *stats         = pacer->stats;
+    stats->spin_ns = pacer->spin_ns;
+
+    return stats;
+}
+
+/**
+ * @b Start counting stats afresh, for example after a loading screen.
+ *
+ * @param pacer
+ * */
+void xw_frame_pacer_reset_stats (XwFramePacer *pacer) {
+    RETURN_IF (!pacer, ERR_INVALID_ARGUMENTS);
+
+    memset (&pacer->stats, 0, sizeof (pacer->stats));
+    pacer->stats.period_ns = pacer->period_ns;
+    pacer->intervals       = 0;
+    pacer->last_frame_ns   = 0;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Spin about twice as long as sleeps recently overslept, within bounds.
+ *
+ * @param self
+ * @param oversleep_ns How late last sleep woke up.
+ * */
+static void xw_frame_pacer_adapt_spin (XwFramePacer *self, Uint64 oversleep_ns) {
+    self->oversleep_ns += (oversleep_ns - self->oversleep_ns) / 8;
+
+    Uint64 spin_ns = 2 * self->oversleep_ns;
+    self->spin_ns  = CLAMP (spin_ns, XW_FRAME_PACER_MIN_SPIN_NS, XW_FRAME_PACER_MAX_SPIN_NS);
+}
+
+/**
+ * @b Count a frame starting now in stats, and move deadline to next frame.
+ *
+ * @param self
+ * @param now
+ * */
+static void xw_frame_pacer_begin_frame (XwFramePacer *self, Uint64 now) {
+    XwFramePacerStats *stats = &self->stats;
+
+    /* first frame (after creation or reset) sets phase of deadlines, it can't be late */
+    Uint64 next_ns = (self->last_frame_ns ? self->deadline_ns : now) + self->period_ns;
+    Uint64 missed  = now >= next_ns ? (now - next_ns) / self->period_ns + 1 : 0;
+
+    /* intervals spanning missed deadlines are counted as misses only */
+    if (self->last_frame_ns && !missed) {
+        Float64 interval = now - self->last_frame_ns;
+        Float64 jitter   = interval > self->period_ns ? interval - self->period_ns :
+                                                        self->period_ns - interval;
+
+        self->intervals++;
+        stats->mean_interval_ns += (interval - stats->mean_interval_ns) / self->intervals;
+        stats->jitter_ns        += (jitter - stats->jitter_ns) / self->intervals;
+        stats->max_jitter_ns     = MAX (stats->max_jitter_ns, jitter);
+    }
+
+    stats->frames++;
+    stats->missed       += missed;
+    self->last_frame_ns  = now;
+    self->deadline_ns    = next_ns + missed * self->period_ns;
+}
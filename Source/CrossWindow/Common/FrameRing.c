@@ -0,0 +1,443 @@
+/**
+ * @file FrameRing.c
+ * @time 18/10/2026 12:41:02
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Vulkan.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+
+/* libc headers */
+#include <string.h>
+
+#define XW_VK_DEFAULT_FRAME_COUNT 2
+
+static VkResult xw_vk_frame_init (XwVkFrameRing *ring, XwVkFrame *frame);
+static void     xw_vk_frame_deinit (XwVkFrameRing *ring, XwVkFrame *frame);
+static VkResult xw_vk_frame_ring_reserve_semaphores (XwVkFrameRing *ring, Uint32 count);
+static void     xw_vk_frame_ring_forget_fence (XwVkFrameRing *ring, VkFence fence);
+
+/**
+ * @b Create a new ring of frames in flight.
+ *
+ * @param info
+ *
+ * @return @c XwVkFrameRing on success.
+ * @return @c Null otherwise.
+ * */
+XwVkFrameRing *xw_vk_frame_ring_create (const XwVkFrameRingCreateInfo *info) {
+    RETURN_VALUE_IF (!info, Null, ERR_INVALID_ARGUMENTS);
+
+    XwVkFrameRing *ring = XW_NEW (XW_ALLOC_CATEGORY_VULKAN, XwVkFrameRing);
+    RETURN_VALUE_IF (!ring, Null, ERR_OUT_OF_MEMORY);
+
+    XwVkFrameRing *iring = xw_vk_frame_ring_init (ring, info);
+    GOTO_HANDLER_IF (!iring, INIT_FAILED, ERR_OBJECT_INITIALIZATION_FAILED);
+
+    return iring;
+
+INIT_FAILED:
+    XW_FREE (XW_ALLOC_CATEGORY_VULKAN, ring);
+    return Null;
+}
+
+/**
+ * @b Initialize given frame ring. Creates a command pool, command buffer, fence and acquire
+ *    semaphore for each frame, and a render finished semaphore for each swapchain image.
+ *
+ * @param self
+ * @param info
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkFrameRing *xw_vk_frame_ring_init (XwVkFrameRing *self, const XwVkFrameRingCreateInfo *info) {
+    RETURN_VALUE_IF (
+        !self || !info || !info->swapchain || !info->queue,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    memset (self, 0, sizeof (XwVkFrameRing));
+    self->info   = *info;
+    self->device = info->swapchain->info.device;
+
+    if (!self->info.frame_count) {
+        self->info.frame_count = XW_VK_DEFAULT_FRAME_COUNT;
+    }
+
+    if (!self->info.wait_stage) {
+        self->info.wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+
+    self->frames = XW_ALLOCATE (XW_ALLOC_CATEGORY_VULKAN, XwVkFrame, self->info.frame_count);
+    GOTO_HANDLER_IF (!self->frames, INIT_FAILED, ERR_OUT_OF_MEMORY);
+
+    for (Uint32 f = 0; f < self->info.frame_count; f++) {
+        VkResult res = xw_vk_frame_init (self, self->frames + f);
+        self->frame_count++;
+        GOTO_HANDLER_IF (
+            res != VK_SUCCESS,
+            INIT_FAILED,
+            "Failed to create objects for frame %u. RET = %d\n",
+            f,
+            res
+        );
+    }
+
+    /* more are created later if a recreated swapchain has more images */
+    VkResult res = xw_vk_frame_ring_reserve_semaphores (self, info->swapchain->image_count);
+    GOTO_HANDLER_IF (
+        res != VK_SUCCESS,
+        INIT_FAILED,
+        "Failed to create semaphores. RET = %d\n",
+        res
+    );
+
+    return self;
+
+INIT_FAILED:
+    xw_vk_frame_ring_deinit (self);
+    return Null;
+}
+
+/**
+ * @b Destroy all objects created for frames in given ring.
+ *
+ * Caller must make sure GPU is done with all frames (eg: using @c vkDeviceWaitIdle).
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkFrameRing *xw_vk_frame_ring_deinit (XwVkFrameRing *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    if (self->frames) {
+        for (Uint32 f = 0; f < self->frame_count; f++) {
+            xw_vk_frame_ring_forget_fence (self, self->frames[f].fence);
+            xw_vk_frame_deinit (self, self->frames + f);
+        }
+
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self->frames);
+    }
+
+    if (self->render_finished) {
+        for (Uint32 s = 0; s < self->render_finished_count; s++) {
+            if (self->render_finished[s]) {
+                vkDestroySemaphore (self->device, self->render_finished[s], Null);
+            }
+        }
+
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self->render_finished);
+    }
+
+    memset (self, 0, sizeof (XwVkFrameRing));
+
+    return self;
+}
+
+/**
+ * @b De-initialize and free given frame ring.
+ *
+ * @param self
+ * */
+void xw_vk_frame_ring_destroy (XwVkFrameRing *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    xw_vk_frame_ring_deinit (self);
+    XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self);
+}
+
+/**
+ * @b Begin next frame in ring.
+ *
+ * Waits for GPU to finish the frame that last used same slot in ring (@c frame_count frames
+ * ago), acquires a swapchain image and starts recording frame's command buffer.
+ *
+ * @param ring
+ * @param frame Frame to record commands into is stored here. It's command buffer is in
+ *        recording state on success.
+ *
+ * @return @c VK_SUCCESS on success. Must be followed by a @c xw_vk_frame_end.
+ * @return @c VK_NOT_READY or @c VK_ERROR_OUT_OF_DATE_KHR if there's no image to render to
+ *         (see @c xw_vk_swapchain_acquire). Frame must be skipped, without ending it.
+ * @return Other errors from fence wait, acquire or command buffer begin.
+ * */
+VkResult xw_vk_frame_begin (XwVkFrameRing *ring, XwVkFrame **frame) {
+    RETURN_VALUE_IF (!ring || !frame, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    XwVkFrame *next = ring->frames + ring->current;
+
+    VkResult res = vkWaitForFences (ring->device, 1, &next->fence, VK_TRUE, UINT64_MAX);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to wait for frame fence. RET = %d\n", res);
+
+    /* fence stays signalled if nothing is acquired, so a skipped frame won't block next begin */
+    res = xw_vk_swapchain_acquire (
+        ring->info.swapchain,
+        next->image_available,
+        UINT64_MAX,
+        &next->image_index
+    );
+    if (res != VK_SUCCESS) {
+        return res;
+    }
+
+    res = xw_vk_frame_ring_reserve_semaphores (ring, ring->info.swapchain->image_count);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create semaphores. RET = %d\n", res);
+
+    res = vkResetFences (ring->device, 1, &next->fence);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to reset frame fence. RET = %d\n", res);
+
+    /* resetting whole pool is cheaper than resetting individual command buffers */
+    res = vkResetCommandPool (ring->device, next->cmd_pool, 0);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to reset command pool. RET = %d\n", res);
+
+    VkCommandBufferBeginInfo begin_info = {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext            = Null,
+        .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .pInheritanceInfo = Null
+    };
+
+    res = vkBeginCommandBuffer (next->cmd_buffer, &begin_info);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to begin command buffer. RET = %d\n", res);
+
+    *frame = next;
+    return VK_SUCCESS;
+}
+
+/**
+ * @b End recording of given frame, submit it and present it's image. Does not wait for GPU.
+ *
+ * @param ring
+ * @param frame Frame returned by last @c xw_vk_frame_begin.
+ *
+ * @return @c VK_SUCCESS on success. Out of date swapchain is also treated as success, see
+ *         @c xw_vk_swapchain_present.
+ * @return Error code otherwise.
+ * */
+VkResult xw_vk_frame_end (XwVkFrameRing *ring, XwVkFrame *frame) {
+    RETURN_VALUE_IF (
+        !ring || !frame || frame != ring->frames + ring->current,
+        VK_ERROR_UNKNOWN,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    VkResult res = vkEndCommandBuffer (frame->cmd_buffer);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to end command buffer. RET = %d\n", res);
+
+    VkSemaphore render_finished = ring->render_finished[frame->image_index];
+
+    VkSubmitInfo submit_info = {
+        .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .pNext                = Null,
+        .waitSemaphoreCount   = 1,
+        .pWaitSemaphores      = &frame->image_available,
+        .pWaitDstStageMask    = &ring->info.wait_stage,
+        .commandBufferCount   = 1,
+        .pCommandBuffers      = &frame->cmd_buffer,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores    = &render_finished
+    };
+
+    res = vkQueueSubmit (ring->info.queue, 1, &submit_info, frame->fence);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to submit frame. RET = %d\n", res);
+
+    /* slot is done even if present fails, it's fence will signal anyway */
+    ring->current = (ring->current + 1) % ring->frame_count;
+    ring->frame_number++;
+
+    return xw_vk_swapchain_present (
+        ring->info.swapchain,
+        ring->info.queue,
+        render_finished,
+        frame->fence,
+        frame->image_index
+    );
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Create objects for one frame. Fence is created in signalled state, so very first wait on
+ *    it does not block.
+ *
+ * @param ring
+ * @param frame
+ *
+ * @return @c VK_SUCCESS on success.
+ * @return Error code otherwise. Already created objects are destroyed by deinit.
+ * */
+static VkResult xw_vk_frame_init (XwVkFrameRing *ring, XwVkFrame *frame) {
+    RETURN_VALUE_IF (!ring || !frame, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    VkCommandPoolCreateInfo pool_create_info = {
+        .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .pNext            = Null,
+        .flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = ring->info.queue_family_index
+    };
+
+    VkResult res = vkCreateCommandPool (ring->device, &pool_create_info, Null, &frame->cmd_pool);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create command pool. RET = %d\n", res);
+
+    VkCommandBufferAllocateInfo cmd_allocate_info = {
+        .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .pNext              = Null,
+        .commandPool        = frame->cmd_pool,
+        .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1
+    };
+
+    res = vkAllocateCommandBuffers (ring->device, &cmd_allocate_info, &frame->cmd_buffer);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to allocate command buffer. RET = %d\n", res);
+
+    VkFenceCreateInfo fence_create_info = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .pNext = Null,
+        .flags = VK_FENCE_CREATE_SIGNALED_BIT
+    };
+
+    res = vkCreateFence (ring->device, &fence_create_info, Null, &frame->fence);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create fence. RET = %d\n", res);
+
+    VkSemaphoreCreateInfo semaphore_create_info = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = Null,
+        .flags = 0
+    };
+
+    res = vkCreateSemaphore (ring->device, &semaphore_create_info, Null, &frame->image_available);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create semaphore. RET = %d\n", res);
+
+    return VK_SUCCESS;
+}
+
+/**
+ * @b Destroy objects of one frame. Command buffer is freed along with it's pool.
+ *
+ * @param ring
+ * @param frame
+ * */
+static void xw_vk_frame_deinit (XwVkFrameRing *ring, XwVkFrame *frame) {
+    RETURN_IF (!ring || !frame, ERR_INVALID_ARGUMENTS);
+
+    if (frame->image_available) {
+        vkDestroySemaphore (ring->device, frame->image_available, Null);
+    }
+
+    if (frame->fence) {
+        vkDestroyFence (ring->device, frame->fence, Null);
+    }
+
+    if (frame->cmd_pool) {
+        vkDestroyCommandPool (ring->device, frame->cmd_pool, Null);
+    }
+
+    memset (frame, 0, sizeof (XwVkFrame));
+}
+
+/**
+ * @b Make sure there's a render finished semaphore for each of @c count swapchain images.
+ *    Existing semaphores are kept, so this does nothing when swapchain is recreated with same
+ *    number of images.
+ *
+ * @param ring
+ * @param count Number of swapchain images.
+ *
+ * @return @c VK_SUCCESS on success.
+ * @return Error code otherwise.
+ * */
+static VkResult xw_vk_frame_ring_reserve_semaphores (XwVkFrameRing *ring, Uint32 count) {
+    RETURN_VALUE_IF (!ring, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    if (count <= ring->render_finished_count) {
+        return VK_SUCCESS;
+    }
+
+    VkSemaphore *semaphores =
+        XW_REALLOCATE (XW_ALLOC_CATEGORY_VULKAN, ring->render_finished, VkSemaphore, count);
+    RETURN_VALUE_IF (!semaphores, VK_ERROR_OUT_OF_HOST_MEMORY, ERR_OUT_OF_MEMORY);
+    ring->render_finished = semaphores;
+
+    VkSemaphoreCreateInfo semaphore_create_info = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+        .pNext = Null,
+        .flags = 0
+    };
+
+    while (ring->render_finished_count < count) {
+        VkSemaphore *semaphore = ring->render_finished + ring->render_finished_count;
+
+        VkResult res = vkCreateSemaphore (ring->device, &semaphore_create_info, Null, semaphore);
+        RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create semaphore. RET = %d\n", res);
+
+        ring->render_finished_count++;
+    }
+
+    return VK_SUCCESS;
+}
+
+/**
+ * @b Remove given fence from swapchain (and it's retired swapchains), so that it's not waited
+ *    upon after being destroyed. Swapchain can outlive the frame ring.
+ *
+ * @param ring
+ * @param fence
+ * */
+static void xw_vk_frame_ring_forget_fence (XwVkFrameRing *ring, VkFence fence) {
+    RETURN_IF (!ring, ERR_INVALID_ARGUMENTS);
+
+    XwVkSwapchain *swapchain = ring->info.swapchain;
+    if (!swapchain || !fence) {
+        return;
+    }
+
+    for (Uint32 s = 0; s < swapchain->image_count; s++) {
+        if (swapchain->image_fences[s] == fence) {
+            swapchain->image_fences[s] = VK_NULL_HANDLE;
+        }
+    }
+
+    for (Size r = 0; r < swapchain->retired_count; r++) {
+        XwVkRetiredSwapchain *old = swapchain->retired + r;
+        for (Uint32 f = 0; f < old->fence_count; f++) {
+            if (old->fences[f] == fence) {
+                old->fences[f] = VK_NULL_HANDLE;
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Idle.c
+ * @time 18/10/2026 13:36:09
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Event.h>
+
+/* local headers */
+#include "Idle.h"
+#include "Lock.h"
+
+static struct {
+    Size presentable_count; /**< @b Windows currently presentable. */
+    Bool blocking;          /**< @b Event waits block while no window is presentable. */
+} xw_idle = {0};
+
+/**
+ * @b Make @c xw_event_wait and @c xw_event_wait_until block while no window is presentable
+ *    (mapped, not minimized and not fully obscured), ignoring deadline given to them.
+ *
+ * Waiting ends with the first event, so a window becoming presentable again, input, posted
+ * events and timers all wake the waiting thread as usual. With a frame pacer, this turns a
+ * render loop of an application nobody can see into a single sleeping thread.
+ *
+ * @param enable
+ * */
+void xw_event_set_idle_blocking (Bool enable) {
+    XW_STORE (&xw_idle.blocking, !!enable);
+}
+
+/**
+ * @b Change presentable state of a window, keeping count of presentable windows. Must be
+ *    called with event lock of backend held.
+ *
+ * @param presentable Presentable state of window.
+ * @param value New state.
+ * */
+void xw_idle_set_presentable (Bool *presentable, Bool value) {
+    if (*presentable == !!value) {
+        return;
+    }
+
+    XW_STORE (presentable, !!value);
+    XW_STORE (&xw_idle.presentable_count, xw_idle.presentable_count + (value ? 1 : -1));
+}
+
+/**
+ * @b Check whether any window is presentable.
+ * */
+Bool xw_idle_any_presentable (void) {
+    return !!XW_LOAD (&xw_idle.presentable_count);
+}
+
+/**
+ * @b Check whether event waits must block till next event, whatever their deadline.
+ * */
+Bool xw_idle_should_block (void) {
+    return XW_LOAD (&xw_idle.blocking) && !xw_idle_any_presentable();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file Lock.h
+ * @time 18/10/2026 13:07:21
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_LOCK_H
+#define ANVIE_CROSSWINDOW_COMMON_LOCK_H
+
+#include <Anvie/Types.h>
+
+/* libc includes */
+#include <pthread.h>
+
+/* Locks and atomic accesses needed for calling CrossWindow from many threads. Without
+ * XW_THREAD_SAFE these compile to nothing, and every access is a plain load or store. */
+
+/** @b Data written by different threads is kept this far apart to avoid false sharing. */
+#define XW_CACHE_LINE_SIZE 64
+
+typedef pthread_mutex_t XwMutex;
+
+#define XW_MUTEX_INIT(mutex)   pthread_mutex_init ((mutex), Null)
+#define XW_MUTEX_DEINIT(mutex) pthread_mutex_destroy (mutex)
+
+#ifdef XW_THREAD_SAFE
+#    define XW_MUTEX_LOCK(mutex)   pthread_mutex_lock (mutex)
+#    define XW_MUTEX_UNLOCK(mutex) pthread_mutex_unlock (mutex)
+
+/** @b Load whole value at once. Works with small structs too (eg: @c XwWindowSize). */
+#    define XW_LOAD(ptr)                                                                           \
+        ({                                                                                         \
+            __typeof__ (*(ptr)) xw_loaded_;                                                        \
+            __atomic_load ((ptr), &xw_loaded_, __ATOMIC_ACQUIRE);                                  \
+            xw_loaded_;                                                                            \
+        })
+
+/** @b Store whole value at once. Works with small structs too (eg: @c XwWindowSize). */
+#    define XW_STORE(ptr, value)                                                                   \
+        do {                                                                                       \
+            __typeof__ (*(ptr)) xw_stored_ = (value);                                              \
+            __atomic_store ((ptr), &xw_stored_, __ATOMIC_RELEASE);                                 \
+        } while (0)
+#else
+#    define XW_MUTEX_LOCK(mutex)   ((void)(mutex))
+#    define XW_MUTEX_UNLOCK(mutex) ((void)(mutex))
+#    define XW_LOAD(ptr)           (*(ptr))
+#    define XW_STORE(ptr, value)   (*(ptr) = (value))
+#endif
+
+#endif // ANVIE_CROSSWINDOW_COMMON_LOCK_H
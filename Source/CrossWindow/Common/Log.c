@@ -0,0 +1,189 @@
+/**
+ * @file Log.c
+ * @time 18/10/2026 13:00:41
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Log.h>
+
+/* local headers */
+#include "Log.h"
+
+/* libc headers */
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+/** @b Most messages a single place can log in one rate limiting window. */
+#define XW_LOG_RATE_LIMIT 10
+
+/** @b Length of rate limiting window in nanoseconds. */
+#define XW_LOG_RATE_WINDOW_NS 1000000000ull
+
+/** @b Longest message passed to sink, longer messages are truncated. */
+#define XW_LOG_MAX_MESSAGE_LENGTH 512
+
+static void
+    xw_log_default_sink (void *user_data, XwLogLevel level, CString function, CString message);
+
+static struct {
+    XwLogSink  sink;
+    void      *user_data;
+    XwLogLevel level;
+} xw_log = {
+    .sink      = xw_log_default_sink,
+    .user_data = Null,
+    .level     = XW_LOG_MIN_LEVEL,
+};
+
+/**
+ * @b Send all log messages to given sink instead of stderr.
+ *
+ * Must not be called while other threads are inside CrossWindow.
+ *
+ * @param sink Callback receiving messages. Pass @c Null to switch back to printing on stderr.
+ * @param user_data Passed as is to @c sink.
+ * */
+void xw_log_set_sink (XwLogSink sink, void *user_data) {
+    xw_log.sink      = sink ? sink : xw_log_default_sink;
+    xw_log.user_data = sink ? user_data : Null;
+}
+
+/**
+ * @b Drop messages less severe than given level.
+ *
+ * Messages removed at compile time can't be brought back by lowering the level.
+ *
+ * @param level
+ * */
+void xw_log_set_level (XwLogLevel level) {
+    RETURN_IF (level > XW_LOG_LEVEL_NONE, ERR_INVALID_ARGUMENTS);
+    __atomic_store_n (&xw_log.level, level, __ATOMIC_RELAXED);
+}
+
+/**
+ * @b Get current minimum level of messages that reach the sink.
+ * */
+XwLogLevel xw_log_get_level (void) {
+    return __atomic_load_n (&xw_log.level, __ATOMIC_RELAXED);
+}
+
+/**
+ * @b Format a message and pass it to sink. Use through @c XW_LOG_* macros.
+ *
+ * Each place that logs may pass @c XW_LOG_RATE_LIMIT messages per second. Rest are dropped
+ * and their count is reported along with the first message of the next second. Rate limiting
+ * state is updated atomically, so many threads may log from the same place at once, and only
+ * messages logged right as a second ends may be counted in the other one.
+ *
+ * @param site Rate limiting state of calling place.
+ * @param level Severity of message.
+ * @param function Name of function logging the message.
+ * @param prefix Printed before formatted message.
+ * @param format printf style format string.
+ * */
+void xw_log_message (
+    XwLogSite *site,
+    XwLogLevel level,
+    CString    function,
+    CString    prefix,
+    CString    format,
+    ...
+) {
+    if (level < __atomic_load_n (&xw_log.level, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    Uint64 now = (Uint64)ts.tv_sec * 1000000000ull + (Uint64)ts.tv_nsec;
+
+    /* only the thread that starts a new window reports and resets counts of previous one */
+    Uint32 suppressed = 0;
+    Uint64 start      = __atomic_load_n (&site->window_start, __ATOMIC_RELAXED);
+    if (now - start >= XW_LOG_RATE_WINDOW_NS &&
+        __atomic_compare_exchange_n (
+            &site->window_start,
+            &start,
+            now,
+            False,
+            __ATOMIC_RELAXED,
+            __ATOMIC_RELAXED
+        )) {
+        suppressed = __atomic_exchange_n (&site->suppressed, 0, __ATOMIC_RELAXED);
+        __atomic_store_n (&site->count, 0, __ATOMIC_RELAXED);
+    }
+
+    if (__atomic_fetch_add (&site->count, 1, __ATOMIC_RELAXED) >= XW_LOG_RATE_LIMIT) {
+        __atomic_fetch_add (&site->suppressed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    Char message[XW_LOG_MAX_MESSAGE_LENGTH];
+    Size prefix_length = MIN (strlen (prefix), sizeof (message) - 1);
+    memcpy (message, prefix, prefix_length);
+
+    va_list args;
+    va_start (args, format);
+    Int32 format_length =
+        vsnprintf (message + prefix_length, sizeof (message) - prefix_length, format, args);
+    va_end (args);
+
+    Size length     = MIN (prefix_length + MAX (format_length, 0), sizeof (message) - 1);
+    message[length] = 0;
+
+    /* messages are written with a trailing newline to be printed directly, sink gets lines */
+    if (length && message[length - 1] == '\n') {
+        message[--length] = 0;
+    }
+
+    if (suppressed) {
+        snprintf (
+            message + length,
+            sizeof (message) - length,
+            " (%u similar messages suppressed)",
+            suppressed
+        );
+    }
+
+    xw_log.sink (xw_log.user_data, level, function, message);
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Print messages to stderr, in same format as error handling macros of Common.h
+ * */
+static void
+    xw_log_default_sink (void *user_data, XwLogLevel level, CString function, CString message) {
+    UNUSED (user_data);
+    UNUSED (level);
+    fprintf (stderr, "%s : %s\n", function, message);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file Log.h
+ * @time 18/10/2026 13:00:27
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_LOG_H
+#define ANVIE_CROSSWINDOW_COMMON_LOG_H
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Log.h>
+
+/* Least severe level compiled in, as a number matching XwLogLevel. Set by build system. */
+#ifndef XW_LOG_MIN_LEVEL
+#    define XW_LOG_MIN_LEVEL 0
+#endif
+
+/** @b Rate limiting state of a single place that logs. Only accessed atomically. */
+typedef struct XwLogSite {
+    Uint64 window_start; /**< @b Start of current rate limiting window, in nanoseconds. */
+    Uint32 count;        /**< @b Messages logged in current window. */
+    Uint32 suppressed;   /**< @b Messages dropped in current window. */
+} XwLogSite;
+
+/* every place that logs gets it's own rate limit */
+#define XW_LOG_AT(level, prefix, ...)                                                              \
+    do {                                                                                           \
+        static XwLogSite xw_log_site_ = {0};                                                       \
+        xw_log_message (&xw_log_site_, level, __func__, prefix, __VA_ARGS__);                      \
+    } while (0)
+
+/* stripped messages are still type checked, but never reach the binary */
+#define XW_LOG_STRIPPED(...)                                                                       \
+    do {                                                                                           \
+        if (0) {                                                                                   \
+            xw_log_discard (__VA_ARGS__);                                                          \
+        }                                                                                          \
+    } while (0)
+
+#if XW_LOG_MIN_LEVEL <= 0
+#    define XW_LOG_DEBUG(...) XW_LOG_AT (XW_LOG_LEVEL_DEBUG, "", __VA_ARGS__)
+#else
+#    define XW_LOG_DEBUG(...) XW_LOG_STRIPPED (__VA_ARGS__)
+#endif
+
+#if XW_LOG_MIN_LEVEL <= 1
+#    define XW_LOG_INFO(...) XW_LOG_AT (XW_LOG_LEVEL_INFO, "", __VA_ARGS__)
+#else
+#    define XW_LOG_INFO(...) XW_LOG_STRIPPED (__VA_ARGS__)
+#endif
+
+#if XW_LOG_MIN_LEVEL <= 2
+#    define XW_LOG_WARNING(...) XW_LOG_AT (XW_LOG_LEVEL_WARNING, "", __VA_ARGS__)
+#else
+#    define XW_LOG_WARNING(...) XW_LOG_STRIPPED (__VA_ARGS__)
+#endif
+
+/* error handling macros from Common.h report through log sink as well */
+#undef ANVIE_LOG_ERROR
+#if XW_LOG_MIN_LEVEL <= 3
+#    define XW_LOG_ERROR(...)            XW_LOG_AT (XW_LOG_LEVEL_ERROR, "", __VA_ARGS__)
+#    define ANVIE_LOG_ERROR(prefix, ...) XW_LOG_AT (XW_LOG_LEVEL_ERROR, prefix, __VA_ARGS__)
+#else
+#    define XW_LOG_ERROR(...)            XW_LOG_STRIPPED (__VA_ARGS__)
+#    define ANVIE_LOG_ERROR(prefix, ...) XW_LOG_STRIPPED (__VA_ARGS__)
+#endif
+
+void xw_log_message (
+    XwLogSite *site,
+    XwLogLevel level,
+    CString    function,
+    CString    prefix,
+    CString    format,
+    ...
+) __attribute__ ((format (printf, 5, 6)));
+
+static inline __attribute__ ((format (printf, 1, 2))) void xw_log_discard (CString format, ...) {
+    UNUSED (format);
+}
+
+#endif // ANVIE_CROSSWINDOW_COMMON_LOG_H
@@ -0,0 +1,174 @@
+/**
+ * @file Post.c
+ * @time 18/10/2026 13:20:43
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* local headers */
+#include "EventQueue.h"
+#include "Log.h"
+#include "Post.h"
+
+/* libc headers */
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+static struct {
+    XwSharedEventQueue *queue;
+    int                 wakeup_fd; /**< @b eventfd, readable after a wakeup. -1 if not created. */
+    Size                waiters;   /**< @b Threads that may be sleeping on @c wakeup_fd. */
+} xw_post = {.wakeup_fd = -1};
+
+/**
+ * @b Add a copy of given event to events polled by @c xw_event_poll and @c xw_event_wait,
+ *    and wake thread waiting for events, if any. Can be called from any thread.
+ *
+ * Posted events are returned after events already received from display server. If event
+ * has a window, it must not be destroyed before event is polled, otherwise the event is
+ * dropped. Event is routed to window event queue if window has one.
+ *
+ * @param event Event of type @c XW_EVENT_TYPE_USER.
+ *
+ * @return @c event on success.
+ * @return Null otherwise (eg: too many events posted and not polled yet).
+ * */
+XwEvent *xw_event_post (const XwEvent *event) {
+    RETURN_VALUE_IF (!event, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (event->type != XW_EVENT_TYPE_USER, Null, "Only user events can be posted\n");
+    RETURN_VALUE_IF (!xw_post.queue, Null, "CrossWindow is not initialized\n");
+
+    if (!xw_shared_event_queue_push (xw_post.queue, event)) {
+        XW_LOG_DEBUG ("Too many posted events waiting to be polled, dropping event\n");
+        return Null;
+    }
+
+    xw_post_wakeup();
+    return (XwEvent *)event;
+}
+
+/**
+ * @b Create queue of posted events and the eventfd used to wake waiting thread.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_post_init (void) {
+    if (xw_post.queue) {
+        return True;
+    }
+
+    xw_post.queue = xw_shared_event_queue_create (XW_POSTED_EVENT_CAPACITY);
+    RETURN_VALUE_IF (!xw_post.queue, False, "Failed to create posted event queue\n");
+
+    xw_post.wakeup_fd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+    GOTO_HANDLER_IF (xw_post.wakeup_fd < 0, EVENTFD_FAILED, "Failed to create wakeup eventfd\n");
+
+    return True;
+
+EVENTFD_FAILED:
+    xw_shared_event_queue_destroy (xw_post.queue);
+    xw_post.queue = Null;
+    return False;
+}
+
+/**
+ * @b Destroy queue of posted events, dropping events still in it, and close eventfd.
+ * */
+void xw_post_deinit (void) {
+    if (xw_post.queue) {
+        xw_shared_event_queue_destroy (xw_post.queue);
+        xw_post.queue = Null;
+    }
+
+    if (xw_post.wakeup_fd >= 0) {
+        close (xw_post.wakeup_fd);
+        xw_post.wakeup_fd = -1;
+    }
+}
+
+/**
+ * @b Remove oldest posted event.
+ *
+ * @param event Where removed event is stored.
+ *
+ * @return True if an event was removed.
+ * @return False if there are no posted events.
+ * */
+Bool xw_post_pop (XwEvent *event) {
+    return xw_post.queue && xw_shared_event_queue_pop (xw_post.queue, event);
+}
+
+/**
+ * @b Tell posting threads that calling thread is about to sleep. Must be followed by a
+ *    call to @c xw_post_end_wait.
+ *
+ * @return eventfd to poll for reading along with other fds.
+ * @return -1 if there's no eventfd.
+ * */
+int xw_post_begin_wait (void) {
+    /* Pairs with read-modify-write in xw_post_wakeup. These are totally ordered, so either
+     * poster sees the waiter and signals eventfd, or waiter sees the event when it checks
+     * once more after this. */
+    __atomic_add_fetch (&xw_post.waiters, 1, __ATOMIC_ACQ_REL);
+
+    return xw_post.wakeup_fd;
+}
+
+/**
+ * @b Tell posting threads that calling thread is not sleeping anymore.
+ *
+ * @param woken Whether eventfd became readable. It's reset in that case.
+ * */
+void xw_post_end_wait (Bool woken) {
+    __atomic_sub_fetch (&xw_post.waiters, 1, __ATOMIC_RELEASE);
+
+    Uint64 count = 0;
+    if (woken && read (xw_post.wakeup_fd, &count, sizeof (count)) < 0) {
+        /* another waiter reset it first */
+        XW_LOG_DEBUG ("Wakeup eventfd was already reset\n");
+    }
+}
+
+/**
+ * @b Wake threads sleeping in @c xw_event_wait, if any. Can be called from any thread.
+ * */
+void xw_post_wakeup (void) {
+    /* a plain load could see a stale count, see xw_post_begin_wait */
+    if (!__atomic_fetch_add (&xw_post.waiters, 0, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+
+    Uint64 one = 1;
+    if (write (xw_post.wakeup_fd, &one, sizeof (one)) < 0) {
+        /* counter is saturated, waiter will wake up anyway */
+        XW_LOG_DEBUG ("Failed to signal wakeup eventfd\n");
+    }
+}
@@ -0,0 +1,56 @@
+/**
+ * @file Post.h
+ * @time 18/10/2026 13:20:43
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_POST_H
+#define ANVIE_CROSSWINDOW_COMMON_POST_H
+
+#include <Anvie/CrossWindow/Event.h>
+
+/** @b Most events that can be posted before they are polled. */
+#define XW_POSTED_EVENT_CAPACITY 4096
+
+/* Events posted with xw_event_post from any thread wait in a shared queue till the thread
+ * pumping events pops them. Posting also signals an eventfd, but only while a thread is
+ * sleeping in xw_event_wait, so posting to a busy event loop costs no system call.
+ *
+ * A thread that sleeps must call xw_post_begin_wait, check for events once more (both posted
+ * and from display server), poll returned fd only if there were none, and then call
+ * xw_post_end_wait. Doing the last check after begin makes sure no wakeup is missed. */
+
+Bool xw_post_init (void);
+void xw_post_deinit (void);
+Bool xw_post_pop (XwEvent *event);
+int  xw_post_begin_wait (void);
+void xw_post_end_wait (Bool woken);
+void xw_post_wakeup (void);
+
+#endif // ANVIE_CROSSWINDOW_COMMON_POST_H
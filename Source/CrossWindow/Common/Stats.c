@@ -0,0 +1,229 @@
+/**
+ * @file Stats.c
+ * @time 18/10/2026 12:58:19
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Stats.h>
+
+/* local headers */
+#include "Log.h"
+#include "Post.h"
+#include "Stats.h"
+#include "Trace.h"
+
+/* libc headers */
+#include <string.h>
+#include <time.h>
+
+/* sites are found and updated under this lock, round trips are slow enough for it not to matter */
+static Bool             xw_round_trip_lock = False;
+static XwRoundTripStats xw_round_trips     = {0};
+
+/* abort on repeated round trips inside event pump */
+static Bool xw_round_trip_strict = False;
+
+/* greater than zero while calling thread is inside event pump */
+static _Thread_local Uint32 xw_round_trip_poll_depth = 0;
+
+static void   xw_round_trip_lock_acquire (void);
+static void   xw_round_trip_lock_release (void);
+static Uint64 xw_round_trip_now (void);
+
+/**
+ * @b Get a snapshot of round trips made so far.
+ *
+ * Round trips are always counted, the cost is negligible compared to the round trip itself.
+ *
+ * @param stats Where snapshot will be stored.
+ *
+ * @return @c stats on success.
+ * @return @c Null otherwise.
+ * */
+XwRoundTripStats *xw_stats_round_trips (XwRoundTripStats *stats) {
+    RETURN_VALUE_IF (!stats, Null, ERR_INVALID_ARGUMENTS);
+
+    xw_round_trip_lock_acquire();
+    *stats = xw_round_trips;
+    xw_round_trip_lock_release();
+
+    return stats;
+}
+
+/**
+ * @b Forget all round trips counted so far.
+ * */
+void xw_stats_reset_round_trips (void) {
+    xw_round_trip_lock_acquire();
+    memset (&xw_round_trips, 0, sizeof (xw_round_trips));
+    xw_round_trip_lock_release();
+}
+
+/**
+ * @b Enable or disable strict round trip checking.
+ *
+ * Event pump (@c xw_event_poll, @c xw_event_wait and @c xw_event_wait_until) is expected to
+ * never wait for a reply from display server, requests made while converting events are
+ * answered on a later pump. In strict mode, a round trip made inside event pump from a place
+ * that already made one there before aborts the program, printing where it came from. The
+ * first round trip from each place is allowed, so that one time lazy initialization (eg:
+ * creating keymap on first key press) does not trigger it.
+ *
+ * Strict mode can also be enabled by setting @c XW_STRICT_ROUND_TRIPS environment variable
+ * to 1 before library is loaded.
+ *
+ * @param strict
+ * */
+void xw_stats_set_strict_round_trips (Bool strict) {
+    __atomic_store_n (&xw_round_trip_strict, !!strict, __ATOMIC_RELAXED);
+}
+
+/**
+ * @b Mark start of a round trip. Use through @c XW_ROUND_TRIP.
+ *
+ * @param name What is being waited for.
+ *
+ * @return Start timestamp to be passed to @c xw_round_trip_end.
+ * */
+Uint64 xw_round_trip_begin (CString name) {
+    UNUSED (name);
+    XW_TRACE_BEGIN (name);
+    return xw_round_trip_now();
+}
+
+/**
+ * @b Mark end of a round trip, and attribute time spent in it to the place it was made from.
+ * Use through @c XW_ROUND_TRIP.
+ *
+ * @param name What was waited for.
+ * @param function Function that waited.
+ * @param line Line in source file where it waited.
+ * @param start Value returned by @c xw_round_trip_begin.
+ * */
+void xw_round_trip_end (CString name, CString function, Uint32 line, Uint64 start) {
+    Uint64 blocked = xw_round_trip_now() - start;
+    XW_TRACE_END (name);
+
+    Bool in_poll = xw_round_trip_poll_depth > 0;
+    Bool repeat  = False;
+
+    xw_round_trip_lock_acquire();
+
+    xw_round_trips.count++;
+    xw_round_trips.blocked_ns += blocked;
+    xw_round_trips.poll_count += in_poll;
+
+    /* sites are told apart by address of their name and function, these are string literals */
+    XwRoundTripSite *site = Null;
+    for (Size s = 0; s < xw_round_trips.site_count; s++) {
+        XwRoundTripSite *it = xw_round_trips.sites + s;
+        if (it->line == line && it->name == name && it->function == function) {
+            site = it;
+            break;
+        }
+    }
+    if (!site && xw_round_trips.site_count < XW_ROUND_TRIP_MAX_SITES) {
+        site           = xw_round_trips.sites + xw_round_trips.site_count++;
+        site->name     = name;
+        site->function = function;
+        site->line     = line;
+    }
+
+    if (site) {
+        repeat = in_poll && site->poll_count;
+
+        site->count++;
+        site->poll_count += in_poll;
+        site->blocked_ns += blocked;
+
+        site->max_blocked_ns = MAX (site->max_blocked_ns, blocked);
+    }
+
+    xw_round_trip_lock_release();
+
+#ifdef XW_THREAD_SAFE
+    /* reading the reply may have queued events too, and a thread sleeping in xw_event_wait
+     * would not notice them till something else arrives */
+    xw_post_wakeup();
+#endif
+
+    ABORT_IF (
+        repeat && __atomic_load_n (&xw_round_trip_strict, __ATOMIC_RELAXED),
+        "Round trip (%s) at %s:%u inside event pump (strict round trip mode)\n",
+        name,
+        function,
+        line
+    );
+}
+
+/**
+ * @b Mark that calling thread entered event pump (@c xw_event_poll, @c xw_event_wait or
+ *    @c xw_event_wait_until). Calls can be nested.
+ * */
+void xw_round_trip_enter_poll (void) {
+    xw_round_trip_poll_depth++;
+}
+
+/**
+ * @b Mark that calling thread left event pump.
+ * */
+void xw_round_trip_leave_poll (void) {
+    if (xw_round_trip_poll_depth) {
+        xw_round_trip_poll_depth--;
+    }
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Read strict mode setting from environment when library is loaded.
+ * */
+static CONSTRUCTOR void xw_round_trip_read_env (void) {
+    CString strict = getenv ("XW_STRICT_ROUND_TRIPS");
+    if (strict && !strcmp (strict, "1")) {
+        xw_stats_set_strict_round_trips (True);
+    }
+}
+
+static void xw_round_trip_lock_acquire (void) {
+    while (__atomic_test_and_set (&xw_round_trip_lock, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n (&xw_round_trip_lock, __ATOMIC_RELAXED)) {}
+    }
+}
+
+static void xw_round_trip_lock_release (void) {
+    __atomic_clear (&xw_round_trip_lock, __ATOMIC_RELEASE);
+}
+
+static Uint64 xw_round_trip_now (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ull + (Uint64)ts.tv_nsec;
+}
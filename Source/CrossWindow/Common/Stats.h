@@ -0,0 +1,54 @@
+/**
+ * @file Stats.h
+ * @time 18/10/2026 12:58:02
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_STATS_H
+#define ANVIE_CROSSWINDOW_COMMON_STATS_H
+
+#include <Anvie/CrossWindow/Stats.h>
+
+/* Every call that blocks till display server answers must be wrapped in this, so that it's
+ * counted, timed and attributed to the place it was made from. Evaluates to value of call.
+ * Name must be a string literal, it's used to tell apart round trips made from same function. */
+#define XW_ROUND_TRIP(name, call)                                                                  \
+    ({                                                                                             \
+        Uint64            xw_round_trip_start_  = xw_round_trip_begin (name);                      \
+        __typeof__ (call) xw_round_trip_result_ = (call);                                          \
+        xw_round_trip_end (name, __func__, __LINE__, xw_round_trip_start_);                        \
+        xw_round_trip_result_;                                                                     \
+    })
+
+Uint64 xw_round_trip_begin (CString name);
+void   xw_round_trip_end (CString name, CString function, Uint32 line, Uint64 start);
+void   xw_round_trip_enter_poll (void);
+void   xw_round_trip_leave_poll (void);
+
+#endif // ANVIE_CROSSWINDOW_COMMON_STATS_H
@@ -0,0 +1,363 @@
+/**
+ * @file SurfaceInfo.c
+ * @time 18/10/2026 12:43:57
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Vulkan.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+
+/* libc headers */
+#include <string.h>
+
+/* present modes tried in order for each policy, FIFO is tried after all of these */
+static const VkPresentModeKHR policy_present_modes[XW_VK_LATENCY_POLICY_MAX][2] = {
+    [XW_VK_LATENCY_POLICY_POWER_SAVING] = {VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_KHR},
+    [XW_VK_LATENCY_POLICY_LOWEST_LATENCY] =
+        {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR},
+    [XW_VK_LATENCY_POLICY_TEAR_FREE_LOW_LATENCY] =
+        {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR},
+};
+
+static Bool xw_vk_surface_info_supports_present_mode (XwVkSurfaceInfo *self, VkPresentModeKHR m);
+
+/**
+ * @b Create a new surface info cache for given window surface. Nothing is queried until needed.
+ *
+ * @param gpu
+ * @param surface
+ * @param window Window @c surface was created for.
+ *
+ * @return @c XwVkSurfaceInfo on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSurfaceInfo *
+    xw_vk_surface_info_create (VkPhysicalDevice gpu, VkSurfaceKHR surface, XwWindow *window) {
+    XwVkSurfaceInfo *info = XW_NEW (XW_ALLOC_CATEGORY_VULKAN, XwVkSurfaceInfo);
+    RETURN_VALUE_IF (!info, Null, ERR_OUT_OF_MEMORY);
+
+    XwVkSurfaceInfo *iinfo = xw_vk_surface_info_init (info, gpu, surface, window);
+    GOTO_HANDLER_IF (!iinfo, INIT_FAILED, ERR_OBJECT_INITIALIZATION_FAILED);
+
+    return iinfo;
+
+INIT_FAILED:
+    XW_FREE (XW_ALLOC_CATEGORY_VULKAN, info);
+    return Null;
+}
+
+/**
+ * @b Initialize given surface info cache.
+ *
+ * @param self
+ * @param gpu
+ * @param surface
+ * @param window
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSurfaceInfo *xw_vk_surface_info_init (
+    XwVkSurfaceInfo *self,
+    VkPhysicalDevice gpu,
+    VkSurfaceKHR     surface,
+    XwWindow        *window
+) {
+    RETURN_VALUE_IF (!self || !gpu || !surface || !window, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (self, 0, sizeof (XwVkSurfaceInfo));
+    self->gpu     = gpu;
+    self->surface = surface;
+    self->window  = window;
+
+    return self;
+}
+
+/**
+ * @b Free cached surface info.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSurfaceInfo *xw_vk_surface_info_deinit (XwVkSurfaceInfo *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    if (self->formats) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self->formats);
+    }
+
+    if (self->present_modes) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self->present_modes);
+    }
+
+    memset (self, 0, sizeof (XwVkSurfaceInfo));
+
+    return self;
+}
+
+/**
+ * @b De-initialize and free given surface info cache.
+ *
+ * @param self
+ * */
+void xw_vk_surface_info_destroy (XwVkSurfaceInfo *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    xw_vk_surface_info_deinit (self);
+    XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self);
+}
+
+/**
+ * @b Query supported surface formats and present modes, only if cached ones are invalid.
+ *
+ * @param self
+ *
+ * @return @c VK_SUCCESS on success.
+ * @return Error code otherwise. Cache stays invalid in that case.
+ * */
+VkResult xw_vk_surface_info_query (XwVkSurfaceInfo *self) {
+    RETURN_VALUE_IF (!self, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    if (self->valid) {
+        return VK_SUCCESS;
+    }
+
+    Uint32   format_count = 0;
+    VkResult res          = vkGetPhysicalDeviceSurfaceFormatsKHR (
+        self->gpu,
+        self->surface,
+        &format_count,
+        Null
+    );
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS || !format_count,
+        res ? res : VK_ERROR_FORMAT_NOT_SUPPORTED,
+        "Failed to get number of surface formats. RET = %d\n",
+        res
+    );
+
+    Uint32 mode_count = 0;
+    res = vkGetPhysicalDeviceSurfacePresentModesKHR (self->gpu, self->surface, &mode_count, Null);
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS,
+        res,
+        "Failed to get number of present modes. RET = %d\n",
+        res
+    );
+
+    /* arrays are reused if they are large enough */
+    if (format_count > self->format_count || !self->formats) {
+        VkSurfaceFormatKHR *formats = XW_REALLOCATE (
+            XW_ALLOC_CATEGORY_VULKAN,
+            self->formats,
+            VkSurfaceFormatKHR,
+            format_count
+        );
+        RETURN_VALUE_IF (!formats, VK_ERROR_OUT_OF_HOST_MEMORY, ERR_OUT_OF_MEMORY);
+        self->formats = formats;
+    }
+
+    if (mode_count > self->present_mode_count || !self->present_modes) {
+        VkPresentModeKHR *modes = XW_REALLOCATE (
+            XW_ALLOC_CATEGORY_VULKAN,
+            self->present_modes,
+            VkPresentModeKHR,
+            mode_count + 1
+        );
+        RETURN_VALUE_IF (!modes, VK_ERROR_OUT_OF_HOST_MEMORY, ERR_OUT_OF_MEMORY);
+        self->present_modes = modes;
+    }
+
+    res = vkGetPhysicalDeviceSurfaceFormatsKHR (
+        self->gpu,
+        self->surface,
+        &format_count,
+        self->formats
+    );
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS && res != VK_INCOMPLETE,
+        res,
+        "Failed to get surface formats. RET = %d\n",
+        res
+    );
+
+    res = vkGetPhysicalDeviceSurfacePresentModesKHR (
+        self->gpu,
+        self->surface,
+        &mode_count,
+        self->present_modes
+    );
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS && res != VK_INCOMPLETE,
+        res,
+        "Failed to get present modes. RET = %d\n",
+        res
+    );
+
+    self->format_count       = format_count;
+    self->present_mode_count = mode_count;
+    self->valid              = True;
+
+    return VK_SUCCESS;
+}
+
+/**
+ * @b Mark cached info invalid, it's queried again when needed next time.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSurfaceInfo *xw_vk_surface_info_invalidate (XwVkSurfaceInfo *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    self->valid = False;
+
+    return self;
+}
+
+/**
+ * @b Invalidate cached info if given event is a resize or DPI change (monitor change) of
+ *    surface's window. Other events are ignored.
+ *
+ * @param self
+ * @param event
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSurfaceInfo *xw_vk_surface_info_handle_event (XwVkSurfaceInfo *self, const XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, Null, ERR_INVALID_ARGUMENTS);
+
+    if (event->window == self->window &&
+        (event->type == XW_EVENT_TYPE_RESIZE || event->type == XW_EVENT_TYPE_DPI_CHANGE)) {
+        self->valid = False;
+    }
+
+    return self;
+}
+
+/**
+ * @b Choose a present mode supported by surface, according to given latency policy.
+ *
+ * @param info Surface info, queried if not valid.
+ * @param policy
+ *
+ * @return Selected present mode. FIFO if nothing else is supported, or on failure.
+ * */
+VkPresentModeKHR xw_vk_choose_present_mode (XwVkSurfaceInfo *info, XwVkLatencyPolicy policy) {
+    RETURN_VALUE_IF (
+        !info || policy >= XW_VK_LATENCY_POLICY_MAX,
+        VK_PRESENT_MODE_FIFO_KHR,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    VkResult res = xw_vk_surface_info_query (info);
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS,
+        VK_PRESENT_MODE_FIFO_KHR,
+        "Failed to query surface info. RET = %d\n",
+        res
+    );
+
+    for (Size m = 0; m < ARRAY_SIZE (policy_present_modes[policy]); m++) {
+        VkPresentModeKHR mode = policy_present_modes[policy][m];
+        if (xw_vk_surface_info_supports_present_mode (info, mode)) {
+            return mode;
+        }
+    }
+
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+/**
+ * @b Choose a surface format supported by surface.
+ *
+ * @param info Surface info, queried if not valid.
+ * @param preferred Format (and color space) to select if supported. @c VK_FORMAT_UNDEFINED means
+ *        no preference.
+ *
+ * @return @c preferred if supported, otherwise first format supported by surface.
+ * @return Format with @c VK_FORMAT_UNDEFINED on failure.
+ * */
+VkSurfaceFormatKHR
+    xw_vk_choose_surface_format (XwVkSurfaceInfo *info, VkSurfaceFormatKHR preferred) {
+    VkSurfaceFormatKHR undefined = {VK_FORMAT_UNDEFINED, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+    RETURN_VALUE_IF (!info, undefined, ERR_INVALID_ARGUMENTS);
+
+    VkResult res = xw_vk_surface_info_query (info);
+    RETURN_VALUE_IF (res != VK_SUCCESS, undefined, "Failed to query surface info. RET = %d\n", res);
+
+    for (Size s = 0; s < info->format_count && preferred.format != VK_FORMAT_UNDEFINED; s++) {
+        if (info->formats[s].format == preferred.format &&
+            info->formats[s].colorSpace == preferred.colorSpace) {
+            return info->formats[s];
+        }
+    }
+
+    /* surface has no preference of it's own */
+    VkSurfaceFormatKHR format = info->formats[0];
+    if (format.format == VK_FORMAT_UNDEFINED) {
+        format.format = preferred.format != VK_FORMAT_UNDEFINED ? preferred.format :
+                                                                  VK_FORMAT_B8G8R8A8_UNORM;
+    }
+
+    return format;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Check whether cached present modes contain given mode.
+ *
+ * @param self
+ * @param m Present mode.
+ *
+ * @return @c True if supported.
+ * @return @c False otherwise.
+ * */
+static Bool xw_vk_surface_info_supports_present_mode (XwVkSurfaceInfo *self, VkPresentModeKHR m) {
+    RETURN_VALUE_IF (!self, False, ERR_INVALID_ARGUMENTS);
+
+    for (Uint32 s = 0; s < self->present_mode_count; s++) {
+        if (self->present_modes[s] == m) {
+            return True;
+        }
+    }
+
+    return False;
+}
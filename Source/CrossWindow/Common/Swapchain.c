@@ -0,0 +1,693 @@
+/**
+ * @file Swapchain.c
+ * @time 18/10/2026 12:37:46
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Vulkan.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+
+/* libc headers */
+#include <string.h>
+
+static VkResult xw_vk_swapchain_select_surface_format_and_present_mode (XwVkSwapchain *self);
+static VkResult xw_vk_swapchain_rebuild (XwVkSwapchain *self);
+static VkResult xw_vk_swapchain_create_image_objects (XwVkSwapchain *self);
+static Bool     xw_vk_swapchain_reserve_retired (XwVkSwapchain *self);
+static void     xw_vk_swapchain_retire (XwVkSwapchain *self, XwVkRetiredSwapchain *old);
+static void     xw_vk_retired_swapchain_destroy (XwVkSwapchain *self, XwVkRetiredSwapchain *old);
+
+/**
+ * @b Create a new swapchain for a window surface.
+ *
+ * @param info Parameters used for creating and later recreating swapchain.
+ *
+ * @return @c XwVkSwapchain on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSwapchain *xw_vk_swapchain_create (const XwVkSwapchainCreateInfo *info) {
+    RETURN_VALUE_IF (!info, Null, ERR_INVALID_ARGUMENTS);
+
+    XwVkSwapchain *swapchain = XW_NEW (XW_ALLOC_CATEGORY_VULKAN, XwVkSwapchain);
+    RETURN_VALUE_IF (!swapchain, Null, ERR_OUT_OF_MEMORY);
+
+    XwVkSwapchain *iswapchain = xw_vk_swapchain_init (swapchain, info);
+    GOTO_HANDLER_IF (!iswapchain, INIT_FAILED, ERR_OBJECT_INITIALIZATION_FAILED);
+
+    return iswapchain;
+
+INIT_FAILED:
+    XW_FREE (XW_ALLOC_CATEGORY_VULKAN, swapchain);
+    return Null;
+}
+
+/**
+ * @b Initialize given swapchain object. Surface format and present mode are selected here, and
+ *    selected again on recreate only if surface info got invalidated since then.
+ *
+ * @param self
+ * @param info
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSwapchain *xw_vk_swapchain_init (XwVkSwapchain *self, const XwVkSwapchainCreateInfo *info) {
+    RETURN_VALUE_IF (
+        !self || !info || !info->gpu || !info->device || !info->surface || !info->window ||
+            !info->extent.width || !info->extent.height,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    memset (self, 0, sizeof (XwVkSwapchain));
+    self->info         = *info;
+    self->surface_info = info->surface_info;
+
+    if (!self->surface_info) {
+        self->surface_info = xw_vk_surface_info_create (info->gpu, info->surface, info->window);
+        GOTO_HANDLER_IF (!self->surface_info, INIT_FAILED, "Failed to create surface info\n");
+        self->owns_surface_info = True;
+    }
+
+    VkResult res = xw_vk_swapchain_select_surface_format_and_present_mode (self);
+    GOTO_HANDLER_IF (
+        res != VK_SUCCESS,
+        INIT_FAILED,
+        "Failed to select surface format and present mode. RET = %d\n",
+        res
+    );
+
+    /* a minimized window gives VK_NOT_READY, swapchain will be created in first acquire then */
+    res = xw_vk_swapchain_rebuild (self);
+    GOTO_HANDLER_IF (
+        res != VK_SUCCESS && res != VK_NOT_READY,
+        INIT_FAILED,
+        "Failed to create swapchain. RET = %d\n",
+        res
+    );
+
+    return self;
+
+INIT_FAILED:
+    xw_vk_swapchain_deinit (self);
+    return Null;
+}
+
+/**
+ * @b Destroy current and all retired swapchains.
+ *
+ * Unlike recreating, this does not wait for fences of retired swapchains. Caller must make sure
+ * GPU is done with all submissions using swapchain images (eg: using @c vkDeviceWaitIdle).
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSwapchain *xw_vk_swapchain_deinit (XwVkSwapchain *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    /* current swapchain is destroyed same as a retired one */
+    XwVkRetiredSwapchain current;
+    xw_vk_swapchain_retire (self, &current);
+    xw_vk_retired_swapchain_destroy (self, &current);
+
+    for (Size s = 0; s < self->retired_count; s++) {
+        xw_vk_retired_swapchain_destroy (self, self->retired + s);
+    }
+
+    if (self->retired) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self->retired);
+    }
+
+    if (self->images) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self->images);
+    }
+
+    if (self->owns_surface_info) {
+        xw_vk_surface_info_destroy (self->surface_info);
+    }
+
+    memset (self, 0, sizeof (XwVkSwapchain));
+
+    return self;
+}
+
+/**
+ * @b De-initialize and free given swapchain.
+ *
+ * @param self
+ * */
+void xw_vk_swapchain_destroy (XwVkSwapchain *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    xw_vk_swapchain_deinit (self);
+    XW_FREE (XW_ALLOC_CATEGORY_VULKAN, self);
+}
+
+/**
+ * @b Let swapchain know about an event. Resize and DPI change events of swapchain's window
+ *    mark it out of date, and it's recreated in next @c xw_vk_swapchain_acquire.
+ *
+ * Events of other windows are ignored, so all polled events can be passed here.
+ *
+ * @param self
+ * @param event
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSwapchain *xw_vk_swapchain_handle_event (XwVkSwapchain *self, const XwEvent *event) {
+    RETURN_VALUE_IF (!self || !event, Null, ERR_INVALID_ARGUMENTS);
+
+    if (event->window != self->info.window) {
+        return self;
+    }
+
+    /* supported formats and present modes are queried again in next recreate */
+    xw_vk_surface_info_handle_event (self->surface_info, event);
+
+    switch (event->type) {
+        case XW_EVENT_TYPE_RESIZE : {
+            self->info.extent = (VkExtent2D) {event->resize.width, event->resize.height};
+
+            /* configure events are also generated for moves and restacks */
+            if (event->resize.width != self->extent.width ||
+                event->resize.height != self->extent.height) {
+                self->out_of_date = True;
+            }
+            break;
+        }
+        case XW_EVENT_TYPE_DPI_CHANGE : {
+            self->out_of_date = True;
+            break;
+        }
+        default :
+            break;
+    }
+
+    return self;
+}
+
+/**
+ * @b Destroy retired swapchains that GPU is done with. Never blocks.
+ *
+ * This is called by @c xw_vk_swapchain_acquire, so calling this explicitly is needed only when
+ * no frames are being rendered for a long time.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwVkSwapchain *xw_vk_swapchain_collect_retired (XwVkSwapchain *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    Size s = 0;
+    while (s < self->retired_count) {
+        XwVkRetiredSwapchain *old = self->retired + s;
+
+        /* A fence might have been reset and submitted again since then, in that case it's
+         * signalled only after the newer submission completes, which is later anyway. */
+        Bool done = True;
+        for (Size f = 0; f < old->fence_count && done; f++) {
+            if (old->fences[f] &&
+                vkGetFenceStatus (self->info.device, old->fences[f]) != VK_SUCCESS) {
+                done = False;
+            }
+        }
+
+        if (!done) {
+            s++;
+            continue;
+        }
+
+        xw_vk_retired_swapchain_destroy (self, old);
+        self->retired[s] = self->retired[--self->retired_count];
+    }
+
+    return self;
+}
+
+/**
+ * @b Acquire index of next swapchain image to render to.
+ *
+ * If swapchain is out of date, it's recreated here before acquiring. This happens at-most once
+ * per call, no matter how many resize events were received since last frame.
+ *
+ * @param self
+ * @param image_available Semaphore signalled when image is ready to be rendered to.
+ * @param timeout Timeout in nanoseconds.
+ * @param image_index Acquired image index is stored here.
+ *
+ * @return @c VK_SUCCESS when an image was acquired. @c VK_SUBOPTIMAL_KHR is reported as success,
+ *         because swapchain is already marked for recreate.
+ * @return @c VK_NOT_READY if window is minimized (zero extent) and there's nothing to render to.
+ * @return @c VK_ERROR_OUT_OF_DATE_KHR if swapchain went out of date right after recreate. Frame
+ *         must be skipped, swapchain will be recreated in next call.
+ * @return Other errors from @c vkAcquireNextImageKHR or swapchain creation.
+ * */
+VkResult xw_vk_swapchain_acquire (
+    XwVkSwapchain *self,
+    VkSemaphore    image_available,
+    Uint64         timeout,
+    Uint32        *image_index
+) {
+    RETURN_VALUE_IF (
+        !self || !image_available || !image_index,
+        VK_ERROR_UNKNOWN,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    xw_vk_swapchain_collect_retired (self);
+
+    if (self->out_of_date || !self->swapchain) {
+        VkResult res = xw_vk_swapchain_rebuild (self);
+        if (res != VK_SUCCESS) {
+            return res;
+        }
+    }
+
+    VkResult res = vkAcquireNextImageKHR (
+        self->info.device,
+        self->swapchain,
+        timeout,
+        image_available,
+        VK_NULL_HANDLE,
+        image_index
+    );
+
+    if (res == VK_SUBOPTIMAL_KHR) {
+        self->out_of_date = True;
+        return VK_SUCCESS;
+    }
+
+    if (res == VK_ERROR_OUT_OF_DATE_KHR) {
+        self->out_of_date = True;
+    }
+
+    return res;
+}
+
+/**
+ * @b Present an acquired image.
+ *
+ * @param self
+ * @param queue Queue to present on. Must be the same queue rendering commands were submitted to.
+ * @param render_finished Semaphore signalled by rendering to this image.
+ * @param render_fence Fence signalled by rendering to this image. Images of this swapchain are
+ *        not destroyed after a recreate until this fence signals.
+ * @param image_index Index returned by @c xw_vk_swapchain_acquire.
+ *
+ * @return @c VK_SUCCESS on success, also when swapchain is out of date or suboptimal, because
+ *         it's already marked for recreate.
+ * @return Other errors from @c vkQueuePresentKHR.
+ * */
+VkResult xw_vk_swapchain_present (
+    XwVkSwapchain *self,
+    VkQueue        queue,
+    VkSemaphore    render_finished,
+    VkFence        render_fence,
+    Uint32         image_index
+) {
+    RETURN_VALUE_IF (
+        !self || !queue || !render_fence || image_index >= self->image_count,
+        VK_ERROR_UNKNOWN,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    self->image_fences[image_index] = render_fence;
+
+    VkPresentInfoKHR present_info = {
+        .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        .pNext              = Null,
+        .waitSemaphoreCount = render_finished ? 1 : 0,
+        .pWaitSemaphores    = &render_finished,
+        .swapchainCount     = 1,
+        .pSwapchains        = &self->swapchain,
+        .pImageIndices      = &image_index,
+        .pResults           = Null
+    };
+
+    VkResult res = vkQueuePresentKHR (queue, &present_info);
+    if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR) {
+        self->out_of_date = True;
+        return VK_SUCCESS;
+    }
+
+    return res;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Select surface format and present mode, using cached surface info. Current format is
+ *    preferred over the one in create info, so that a recreate changes format only if current
+ *    one is not supported anymore.
+ *
+ * @param self
+ *
+ * @return @c VK_SUCCESS on success.
+ * @return Error code of surface info query otherwise.
+ * */
+static VkResult xw_vk_swapchain_select_surface_format_and_present_mode (XwVkSwapchain *self) {
+    RETURN_VALUE_IF (!self, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    /* nothing could have changed if cached info is still valid */
+    if (self->surface_info->valid && self->surface_format.format != VK_FORMAT_UNDEFINED) {
+        return VK_SUCCESS;
+    }
+
+    VkResult res = xw_vk_surface_info_query (self->surface_info);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to query surface info. RET = %d\n", res);
+
+    VkSurfaceFormatKHR preferred = self->surface_format.format != VK_FORMAT_UNDEFINED ?
+                                       self->surface_format :
+                                       self->info.surface_format;
+
+    self->surface_format = xw_vk_choose_surface_format (self->surface_info, preferred);
+
+    self->present_mode = xw_vk_choose_present_mode (self->surface_info, self->info.latency_policy);
+
+    return VK_SUCCESS;
+}
+
+/**
+ * @b Create a new swapchain, passing current one as @c oldSwapchain, and retire the current one.
+ *    Never waits for GPU.
+ *
+ * @param self
+ *
+ * @return @c VK_SUCCESS on success.
+ * @return @c VK_NOT_READY if surface has zero extent. Swapchain stays out of date.
+ * @return Error from swapchain or image view creation otherwise.
+ * */
+static VkResult xw_vk_swapchain_rebuild (XwVkSwapchain *self) {
+    RETURN_VALUE_IF (!self, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    /* surface info is invalidated by resize or monitor change */
+    VkResult res = xw_vk_swapchain_select_surface_format_and_present_mode (self);
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS,
+        res,
+        "Failed to select surface format and present mode. RET = %d\n",
+        res
+    );
+
+    VkSurfaceCapabilitiesKHR caps;
+    res = vkGetPhysicalDeviceSurfaceCapabilitiesKHR (self->info.gpu, self->info.surface, &caps);
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS,
+        res,
+        "Failed to get surface capabilities. RET = %d\n",
+        res
+    );
+
+    /* surface size is determined by swapchain extent in this case */
+    VkExtent2D extent = caps.currentExtent;
+    if (extent.width == UINT32_MAX) {
+        VkExtent2D size = self->info.extent;
+        extent.width  = CLAMP (size.width, caps.minImageExtent.width, caps.maxImageExtent.width);
+        extent.height = CLAMP (size.height, caps.minImageExtent.height, caps.maxImageExtent.height);
+    }
+
+    /* minimized, keep the old swapchain (if any) until window is visible again */
+    if (!extent.width || !extent.height) {
+        self->out_of_date = True;
+        return VK_NOT_READY;
+    }
+
+    Uint32 min_image_count = self->info.min_image_count ? self->info.min_image_count :
+                                                          caps.minImageCount + 1;
+    min_image_count        = MAX (min_image_count, caps.minImageCount);
+    if (caps.maxImageCount) {
+        min_image_count = MIN (min_image_count, caps.maxImageCount);
+    }
+
+    VkCompositeAlphaFlagBitsKHR composite_alpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    if (!(caps.supportedCompositeAlpha & composite_alpha)) {
+        /* lowest set bit is a supported one */
+        composite_alpha = caps.supportedCompositeAlpha & -caps.supportedCompositeAlpha;
+    }
+
+    VkSwapchainCreateInfoKHR create_info = {
+        .sType                 = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
+        .pNext                 = Null,
+        .flags                 = 0,
+        .surface               = self->info.surface,
+        .minImageCount         = min_image_count,
+        .imageFormat           = self->surface_format.format,
+        .imageColorSpace       = self->surface_format.colorSpace,
+        .imageExtent           = extent,
+        .imageArrayLayers      = 1,
+        .imageUsage            = self->info.image_usage ? self->info.image_usage :
+                                                          VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+        .imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices   = Null,
+        .preTransform          = caps.currentTransform,
+        .compositeAlpha        = composite_alpha,
+        .presentMode           = self->present_mode,
+        .clipped               = VK_TRUE,
+        .oldSwapchain          = self->swapchain
+    };
+
+    /* make space for old swapchain first, so retiring it after creation never fails */
+    RETURN_VALUE_IF (
+        !xw_vk_swapchain_reserve_retired (self),
+        VK_ERROR_OUT_OF_HOST_MEMORY,
+        ERR_OUT_OF_MEMORY
+    );
+
+    VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+    res = vkCreateSwapchainKHR (self->info.device, &create_info, Null, &swapchain);
+
+    /* old swapchain is retired even if creation fails, it cannot be presented to anymore */
+    if (self->swapchain) {
+        xw_vk_swapchain_retire (self, self->retired + self->retired_count++);
+    }
+
+    self->swapchain = swapchain;
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create swapchain. RET = %d\n", res);
+
+    self->extent = extent;
+    self->generation++;
+
+    /* try again in next acquire if views or framebuffers could not be created */
+    res               = xw_vk_swapchain_create_image_objects (self);
+    self->out_of_date = res != VK_SUCCESS;
+
+    return res;
+}
+
+/**
+ * @b Get images of current swapchain and create image views (and framebuffers if render pass
+ *    was provided) for them.
+ *
+ * @param self
+ *
+ * @return @c VK_SUCCESS on success.
+ * @return Error code otherwise.
+ * */
+static VkResult xw_vk_swapchain_create_image_objects (XwVkSwapchain *self) {
+    RETURN_VALUE_IF (!self, VK_ERROR_UNKNOWN, ERR_INVALID_ARGUMENTS);
+
+    VkDevice device = self->info.device;
+    Uint32   count  = 0;
+    VkResult res    = vkGetSwapchainImagesKHR (device, self->swapchain, &count, Null);
+    RETURN_VALUE_IF (
+        res != VK_SUCCESS,
+        res,
+        "Failed to get number of swapchain images. RET = %d\n",
+        res
+    );
+
+    /* image handles are owned by swapchain, so only this array is reused */
+    VkImage *images = XW_REALLOCATE (XW_ALLOC_CATEGORY_VULKAN, self->images, VkImage, count);
+    RETURN_VALUE_IF (!images, VK_ERROR_OUT_OF_HOST_MEMORY, ERR_OUT_OF_MEMORY);
+    self->images = images;
+
+    /* views, framebuffers and fences of previous swapchain are owned by a retired entry now */
+    self->image_views  = XW_ALLOCATE (XW_ALLOC_CATEGORY_VULKAN, VkImageView, count);
+    self->framebuffers = XW_ALLOCATE (XW_ALLOC_CATEGORY_VULKAN, VkFramebuffer, count);
+    self->image_fences = XW_ALLOCATE (XW_ALLOC_CATEGORY_VULKAN, VkFence, count);
+    RETURN_VALUE_IF (
+        !self->image_views || !self->framebuffers || !self->image_fences,
+        VK_ERROR_OUT_OF_HOST_MEMORY,
+        ERR_OUT_OF_MEMORY
+    );
+
+    res = vkGetSwapchainImagesKHR (device, self->swapchain, &count, self->images);
+    RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to get swapchain images. RET = %d\n", res);
+    self->image_count = count;
+
+    VkImageViewCreateInfo view_create_info = {
+        .sType      = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext      = Null,
+        .flags      = 0,
+        .image      = VK_NULL_HANDLE,
+        .viewType   = VK_IMAGE_VIEW_TYPE_2D,
+        .format     = self->surface_format.format,
+        .components = {VK_COMPONENT_SWIZZLE_IDENTITY,
+                       VK_COMPONENT_SWIZZLE_IDENTITY,
+                       VK_COMPONENT_SWIZZLE_IDENTITY,
+                       VK_COMPONENT_SWIZZLE_IDENTITY},
+        .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}
+    };
+
+    VkFramebufferCreateInfo framebuffer_create_info = {
+        .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+        .pNext           = Null,
+        .flags           = 0,
+        .renderPass      = self->info.render_pass,
+        .attachmentCount = 1,
+        .pAttachments    = Null,
+        .width           = self->extent.width,
+        .height          = self->extent.height,
+        .layers          = 1
+    };
+
+    for (Size s = 0; s < count; s++) {
+        view_create_info.image = self->images[s];
+        res = vkCreateImageView (device, &view_create_info, Null, self->image_views + s);
+        RETURN_VALUE_IF (res != VK_SUCCESS, res, "Failed to create image view. RET = %d\n", res);
+
+        if (self->info.render_pass) {
+            framebuffer_create_info.pAttachments = self->image_views + s;
+            VkFramebuffer *framebuffer = self->framebuffers + s;
+            res = vkCreateFramebuffer (device, &framebuffer_create_info, Null, framebuffer);
+            RETURN_VALUE_IF (
+                res != VK_SUCCESS,
+                res,
+                "Failed to create framebuffer. RET = %d\n",
+                res
+            );
+        }
+    }
+
+    return VK_SUCCESS;
+}
+
+/**
+ * @b Make sure retired list has space for one more entry.
+ *
+ * @param self
+ *
+ * @return @c True on success.
+ * @return @c False otherwise.
+ * */
+static Bool xw_vk_swapchain_reserve_retired (XwVkSwapchain *self) {
+    RETURN_VALUE_IF (!self, False, ERR_INVALID_ARGUMENTS);
+
+    if (self->retired_count < self->retired_capacity) {
+        return True;
+    }
+
+    Size                  capacity = self->retired_capacity ? self->retired_capacity * 2 : 4;
+    XwVkRetiredSwapchain *retired =
+        XW_REALLOCATE (XW_ALLOC_CATEGORY_VULKAN, self->retired, XwVkRetiredSwapchain, capacity);
+    RETURN_VALUE_IF (!retired, False, ERR_OUT_OF_MEMORY);
+
+    self->retired          = retired;
+    self->retired_capacity = capacity;
+
+    return True;
+}
+
+/**
+ * @b Move current swapchain and objects created for it's images to given retired entry.
+ *    Current swapchain handle is reset but not destroyed.
+ *
+ * @param self
+ * @param old Where retired swapchain is stored.
+ * */
+static void xw_vk_swapchain_retire (XwVkSwapchain *self, XwVkRetiredSwapchain *old) {
+    RETURN_IF (!self || !old, ERR_INVALID_ARGUMENTS);
+
+    *old = (XwVkRetiredSwapchain) {
+        .swapchain    = self->swapchain,
+        .image_count  = self->image_count,
+        .image_views  = self->image_views,
+        .framebuffers = self->framebuffers,
+        .fence_count  = self->image_count,
+        .fences       = self->image_fences,
+    };
+
+    self->swapchain    = VK_NULL_HANDLE;
+    self->image_count  = 0;
+    self->image_views  = Null;
+    self->framebuffers = Null;
+    self->image_fences = Null;
+}
+
+/**
+ * @b Destroy swapchain and objects in given retired entry. Entry is not removed from list.
+ *
+ * @param self
+ * @param old
+ * */
+static void xw_vk_retired_swapchain_destroy (XwVkSwapchain *self, XwVkRetiredSwapchain *old) {
+    RETURN_IF (!self || !old, ERR_INVALID_ARGUMENTS);
+
+    VkDevice device = self->info.device;
+
+    /* arrays may be partially filled if image object creation failed in between */
+    for (Size s = 0; s < old->image_count; s++) {
+        if (old->framebuffers && old->framebuffers[s]) {
+            vkDestroyFramebuffer (device, old->framebuffers[s], Null);
+        }
+
+        if (old->image_views && old->image_views[s]) {
+            vkDestroyImageView (device, old->image_views[s], Null);
+        }
+    }
+
+    if (old->swapchain) {
+        vkDestroySwapchainKHR (device, old->swapchain, Null);
+    }
+
+    if (old->image_views) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, old->image_views);
+    }
+
+    if (old->framebuffers) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, old->framebuffers);
+    }
+
+    if (old->fences) {
+        XW_FREE (XW_ALLOC_CATEGORY_VULKAN, old->fences);
+    }
+
+    memset (old, 0, sizeof (XwVkRetiredSwapchain));
+}
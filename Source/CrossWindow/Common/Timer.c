@@ -0,0 +1,396 @@
+/**
+ * @file Timer.c
+ * @time 18/10/2026 13:25:53
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Event.h"
+#include "Lock.h"
+#include "Log.h"
+#include "Timer.h"
+
+/* libc headers */
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#define XW_TIMER_SLOT_MASK (XW_TIMER_WHEEL_SLOTS - 1)
+
+struct XwTimer {
+    struct XwTimer *prev; /**< @b Previous timer in slot. */
+    struct XwTimer *next; /**< @b Next timer in slot. */
+
+    Uint64 interval_ns;
+    Uint64 deadline_ns; /**< @b CLOCK_MONOTONIC time of next expiry. */
+    Bool   repeat;
+    Bool   armed; /**< @b Timer is in wheel. One shot timers leave it once expired. */
+    Size   slot;  /**< @b Slot of wheel timer is in, when armed. */
+    void  *user;
+};
+
+static struct {
+    XwTimer *slots[XW_TIMER_WHEEL_SLOTS];
+    Uint64   occupied[XW_TIMER_WHEEL_SLOTS / 64]; /**< @b Bit set for every non-empty slot. */
+    Uint64   current_tick; /**< @b Earliest tick that may still have expired timers. */
+    Uint64   armed_ns;     /**< @b Time timerfd is set to expire at, 0 if disarmed. */
+    Size     count;        /**< @b Timers in wheel. */
+    int      fd;
+    XwMutex  lock; /**< @b Timers are created and destroyed from any thread. */
+} xw_timers = {.fd = -1};
+
+static void xw_timer_insert (XwTimer *timer);
+static void xw_timer_unlink (XwTimer *timer);
+static void xw_timer_arm_fd (Uint64 deadline_ns);
+static void xw_timer_rearm_fd (void);
+
+/**
+ * @b Create a timer and start it.
+ *
+ * Each time the timer expires, an @c XW_EVENT_TYPE_TIMER event is returned by @c xw_event_poll
+ * and @c xw_event_wait, carrying given @c user value. A repeating timer keeps expiring every
+ * @c interval_ns from the time it was created (not from time event was polled), so it does not
+ * drift. If event loop falls behind, missed expirations are reported in a single event.
+ *
+ * Can be called from any thread when built with thread-safe mode.
+ *
+ * @param interval_ns Time in nanoseconds till first expiry, and between expiries.
+ * @param repeat Keep expiring till destroyed. One shot timers must be destroyed as well.
+ * @param user Passed as is in timer events.
+ *
+ * @return @c XwTimer* on success.
+ * @return @c Null otherwise.
+ * */
+XwTimer *xw_timer_create (Uint64 interval_ns, Bool repeat, void *user) {
+    RETURN_VALUE_IF (!interval_ns, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (xw_timers.fd < 0, Null, "CrossWindow is not initialized\n");
+
+    XwTimer *timer = XW_NEW (XW_ALLOC_CATEGORY_TIMER, XwTimer);
+    RETURN_VALUE_IF (!timer, Null, ERR_OUT_OF_MEMORY);
+
+    timer->interval_ns = interval_ns;
+    timer->repeat      = !!repeat;
+    timer->user        = user;
+
+    XW_MUTEX_LOCK (&xw_timers.lock);
+
+    Uint64 now = xw_timer_now_ns();
+
+    /* wheel is not advanced while empty, so catch up before using it again */
+    if (!xw_timers.count) {
+        xw_timers.current_tick = now / XW_TIMER_TICK_NS;
+    }
+
+    timer->deadline_ns = now + interval_ns;
+    xw_timer_insert (timer);
+
+    if (!xw_timers.armed_ns || timer->deadline_ns < xw_timers.armed_ns) {
+        xw_timer_arm_fd (timer->deadline_ns);
+    }
+
+    XW_MUTEX_UNLOCK (&xw_timers.lock);
+
+    return timer;
+}
+
+/**
+ * @b Stop and destroy given timer. Timer events already polled still refer to it.
+ *
+ * Timers still alive when CrossWindow is deinitialized must be destroyed after that as well.
+ *
+ * @param timer
+ * */
+void xw_timer_destroy (XwTimer *timer) {
+    RETURN_IF (!timer, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&xw_timers.lock);
+    if (timer->armed) {
+        xw_timer_unlink (timer);
+    }
+    XW_MUTEX_UNLOCK (&xw_timers.lock);
+
+    XW_FREE (XW_ALLOC_CATEGORY_TIMER, timer);
+}
+
+/**
+ * @b Create timerfd that all timers share.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_timer_wheel_init (void) {
+    if (xw_timers.fd >= 0) {
+        return True;
+    }
+
+    RETURN_VALUE_IF (XW_MUTEX_INIT (&xw_timers.lock), False, "Failed to create timer lock\n");
+
+    xw_timers.fd = timerfd_create (CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    GOTO_HANDLER_IF (xw_timers.fd < 0, TIMERFD_FAILED, "Failed to create timerfd\n");
+
+    return True;
+
+TIMERFD_FAILED:
+    XW_MUTEX_DEINIT (&xw_timers.lock);
+    return False;
+}
+
+/**
+ * @b Close timerfd. Timers still in wheel are taken out of it and left to application to
+ *    destroy, but never expire again.
+ * */
+void xw_timer_wheel_deinit (void) {
+    if (xw_timers.fd < 0) {
+        return;
+    }
+
+    /* destroying a timer after this must not touch the wheel */
+    for (Size s = 0; s < XW_TIMER_WHEEL_SLOTS; s++) {
+        XwTimer *timer = xw_timers.slots[s];
+        while (timer) {
+            XwTimer *next = timer->next;
+            timer->prev   = Null;
+            timer->next   = Null;
+            timer->armed  = False;
+            timer         = next;
+        }
+    }
+
+    close (xw_timers.fd);
+    XW_MUTEX_DEINIT (&xw_timers.lock);
+
+    memset (&xw_timers, 0, sizeof (xw_timers));
+    xw_timers.fd = -1;
+}
+
+/**
+ * @b Get timerfd to be polled for reading while waiting for events. It becomes readable
+ *    when some timer may have expired.
+ *
+ * @return timerfd, -1 if not created.
+ * */
+int xw_timer_wheel_fd (void) {
+    return xw_timers.fd;
+}
+
+/**
+ * @b Check whether any timer is running, and so waiting on timerfd will return sometime.
+ * */
+Bool xw_timer_wheel_pending (void) {
+    XW_MUTEX_LOCK (&xw_timers.lock);
+    Bool pending = !!xw_timers.count;
+    XW_MUTEX_UNLOCK (&xw_timers.lock);
+
+    return pending;
+}
+
+/**
+ * @b Get an event for next expired timer, if any. Repeating timer is put back in wheel for
+ *    it's next expiry. When no timer has expired, timerfd is armed for next expiry.
+ *
+ * @param event Where timer event is stored.
+ *
+ * @return True if a timer had expired.
+ * @return False otherwise.
+ * */
+Bool xw_timer_wheel_pop (XwEvent *event) {
+    RETURN_VALUE_IF (!event, False, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&xw_timers.lock);
+
+    if (!xw_timers.count) {
+        if (xw_timers.armed_ns) {
+            xw_timer_arm_fd (0);
+        }
+        XW_MUTEX_UNLOCK (&xw_timers.lock);
+        return False;
+    }
+
+    Uint64 now      = xw_timer_now_ns();
+    Uint64 now_tick = now / XW_TIMER_TICK_NS;
+
+    /* after a full revolution every slot has been looked at once */
+    if (now_tick >= xw_timers.current_tick + XW_TIMER_WHEEL_SLOTS) {
+        xw_timers.current_tick = now_tick - XW_TIMER_WHEEL_SLOTS + 1;
+    }
+
+    /* current tick is advanced only past slots having no expired timers left, and never past
+     * current time, because slot of current tick may have timers expiring later in it */
+    while (True) {
+        XwTimer *timer = xw_timers.slots[xw_timers.current_tick & XW_TIMER_SLOT_MASK];
+        while (timer && timer->deadline_ns > now) {
+            timer = timer->next;
+        }
+
+        if (timer) {
+            xw_timer_unlink (timer);
+
+            Uint64 expirations = 1;
+            if (timer->repeat) {
+                /* skip intervals event loop was too late for, instead of bursting them */
+                Uint64 late = now - timer->deadline_ns;
+                expirations += late / timer->interval_ns;
+
+                timer->deadline_ns += expirations * timer->interval_ns;
+                xw_timer_insert (timer);
+            }
+
+            xw_event_make_timer (event, timer, timer->user, expirations);
+
+            XW_MUTEX_UNLOCK (&xw_timers.lock);
+            return True;
+        }
+
+        if (xw_timers.current_tick >= now_tick) {
+            break;
+        }
+        xw_timers.current_tick++;
+    }
+
+    /* timerfd fired, or will in a moment, reset it and set it for next expiry */
+    if (!xw_timers.armed_ns || xw_timers.armed_ns <= now) {
+        Uint64 expired = 0;
+        if (read (xw_timers.fd, &expired, sizeof (expired)) < 0) {
+            XW_LOG_DEBUG ("timerfd was not readable yet\n");
+        }
+        xw_timer_rearm_fd();
+    }
+
+    XW_MUTEX_UNLOCK (&xw_timers.lock);
+    return False;
+}
+
+/**
+ * @b Get current CLOCK_MONOTONIC time, which timer deadlines and event wait deadlines use.
+ * */
+Uint64 xw_timer_now_ns (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Add timer to head of slot of it's deadline. Deadlines already passed go to current slot.
+ * */
+static void xw_timer_insert (XwTimer *timer) {
+    Uint64 tick = MAX (timer->deadline_ns / XW_TIMER_TICK_NS, xw_timers.current_tick);
+    Size   slot = tick & XW_TIMER_SLOT_MASK;
+
+    timer->prev = Null;
+    timer->next = xw_timers.slots[slot];
+    if (timer->next) {
+        timer->next->prev = timer;
+    }
+    xw_timers.slots[slot] = timer;
+
+    xw_timers.occupied[slot / 64] |= 1ull << (slot % 64);
+    xw_timers.count++;
+    timer->slot  = slot;
+    timer->armed = True;
+}
+
+/**
+ * @b Remove timer from it's slot.
+ * */
+static void xw_timer_unlink (XwTimer *timer) {
+    if (timer->prev) {
+        timer->prev->next = timer->next;
+    } else {
+        xw_timers.slots[timer->slot] = timer->next;
+        if (!timer->next) {
+            xw_timers.occupied[timer->slot / 64] &= ~(1ull << (timer->slot % 64));
+        }
+    }
+    if (timer->next) {
+        timer->next->prev = timer->prev;
+    }
+
+    timer->prev = timer->next = Null;
+    xw_timers.count--;
+    timer->armed = False;
+}
+
+/**
+ * @b Set timerfd to expire at given CLOCK_MONOTONIC time, or disarm it if 0.
+ * */
+static void xw_timer_arm_fd (Uint64 deadline_ns) {
+    struct itimerspec spec = {0};
+    spec.it_value.tv_sec   = deadline_ns / 1000000000ull;
+    spec.it_value.tv_nsec  = deadline_ns % 1000000000ull;
+
+    if (timerfd_settime (xw_timers.fd, TFD_TIMER_ABSTIME, &spec, Null) < 0) {
+        XW_LOG_ERROR ("Failed to set timerfd\n");
+    }
+    xw_timers.armed_ns = deadline_ns;
+}
+
+/**
+ * @b Set timerfd for earliest deadline in current revolution of wheel. Non-empty slots are
+ *    found using bitmap, so only slots with timers are looked into.
+ * */
+static void xw_timer_rearm_fd (void) {
+    Uint64 first = xw_timers.current_tick;
+    Uint64 last  = first + XW_TIMER_WHEEL_SLOTS;
+    Uint64 next  = 0;
+
+    for (Uint64 tick = first; tick < last && !next; tick++) {
+        Size   slot = tick & XW_TIMER_SLOT_MASK;
+        Uint64 bits = xw_timers.occupied[slot / 64] >> (slot % 64);
+        if (!bits) {
+            tick += 63 - slot % 64;
+            continue;
+        }
+
+        tick += __builtin_ctzll (bits);
+        if (tick >= last) {
+            break;
+        }
+
+        /* slot may have timers of later revolutions only */
+        for (XwTimer *timer = xw_timers.slots[tick & XW_TIMER_SLOT_MASK]; timer;
+             timer          = timer->next) {
+            if (timer->deadline_ns / XW_TIMER_TICK_NS <= tick) {
+                next = next ? MIN (next, timer->deadline_ns) : timer->deadline_ns;
+            }
+        }
+    }
+
+    /* every timer is more than a revolution away, look again after one */
+    if (!next && xw_timers.count) {
+        next = last * XW_TIMER_TICK_NS;
+    }
+
+    xw_timer_arm_fd (next);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file Timer.h
+ * @time 18/10/2026 13:25:53
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_TIMER_H
+#define ANVIE_CROSSWINDOW_COMMON_TIMER_H
+
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Timer.h>
+
+/** @b Time covered by one slot of timer wheel. */
+#define XW_TIMER_TICK_NS 1000000ull
+
+/** @b Slots in timer wheel. Timers further than this many ticks away wake the wheel once
+ *     per revolution. Must be a power of two, and a multiple of 64. */
+#define XW_TIMER_WHEEL_SLOTS 1024
+
+/* All timers live in a single hashed timing wheel. Each slot holds a list of timers expiring
+ * in ticks equal to slot index modulo slot count, so arming and cancelling a timer are O(1).
+ * A timerfd is kept armed to the earliest deadline in current revolution of the wheel, to be
+ * waited on along with display server connection. */
+
+Bool xw_timer_wheel_init (void);
+void xw_timer_wheel_deinit (void);
+int  xw_timer_wheel_fd (void);
+Bool xw_timer_wheel_pending (void);
+Bool xw_timer_wheel_pop (XwEvent *event);
+
+Uint64 xw_timer_now_ns (void);
+
+#endif // ANVIE_CROSSWINDOW_COMMON_TIMER_H
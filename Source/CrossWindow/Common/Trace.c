@@ -0,0 +1,583 @@
+/**
+ * @file Trace.c
+ * @time 18/10/2026 12:55:28
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Trace.h>
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+#include "Trace.h"
+
+#define ERR_TRACING_DISABLED                                                                       \
+    "CrossWindow is built without tracing support (enable CROSSWINDOW_ENABLE_TRACING)\n"
+
+#ifdef XW_ENABLE_TRACING
+
+/* libc headers */
+#include <pthread.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/** @b Number of records each thread keeps. Once full, oldest records are overwritten. */
+#ifndef XW_TRACE_BUFFER_CAPACITY
+#    define XW_TRACE_BUFFER_CAPACITY 32768
+#endif
+
+/** @b Longest name written to a perfetto trace, longer names are truncated. */
+#define XW_TRACE_MAX_NAME_LENGTH 128
+
+typedef struct XwTraceRecord {
+    Uint64       timestamp; /**< @b Nanoseconds, CLOCK_MONOTONIC */
+    CString      name;
+    CString      arg_name; /**< @b Null if record has no argument */
+    Uint64       arg;
+    XwTracePhase phase;
+} XwTraceRecord;
+
+/**
+ * @b Latest records made by a single thread, in a ring.
+ *
+ * Only the owner thread writes records. Record with index @c i is stored in slot
+ * @c i % XW_TRACE_BUFFER_CAPACITY, and is published by storing @c i + 1 to @c head with
+ * release semantics. Reusing a slot overwrites the record @c XW_TRACE_BUFFER_CAPACITY older,
+ * so readers copy a record, and then check @c head to know whether slot was reused meanwhile
+ * (like a seqlock, with @c head as sequence).
+ *
+ * Buffers are never freed while library is loaded, so readers can walk the list at any time.
+ * Once it's owner thread exits, a buffer is handed to the next thread that starts tracing.
+ * */
+typedef struct XwTraceBuffer {
+    struct XwTraceBuffer *next;
+    Bool                  in_use;  /**< @b Owned by a running thread. */
+    Uint32                tid;     /**< @b Owner thread, or last owner if not in use. */
+    Size                  head;    /**< @b Number of records ever made into this buffer. */
+    Size                  cleared; /**< @b Records before this index are not dumped. */
+    XwTraceRecord         records[XW_TRACE_BUFFER_CAPACITY];
+} XwTraceBuffer;
+
+/** @b Encoder state for a single protobuf message. */
+typedef struct XwProtoMessage {
+    Uint8 data[512];
+    Size  size;
+} XwProtoMessage;
+
+/* all buffers ever created, new buffers are pushed to front with compare and swap */
+static XwTraceBuffer *xw_trace_buffers = Null;
+
+static _Thread_local XwTraceBuffer *xw_trace_buffer = Null;
+
+/* releases buffer of a thread when it exits */
+static pthread_once_t xw_trace_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t  xw_trace_key;
+static Bool           xw_trace_key_created = False;
+
+static XwTraceBuffer *xw_trace_buffer_acquire (void);
+static void           xw_trace_buffer_push (XwTraceBuffer *buffer);
+static void           xw_trace_buffer_release (void *buffer);
+static void           xw_trace_key_create (void);
+static Size           xw_trace_buffer_first (XwTraceBuffer *buffer, Size head);
+static Uint64         xw_trace_now (void);
+
+static Bool xw_trace_buffer_read (XwTraceBuffer *buffer, Size index, XwTraceRecord *record);
+static Bool xw_trace_balance (Size *depth, XwTracePhase phase);
+
+static void xw_proto_put_varint (XwProtoMessage *msg, Uint64 value);
+static void xw_proto_put_uint (XwProtoMessage *msg, Uint32 field, Uint64 value);
+static void xw_proto_put_bytes (XwProtoMessage *msg, Uint32 field, const void *data, Size size);
+static void xw_proto_put_string (XwProtoMessage *msg, Uint32 field, CString str);
+static Bool xw_proto_write_packet (FILE *file, const XwProtoMessage *packet);
+
+/**
+ * @b Record a single trace event for calling thread. Use through @c XW_TRACE_* macros.
+ *
+ * @param phase Whether a slice begins or ends.
+ * @param name Name of slice. Must stay valid till trace is dumped.
+ * @param arg_name Name of argument, or @c Null if there's no argument. Must stay valid
+ *        till trace is dumped.
+ * @param arg Argument value.
+ * */
+void xw_trace_record (XwTracePhase phase, CString name, CString arg_name, Uint64 arg) {
+    XwTraceBuffer *buffer = xw_trace_buffer ? xw_trace_buffer : xw_trace_buffer_acquire();
+    if (!buffer) {
+        return;
+    }
+
+    Size           head   = __atomic_load_n (&buffer->head, __ATOMIC_RELAXED);
+    XwTraceRecord *record = buffer->records + head % XW_TRACE_BUFFER_CAPACITY;
+
+    /* a reader that sees any of the new values also sees current head, and so knows that the
+     * record it was copying from this slot got overwritten. These are plain moves on x86. */
+    __atomic_store_n (&record->timestamp, xw_trace_now(), __ATOMIC_RELEASE);
+    __atomic_store_n (&record->name, name, __ATOMIC_RELEASE);
+    __atomic_store_n (&record->arg_name, arg_name, __ATOMIC_RELEASE);
+    __atomic_store_n (&record->arg, arg, __ATOMIC_RELEASE);
+    __atomic_store_n (&record->phase, phase, __ATOMIC_RELEASE);
+
+    __atomic_store_n (&buffer->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @b Whether CrossWindow is built with tracing support.
+ * */
+Bool xw_trace_is_enabled (void) {
+    return True;
+}
+
+/**
+ * @b Write latest records of all threads, in Chrome trace event JSON format. Each thread
+ *    keeps its last @c XW_TRACE_BUFFER_CAPACITY records.
+ *
+ * Can be called while other threads are still tracing, records made by them after the
+ * call starts may or may not be part of the dump.
+ *
+ * REF : https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+ *
+ * @param path File to write trace to. Overwritten if it already exists.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_trace_dump_chrome_json (CString path) {
+    RETURN_VALUE_IF (!path, False, ERR_INVALID_ARGUMENTS);
+
+    FILE *file = fopen (path, "w");
+    RETURN_VALUE_IF (!file, False, ERR_FILE_OPEN_FAILED);
+
+    Int32 pid   = getpid();
+    Bool  first = True;
+
+    fputs ("{\"traceEvents\":[", file);
+
+    XwTraceBuffer *buffer = __atomic_load_n (&xw_trace_buffers, __ATOMIC_ACQUIRE);
+    for (; buffer; buffer = buffer->next) {
+        Uint32 tid   = __atomic_load_n (&buffer->tid, __ATOMIC_RELAXED);
+        Size   head  = __atomic_load_n (&buffer->head, __ATOMIC_ACQUIRE);
+        Size   depth = 0;
+
+        for (Size r = xw_trace_buffer_first (buffer, head); r < head; r++) {
+            XwTraceRecord record;
+            if (!xw_trace_buffer_read (buffer, r, &record) ||
+                !xw_trace_balance (&depth, record.phase)) {
+                continue;
+            }
+
+            /* names are internal string literals, so they never need escaping */
+            fprintf (
+                file,
+                "%s\n{\"name\":\"%s\",\"cat\":\"crosswindow\",\"ph\":\"%c\",\"ts\":%llu.%03llu,"
+                "\"pid\":%d,\"tid\":%u",
+                first ? "" : ",",
+                record.name,
+                (Char)record.phase,
+                record.timestamp / 1000,
+                record.timestamp % 1000,
+                pid,
+                tid
+            );
+            if (record.arg_name) {
+                fprintf (file, ",\"args\":{\"%s\":%llu}", record.arg_name, record.arg);
+            }
+            fputc ('}', file);
+
+            first = False;
+        }
+    }
+
+    fputs ("\n],\"displayTimeUnit\":\"ns\"}\n", file);
+
+    Bool failed = !!ferror (file);
+    failed      = !!fclose (file) || failed;
+    RETURN_VALUE_IF (failed, False, "Failed to write trace file\n");
+
+    return True;
+}
+
+/**
+ * @b Write latest records of all threads as a Perfetto protobuf trace, see
+ *    @c xw_trace_dump_chrome_json.
+ *
+ * Each thread gets its own track. Timestamps are in CLOCK_MONOTONIC domain, so the trace
+ * can be merged with system traces recorded by perfetto on the same machine.
+ *
+ * REF : https://perfetto.dev/docs/reference/synthetic-track-event
+ *
+ * @param path File to write trace to. Overwritten if it already exists.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_trace_dump_perfetto (CString path) {
+    RETURN_VALUE_IF (!path, False, ERR_INVALID_ARGUMENTS);
+
+    FILE *file = fopen (path, "wb");
+    RETURN_VALUE_IF (!file, False, ERR_FILE_OPEN_FAILED);
+
+    /* protobuf field numbers from perfetto's trace_packet.proto and track_event.proto */
+    enum {
+        TRACE_PACKET_TIMESTAMP                  = 8,
+        TRACE_PACKET_TRUSTED_PACKET_SEQUENCE_ID = 10,
+        TRACE_PACKET_TRACK_EVENT                = 11,
+        TRACE_PACKET_TIMESTAMP_CLOCK_ID         = 58,
+        TRACE_PACKET_TRACK_DESCRIPTOR           = 60,
+        TRACK_DESCRIPTOR_UUID                   = 1,
+        TRACK_DESCRIPTOR_THREAD                 = 4,
+        THREAD_DESCRIPTOR_PID                   = 1,
+        THREAD_DESCRIPTOR_TID                   = 2,
+        TRACK_EVENT_DEBUG_ANNOTATIONS           = 4,
+        TRACK_EVENT_TYPE                        = 9,
+        TRACK_EVENT_TRACK_UUID                  = 11,
+        TRACK_EVENT_NAME                        = 23,
+        DEBUG_ANNOTATION_UINT_VALUE             = 3,
+        DEBUG_ANNOTATION_NAME                   = 10,
+        TRACK_EVENT_TYPE_SLICE_BEGIN            = 1,
+        TRACK_EVENT_TYPE_SLICE_END              = 2,
+        BUILTIN_CLOCK_MONOTONIC                 = 3,
+    };
+
+    Int32  pid         = getpid();
+    Uint32 sequence_id = 0;
+    Bool   failed      = False;
+
+    XwTraceBuffer *buffer = __atomic_load_n (&xw_trace_buffers, __ATOMIC_ACQUIRE);
+    for (; buffer && !failed; buffer = buffer->next) {
+        Uint32 tid   = __atomic_load_n (&buffer->tid, __ATOMIC_RELAXED);
+        Size   head  = __atomic_load_n (&buffer->head, __ATOMIC_ACQUIRE);
+        Uint64 uuid  = ((Uint64)pid << 32) | tid;
+        Size   depth = 0;
+        sequence_id++;
+
+        /* describe the thread track all events of this buffer go to */
+        XwProtoMessage thread = {0}, track = {0}, packet = {0};
+        xw_proto_put_uint (&thread, THREAD_DESCRIPTOR_PID, pid);
+        xw_proto_put_uint (&thread, THREAD_DESCRIPTOR_TID, tid);
+        xw_proto_put_uint (&track, TRACK_DESCRIPTOR_UUID, uuid);
+        xw_proto_put_bytes (&track, TRACK_DESCRIPTOR_THREAD, thread.data, thread.size);
+        xw_proto_put_uint (&packet, TRACE_PACKET_TRUSTED_PACKET_SEQUENCE_ID, sequence_id);
+        xw_proto_put_bytes (&packet, TRACE_PACKET_TRACK_DESCRIPTOR, track.data, track.size);
+        failed = !xw_proto_write_packet (file, &packet);
+
+        for (Size r = xw_trace_buffer_first (buffer, head); r < head && !failed; r++) {
+            XwTraceRecord record;
+            if (!xw_trace_buffer_read (buffer, r, &record) ||
+                !xw_trace_balance (&depth, record.phase)) {
+                continue;
+            }
+
+            XwProtoMessage event = {0};
+            xw_proto_put_uint (
+                &event,
+                TRACK_EVENT_TYPE,
+                record.phase == XW_TRACE_PHASE_BEGIN ? TRACK_EVENT_TYPE_SLICE_BEGIN :
+                                                        TRACK_EVENT_TYPE_SLICE_END
+            );
+            xw_proto_put_uint (&event, TRACK_EVENT_TRACK_UUID, uuid);
+
+            if (record.phase == XW_TRACE_PHASE_BEGIN) {
+                xw_proto_put_string (&event, TRACK_EVENT_NAME, record.name);
+            }
+
+            if (record.arg_name) {
+                XwProtoMessage annotation = {0};
+                xw_proto_put_string (&annotation, DEBUG_ANNOTATION_NAME, record.arg_name);
+                xw_proto_put_uint (&annotation, DEBUG_ANNOTATION_UINT_VALUE, record.arg);
+                xw_proto_put_bytes (
+                    &event,
+                    TRACK_EVENT_DEBUG_ANNOTATIONS,
+                    annotation.data,
+                    annotation.size
+                );
+            }
+
+            packet.size = 0;
+            xw_proto_put_uint (&packet, TRACE_PACKET_TIMESTAMP, record.timestamp);
+            xw_proto_put_uint (&packet, TRACE_PACKET_TIMESTAMP_CLOCK_ID, BUILTIN_CLOCK_MONOTONIC);
+            xw_proto_put_uint (&packet, TRACE_PACKET_TRUSTED_PACKET_SEQUENCE_ID, sequence_id);
+            xw_proto_put_bytes (&packet, TRACE_PACKET_TRACK_EVENT, event.data, event.size);
+            failed = !xw_proto_write_packet (file, &packet);
+        }
+    }
+
+    failed = !!fclose (file) || failed;
+    RETURN_VALUE_IF (failed, False, "Failed to write trace file\n");
+
+    return True;
+}
+
+/**
+ * @b Forget all records made so far by all threads. Can be called while other threads are
+ *    still tracing, their records are only hidden from later dumps.
+ * */
+void xw_trace_clear (void) {
+    XwTraceBuffer *buffer = __atomic_load_n (&xw_trace_buffers, __ATOMIC_ACQUIRE);
+    for (; buffer; buffer = buffer->next) {
+        Size head = __atomic_load_n (&buffer->head, __ATOMIC_ACQUIRE);
+        __atomic_store_n (&buffer->cleared, head, __ATOMIC_RELAXED);
+    }
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Get a trace buffer for calling thread : one left by a thread that exited, or a new one
+ *    added to list of all buffers.
+ *
+ * Records of exited threads can still be dumped till their buffer is taken by another thread,
+ * so memory used stays bounded by the most threads tracing at once.
+ * */
+static XwTraceBuffer *xw_trace_buffer_acquire (void) {
+    pthread_once (&xw_trace_key_once, xw_trace_key_create);
+    Uint32 tid = (Uint32)syscall (SYS_gettid);
+
+    XwTraceBuffer *buffer = __atomic_load_n (&xw_trace_buffers, __ATOMIC_ACQUIRE);
+    for (; buffer; buffer = buffer->next) {
+        Bool in_use = False;
+        if (__atomic_compare_exchange_n (
+                &buffer->in_use,
+                &in_use,
+                True,
+                False,
+                __ATOMIC_ACQUIRE,
+                __ATOMIC_RELAXED
+            )) {
+            /* records of previous owner are not dumped under this thread's id */
+            __atomic_store_n (&buffer->tid, tid, __ATOMIC_RELAXED);
+            Size head = __atomic_load_n (&buffer->head, __ATOMIC_RELAXED);
+            __atomic_store_n (&buffer->cleared, head, __ATOMIC_RELAXED);
+            break;
+        }
+    }
+
+    if (!buffer) {
+        buffer = XW_NEW (XW_ALLOC_CATEGORY_MISC, XwTraceBuffer);
+        RETURN_VALUE_IF (!buffer, Null, ERR_OUT_OF_MEMORY);
+
+        buffer->in_use = True;
+        buffer->tid    = tid;
+        xw_trace_buffer_push (buffer);
+    }
+
+    if (xw_trace_key_created) {
+        pthread_setspecific (xw_trace_key, buffer);
+    }
+
+    xw_trace_buffer = buffer;
+    return buffer;
+}
+
+/**
+ * @b Add a new buffer to front of list of all buffers.
+ * */
+static void xw_trace_buffer_push (XwTraceBuffer *buffer) {
+    XwTraceBuffer *head = __atomic_load_n (&xw_trace_buffers, __ATOMIC_RELAXED);
+    do {
+        buffer->next = head;
+    } while (!__atomic_compare_exchange_n (
+        &xw_trace_buffers,
+        &head,
+        buffer,
+        True,
+        __ATOMIC_RELEASE,
+        __ATOMIC_RELAXED
+    ));
+}
+
+/**
+ * @b Hand buffer of an exiting thread over to next thread that starts tracing.
+ *
+ * @param buffer Buffer of calling thread.
+ * */
+static void xw_trace_buffer_release (void *buffer) {
+    XwTraceBuffer *self = buffer;
+
+    /* trace points hit after this (eg: by other thread exit handlers) get a new buffer */
+    xw_trace_buffer = Null;
+    __atomic_store_n (&self->in_use, False, __ATOMIC_RELEASE);
+}
+
+/**
+ * @b Create key whose destructor releases trace buffer of each thread when it exits.
+ * */
+static void xw_trace_key_create (void) {
+    xw_trace_key_created = !pthread_key_create (&xw_trace_key, xw_trace_buffer_release);
+}
+
+/**
+ * @b Index of oldest record of given buffer that can be dumped.
+ *
+ * @param buffer
+ * @param head Value of @c head loaded by caller.
+ * */
+static Size xw_trace_buffer_first (XwTraceBuffer *buffer, Size head) {
+    Size oldest  = head > XW_TRACE_BUFFER_CAPACITY ? head - XW_TRACE_BUFFER_CAPACITY : 0;
+    Size cleared = __atomic_load_n (&buffer->cleared, __ATOMIC_RELAXED);
+    return MAX (oldest, cleared);
+}
+
+/**
+ * @b Copy record with given index out of buffer, while owner thread may be making new records.
+ *
+ * @param buffer
+ * @param index Index of record, less than @c head loaded by caller.
+ * @param record Where record is copied.
+ *
+ * @return True if record was copied.
+ * @return False if it's slot was reused by a newer record meanwhile.
+ * */
+static Bool xw_trace_buffer_read (XwTraceBuffer *buffer, Size index, XwTraceRecord *record) {
+    XwTraceRecord *slot = buffer->records + index % XW_TRACE_BUFFER_CAPACITY;
+
+    record->timestamp = __atomic_load_n (&slot->timestamp, __ATOMIC_ACQUIRE);
+    record->name      = __atomic_load_n (&slot->name, __ATOMIC_ACQUIRE);
+    record->arg_name  = __atomic_load_n (&slot->arg_name, __ATOMIC_ACQUIRE);
+    record->arg       = __atomic_load_n (&slot->arg, __ATOMIC_ACQUIRE);
+    record->phase     = __atomic_load_n (&slot->phase, __ATOMIC_ACQUIRE);
+
+    /* slot is being overwritten once head reaches index + capacity */
+    Size head = __atomic_load_n (&buffer->head, __ATOMIC_RELAXED);
+    return index + XW_TRACE_BUFFER_CAPACITY > head;
+}
+
+/**
+ * @b Keep track of nesting of slices while dumping, to skip ends of slices whose begin was
+ *    overwritten or cleared.
+ *
+ * @param depth Number of slices open, starts at 0 for each buffer.
+ * @param phase Phase of next record.
+ *
+ * @return True if record is to be dumped.
+ * @return False otherwise.
+ * */
+static Bool xw_trace_balance (Size *depth, XwTracePhase phase) {
+    if (phase == XW_TRACE_PHASE_BEGIN) {
+        (*depth)++;
+        return True;
+    }
+
+    if (!*depth) {
+        return False;
+    }
+    (*depth)--;
+    return True;
+}
+
+/**
+ * @b Release all trace buffers when library is unloaded.
+ * */
+static DESTRUCTOR void xw_trace_buffers_destroy (void) {
+    /* exiting threads must not release buffers that are freed */
+    if (xw_trace_key_created) {
+        pthread_key_delete (xw_trace_key);
+        xw_trace_key_created = False;
+    }
+
+    XwTraceBuffer *buffer = __atomic_exchange_n (&xw_trace_buffers, Null, __ATOMIC_ACQUIRE);
+    while (buffer) {
+        XwTraceBuffer *next = buffer->next;
+        XW_FREE (XW_ALLOC_CATEGORY_MISC, buffer);
+        buffer = next;
+    }
+    xw_trace_buffer = Null;
+}
+
+static Uint64 xw_trace_now (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (Uint64)ts.tv_sec * 1000000000ull + (Uint64)ts.tv_nsec;
+}
+
+static void xw_proto_put_varint (XwProtoMessage *msg, Uint64 value) {
+    do {
+        if (msg->size >= sizeof (msg->data)) {
+            return;
+        }
+
+        Uint8 byte               = value & 0x7f;
+        value                  >>= 7;
+        msg->data[msg->size++]   = byte | (value ? 0x80 : 0);
+    } while (value);
+}
+
+static void xw_proto_put_uint (XwProtoMessage *msg, Uint32 field, Uint64 value) {
+    xw_proto_put_varint (msg, (Uint64)field << 3); /* wire type 0 : varint */
+    xw_proto_put_varint (msg, value);
+}
+
+static void xw_proto_put_bytes (XwProtoMessage *msg, Uint32 field, const void *data, Size size) {
+    xw_proto_put_varint (msg, ((Uint64)field << 3) | 2); /* wire type 2 : length delimited */
+    xw_proto_put_varint (msg, size);
+
+    size = MIN (size, sizeof (msg->data) - MIN (msg->size, sizeof (msg->data)));
+    memcpy (msg->data + msg->size, data, size);
+    msg->size += size;
+}
+
+static void xw_proto_put_string (XwProtoMessage *msg, Uint32 field, CString str) {
+    xw_proto_put_bytes (msg, field, str, strnlen (str, XW_TRACE_MAX_NAME_LENGTH));
+}
+
+/**
+ * @b Write given message as a Trace.packet entry. A trace file is just a Trace message, so
+ *    packets can be appended one after the other.
+ * */
+static Bool xw_proto_write_packet (FILE *file, const XwProtoMessage *packet) {
+    XwProtoMessage header = {0};
+    xw_proto_put_varint (&header, (1 << 3) | 2); /* Trace.packet = 1, length delimited */
+    xw_proto_put_varint (&header, packet->size);
+
+    return fwrite (header.data, 1, header.size, file) == header.size &&
+           fwrite (packet->data, 1, packet->size, file) == packet->size;
+}
+
+#else
+
+Bool xw_trace_is_enabled (void) {
+    return False;
+}
+
+Bool xw_trace_dump_chrome_json (CString path) {
+    UNUSED (path);
+    PRINT_ERR (ERR_TRACING_DISABLED);
+    return False;
+}
+
+Bool xw_trace_dump_perfetto (CString path) {
+    UNUSED (path);
+    PRINT_ERR (ERR_TRACING_DISABLED);
+    return False;
+}
+
+void xw_trace_clear (void) {}
+
+#endif // XW_ENABLE_TRACING
@@ -0,0 +1,61 @@
+/**
+ * @file Trace.h
+ * @time 18/10/2026 12:54:28
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_TRACE_H
+#define ANVIE_CROSSWINDOW_COMMON_TRACE_H
+
+#include <Anvie/CrossWindow/Trace.h>
+
+/* Trace points used inside CrossWindow. Every BEGIN must be paired with an END of the same name
+ * on the same thread. Names must be string literals (or otherwise live forever), only the
+ * pointer is recorded. When built without XW_ENABLE_TRACING these expand to nothing. */
+#ifdef XW_ENABLE_TRACING
+#    define XW_TRACE_BEGIN(name) xw_trace_record (XW_TRACE_PHASE_BEGIN, name, Null, 0)
+#    define XW_TRACE_END(name)   xw_trace_record (XW_TRACE_PHASE_END, name, Null, 0)
+#    define XW_TRACE_BEGIN_ARG(name, arg_name, arg)                                                \
+        xw_trace_record (XW_TRACE_PHASE_BEGIN, name, arg_name, (Uint64)(arg))
+#else
+#    define XW_TRACE_BEGIN(name)                    ((void)0)
+#    define XW_TRACE_END(name)                      ((void)0)
+#    define XW_TRACE_BEGIN_ARG(name, arg_name, arg) ((void)0)
+#endif
+
+typedef enum XwTracePhase {
+    XW_TRACE_PHASE_BEGIN = 'B',
+    XW_TRACE_PHASE_END   = 'E',
+} XwTracePhase;
+
+#ifdef XW_ENABLE_TRACING
+void xw_trace_record (XwTracePhase phase, CString name, CString arg_name, Uint64 arg);
+#endif
+
+#endif // ANVIE_CROSSWINDOW_COMMON_TRACE_H
@@ -0,0 +1,210 @@
+/**
+ * @file WindowTable.c
+ * @time 18/10/2026 13:07:43
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* local headers */
+#include "Allocator.h"
+#include "Log.h"
+#include "WindowTable.h"
+
+/* libc headers */
+#include <string.h>
+
+/** @b Number of slots allocated when first window is inserted. */
+#define XW_WINDOW_TABLE_INITIAL_CAPACITY 64
+
+static XwWindowSlots *xw_window_table_grow (XwWindowTable *self);
+
+/**
+ * @b Initialize an empty window table.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwWindowTable *xw_window_table_init (XwWindowTable *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    memset (self, 0, sizeof (XwWindowTable));
+    RETURN_VALUE_IF (XW_MUTEX_INIT (&self->lock), Null, "Failed to create window table lock\n");
+
+    return self;
+}
+
+/**
+ * @b Release all slots of window table. Windows themselves are not touched.
+ *
+ * Nothing else must be using the table anymore.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwWindowTable *xw_window_table_deinit (XwWindowTable *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    XwWindowSlots *slots = self->slots;
+    while (slots) {
+        XwWindowSlots *retired = slots->retired;
+        XW_FREE (XW_ALLOC_CATEGORY_WINDOW, slots);
+        slots = retired;
+    }
+
+    XW_MUTEX_DEINIT (&self->lock);
+    memset (self, 0, sizeof (XwWindowTable));
+
+    return self;
+}
+
+/**
+ * @b Find a free slot for given window and register the window in it.
+ *
+ * CrossWindow ID helps in pairing events with the window they correspond to.
+ * Once the window is destroyed, it's slot is set to @c Null, so the same ID can be
+ * given to some other window later on.
+ *
+ * @param self
+ * @param win Window to generate new ID for.
+ *
+ * @return New window ID on success.
+ * @return SIZE_MAX on failure.
+ * */
+Size xw_window_table_insert (XwWindowTable *self, struct XwWindow *win) {
+    RETURN_VALUE_IF (!self || !win, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+
+    Size window_id = SIZE_MAX;
+    XW_MUTEX_LOCK (&self->lock);
+
+    XwWindowSlots *slots = self->slots;
+    if (!slots || self->count == slots->capacity) {
+        slots = xw_window_table_grow (self);
+        GOTO_HANDLER_IF (!slots, GROW_FAILED, ERR_OUT_OF_MEMORY);
+    }
+
+    /* slots added by growing are at the end, so searching from there is fastest */
+    for (Size s = slots->capacity; s--;) {
+        if (!slots->windows[s]) {
+            XW_STORE (&slots->windows[s], win);
+            self->count++;
+            window_id = s;
+            break;
+        }
+    }
+
+GROW_FAILED:
+    XW_MUTEX_UNLOCK (&self->lock);
+    return window_id;
+}
+
+/**
+ * @b Mark a slot to be free for use for new windows.
+ *
+ * @param self
+ * @param window_id CrossWindow ID of window.
+ * */
+void xw_window_table_remove (XwWindowTable *self, Size window_id) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&self->lock);
+
+    XwWindowSlots *slots = self->slots;
+    if (slots && window_id < slots->capacity && slots->windows[window_id]) {
+        XW_STORE (&slots->windows[window_id], Null);
+        self->count--;
+    }
+
+    XW_MUTEX_UNLOCK (&self->lock);
+}
+
+/**
+ * @b Check whether given pointer refers to a window registered in table.
+ *
+ * This only compares pointers, so it's safe to call with dangling pointers.
+ *
+ * @param self
+ * @param win
+ *
+ * @return True if window is registered.
+ * @return False otherwise.
+ * */
+Bool xw_window_table_contains (XwWindowTable *self, struct XwWindow *win) {
+    RETURN_VALUE_IF (!self, False, ERR_INVALID_ARGUMENTS);
+
+    XwWindowSlots *slots = xw_window_table_slots (self);
+    if (!win || !slots) {
+        return False;
+    }
+
+    for (Size s = 0; s < slots->capacity; s++) {
+        if (xw_window_slots_get (slots, s) == win) {
+            return True;
+        }
+    }
+
+    return False;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Replace slots of table with a copy twice as big. Must be called with table locked.
+ *
+ * Old slots are not freed, threads looking up windows may still be going through them.
+ *
+ * @param self
+ *
+ * @return New slots on success.
+ * @return @c Null otherwise.
+ * */
+static XwWindowSlots *xw_window_table_grow (XwWindowTable *self) {
+    XwWindowSlots *old_slots    = self->slots;
+    Size           old_capacity = old_slots ? old_slots->capacity : 0;
+    Size new_capacity = old_capacity ? old_capacity * 2 : XW_WINDOW_TABLE_INITIAL_CAPACITY;
+
+    XwWindowSlots *slots = (XwWindowSlots *)XW_ALLOCATE (
+        XW_ALLOC_CATEGORY_WINDOW,
+        Uint8,
+        sizeof (XwWindowSlots) + new_capacity * sizeof (struct XwWindow *)
+    );
+    RETURN_VALUE_IF (!slots, Null, ERR_OUT_OF_MEMORY);
+
+    /* new slots are zeroed by allocator */
+    slots->capacity = new_capacity;
+    slots->retired  = old_slots;
+    if (old_slots) {
+        memcpy (slots->windows, old_slots->windows, old_capacity * sizeof (struct XwWindow *));
+    }
+
+    XW_STORE (&self->slots, slots);
+    return slots;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file WindowTable.h
+ * @time 18/10/2026 13:07:28
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_COMMON_WINDOW_TABLE_H
+#define ANVIE_CROSSWINDOW_COMMON_WINDOW_TABLE_H
+
+#include <Anvie/Types.h>
+
+/* local includes */
+#include "Lock.h"
+
+struct XwWindow;
+
+/**
+ * @b Slots of window table. Replaced by a bigger copy when all slots are used, and the
+ *    old one is kept around till table is deinitialized, because threads looking up
+ *    windows without a lock may still be reading it.
+ * */
+typedef struct XwWindowSlots {
+    Size                  capacity; /**< @b Number of entries in @c windows. */
+    struct XwWindowSlots *retired;  /**< @b Slots this one replaced. */
+    struct XwWindow      *windows[];
+} XwWindowSlots;
+
+/**
+ * @b A mapping from CrossWindow Id to the window itself.
+ *
+ * Grows as needed. Slots of destroyed windows are set to @c Null and reused. Inserting and
+ * removing windows takes a lock, looking them up does not.
+ * */
+typedef struct XwWindowTable {
+    XwWindowSlots *slots;
+    Size           count; /**< @b Number of non-Null entries in @c slots. */
+    XwMutex        lock;
+} XwWindowTable;
+
+XwWindowTable *xw_window_table_init (XwWindowTable *self);
+XwWindowTable *xw_window_table_deinit (XwWindowTable *self);
+Size           xw_window_table_insert (XwWindowTable *self, struct XwWindow *win);
+void           xw_window_table_remove (XwWindowTable *self, Size window_id);
+Bool           xw_window_table_contains (XwWindowTable *self, struct XwWindow *win);
+
+/**
+ * @b Get current slots of window table, to go through all windows without locking.
+ *
+ * Entries must be read using @c xw_window_slots_get. Returned slots stay valid till the
+ * table is deinitialized, but windows added after this call may not be in it.
+ *
+ * @return @c XwWindowSlots* if table has any slots.
+ * @return @c Null otherwise.
+ * */
+static inline XwWindowSlots *xw_window_table_slots (XwWindowTable *self) {
+    return XW_LOAD (&self->slots);
+}
+
+/**
+ * @b Get window in given slot.
+ *
+ * @return @c XwWindow* if a window is registered in slot.
+ * @return @c Null otherwise.
+ * */
+static inline struct XwWindow *xw_window_slots_get (XwWindowSlots *slots, Size slot) {
+    return XW_LOAD (&slots->windows[slot]);
+}
+
+#endif // ANVIE_CROSSWINDOW_COMMON_WINDOW_TABLE_H
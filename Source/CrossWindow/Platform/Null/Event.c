@@ -0,0 +1,393 @@
+/**
+ * @file Event.c
+ * @time 18/10/2026 12:48:40
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+/* ppoll */
+#define _GNU_SOURCE
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Null.h>
+
+/* local headers */
+#include "State.h"
+#include "Window.h"
+
+/* libc headers */
+#include <poll.h>
+
+extern XwState xw_state;
+
+static XwEvent *xw_apply_event (XwEvent *e);
+static Bool     xw_event_route (const XwEvent *e);
+static XwEvent *xw_pump_event (XwEvent *e);
+
+XwEvent *xw_event_poll (XwEvent *e) {
+    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    return xw_pump_event (e);
+}
+
+/**
+ * @b Get next event from event queue.
+ *
+ * There's no display server to wait on, so if event queue is empty and no timer is running
+ * this returns immediately instead of blocking forever. While a timer is running, this
+ * blocks till it expires or an event is posted using @c xw_event_post.
+ *
+ * @param e
+ *
+ * @return @c e on success.
+ * @return Null if event queue is empty.
+ * */
+XwEvent *xw_event_wait (XwEvent *e) {
+    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    XwEvent *polled = xw_event_wait_until (e, 0);
+
+    RETURN_VALUE_IF (
+        !polled && !xw_timer_wheel_pending(),
+        Null,
+        "Waiting on empty event queue would never return\n"
+    );
+    return polled;
+}
+
+/**
+ * @b Same as @c xw_event_wait, but gives up once given CLOCK_MONOTONIC time is reached.
+ *    Until then this blocks even when no timer is running, as only a posted event can
+ *    arrive. Deadline is ignored while idle blocking is enabled and no window is presentable.
+ *
+ * @param e
+ * @param deadline_ns Time to stop waiting at, in nanoseconds. 0 waits only while a timer is
+ *        running, same as @c xw_event_wait.
+ *
+ * @return @c e on success.
+ * @return Null if deadline was reached, or event queue is empty.
+ * */
+XwEvent *xw_event_wait_until (XwEvent *e, Uint64 deadline_ns) {
+    RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    while (True) {
+        /* check for events once more after telling posters we're about to sleep */
+        int      wakeup_fd = xw_post_begin_wait();
+        XwEvent *polled    = xw_pump_event (e);
+        Bool     idle      = xw_idle_should_block();
+        Bool     woken     = False;
+
+        /* deadline does not matter while nothing can be seen, see xw_event_set_idle_blocking */
+        Uint64 until = idle ? 0 : deadline_ns;
+        Uint64 now   = until ? xw_timer_now_ns() : 0;
+        Bool   block = until ? now < until : idle || xw_timer_wheel_pending();
+
+        if (!polled && block) {
+            struct pollfd fds[] = {
+                {.fd = wakeup_fd,            .events = POLLIN},
+                {.fd = xw_timer_wheel_fd(), .events = POLLIN}
+            };
+
+            struct timespec timeout = {
+                .tv_sec  = (until - now) / 1000000000ull,
+                .tv_nsec = (until - now) % 1000000000ull
+            };
+
+            if (ppoll (fds, ARRAY_SIZE (fds), until ? &timeout : Null, Null) > 0) {
+                woken = !!(fds[0].revents & POLLIN);
+            }
+        }
+
+        xw_post_end_wait (woken);
+
+        if (polled || !block) {
+            return polled;
+        }
+    }
+}
+
+/**
+ * @b Give window it's own event queue. From now on, events of this window are routed to it's
+ *    queue, and are popped using @c xw_window_event_poll instead of @c xw_event_poll.
+ *
+ * Routing happens while some thread pumps events using @c xw_event_poll or @c xw_event_wait,
+ * so one thread must keep doing that. Events not tied to any window (keymap changes for
+ * example) are copied to queues of all windows and also returned by @c xw_event_poll.
+ *
+ * Queue has a single consumer, only one thread must call @c xw_window_event_poll for a
+ * window. Events that arrive while queue is full are dropped.
+ *
+ * @param self
+ * @param capacity Most events queue can hold before dropping them.
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_enable_event_queue (XwWindow *self, Size capacity) {
+    RETURN_VALUE_IF (!self || !capacity, Null, ERR_INVALID_ARGUMENTS);
+
+    XwEventQueue *queue = xw_event_queue_create (capacity);
+    RETURN_VALUE_IF (!queue, Null, "Failed to create event queue for window\n");
+
+    /* events of this window may be getting routed right now */
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    Bool enabled = !!self->queue;
+    if (!enabled) {
+        XW_STORE (&self->queue, queue);
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    if (enabled) {
+        xw_event_queue_destroy (queue);
+    }
+    RETURN_VALUE_IF (enabled, Null, "Event queue of window is already enabled\n");
+
+    return self;
+}
+
+/**
+ * @b Get next event from event queue of given window, without waiting.
+ *
+ * Takes no lock. Call only from the one thread that consumes events of this window.
+ *
+ * @param self Window with event queue enabled using @c xw_window_enable_event_queue.
+ * @param e
+ *
+ * @return @c e if an event was popped.
+ * @return Null if queue is empty, or not enabled.
+ * */
+XwEvent *xw_window_event_poll (XwWindow *self, XwEvent *e) {
+    RETURN_VALUE_IF (!self || !e, Null, ERR_INVALID_ARGUMENTS);
+
+    XwEventQueue *queue = XW_LOAD (&self->queue);
+    RETURN_VALUE_IF (!queue, Null, "Event queue of window is not enabled\n");
+
+    return xw_event_queue_pop (queue, e) ? e : Null;
+}
+
+/**
+ * @b Add given event to end of event queue, as if display server sent it.
+ *
+ * Window of the event is updated when the event is polled, exactly like it happens
+ * with a real display server. For example a polled @c XW_EVENT_TYPE_RESIZE event changes
+ * value returned by @c xw_window_get_size.
+ *
+ * Events of a window are removed from event queue when the window is destroyed.
+ *
+ * @param event Event to be copied into event queue. @c event->window must be a window
+ *        that's not destroyed yet. It can be Null only for keymap change and error events.
+ *
+ * @return @c event on success.
+ * @return Null otherwise.
+ * */
+XwEvent *xw_null_inject_event (const XwEvent *event) {
+    RETURN_VALUE_IF (!event, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        event->type <= XW_EVENT_TYPE_NONE || event->type >= XW_EVENT_TYPE_MAX,
+        Null,
+        "Invalid event type\n"
+    );
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+    RETURN_VALUE_IF (
+        event->window ? !xw_window_table_contains (&xw_state.windows, event->window) :
+                        event->type != XW_EVENT_TYPE_KEYMAP_CHANGE &&
+                            event->type != XW_EVENT_TYPE_ERROR,
+        Null,
+        "Cannot inject event for a window that does not exist\n"
+    );
+    RETURN_VALUE_IF (
+        event->type == XW_EVENT_TYPE_RESTACK && event->restack.above &&
+            !xw_window_table_contains (&xw_state.windows, event->restack.above),
+        Null,
+        "Cannot restack above a window that does not exist\n"
+    );
+
+    RETURN_VALUE_IF (!xw_push_event (event), Null, "Failed to queue event\n");
+    return (XwEvent *)event;
+}
+
+/**
+ * @b Make windows ask display server for pointer motion hints instead of every motion.
+ *
+ * There's no display server, so this is only remembered. Injected mouse moves are returned
+ * as they are.
+ *
+ * @param enable
+ * */
+void xw_event_set_motion_hints (Bool enable) {
+    XW_STORE (&xw_state.motion_hints, !!enable);
+}
+
+/**
+ * @b Check whether windows ask for pointer motion hints, see @c xw_event_set_motion_hints.
+ * */
+Bool xw_event_get_motion_hints (void) {
+    return XW_LOAD (&xw_state.motion_hints);
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Update window of given event with data in event, the way XCB backend does when it
+ *    receives same event from display server.
+ *
+ * @param e
+ *
+ * @return @c e.
+ * */
+static XwEvent *xw_apply_event (XwEvent *e) {
+    XwWindow *window = e->window;
+    if (!window) {
+        return e;
+    }
+
+    switch (e->type) {
+        case XW_EVENT_TYPE_STATE_CHANGE : {
+            XW_STORE (&window->state, e->state_change.new_state);
+            break;
+        }
+
+        case XW_EVENT_TYPE_VISIBILITY : {
+            XW_STORE (&window->visible, e->visibility.visible);
+            break;
+        }
+
+        case XW_EVENT_TYPE_BORDER_WIDTH_CHANGE : {
+            XW_STORE (&window->border_width, e->border_width_change.border_width);
+            break;
+        }
+
+        case XW_EVENT_TYPE_REPOSITION : {
+            XW_STORE (&window->pos, ((XwWindowPos) {e->reposition.x, e->reposition.y}));
+            break;
+        }
+
+        case XW_EVENT_TYPE_RESIZE : {
+            XW_STORE (&window->size, ((XwWindowSize) {e->resize.width, e->resize.height}));
+            break;
+        }
+
+        default :
+            break;
+    }
+
+    Bool hidden = !!(XW_LOAD (&window->state) & XW_WINDOW_STATE_MASK_HIDDEN);
+    xw_idle_set_presentable (&window->presentable, XW_LOAD (&window->visible) && !hidden);
+
+    return e;
+}
+
+/**
+ * @b Pop and apply events, till one is found that's not routed to a window queue. Posted
+ *    events are popped after all injected ones, and expired timers after posted events.
+ *    In priority mode or with backlog limits, injected events go through backlog first, see
+ *    @c xw_event_set_priority_mode and @c xw_event_set_backlog_limit.
+ *
+ * @param e
+ *
+ * @return @c e on success.
+ * @return Null if event queue became empty.
+ * */
+static XwEvent *xw_pump_event (XwEvent *e) {
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+
+    /* sort everything injected so far, and keep it within limits, before returning any of it */
+    while (xw_event_backlog_enabled() && xw_pop_event (e)) {
+        xw_apply_event (e);
+        if (!xw_event_route (e)) {
+            xw_event_backlog_push (&xw_state.backlog, e);
+        }
+    }
+
+    XwEvent *polled = xw_event_backlog_pop (&xw_state.backlog, e) ? e : Null;
+    while (!polled && xw_pop_event (e)) {
+        xw_apply_event (e);
+        polled = xw_event_route (e) ? Null : e;
+    }
+
+    while (!polled && xw_post_pop (e)) {
+        if (e->window && !xw_window_table_contains (&xw_state.windows, e->window)) {
+            XW_LOG_DEBUG ("Window of posted event was destroyed, dropping event\n");
+            continue;
+        }
+        polled = xw_event_route (e) ? Null : e;
+    }
+
+    if (!polled && xw_timer_wheel_pop (e)) {
+        polled = e;
+    }
+
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    return polled;
+}
+
+/**
+ * @b Push given event to event queue of it's window, if window has one. Events not tied to
+ *    any window are pushed to queues of all windows, but are still returned to caller.
+ *
+ * Must be called with @c xw_state.event_lock held, so that windows are not destroyed while
+ * their events are being routed.
+ *
+ * @param e Applied event.
+ *
+ * @return True if event was taken by a window queue, and must not be returned to caller.
+ * @return False otherwise.
+ * */
+static Bool xw_event_route (const XwEvent *e) {
+    if (e->window) {
+        XwEventQueue *queue = e->window->queue;
+        if (!queue) {
+            return False;
+        }
+
+        if (!xw_event_queue_push (queue, e)) {
+            XW_LOG_WARNING ("Event queue of window is full, dropping event\n");
+        }
+        return True;
+    }
+
+    /* timers belong to whoever created them, not to windows */
+    if (e->type == XW_EVENT_TYPE_TIMER) {
+        return False;
+    }
+
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    for (Size s = 0; slots && s < slots->capacity; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (win && win->queue && !xw_event_queue_push (win->queue, e)) {
+            XW_LOG_WARNING ("Event queue of window is full, dropping event\n");
+        }
+    }
+
+    return False;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file Framebuffer.c
+ * @time 18/10/2026 12:49:16
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Framebuffer.h>
+
+/* local headers */
+#include "Common/Allocator.h"
+#include "State.h"
+#include "Window.h"
+
+/* libc headers */
+#include <string.h>
+
+extern XwState xw_state;
+
+static XwWindow *xw_window_create_framebuffer (XwWindow *self);
+
+/**
+ * @b Get CPU accessible pixel buffer of window.
+ *
+ * Framebuffer is created in heap memory on first call, in the most common pixel format
+ * of XCB backend. If window got resized since last call, the framebuffer is re-created
+ * with new size and it's previous contents are lost, so this must be called again after
+ * every @c XW_EVENT_TYPE_RESIZE event.
+ *
+ * @param self
+ * @param fb Where framebuffer info will be stored.
+ *
+ * @return @c fb on success.
+ * @return Null otherwise.
+ * */
+XwFramebuffer *xw_window_get_framebuffer (XwWindow *self, XwFramebuffer *fb) {
+    RETURN_VALUE_IF (!self || !fb, Null, ERR_INVALID_ARGUMENTS);
+
+    XwFramebuffer *current = &self->framebuffer.info;
+    XwWindowSize   size    = XW_LOAD (&self->size);
+    if (!self->framebuffer.data || current->width != size.width || current->height != size.height) {
+        xw_window_release_framebuffer (self);
+        RETURN_VALUE_IF (
+            !xw_window_create_framebuffer (self),
+            Null,
+            "Failed to create framebuffer\n"
+        );
+    }
+
+    *fb = *current;
+    return fb;
+}
+
+/**
+ * @b Show given regions of framebuffer in window.
+ *
+ * There's no screen to show pixels on, so this only validates arguments. Pixels stay
+ * in framebuffer and can be inspected by application.
+ *
+ * @param self
+ * @param rects Regions to be updated. Parts outside of framebuffer are ignored.
+ * @param n Number of rects. Pass 0 to present whole framebuffer.
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_present_region (XwWindow *self, const XwRect *rects, Size n) {
+    RETURN_VALUE_IF (!self || (n && !rects), Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        !self->framebuffer.data,
+        Null,
+        "Framebuffer is not created yet. Call xw_window_get_framebuffer() first\n"
+    );
+
+    return self;
+}
+
+/**
+ * @b Release framebuffer of window if it has one.
+ *
+ * Used by Window.c when window is being de-initialized.
+ *
+ * @param self
+ * */
+void xw_window_release_framebuffer (XwWindow *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    if (!self->framebuffer.data) {
+        return;
+    }
+
+    XW_FREE (XW_ALLOC_CATEGORY_FRAMEBUFFER, self->framebuffer.data);
+    memset (&self->framebuffer, 0, sizeof (self->framebuffer));
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Create framebuffer of same size as window.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+static XwWindow *xw_window_create_framebuffer (XwWindow *self) {
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    XwWindowSize window_size = XW_LOAD (&self->size);
+
+    XwFramebuffer *fb   = &self->framebuffer.info;
+    fb->width           = window_size.width;
+    fb->height          = window_size.height;
+    fb->bytes_per_pixel = 4;
+    fb->stride          = fb->width * fb->bytes_per_pixel;
+    fb->format          = XW_PIXEL_FORMAT_BGRX8888;
+
+    Size size = (Size)fb->stride * fb->height;
+    RETURN_VALUE_IF (!size, Null, ERR_INVALID_SIZE);
+
+    self->framebuffer.data = XW_ALLOCATE (XW_ALLOC_CATEGORY_FRAMEBUFFER, Uint8, size);
+    RETURN_VALUE_IF (!self->framebuffer.data, Null, ERR_OUT_OF_MEMORY);
+
+    fb->pixels = self->framebuffer.data;
+    return self;
+}
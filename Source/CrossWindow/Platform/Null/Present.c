@@ -0,0 +1,121 @@
+/**
+ * @file Present.c
+ * @time 18/10/2026 12:49:16
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Present.h>
+
+/* local headers */
+#include "State.h"
+#include "Window.h"
+
+/* libc headers */
+#include <time.h>
+
+extern XwState xw_state;
+
+/**
+ * @b Start receiving @c XW_EVENT_TYPE_FRAME_COMPLETE and @c XW_EVENT_TYPE_FRAME_IDLE
+ * events for given window.
+ *
+ * Calling this more than once does nothing.
+ *
+ * @param self
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_window_enable_frame_events (XwWindow *self) {
+    RETURN_VALUE_IF (!self, False, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.initialized, False, ERR_XW_STATE_NOT_INITIALIZED);
+
+    self->frame_events_enabled = True;
+    return True;
+}
+
+/**
+ * @b Pretend to show given pixmap in window.
+ *
+ * Every present completes immediately, on it's own virtual vblank. Frame complete and
+ * frame idle events are queued right away, so code depending on them sees the same
+ * sequence of events it would see with XCB backend, just without any waiting.
+ *
+ * @param self
+ * @param pixmap Any non-zero handle. It's only passed back in frame idle event.
+ * @param target_msc Ignored, frames are never delayed.
+ * @param flags Bitwise OR of @c XwPresentFlagBits. @c XW_PRESENT_FLAG_COPY is reflected
+ *        in present mode of frame complete event.
+ *
+ * @return Non-zero serial identifying this frame in frame events on success.
+ * @return 0 otherwise.
+ * */
+Uint32 xw_window_present_pixmap (
+    XwWindow      *self,
+    Uint32         pixmap,
+    Uint64         target_msc,
+    XwPresentFlags flags
+) {
+    UNUSED (target_msc);
+
+    RETURN_VALUE_IF (!self || !pixmap, 0, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_window_enable_frame_events (self), 0, "Failed to enable frame events\n");
+
+    /* 0 is reserved for failure */
+    if (!++self->present_serial) {
+        self->present_serial = 1;
+    }
+
+    struct timespec now;
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    Uint64 ust = (Uint64)now.tv_sec * 1000000 + (Uint64)now.tv_nsec / 1000;
+
+    XwPresentMode mode = (flags & XW_PRESENT_FLAG_COPY) ? XW_PRESENT_MODE_COPY :
+                                                          XW_PRESENT_MODE_FLIP;
+
+    XwEvent complete, idle;
+    xw_event_make_frame_complete (
+        &complete,
+        self->present_serial,
+        ++self->present_msc,
+        ust,
+        mode,
+        self
+    );
+    xw_event_make_frame_idle (&idle, self->present_serial, pixmap, self);
+    RETURN_VALUE_IF (
+        !xw_push_event (&complete) || !xw_push_event (&idle),
+        0,
+        "Failed to queue frame events\n"
+    );
+
+    return self->present_serial;
+}
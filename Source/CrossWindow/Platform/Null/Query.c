@@ -0,0 +1,215 @@
+/**
+ * @file Query.c
+ * @time 18/10/2026 12:48:57
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Query.h>
+
+/* local headers */
+#include "State.h"
+#include "Window.h"
+
+extern XwState xw_state;
+
+static XwQuery        xw_query_init (XwQueryType type, XwWindow *win);
+static XwQueryResult *xw_query_complete (XwQuery *query, XwQueryResult *result);
+
+/**
+ * @b Request geometry (position, size and border width) of given window.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_GEOMETRY on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_geometry (XwWindow *self) {
+    return xw_query_init (XW_QUERY_TYPE_GEOMETRY, self);
+}
+
+/**
+ * @b Request current window state (maximized, hidden, etc...) of given window.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_STATE on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_state (XwWindow *self) {
+    return xw_query_init (XW_QUERY_TYPE_STATE, self);
+}
+
+/**
+ * @b Request size of decorations added around given window.
+ *
+ * There is no window manager, so all extents in result are always zero.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_FRAME_EXTENTS on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_frame_extents (XwWindow *self) {
+    return xw_query_init (XW_QUERY_TYPE_FRAME_EXTENTS, self);
+}
+
+/**
+ * @b Request bitmask of actions currently allowed on given window.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_ACTION_PERMISSIONS on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_action_permissions (XwWindow *self) {
+    return xw_query_init (XW_QUERY_TYPE_ACTION_PERMISSIONS, self);
+}
+
+/**
+ * @b Get answer to given query.
+ *
+ * Queries are answered from window data at the time of this call, so this never blocks.
+ * The query is consumed after this call, and it's type is set to @c XW_QUERY_TYPE_NONE.
+ *
+ * @param query Query to wait on.
+ * @param result Where result will be stored.
+ *
+ * @return @c result on success.
+ * @return @c Null otherwise.
+ * */
+XwQueryResult *xw_query_wait (XwQuery *query, XwQueryResult *result) {
+    RETURN_VALUE_IF (
+        !query || !result || query->type == XW_QUERY_TYPE_NONE,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    return xw_query_complete (query, result);
+}
+
+/**
+ * @b Same as @c xw_query_wait, because queries never have to wait in Null backend.
+ *
+ * @param query Query to poll.
+ * @param result Where result will be stored.
+ *
+ * @return @c result if query was answered successfully.
+ * @return @c Null otherwise.
+ * */
+XwQueryResult *xw_query_poll (XwQuery *query, XwQueryResult *result) {
+    RETURN_VALUE_IF (
+        !query || !result || query->type == XW_QUERY_TYPE_NONE,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+
+    return xw_query_complete (query, result);
+}
+
+/**
+ * @b Throw away given query without getting it's answer.
+ *
+ * @param query
+ * */
+void xw_query_discard (XwQuery *query) {
+    RETURN_IF (!query, ERR_INVALID_ARGUMENTS);
+    query->type = XW_QUERY_TYPE_NONE;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Create a new query object.
+ *
+ * @param type
+ * @param win
+ *
+ * @return XwQuery
+ * */
+static XwQuery xw_query_init (XwQueryType type, XwWindow *win) {
+    RETURN_VALUE_IF (!win, ((XwQuery) {0}), ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.initialized, ((XwQuery) {0}), ERR_XW_STATE_NOT_INITIALIZED);
+
+    return (XwQuery) {.type = type, .window = win, .sequence = 0};
+}
+
+/**
+ * @b Fill result of given query from current window data, and consume the query.
+ *
+ * @param query
+ * @param result
+ *
+ * @return @c result on success.
+ * @return @c Null otherwise.
+ * */
+static XwQueryResult *xw_query_complete (XwQuery *query, XwQueryResult *result) {
+    XwQueryType type = query->type;
+    query->type      = XW_QUERY_TYPE_NONE;
+
+    /* a window destroyed after query was made would make X server fail the request as well */
+    XwWindow *win = query->window;
+    RETURN_VALUE_IF (
+        !xw_window_table_contains (&xw_state.windows, win),
+        Null,
+        "Window of query was destroyed\n"
+    );
+
+    result->type   = type;
+    result->window = win;
+
+    switch (type) {
+        case XW_QUERY_TYPE_GEOMETRY : {
+            result->geometry.pos          = XW_LOAD (&win->pos);
+            result->geometry.size         = XW_LOAD (&win->size);
+            result->geometry.border_width = XW_LOAD (&win->border_width);
+            break;
+        }
+
+        case XW_QUERY_TYPE_STATE : {
+            result->state = XW_LOAD (&win->state);
+            break;
+        }
+
+        case XW_QUERY_TYPE_FRAME_EXTENTS : {
+            result->frame_extents = (XwFrameExtents) {0, 0, 0, 0};
+            break;
+        }
+
+        case XW_QUERY_TYPE_ACTION_PERMISSIONS : {
+            result->action_permissions = XW_LOAD (&win->action_permissions);
+            break;
+        }
+
+        default :
+            RETURN_VALUE_IF_REACHED (Null, "Invalid query type\n");
+    }
+
+    return result;
+}
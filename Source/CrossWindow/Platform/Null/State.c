@@ -0,0 +1,215 @@
+/**
+ * @file State.c
+ * @time 18/10/2026 12:47:35
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* local includes */
+#include "Common/Allocator.h"
+#include "State.h"
+#include "Window.h"
+
+/* libc includes */
+#include <string.h>
+
+/* global state */
+XwState xw_state = {0};
+
+static Bool xw_grow_event_queue (void);
+
+/**
+ * @b Initialize CrossWindow.
+ *
+ * Null backend needs no display server, so this never fails. This is called automatically
+ * when library is loaded, and calling it again does nothing unless @c xw_deinit is called
+ * first.
+ *
+ * @return True if initialization is successful.
+ * @return False otherwise.
+ * */
+CONSTRUCTOR Bool xw_init (void) {
+    if (xw_state.initialized) {
+        return True;
+    }
+
+    memset (&xw_state, 0, sizeof (xw_state));
+    RETURN_VALUE_IF (
+        !xw_window_table_init (&xw_state.windows) || XW_MUTEX_INIT (&xw_state.event_lock) ||
+            XW_MUTEX_INIT (&xw_state.events.lock),
+        False,
+        "Failed to create locks\n"
+    );
+    RETURN_VALUE_IF (!xw_post_init(), False, "Failed to create posted event queue\n");
+    RETURN_VALUE_IF (!xw_timer_wheel_init(), False, "Failed to create timer wheel\n");
+
+    xw_state.initialized = True;
+    return True;
+}
+
+/**
+ * @b Deinitialize globally initialized XwState object.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+DESTRUCTOR Bool xw_deinit (void) {
+    if (xw_state.events.data) {
+        XW_FREE (XW_ALLOC_CATEGORY_QUEUE, xw_state.events.data);
+    }
+    XW_MUTEX_DEINIT (&xw_state.events.lock);
+    memset (&xw_state.events, 0, sizeof (xw_state.events));
+
+    xw_event_backlog_deinit (&xw_state.backlog);
+    xw_window_table_deinit (&xw_state.windows);
+    XW_MUTEX_DEINIT (&xw_state.event_lock);
+
+    xw_post_deinit();
+    xw_timer_wheel_deinit();
+
+    xw_state.initialized = False;
+    return True;
+}
+
+/**
+ * @b Add an event at the end of event queue.
+ *
+ * @param event
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+Bool xw_push_event (const XwEvent *event) {
+    RETURN_VALUE_IF (!event, False, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&xw_state.events.lock);
+
+    Bool pushed = xw_state.events.count < xw_state.events.capacity || xw_grow_event_queue();
+    if (pushed) {
+        Size mask = xw_state.events.capacity - 1;
+        Size slot = (xw_state.events.head + xw_state.events.count) & mask;
+
+        xw_state.events.data[slot] = *event;
+        xw_state.events.count++;
+    }
+
+    XW_MUTEX_UNLOCK (&xw_state.events.lock);
+
+    RETURN_VALUE_IF (!pushed, False, ERR_OUT_OF_MEMORY);
+    return True;
+}
+
+/**
+ * @b Remove oldest event from event queue.
+ *
+ * @param event Where removed event will be stored.
+ *
+ * @return True if an event was removed.
+ * @return False if queue is empty.
+ * */
+Bool xw_pop_event (XwEvent *event) {
+    RETURN_VALUE_IF (!event, False, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&xw_state.events.lock);
+
+    Bool popped = !!xw_state.events.count;
+    if (popped) {
+        *event               = xw_state.events.data[xw_state.events.head];
+        xw_state.events.head = (xw_state.events.head + 1) & (xw_state.events.capacity - 1);
+        xw_state.events.count--;
+    }
+
+    XW_MUTEX_UNLOCK (&xw_state.events.lock);
+
+    return popped;
+}
+
+/**
+ * @b Remove all queued events of given window.
+ *
+ * Must be called when window is being destroyed, so polled events never refer to
+ * a dangling window. Order of remaining events is preserved.
+ *
+ * @param win
+ * */
+void xw_forget_window_events (XwWindow *win) {
+    XW_MUTEX_LOCK (&xw_state.events.lock);
+
+    Size mask = xw_state.events.capacity - 1;
+    Size kept = 0;
+
+    for (Size s = 0; s < xw_state.events.count; s++) {
+        XwEvent *e = xw_state.events.data + ((xw_state.events.head + s) & mask);
+        if (e->window == win || (e->type == XW_EVENT_TYPE_RESTACK && e->restack.above == win)) {
+            continue;
+        }
+
+        xw_state.events.data[(xw_state.events.head + kept) & mask] = *e;
+        kept++;
+    }
+
+    xw_state.events.count = kept;
+
+    XW_MUTEX_UNLOCK (&xw_state.events.lock);
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Double capacity of event queue, keeping queued events in order. Must be called with
+ *    event queue locked.
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+static Bool xw_grow_event_queue (void) {
+    Size new_capacity = xw_state.events.capacity ? xw_state.events.capacity * 2 : 256;
+
+    XwEvent *data = XW_ALLOCATE (XW_ALLOC_CATEGORY_QUEUE, XwEvent, new_capacity);
+    RETURN_VALUE_IF (!data, False, ERR_OUT_OF_MEMORY);
+
+    /* unwrap the ring while copying, so head starts at 0 again */
+    Size mask = xw_state.events.capacity - 1;
+    for (Size s = 0; s < xw_state.events.count; s++) {
+        data[s] = xw_state.events.data[(xw_state.events.head + s) & mask];
+    }
+
+    if (xw_state.events.data) {
+        XW_FREE (XW_ALLOC_CATEGORY_QUEUE, xw_state.events.data);
+    }
+
+    xw_state.events.data     = data;
+    xw_state.events.capacity = new_capacity;
+    xw_state.events.head     = 0;
+
+    return True;
+}
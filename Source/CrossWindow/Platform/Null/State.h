@@ -0,0 +1,98 @@
+/**
+ * @file State.h
+ * @time 18/10/2026 12:47:14
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef ANVIE_CROSSWINDOW_PLATFORM_NULL_STATE_H
+#define ANVIE_CROSSWINDOW_PLATFORM_NULL_STATE_H
+
+#include <Anvie/CrossWindow/Event.h>
+
+/* local headers */
+#include "Common/Backlog.h"
+#include "Common/Event.h"
+#include "Common/Idle.h"
+#include "Common/Lock.h"
+#include "Common/Log.h"
+#include "Common/Post.h"
+#include "Common/Timer.h"
+#include "Common/WindowTable.h"
+
+#define ERR_XW_STATE_NOT_INITIALIZED                                                               \
+    "It looks like CrossWindow is not yet initialized. Please call xw_init() before using "        \
+    "CrossWindow\n"
+
+/** @b Size of the virtual screen all windows live on. Also the default max window size. */
+#define XW_NULL_SCREEN_WIDTH  1920
+#define XW_NULL_SCREEN_HEIGHT 1080
+
+typedef struct XwState {
+    Bool initialized;
+
+    /**
+     * @b Held while an event is popped and applied to it's window, and while a window is
+     *    being unregistered. Makes sure a window is not destroyed by other threads while
+     *    it's event is being applied.
+     * */
+    XwMutex event_lock;
+
+    /** @b Events waiting to be returned in priority mode. Guarded by @c event_lock. */
+    XwEventBacklog backlog;
+
+    /** @b Only remembered, there's no pointer motion to save, see xw_event_set_motion_hints. */
+    Bool motion_hints;
+
+    /**
+     * @b Events waiting to be polled, as a ring buffer.
+     *
+     * There is no display server, so this is the only source of events. It's filled by
+     * @c xw_null_inject_event, and by window functions wherever a real display server
+     * would have sent an event back (mapping a window for example).
+     * */
+    struct {
+        XwEvent *data;
+        Size     capacity; /**< @b Number of slots in @c data. Always a power of two. */
+        Size     head;     /**< @b Slot of oldest event. */
+        Size     count;    /**< @b Number of queued events. */
+        XwMutex  lock;     /**< @b Events are queued from any thread. */
+    } events;
+
+    /**
+     * @b A mapping from CrossWindow Id to the window itself. Used to check whether
+     * injected events refer to a live window.
+     * */
+    XwWindowTable windows;
+} XwState;
+
+Bool xw_push_event (const XwEvent *event);
+Bool xw_pop_event (XwEvent *event);
+void xw_forget_window_events (struct XwWindow *win);
+
+#endif // ANVIE_CROSSWINDOW_PLATFORM_NULL_STATE_H
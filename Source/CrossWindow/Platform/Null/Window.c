@@ -0,0 +1,641 @@
+/**
+ * @file Window.c
+ * @time 18/10/2026 12:48:22
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* local headers */
+#include "Common/Allocator.h"
+#include "State.h"
+#include "Window.h"
+
+/* libc headers */
+#include <string.h>
+
+extern XwState xw_state;
+
+static XwWindow *xw_window_setup (
+    XwWindow *self,
+    CString   title,
+    Uint32    width,
+    Uint32    height,
+    Uint32    xpos,
+    Uint32    ypos
+);
+static void xw_window_queue_map_events (XwWindow *self, Bool visible);
+
+/**
+ * @b Create a new @x XwWindow object.
+ *
+ * @param title
+ * @param width
+ * @param height
+ * @param xpos
+ * @param ypos
+ *
+ * @return XwWindow* on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_create (CString title, Uint32 width, Uint32 height, Uint32 xpos, Uint32 ypos) {
+    RETURN_VALUE_IF (!width || !height, Null, ERR_INVALID_ARGUMENTS);
+
+    XwWindow *self = XW_NEW (XW_ALLOC_CATEGORY_WINDOW, XwWindow);
+    RETURN_VALUE_IF (!self, Null, ERR_OUT_OF_MEMORY);
+
+    XwWindow *iself = xw_window_init (self, title, width, height, xpos, ypos);
+    GOTO_HANDLER_IF (!iself, INIT_FAILED, ERR_OBJECT_INITIALIZATION_FAILED);
+
+    return iself;
+
+    /* error catchers/handlers */
+INIT_FAILED: {
+    xw_window_destroy (self);
+    return Null;
+}
+}
+
+/**
+ * @b Create many windows at once.
+ *
+ * Window objects are allocated in a single contiguous block, same as the XCB backend,
+ * so memory behaviour of applications stays the same with both backends.
+ *
+ * Each created window is still destroyed individually using @c xw_window_destroy.
+ *
+ * @param infos Array of @c n create infos, one for each window.
+ * @param n Number of windows to create. Cannot be 0.
+ * @param out Array with space for @c n window pointers. Created windows are stored here
+ *        in same order as @c infos.
+ *
+ * @return @c out on success.
+ * @return Null otherwise. No window is created in this case.
+ * */
+XwWindow **xw_window_create_many (const XwWindowCreateInfo *infos, Size n, XwWindow **out) {
+    RETURN_VALUE_IF (!infos || !n || !out, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    /* validate everything first, so we never have to roll back because of bad arguments */
+    for (Size s = 0; s < n; s++) {
+        RETURN_VALUE_IF (!infos[s].width || !infos[s].height, Null, ERR_INVALID_ARGUMENTS);
+    }
+
+    XwWindow *batch = XW_ALLOCATE (XW_ALLOC_CATEGORY_WINDOW, XwWindow, n);
+    RETURN_VALUE_IF (!batch, Null, ERR_OUT_OF_MEMORY);
+
+    Size num_created = 0;
+    while (num_created < n) {
+        const XwWindowCreateInfo *info = infos + num_created;
+        XwWindow                 *win  = batch + num_created;
+
+        XwWindow *iwin =
+            xw_window_setup (win, info->title, info->width, info->height, info->xpos, info->ypos);
+        GOTO_HANDLER_IF (!iwin, INIT_FAILED, ERR_OBJECT_INITIALIZATION_FAILED);
+
+        win->batch       = batch;
+        out[num_created] = win;
+        num_created++;
+    }
+
+    batch->batch_refs = n;
+    return out;
+
+INIT_FAILED: {
+    /* window that failed can be partially initialized as well */
+    for (Size s = 0; s <= num_created; s++) {
+        xw_window_deinit (batch + s);
+        out[s] = Null;
+    }
+    XW_FREE (XW_ALLOC_CATEGORY_WINDOW, batch);
+    return Null;
+}
+}
+
+/**
+ * @b Create a new @x XwWindow object.
+ *
+ * @param self XwWindow object to be initialized.
+ * @param title Cannot be @c Null.
+ * @param width Cannot be 0.
+ * @param height Cannot be 0.
+ * @param xpos
+ * @param ypos
+ *
+ * @return XwWindow* on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_init (
+    XwWindow *self,
+    CString   title,
+    Uint32    width,
+    Uint32    height,
+    Uint32    xpos,
+    Uint32    ypos
+) {
+    RETURN_VALUE_IF (!self || !width || !height, Null, ERR_INVALID_ARGUMENTS);
+
+    XwWindow *iself = xw_window_setup (self, title, width, height, xpos, ypos);
+    RETURN_VALUE_IF (!iself, Null, ERR_OBJECT_INITIALIZATION_FAILED);
+
+    return self;
+}
+
+/**
+ * @b Deinitialize given @c XwWindow object.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_deinit (XwWindow *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    /* unregister this window from xw_state, waiting for event being applied (if any) in
+     * some other thread, as it may be an event of this window */
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    if (self->xw_id != SIZE_MAX) {
+        xw_window_table_remove (&xw_state.windows, self->xw_id);
+        self->xw_id = SIZE_MAX;
+    }
+    xw_idle_set_presentable (&self->presentable, False);
+    xw_forget_window_events (self);
+    xw_event_backlog_forget_window (&xw_state.backlog, self);
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    /* no more events can be routed to this window now */
+    if (self->queue) {
+        xw_event_queue_destroy (self->queue);
+        self->queue = Null;
+    }
+
+    xw_window_release_framebuffer (self);
+
+    /* destroy strdup-ed string */
+    if (self->title) {
+        XW_FREE (XW_ALLOC_CATEGORY_TITLE, self->title);
+        self->title = Null;
+    }
+
+    XW_MUTEX_DEINIT (&self->lock);
+
+    return self;
+}
+
+/**
+ * @b Destroy window.
+ *
+ * This will also free the given @c XwWindow object. For windows created using
+ * @c xw_window_create_many, memory is released once every window of the batch
+ * is destroyed.
+ *
+ * @param self @c XwWindow object to be destroyed.
+ * */
+void xw_window_destroy (XwWindow *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    xw_window_deinit (self);
+
+    /* windows created by xw_window_create_many share a single allocation */
+    if (self->batch) {
+        if (!__atomic_sub_fetch (&self->batch->batch_refs, 1, __ATOMIC_ACQ_REL)) {
+            XW_FREE (XW_ALLOC_CATEGORY_WINDOW, self->batch);
+        }
+        return;
+    }
+
+    XW_FREE (XW_ALLOC_CATEGORY_WINDOW, self);
+}
+
+/**
+ * @b Change window's visibility to visible.
+ *
+ * Like a display server would, this generates visibility and paint events.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_show (XwWindow *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    xw_window_queue_map_events (self, True);
+    return self;
+}
+
+/**
+ * @b Change window's visibility to invisible.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_hide (XwWindow *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    xw_window_queue_map_events (self, False);
+    return self;
+}
+
+/**
+ * @b Get title string of given window.
+ *
+ * User must free the returend pointer to title string after use.
+ * The returned memory is strduped out of actual window title.
+ *
+ * @param self Window object to get title of.
+ *
+ * @return CString if title is set and we can successfully
+ *         strdup it.
+ * @return Null if title does not exist or some error occured.
+ * */
+CString xw_window_get_title (XwWindow *self) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&self->lock);
+    CString title = self->title ? strdup (self->title) : Null;
+    XW_MUTEX_UNLOCK (&self->lock);
+
+    RETURN_VALUE_IF (!title, Null, ERR_OUT_OF_MEMORY);
+    return title;
+}
+
+/**
+ * @b Get window size.
+ *
+ * @param self Window object.
+ *
+ * @return XwWindowSize containing width and height of window.
+ * */
+XwWindowSize xw_window_get_size (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    return XW_LOAD (&self->size);
+}
+
+/**
+ * @b Get minimum window size.
+ *
+ * @param self Window object.
+ *
+ * @return XwWindowSize containing min width and min height of window.
+ * */
+XwWindowSize xw_window_get_min_size (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    return XW_LOAD (&self->min_size);
+}
+
+/**
+ * @b Get maximum window size.
+ *
+ * @param self Window object.
+ *
+ * @return XwWindowSize containing max width and max height of window.
+ * */
+XwWindowSize xw_window_get_max_size (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    return XW_LOAD (&self->max_size);
+}
+
+/**
+ * @b Get window position.
+ *
+ * @param self Window object.
+ *
+ * @return XwWindowPos containing x and y coordinates of window from left corner of screen.
+ * */
+XwWindowPos xw_window_get_pos (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwWindowPos) {0, 0}), ERR_INVALID_ARGUMENTS);
+    return XW_LOAD (&self->pos);
+}
+
+/**
+ * @b Get refresh rate of monitor showing given window. There's no monitor, so this is
+ *    always a typical 60 Hz, letting frame pacing code run same as it would on a display.
+ *
+ * @param self
+ *
+ * @return Refresh rate in Hz on success.
+ * @return 0 otherwise.
+ * */
+Float64 xw_window_get_refresh_rate (XwWindow *self) {
+    RETURN_VALUE_IF (!self, 0, ERR_INVALID_ARGUMENTS);
+    return 60.0;
+}
+
+/**
+ * @b Check whether anything rendered to given window can be seen, meaning window is mapped,
+ *    not minimized and not fully obscured. Rendering can be skipped otherwise.
+ *
+ * Updated as events are polled, so this is only as fresh as the last @c xw_event_poll.
+ *
+ * @param win Window to check. Null checks whether any window is presentable.
+ *
+ * @return True if rendering is worth it.
+ * @return False otherwise.
+ * */
+Bool xw_should_render (XwWindow *win) {
+    return win ? XW_LOAD (&win->presentable) : xw_idle_any_presentable();
+}
+
+/**
+ * @b Get window state (minimized, fullscreen, normal, etc...)
+ *
+ * @param self @c XwWindow object to get state of.
+ * 
+ * @return @c XW_WINDOW_STATE_CLEAR on failure or if state is not known,
+ * @return Any other value less than @x XW_WINDOW_STATE_MAX on success.
+ * */
+XwWindowState xw_window_get_state (XwWindow *self) {
+    RETURN_VALUE_IF (!self, XW_WINDOW_STATE_MASK_CLEAR, ERR_INVALID_ARGUMENTS);
+    return XW_LOAD (&self->state);
+}
+
+/**
+ * @b Get bitmask of currently allowed window permissions.
+ *
+ * @param self 
+ *
+ * @return @c XwWindowActionPermissions on success.
+ * @return @c XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR otherwise.
+ * */
+XwWindowActionPermissions xw_window_get_action_permissions (XwWindow *self) {
+    RETURN_VALUE_IF (!self, XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR, ERR_INVALID_ARGUMENTS);
+    return XW_LOAD (&self->action_permissions);
+}
+
+/**
+ * @b Set window title.
+ *
+ * @param self
+ * @param title
+ *
+ * @return The set window title on success.
+ * @return Null otherwise.
+ * */
+CString xw_window_set_title (XwWindow *self, CString title) {
+    RETURN_VALUE_IF (!self || !title, Null, ERR_INVALID_ARGUMENTS);
+
+    CString set_title = XW_STRDUP (XW_ALLOC_CATEGORY_TITLE, title);
+    RETURN_VALUE_IF (!set_title, Null, ERR_OUT_OF_MEMORY);
+
+    XW_MUTEX_LOCK (&self->lock);
+    if (self->title) {
+        XW_FREE (XW_ALLOC_CATEGORY_TITLE, self->title);
+    }
+    self->title = set_title;
+    XW_MUTEX_UNLOCK (&self->lock);
+
+    return title;
+}
+
+/**
+ * @b Set window size.
+ *
+ * If provided window size exceeds limit then size is not changed. Same as the XCB
+ * backend, size changed by application itself does not generate a resize event.
+ *
+ * @param self
+ * @param size
+ *
+ * @return Set window size on success. This may or may not be same as provided size
+ *         due to window size bounds.
+ * @return {0, 0} on failure. 
+ * */
+XwWindowSize xw_window_set_size (XwWindow *self, XwWindowSize size) {
+    RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+
+    /* make sure the size is in bounds */
+    XwWindowSize min_size = XW_LOAD (&self->min_size);
+    XwWindowSize max_size = XW_LOAD (&self->max_size);
+    if (size.width < min_size.width || size.width > max_size.width ||
+        size.height < min_size.height || size.height > max_size.height) {
+        return XW_LOAD (&self->size);
+    }
+
+    XW_STORE (&self->size, size);
+    return size;
+}
+
+/**
+ * @b Set minimum window size.
+ *
+ * @param self Window object.
+ * @param size Min size of window.
+ *
+ * @return @c size on success.
+ * @return @c {0, 0} on failure 
+ * */
+XwWindowSize xw_window_set_min_size (XwWindow *self, XwWindowSize size) {
+    RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    XwWindowSize max_size = XW_LOAD (&self->max_size);
+    RETURN_VALUE_IF (
+        size.width > max_size.width || size.height > max_size.height,
+        ((XwWindowSize) {0, 0}),
+        "Min size bound cannot be greater than max size bound of window\n"
+    );
+
+    XW_STORE (&self->min_size, size);
+    return size;
+}
+
+/**
+ * @b Set maximum window size.
+ *
+ * @param self Window object.
+ * @param size Max size of window.
+ *
+ * @return @c size on success.
+ * @return @c {0, 0} on failure 
+ * */
+XwWindowSize xw_window_set_max_size (XwWindow *self, XwWindowSize size) {
+    RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    XwWindowSize min_size = XW_LOAD (&self->min_size);
+    RETURN_VALUE_IF (
+        size.width < min_size.width || size.height < min_size.height,
+        ((XwWindowSize) {0, 0}),
+        "Max size bound cannot be less than min size bound of window\n"
+    );
+
+    XW_STORE (&self->max_size, size);
+    return size;
+}
+
+/**
+ * @b Set window position.
+ *
+ * @param self
+ * @param pos
+ *
+ * @return The window position that was set.
+ * */
+XwWindowPos xw_window_set_pos (XwWindow *self, XwWindowPos pos) {
+    RETURN_VALUE_IF (!self, ((XwWindowPos) {0, 0}), ERR_INVALID_ARGUMENTS);
+
+    XW_STORE (&self->pos, pos);
+    return pos;
+}
+
+/**
+ * @b Mask of window states to be set.
+ *
+ * A state change event is generated, like the one a window manager sends after
+ * changing window state.
+ *
+ * @param self
+ * @param state
+ *
+ * @return @c XwWindowStateMask as mask of all states that were set on success.
+ * @return @c XW_WINDOW_STATE_MASK_CLEAR on failure.
+ * */
+XwWindowState xw_window_set_state (XwWindow *self, XwWindowState state) {
+    RETURN_VALUE_IF (!self, XW_WINDOW_STATE_MASK_CLEAR, ERR_INVALID_ARGUMENTS);
+
+    XwEvent e;
+    RETURN_VALUE_IF (
+        !xw_push_event (xw_event_make_state_change (&e, state, self)),
+        XW_WINDOW_STATE_MASK_CLEAR,
+        "Failed to queue state change event\n"
+    );
+
+    XW_STORE (&self->state, state);
+    return state;
+}
+
+/**
+ * @b Set window action permissions.
+ *
+ * @return @c permissions on success.
+ * @return @c XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR
+ * */
+XwWindowActionPermissions
+    xw_window_set_action_permissions (XwWindow *self, XwWindowActionPermissions permissions) {
+    RETURN_VALUE_IF (!self, XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR, ERR_INVALID_ARGUMENTS);
+
+    XW_STORE (&self->action_permissions, permissions);
+    return permissions;
+}
+
+/**
+ * @c Remove or set border to window.
+ *
+ * @param self 
+ * @param border True if window must have a decoration, False otherwise.
+ *
+ * @return @c self on success.
+ * @return @c Null otherwise.
+ * */
+XwWindow *xw_window_set_bordered (XwWindow *self, Bool border) {
+    RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    XW_STORE (&self->bordered, !!border);
+    return self;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Fill in a new window and register it to global state.
+ *
+ * This is where @c xw_window_init and @c xw_window_create_many do their actual work.
+ *
+ * @param self
+ * @param title Can be @c Null.
+ * @param width Cannot be 0.
+ * @param height Cannot be 0.
+ * @param xpos
+ * @param ypos
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+static XwWindow *xw_window_setup (
+    XwWindow *self,
+    CString   title,
+    Uint32    width,
+    Uint32    height,
+    Uint32    xpos,
+    Uint32    ypos
+) {
+    RETURN_VALUE_IF (!self || !width || !height, Null, ERR_INVALID_ARGUMENTS);
+
+    /* not registered yet, so that deinit on failure does not release some other window's id */
+    self->xw_id = SIZE_MAX;
+    RETURN_VALUE_IF (!xw_state.initialized, Null, ERR_XW_STATE_NOT_INITIALIZED);
+    RETURN_VALUE_IF (XW_MUTEX_INIT (&self->lock), Null, "Failed to create window lock\n");
+
+    self->border_width       = 0;
+    self->min_size           = (XwWindowSize) {0, 0};
+    self->max_size           = (XwWindowSize) {XW_NULL_SCREEN_WIDTH, XW_NULL_SCREEN_HEIGHT};
+    self->size.width         = CLAMP (width, 0, self->max_size.width);
+    self->size.height        = CLAMP (height, 0, self->max_size.height);
+    self->pos.x              = xpos;
+    self->pos.y              = ypos;
+    self->title              = Null;
+    self->state              = XW_WINDOW_STATE_MASK_CLEAR;
+    self->action_permissions = (XwWindowActionPermissions)-1;
+    self->visible            = False;
+    self->bordered           = True;
+
+    if (title) {
+        self->title = XW_STRDUP (XW_ALLOC_CATEGORY_TITLE, title);
+        RETURN_VALUE_IF (!self->title, Null, ERR_OUT_OF_MEMORY);
+    }
+
+    /* register this window to global state. */
+    self->xw_id = xw_window_table_insert (&xw_state.windows, self);
+    RETURN_VALUE_IF (self->xw_id == SIZE_MAX, Null, "Failed to register window\n");
+
+    /* windows are mapped on creation */
+    xw_window_queue_map_events (self, True);
+
+    return self;
+}
+
+/**
+ * @b Queue events a display server sends when window is mapped or unmapped.
+ *
+ * Mapping a window generates a visibility event followed by a paint event, unmapping
+ * generates only the visibility event.
+ *
+ * @param self
+ * @param visible
+ * */
+static void xw_window_queue_map_events (XwWindow *self, Bool visible) {
+    XwEvent e;
+
+    xw_push_event (xw_event_make_visibility (&e, visible, self));
+    if (visible) {
+        xw_push_event (xw_event_make_paint (&e, self));
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file Window.h
+ * @time 18/10/2026 12:47:14
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+#ifndef CROSSWINDOW_PRIVATE_WINDOW_H
+#define CROSSWINDOW_PRIVATE_WINDOW_H
+
+#include <Anvie/CrossWindow/Framebuffer.h>
+#include <Anvie/CrossWindow/Window.h>
+
+/* local headers */
+#include "Common/EventQueue.h"
+#include "Common/Lock.h"
+
+typedef struct XwWindow {
+    /* platform independent data */
+    Size xw_id; /**< @b This is cross window id. Different from platform window id. */
+
+    Uint32       border_width;
+    XwWindowSize size;
+    XwWindowSize min_size;
+    XwWindowSize max_size;
+    XwWindowPos  pos;
+
+    CString title;
+    XwMutex lock; /**< @b Guards @c title, it's freed when replaced. */
+
+    XwWindowState             state; /* bitmask of current window state. */
+    XwWindowActionPermissions action_permissions;
+
+    Bool visible;
+    Bool bordered;
+    Bool presentable; /**< @b Visible and not hidden. Changed with event lock held. */
+
+    Bool   frame_events_enabled; /**< @b Frame events are generated for presented pixmaps. */
+    Uint32 present_serial;       /**< @b Serial of last presented frame. */
+    Uint64 present_msc;          /**< @b Virtual vblank counter, incremented on every present. */
+
+    /* software framebuffer, created on first call to xw_window_get_framebuffer */
+    struct {
+        XwFramebuffer info;
+        Uint8        *data;
+    } framebuffer;
+
+    /**
+     * @b Events of this window are routed here instead of being returned by @c xw_event_poll.
+     *    Set by @c xw_window_enable_event_queue, Null otherwise.
+     * */
+    XwEventQueue *queue;
+
+    /* only for windows created with xw_window_create_many */
+    struct XwWindow *batch;      /**< @b First window of the block this window is allocated in. */
+    Size             batch_refs; /**< @b Windows still alive in block. Used only in first window. */
+} XwWindow;
+
+void xw_window_release_framebuffer (XwWindow *self);
+
+#endif // CROSSWINDOW_PRIVATE_WINDOW_H
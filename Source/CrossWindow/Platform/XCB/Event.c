@@ -32,59 +32,325 @@
  * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * */
 
+/* ppoll */
+#define _GNU_SOURCE
+
 #include <Anvie/Common.h>
 #include <Anvie/CrossWindow/Event.h>
 
 /* local headers */
+#include "Common/Allocator.h"
 #include "State.h"
 #include "Window.h"
 
 /* libc headers */
+#include <poll.h>
 #include <string.h>
 
 /* x11/xcb headers */
+#include <xcb/present.h>
 #include <xcb/xcb_keysyms.h>
+#include <xcb/xcbext.h> /* for polling on replies with only sequence number */
 #include <xcb/xproto.h>
 
 #define ERR_WINDOW_SEARCH_FAILED "Failed to find window associated with event\n"
 
+/** @b In motion hint mode, pointer of a window is queried at most this often (a 60 Hz frame). */
+#define XW_MOTION_HINT_INTERVAL_NS (1000000000ull / 60)
+
+/* Events for windows CrossWindow did not create (eg: children, with substructure notify) are
+ * common and expected, so these are logged only at debug level. */
+#define GOTO_WINDOW_SEARCH_FAILED_IF(cond)                                                         \
+    do {                                                                                           \
+        if ((cond)) {                                                                              \
+            XW_LOG_DEBUG (ERR_WINDOW_SEARCH_FAILED);                                               \
+            goto WINDOW_SEARCH_FAILED;                                                             \
+        }                                                                                          \
+    } while (0)
+
 extern XwState xw_state;
 
 static XwKey    xw_key_from_xcb_keycode (xcb_keycode_t detail);
 static XwEvent *xw_fill_event (XwEvent *eq, const xcb_generic_event_t *event);
-static Size get_xcb_atom_property_atom (xcb_atom_t atom, xcb_window_t window, xcb_atom_t **values);
+static XwEvent *xw_fill_event_traced (XwEvent *e, const xcb_generic_event_t *xcb_event);
+static Bool     xw_event_route (const XwEvent *e);
+static Bool     xw_take_xcb_event (XwEvent *e, xcb_generic_event_t *xcb_event);
+static void     xw_queue_xcb_event (xcb_generic_event_t *xcb_event);
+static Bool     xw_take_backlog_event (XwEvent *e);
+static Bool     xw_take_posted_event (XwEvent *e);
+static Bool     xw_take_pointer_reply (XwEvent *e);
+static Uint64   xw_query_hinted_pointers (void);
+static Bool     xw_take_reply_event (XwEvent *e);
+static Bool     xw_take_state_reply (XwEvent *e);
+static void     xw_window_update_presentable (XwWindow *window);
+static XwWindowState xw_window_state_from_atoms (const xcb_atom_t *atoms, Size atom_count);
 
 /* defined in Window.c */
 extern XwWindow *xw_get_window_by_xcb_id (xcb_window_t xcb_win_id);
 
 XwEvent *xw_event_poll (XwEvent *e) {
     RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    XW_TRACE_BEGIN ("xw_event_poll");
+    xw_round_trip_enter_poll();
 
     /* make sure all pending operations are done */
-    xcb_flush (xw_state.connection);
-
-    /* poll event and fill the given event object */
-    xcb_generic_event_t *xcb_event = xcb_poll_for_event (xw_state.connection);
-    if (!xcb_event) {
-        return Null;
-    } else {
-        xw_fill_event (e, xcb_event);
-        FREE (xcb_event);
-        return e;
+    XW_FLUSH (xw_state.connection);
+
+    /* poll event and fill the given event object, skipping events routed to window queues */
+    xcb_generic_event_t *xcb_event = Null;
+    Bool                 got_event = xw_take_backlog_event (e);
+    while (!got_event && (xcb_event = xcb_poll_for_event (xw_state.connection))) {
+        got_event = xw_take_xcb_event (e, xcb_event);
+    }
+
+    /* replies to requests made while converting earlier events */
+    if (!got_event) {
+        got_event = xw_take_reply_event (e);
+    }
+
+    /* posted events come after the ones display server already sent */
+    while (!got_event && xw_post_pop (e)) {
+        got_event = xw_take_posted_event (e);
     }
+
+    /* timers are not tied to windows, so they're never routed */
+    if (!got_event) {
+        got_event = xw_timer_wheel_pop (e);
+    }
+
+    /* everything that arrived is handled, so motion of this frame can be asked for */
+    if (!got_event) {
+        xw_query_hinted_pointers();
+    }
+
+    xw_round_trip_leave_poll();
+    XW_TRACE_END ("xw_event_poll");
+
+    return got_event ? e : Null;
 }
 
+/**
+ * @b Wait till an event arrives from display server, is posted using @c xw_event_post, or
+ *    a timer expires.
+ *
+ * Display server connection, wakeup eventfd and timerfd are polled together, so posting an
+ * event from any thread wakes the waiting thread without a round trip to display server, and
+ * timers need no thread of their own.
+ *
+ * @param e
+ *
+ * @return @c e on success.
+ * @return Null if connection to display server broke.
+ * */
 XwEvent *xw_event_wait (XwEvent *e) {
+    return xw_event_wait_until (e, 0);
+}
+
+/**
+ * @b Same as @c xw_event_wait, but gives up once given CLOCK_MONOTONIC time is reached.
+ *    Deadline is ignored while idle blocking is enabled and no window is presentable.
+ *
+ * @param e
+ * @param deadline_ns Time to stop waiting at, in nanoseconds. 0 waits forever.
+ *
+ * @return @c e on success.
+ * @return Null if deadline was reached, or connection to display server broke.
+ * */
+XwEvent *xw_event_wait_until (XwEvent *e, Uint64 deadline_ns) {
     RETURN_VALUE_IF (!e, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    /* sleeping in ppoll is expected, only waiting for a reply is counted as a round trip */
+    xw_round_trip_enter_poll();
 
     /* make sure all pending operations are done */
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
+
+    /* wait for event and fill the given event object, skipping events routed to window queues */
+    Bool got_event = False;
+    Bool timed_out = False;
+    Bool broken    = False;
+    while (!got_event && !timed_out && !broken) {
+        if (xw_take_backlog_event (e)) {
+            got_event = True;
+            break;
+        }
 
-    /* poll event and fill the given event object */
-    xcb_generic_event_t *xcb_event = xcb_wait_for_event (xw_state.connection);
-    xw_fill_event (e, xcb_event);
+        /* check for events once more after telling posters we're about to sleep */
+        int                  wakeup_fd = xw_post_begin_wait();
+        xcb_generic_event_t *xcb_event = xcb_poll_for_event (xw_state.connection);
+        Bool                 replied   = !xcb_event && xw_take_reply_event (e);
+        Bool                 posted    = !xcb_event && !replied && xw_post_pop (e);
+        Bool                 expired =
+            !xcb_event && !replied && !posted && xw_timer_wheel_pop (e);
+        Bool woken = False;
+
+        /* xcb returns no events once connection is broken, there's nothing to wait for */
+        broken = !xcb_event && !replied && !posted && !expired &&
+                 xcb_connection_has_error (xw_state.connection);
+
+        if (!xcb_event && !replied && !posted && !expired && !broken) {
+            /* a negative fd is ignored by poll, so a missing wakeup fd needs no special case */
+            struct pollfd fds[] = {
+                {.fd = xcb_get_file_descriptor (xw_state.connection), .events = POLLIN},
+                {.fd = wakeup_fd,                                     .events = POLLIN},
+                {.fd = xw_timer_wheel_fd(),                           .events = POLLIN}
+            };
+
+            /* deadline does not matter while nothing can be seen, see xw_event_set_idle_blocking */
+            Uint64 until = xw_idle_should_block() ? 0 : deadline_ns;
+
+            /* a hinted window whose pointer was queried recently is queried once it's due */
+            Uint64 query_at = xw_query_hinted_pointers();
+            Uint64 wake_at  = query_at && (!until || query_at < until) ? query_at : until;
+
+            Uint64 now = wake_at ? xw_timer_now_ns() : 0;
+            if (now < wake_at || !wake_at) {
+                struct timespec timeout = {
+                    .tv_sec  = (wake_at - now) / 1000000000ull,
+                    .tv_nsec = (wake_at - now) % 1000000000ull
+                };
+
+                XW_TRACE_BEGIN ("xw_event_wait:poll");
+                int ready = ppoll (fds, ARRAY_SIZE (fds), wake_at ? &timeout : Null, Null);
+                XW_TRACE_END ("xw_event_wait:poll");
+
+                woken     = ready > 0 && (fds[1].revents & POLLIN);
+                timed_out = !ready && wake_at == until;
+            } else {
+                timed_out = wake_at == until;
+            }
+        }
 
-    return e;
+        xw_post_end_wait (woken);
+
+        if (xcb_event && xw_event_backlog_enabled()) {
+            /* more events may have arrived with it, sort them all on next iteration */
+            xw_queue_xcb_event (xcb_event);
+        } else if (xcb_event) {
+            got_event = xw_take_xcb_event (e, xcb_event);
+        } else if (replied) {
+            got_event = True;
+        } else if (posted) {
+            got_event = xw_take_posted_event (e);
+        } else {
+            got_event = expired;
+        }
+    }
+
+    xw_round_trip_leave_poll();
+    RETURN_VALUE_IF (broken, Null, "Connection to X server broke while waiting for event\n");
+
+    return got_event ? e : Null;
+}
+
+/**
+ * @b Give window it's own event queue. From now on, events of this window are routed to it's
+ *    queue, and are popped using @c xw_window_event_poll instead of @c xw_event_poll.
+ *
+ * Routing happens while some thread pumps events using @c xw_event_poll or @c xw_event_wait,
+ * so one thread must keep doing that. Events not tied to any window (keymap changes for
+ * example) are copied to queues of all windows and also returned by @c xw_event_poll.
+ *
+ * Queue has a single consumer, only one thread must call @c xw_window_event_poll for a
+ * window. Events that arrive while queue is full are dropped.
+ *
+ * @param self
+ * @param capacity Most events queue can hold before dropping them.
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_enable_event_queue (XwWindow *self, Size capacity) {
+    RETURN_VALUE_IF (!self || !capacity, Null, ERR_INVALID_ARGUMENTS);
+
+    XwEventQueue *queue = xw_event_queue_create (capacity);
+    RETURN_VALUE_IF (!queue, Null, "Failed to create event queue for window\n");
+
+    /* events of this window may be getting routed right now */
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    Bool enabled = !!self->queue;
+    if (!enabled) {
+        XW_STORE (&self->queue, queue);
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    if (enabled) {
+        xw_event_queue_destroy (queue);
+    }
+    RETURN_VALUE_IF (enabled, Null, "Event queue of window is already enabled\n");
+
+    return self;
+}
+
+/**
+ * @b Get next event from event queue of given window, without waiting.
+ *
+ * Takes no lock. Call only from the one thread that consumes events of this window.
+ *
+ * @param self Window with event queue enabled using @c xw_window_enable_event_queue.
+ * @param e
+ *
+ * @return @c e if an event was popped.
+ * @return Null if queue is empty, or not enabled.
+ * */
+XwEvent *xw_window_event_poll (XwWindow *self, XwEvent *e) {
+    RETURN_VALUE_IF (!self || !e, Null, ERR_INVALID_ARGUMENTS);
+
+    XwEventQueue *queue = XW_LOAD (&self->queue);
+    RETURN_VALUE_IF (!queue, Null, "Event queue of window is not enabled\n");
+
+    return xw_event_queue_pop (queue, e) ? e : Null;
+}
+
+/**
+ * @b Make windows ask display server for pointer motion hints instead of every motion.
+ *
+ * Display server then sends a single hint when pointer moves, and nothing more till pointer
+ * is queried. CrossWindow queries it once all events that arrived are handled, at most once
+ * a frame (at 60 Hz) per window, and turns the reply into an @c XW_EVENT_TYPE_MOUSE_MOVE
+ * event with latest position. So there's at most one mouse move per window per frame, and
+ * code handling mouse moves needs no change. Enter, leave and button events are sent as usual.
+ *
+ * Over a network every motion event costs bandwidth and a wakeup, so this is enabled when
+ * @c DISPLAY names another host (X11 forwarding over SSH included). Setting
+ * @c XW_MOTION_HINTS environment variable to 1 or 0 before library is loaded overrides that.
+ *
+ * @param enable
+ * */
+void xw_event_set_motion_hints (Bool enable) {
+    RETURN_IF (!xw_state.connection, ERR_XW_STATE_NOT_INITIALIZED);
+
+    XW_STORE (&xw_state.motion_hints, !!enable);
+    Uint32 mask = XW_WINDOW_EVENT_MASK | (enable ? XCB_EVENT_MASK_POINTER_MOTION_HINT : 0);
+
+    /* change windows that already exist, new ones are created with new mask */
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    for (Size s = 0; slots && s < slots->capacity; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (win) {
+            xcb_void_cookie_t cookie = xcb_change_window_attributes (
+                xw_state.connection,
+                win->xcb_window_id,
+                XCB_CW_EVENT_MASK,
+                &mask
+            );
+            xw_track_request (cookie.sequence, win);
+        }
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    XW_FLUSH (xw_state.connection);
+}
+
+/**
+ * @b Check whether windows ask for pointer motion hints, see @c xw_event_set_motion_hints.
+ * */
+Bool xw_event_get_motion_hints (void) {
+    return XW_LOAD (&xw_state.motion_hints);
 }
 
 /**
@@ -102,6 +368,78 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
     e->type = XW_EVENT_TYPE_NONE;
 
     switch (event_code) {
+        /* Some request failed on X server. XCB places errors of requests that don't expect a
+         * reply, and of all unchecked requests, in the event queue with response type 0.
+         *
+         * REF : https://tronche.com/gui/x/xlib/event-handling/protocol-errors/
+         * */
+        case 0 : {
+            const xcb_generic_error_t *err = (const xcb_generic_error_t *)xcb_event;
+
+            /* find window failed request was made for, the bad resource can be a window as well */
+            XwWindow *window = xw_get_window_by_request (err->full_sequence);
+            if (!window) {
+                window = xw_get_window_by_xcb_id (err->resource_id);
+            }
+
+            e = xw_event_make_error (
+                e,
+                err->error_code,
+                err->major_code,
+                err->minor_code,
+                err->full_sequence,
+                err->resource_id,
+                window
+            );
+
+            break;
+        }
+
+        /* Events of extensions that need more than 32 bytes. Only Present events are
+         * recognized, and only for windows that enabled frame events.
+         *
+         * REF : https://gitlab.freedesktop.org/xorg/proto/xorgproto/-/blob/master/presentproto.txt
+         * */
+        case XCB_GE_GENERIC : {
+            const xcb_ge_generic_event_t *ge = (const xcb_ge_generic_event_t *)xcb_event;
+            if (!xw_state.present_available || ge->extension != xw_state.present_opcode) {
+                break;
+            }
+
+            if (ge->event_type == XCB_PRESENT_COMPLETE_NOTIFY) {
+                const xcb_present_complete_notify_event_t *notify =
+                    (const xcb_present_complete_notify_event_t *)xcb_event;
+
+                /* MSC notifications are never requested */
+                if (notify->kind != XCB_PRESENT_COMPLETE_KIND_PIXMAP) {
+                    break;
+                }
+
+                XwWindow *window = xw_get_window_by_xcb_id (notify->window);
+                GOTO_WINDOW_SEARCH_FAILED_IF (!window);
+
+                /* XCB_PRESENT_COMPLETE_MODE_* values are same as XwPresentMode */
+                e = xw_event_make_frame_complete (
+                    e,
+                    notify->serial,
+                    notify->msc,
+                    notify->ust,
+                    (XwPresentMode)notify->mode,
+                    window
+                );
+            } else if (ge->event_type == XCB_PRESENT_IDLE_NOTIFY) {
+                const xcb_present_idle_notify_event_t *notify =
+                    (const xcb_present_idle_notify_event_t *)xcb_event;
+
+                XwWindow *window = xw_get_window_by_xcb_id (notify->window);
+                GOTO_WINDOW_SEARCH_FAILED_IF (!window);
+
+                e = xw_event_make_frame_idle (e, notify->serial, notify->pixmap, window);
+            }
+
+            break;
+        }
+
         /* Generated when a window is mapped onto screen. 
          * REF : https://tronche.com/gui/x/xlib/events/window-state-change/map.html
          * */
@@ -110,9 +448,12 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with given event */
             XwWindow *window = xw_get_window_by_xcb_id (notify->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
+
+            window->mapped = True;
+            xw_window_update_presentable (window);
 
-            e = xw_event_visibility (e, True, window);
+            e = xw_event_make_visibility (e, True, window);
 
             break;
         }
@@ -125,9 +466,33 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with given event */
             XwWindow *window = xw_get_window_by_xcb_id (notify->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_visibility (e, False, window);
+            /* obscured state is sent again once window is mapped */
+            window->mapped   = False;
+            window->obscured = False;
+            xw_window_update_presentable (window);
+
+            e = xw_event_make_visibility (e, False, window);
+
+            break;
+        }
+
+        /* Generated when a mapped window becomes (partially) covered or uncovered. Windows
+         * redirected by a compositor are always reported as unobscured.
+         * REF : https://tronche.com/gui/x/xlib/events/window-state-change/visibility.html
+         * */
+        case XCB_VISIBILITY_NOTIFY : {
+            xcb_visibility_notify_event_t *notify = (xcb_visibility_notify_event_t *)xcb_event;
+
+            /* find window associated with given event */
+            XwWindow *window = xw_get_window_by_xcb_id (notify->window);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
+
+            window->obscured = notify->state == XCB_VISIBILITY_FULLY_OBSCURED;
+            xw_window_update_presentable (window);
+
+            e = xw_event_make_visibility (e, !window->obscured, window);
 
             break;
         }
@@ -138,9 +503,9 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with given event */
             XwWindow *window = xw_get_window_by_xcb_id (fin->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_focus (e, True, window);
+            e = xw_event_make_focus (e, True, window);
 
             break;
         }
@@ -151,9 +516,9 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with given event */
             XwWindow *window = xw_get_window_by_xcb_id (fout->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_focus (e, False, window);
+            e = xw_event_make_focus (e, False, window);
 
             break;
         }
@@ -168,24 +533,28 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with given event */
             XwWindow *window = xw_get_window_by_xcb_id (notify->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
+
+            /* setters can change these from other threads at the same time */
+            XwWindowSize size = XW_LOAD (&window->size);
+            XwWindowPos  pos  = XW_LOAD (&window->pos);
 
             /* I'm assuming here that not all are possible at once! */
-            if (notify->width != window->size.width || notify->height != window->size.height) {
-                window->size = (XwWindowSize) {notify->width, notify->height};
-                e            = xw_event_resize (e, notify->width, notify->height, window);
-            } else if ((Uint32)notify->x != window->pos.x || (Uint32)notify->y != window->pos.y) {
-                window->pos = (XwWindowPos) {notify->x, notify->y};
-                e           = xw_event_reposition (e, notify->x, notify->y, window);
-            } else if (notify->border_width != window->border_width) {
-                window->border_width = notify->border_width;
-                e = xw_event_border_width_change (e, notify->border_width, window);
+            if (notify->width != size.width || notify->height != size.height) {
+                XW_STORE (&window->size, ((XwWindowSize) {notify->width, notify->height}));
+                e = xw_event_make_resize (e, notify->width, notify->height, window);
+            } else if ((Uint32)notify->x != pos.x || (Uint32)notify->y != pos.y) {
+                XW_STORE (&window->pos, ((XwWindowPos) {notify->x, notify->y}));
+                e = xw_event_make_reposition (e, notify->x, notify->y, window);
+            } else if (notify->border_width != XW_LOAD (&window->border_width)) {
+                XW_STORE (&window->border_width, notify->border_width);
+                e = xw_event_make_border_width_change (e, notify->border_width, window);
             } else if (notify->above_sibling != XCB_WINDOW_NONE) {
                 /* search for sibling window */
                 XwWindow *above_sibling = xw_get_window_by_xcb_id (notify->above_sibling);
-                GOTO_HANDLER_IF (!above_sibling, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+                GOTO_WINDOW_SEARCH_FAILED_IF (!above_sibling);
 
-                e = xw_event_restack (e, above_sibling, window);
+                e = xw_event_make_restack (e, above_sibling, window);
             }
 
             break;
@@ -203,9 +572,9 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (expose->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_paint (e, window);
+            e = xw_event_make_paint (e, window);
             break;
         }
 
@@ -219,9 +588,9 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (resize->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_resize (e, resize->width, resize->height, window);
+            e = xw_event_make_resize (e, resize->width, resize->height, window);
             break;
         }
 
@@ -234,9 +603,9 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (enter->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_enter (e, enter->event_x, enter->event_y, window);
+            e = xw_event_make_enter (e, enter->event_x, enter->event_y, window);
             break;
         }
 
@@ -249,9 +618,9 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (leave->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-            e = xw_event_leave (e, leave->event_x, leave->event_y, window);
+            e = xw_event_make_leave (e, leave->event_x, leave->event_y, window);
             break;
         }
 
@@ -264,12 +633,12 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (msg->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
             if (msg->type == xw_state.WM_PROTOCOLS && msg->format == 32) {
                 xcb_atom_t protocol = msg->data.data32[0];
                 if (protocol == xw_state.WM_DELETE_WINDOW) {
-                    e = xw_event_close_window (e, window);
+                    e = xw_event_make_close_window (e, window);
                 }
             }
             break;
@@ -284,66 +653,43 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (notify->window);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
-
-            if (notify->atom == xw_state._NET_WM_STATE) {
-                xcb_atom_t *values      = Null;
-                Size        value_count = get_xcb_atom_property_atom (
-                    xw_state._NET_WM_STATE,
-                    window->xcb_window_id,
-                    &values
-                );
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
-                XwWindowState new_state = window->state;
-                Bool          add       = notify->state;
-                for (Size s = 0; s < value_count; s++) {
-                    if (values[s] == xw_state._NET_WM_STATE_MODAL) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_MODAL :
-                                          new_state & ~XW_WINDOW_STATE_MASK_MODAL;
-                    } else if (values[s] == xw_state._NET_WM_STATE_STICKY) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_STICKY :
-                                          new_state & ~XW_WINDOW_STATE_MASK_STICKY;
-                    } else if (values[s] == xw_state._NET_WM_STATE_MAXIMIZED_VERT) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_MAXIMIZED_VERT :
-                                          new_state & ~XW_WINDOW_STATE_MASK_MAXIMIZED_VERT;
-                    } else if (values[s] == xw_state._NET_WM_STATE_MAXIMIZED_HORZ) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_MAXIMIZED_HORZ :
-                                          new_state & ~XW_WINDOW_STATE_MASK_MAXIMIZED_HORZ;
-                    } else if (values[s] == xw_state._NET_WM_STATE_SHADED) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_SHADED :
-                                          new_state & ~XW_WINDOW_STATE_MASK_SHADED;
-                    } else if (values[s] == xw_state._NET_WM_STATE_SKIP_TASKBAR) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_SKIP_TASKBAR :
-                                          new_state & ~XW_WINDOW_STATE_MASK_SKIP_TASKBAR;
-                    } else if (values[s] == xw_state._NET_WM_STATE_SKIP_PAGER) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_SKIP_PAGER :
-                                          new_state & ~XW_WINDOW_STATE_MASK_SKIP_PAGER;
-                    } else if (values[s] == xw_state._NET_WM_STATE_HIDDEN) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_HIDDEN :
-                                          new_state & ~XW_WINDOW_STATE_MASK_HIDDEN;
-                    } else if (values[s] == xw_state._NET_WM_STATE_FULLSCREEN) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_FULLSCREEN :
-                                          new_state & ~XW_WINDOW_STATE_MASK_FULLSCREEN;
-                    } else if (values[s] == xw_state._NET_WM_STATE_ABOVE) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_ABOVE :
-                                          new_state & ~XW_WINDOW_STATE_MASK_ABOVE;
-                    } else if (values[s] == xw_state._NET_WM_STATE_BELOW) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_BELOW :
-                                          new_state & ~XW_WINDOW_STATE_MASK_BELOW;
-                    } else if (values[s] == xw_state._NET_WM_STATE_DEMANDS_ATTENTION) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_DEMANDS_ATTENTION :
-                                          new_state & ~XW_WINDOW_STATE_MASK_DEMANDS_ATTENTION;
-                    } else if (values[s] == xw_state._NET_WM_STATE_FOCUSED) {
-                        new_state = add ? new_state | XW_WINDOW_STATE_MASK_FOCUSED :
-                                          new_state & ~XW_WINDOW_STATE_MASK_FOCUSED;
-                    }
-                }
+            if (notify->atom != xw_state._NET_WM_STATE) {
+                break;
+            }
+
+            /* only latest value matters, window managers change it on every focus change */
+            if (window->state_query) {
+                xcb_discard_reply (xw_state.connection, window->state_query);
+                window->state_query = 0;
+                XW_STORE (&xw_state.state_pending, xw_state.state_pending - 1);
+            }
+
+            /* property is read without waiting, state change is sent once value arrives */
+            if (notify->state == XCB_PROPERTY_NEW_VALUE) {
+                xcb_get_property_cookie_t cookie = xcb_get_property (
+                    xw_state.connection,    // xcb_connection_t *c,
+                    False,                  // uint8_t           _delete,
+                    window->xcb_window_id,  // xcb_window_t      window,
+                    xw_state._NET_WM_STATE, // xcb_atom_t        property,
+                    XCB_ATOM_ATOM,          // xcb_atom_t        type,
+                    0,                      // uint32_t          long_offset,
+                    UINT32_MAX              // uint32_t          long_length
+                );
+                xw_track_request (cookie.sequence, window);
+                XW_FLUSH (xw_state.connection);
 
-                /* set new state */
-                window->state = new_state;
-                e             = xw_event_state_change (e, new_state, window);
+                window->state_query = cookie.sequence;
+                XW_STORE (&xw_state.state_pending, xw_state.state_pending + 1);
+                break;
             }
 
+            /* property lists every state that's set, so nothing is set once it's deleted */
+            XW_STORE (&window->state, XW_WINDOW_STATE_MASK_CLEAR);
+            xw_window_update_presentable (window);
+            e = xw_event_make_state_change (e, XW_WINDOW_STATE_MASK_CLEAR, window);
+
             break;
         }
 
@@ -353,7 +699,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (bp->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
             // REF : https://stackoverflow.com/questions/35885572/get-status-of-currently-active-modifiers-in-x11
             XwModifierState mod;
@@ -383,7 +729,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
                 new_state |= XW_MOUSE_BUTTON_MASK_BUTTON5;
             }
 
-            xw_event_mouse_input (e, new_state, bp->event_x, bp->event_y, mod, window);
+            xw_event_make_mouse_input (e, new_state, bp->event_x, bp->event_y, mod, window);
 
             break;
         }
@@ -394,7 +740,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (br->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
             // REF : https://stackoverflow.com/questions/35885572/get-status-of-currently-active-modifiers-in-x11
             XwModifierState mod;
@@ -427,7 +773,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
             }
 
             if (br->state & (XCB_BUTTON_MASK_4 | XCB_BUTTON_MASK_5)) {
-                xw_event_mouse_wheel (
+                xw_event_make_mouse_wheel (
                     e,
                     br->event_x,
                     br->event_y,
@@ -436,7 +782,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
                     window
                 );
             } else {
-                xw_event_mouse_input (e, new_state, br->event_x, br->event_y, mod, window);
+                xw_event_make_mouse_input (e, new_state, br->event_x, br->event_y, mod, window);
             }
 
             break;
@@ -448,14 +794,23 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (motion->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
+
+            /* a hint only tells pointer moved, position comes from querying pointer later */
+            if (motion->detail == XCB_MOTION_HINT) {
+                if (!window->motion_hinted && !window->motion_query) {
+                    XW_STORE (&xw_state.motion_pending, xw_state.motion_pending + 1);
+                }
+                window->motion_hinted = True;
+                break;
+            }
 
             /* compute new displacement */
             Int32 dx = motion->root_x - window->last_cursor_pos_x;
             Int32 dy = motion->root_y - window->last_cursor_pos_y;
 
             /* set event data */
-            e = xw_event_mouse_move (e, motion->root_x, motion->root_y, dx, dy, window);
+            e = xw_event_make_mouse_move (e, motion->root_x, motion->root_y, dx, dy, window);
 
             /* update last cursor position */
             window->last_cursor_pos_x = motion->root_x;
@@ -470,7 +825,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (key->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
             // REF : https://stackoverflow.com/questions/35885572/get-status-of-currently-active-modifiers-in-x11
             XwModifierState mod;
@@ -482,7 +837,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
             mod.caps_lock = !!(key->state & XCB_MOD_MASK_LOCK);
             mod.meta      = !!(key->state & XCB_MOD_MASK_4);
 
-            e = xw_event_keyboard_input (
+            e = xw_event_make_keyboard_input (
                 e,
                 xw_key_from_xcb_keycode (key->detail),
                 XW_BUTTON_STATE_PRESSED,
@@ -499,7 +854,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
 
             /* find window associated with this event */
             XwWindow *window = xw_get_window_by_xcb_id (key->event);
-            GOTO_HANDLER_IF (!window, WINDOW_SEARCH_FAILED, ERR_WINDOW_SEARCH_FAILED);
+            GOTO_WINDOW_SEARCH_FAILED_IF (!window);
 
             // REF : https://stackoverflow.com/questions/35885572/get-status-of-currently-active-modifiers-in-x11
             XwModifierState mod;
@@ -511,7 +866,7 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
             mod.caps_lock = !!(key->state & XCB_MOD_MASK_LOCK);
             mod.meta      = !!(key->state & XCB_MOD_MASK_4);
 
-            e = xw_event_keyboard_input (
+            e = xw_event_make_keyboard_input (
                 e,
                 xw_key_from_xcb_keycode (key->detail),
                 XW_BUTTON_STATE_RELEASED,
@@ -522,6 +877,27 @@ static XwEvent *xw_fill_event (XwEvent *e, const xcb_generic_event_t *xcb_event)
             break;
         }
 
+        /* Keyboard, modifier or pointer mapping changed. New keymap is requested without
+         * waiting, and replaces old one when a later key event is converted.
+         *
+         * REF : https://tronche.com/gui/x/xlib/events/window-state-change/mapping.html
+         * */
+        case XCB_MAPPING_NOTIFY : {
+            const xcb_mapping_notify_event_t *notify =
+                (const xcb_mapping_notify_event_t *)xcb_event;
+            if (notify->request == XCB_MAPPING_POINTER) {
+                break;
+            }
+
+            /* keymap that was never created is created on first key event */
+            if (xw_state.keyboard) {
+                xw_request_keyboard();
+            }
+
+            e = xw_event_make_keymap_change (e);
+            break;
+        }
+
         default :
             break;
     }
@@ -533,30 +909,426 @@ WINDOW_SEARCH_FAILED:
     return e;
 }
 
+/**
+ * @b Same as @c xw_fill_event, but conversion of each event is traced separately per event type.
+ * */
+static XwEvent *xw_fill_event_traced (XwEvent *e, const xcb_generic_event_t *xcb_event) {
+#ifdef XW_ENABLE_TRACING
+    /* names of core events, indexed by response type */
+    static const CString event_names[] = {
+        "xw_fill_event:Error",
+        "xw_fill_event:Reply",
+        "xw_fill_event:KeyPress",
+        "xw_fill_event:KeyRelease",
+        "xw_fill_event:ButtonPress",
+        "xw_fill_event:ButtonRelease",
+        "xw_fill_event:MotionNotify",
+        "xw_fill_event:EnterNotify",
+        "xw_fill_event:LeaveNotify",
+        "xw_fill_event:FocusIn",
+        "xw_fill_event:FocusOut",
+        "xw_fill_event:KeymapNotify",
+        "xw_fill_event:Expose",
+        "xw_fill_event:GraphicsExpose",
+        "xw_fill_event:NoExpose",
+        "xw_fill_event:VisibilityNotify",
+        "xw_fill_event:CreateNotify",
+        "xw_fill_event:DestroyNotify",
+        "xw_fill_event:UnmapNotify",
+        "xw_fill_event:MapNotify",
+        "xw_fill_event:MapRequest",
+        "xw_fill_event:ReparentNotify",
+        "xw_fill_event:ConfigureNotify",
+        "xw_fill_event:ConfigureRequest",
+        "xw_fill_event:GravityNotify",
+        "xw_fill_event:ResizeRequest",
+        "xw_fill_event:CirculateNotify",
+        "xw_fill_event:CirculateRequest",
+        "xw_fill_event:PropertyNotify",
+        "xw_fill_event:SelectionClear",
+        "xw_fill_event:SelectionRequest",
+        "xw_fill_event:SelectionNotify",
+        "xw_fill_event:ColormapNotify",
+        "xw_fill_event:ClientMessage",
+        "xw_fill_event:MappingNotify",
+        "xw_fill_event:GenericEvent",
+    };
+
+    Uint8   event_code = xcb_event->response_type & 0x7f;
+    CString name = event_code < ARRAY_SIZE (event_names) ? event_names[event_code] :
+                                                           "xw_fill_event:Extension";
+#endif
+
+    XW_TRACE_BEGIN_ARG (name, "sequence", xcb_event->full_sequence);
+    e = xw_fill_event (e, xcb_event);
+    XW_TRACE_END (name);
+
+    return e;
+}
+
 /**
  * @b Convert given @c xcb_keycode_t to @c XwKey
  * */
 static XwKey xw_key_from_xcb_keycode (xcb_keycode_t keycode) {
-    if (!xw_state.keyboard) {
-        xw_init_keyboard();
+    /* keymap requested after a mapping change replaces old one once it arrives */
+    xw_poll_keyboard();
+
+    /* only first key event ever waits for keymap */
+    if (!xw_state.keyboard && !xw_init_keyboard()) {
+        return XWK_UNKNOWN;
     }
-    return xw_state.keyboard[keycode];
+    return keycode < xw_state.keyboard_size ? xw_state.keyboard[keycode] : XWK_UNKNOWN;
 }
 
-static Size get_xcb_atom_property_atom (xcb_atom_t atom, xcb_window_t window, xcb_atom_t **values) {
-    xcb_get_property_cookie_t cookie = xcb_get_property (
-        xw_state.connection, // xcb_connection_t *c,
-        False,               // uint8_t           _delete,
-        window,              // xcb_window_t      window,
-        atom,                // xcb_atom_t        property,
-        XCB_ATOM_ATOM,       // xcb_atom_t        type,
-        0,                   // uint32_t          long_offset,
-        UINT32_MAX           // uint32_t          long_length
-    );
-    xcb_get_property_reply_t *reply = xcb_get_property_reply (xw_state.connection, cookie, Null);
-    *values                         = (xcb_atom_t *)xcb_get_property_value (reply);
-    Size length                     = xcb_get_property_value_length (reply);
-    FREE (reply);
-
-    return length;
+/**
+ * @b Push given event to event queue of it's window, if window has one. Events not tied to
+ *    any window are pushed to queues of all windows, but are still returned to caller.
+ *
+ * Must be called with @c xw_state.event_lock held, so that windows are not destroyed while
+ * their events are being routed.
+ *
+ * @param e Converted event.
+ *
+ * @return True if event was taken by a window queue, and must not be returned to caller.
+ * @return False otherwise.
+ * */
+static Bool xw_event_route (const XwEvent *e) {
+    if (!e || e->type == XW_EVENT_TYPE_NONE) {
+        return False;
+    }
+
+    if (e->window) {
+        XwEventQueue *queue = e->window->queue;
+        if (!queue) {
+            return False;
+        }
+
+        if (!xw_event_queue_push (queue, e)) {
+            XW_LOG_WARNING ("Event queue of window is full, dropping event\n");
+        }
+        return True;
+    }
+
+    /* timers belong to whoever created them, not to windows */
+    if (e->type == XW_EVENT_TYPE_TIMER) {
+        return False;
+    }
+
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    for (Size s = 0; slots && s < slots->capacity; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (win && win->queue && !xw_event_queue_push (win->queue, e)) {
+            XW_LOG_WARNING ("Event queue of window is full, dropping event\n");
+        }
+    }
+
+    return False;
+}
+
+/**
+ * @b Convert given display server event and route it to a window queue if needed.
+ *
+ * @param e Where converted event is stored.
+ * @param xcb_event Freed after conversion.
+ *
+ * @return True if @c e is to be returned to caller.
+ * @return False if event was routed to a window queue, or is not meant for application.
+ * */
+static Bool xw_take_xcb_event (XwEvent *e, xcb_generic_event_t *xcb_event) {
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    Bool take = !xw_event_route (xw_fill_event_traced (e, xcb_event)) &&
+                e->type != XW_EVENT_TYPE_NONE;
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    FREE (xcb_event);
+    return take;
+}
+
+/**
+ * @b Convert given display server event and route it to a window queue if needed, adding it
+ *    to backlog otherwise.
+ *
+ * @param xcb_event Freed after conversion.
+ * */
+static void xw_queue_xcb_event (xcb_generic_event_t *xcb_event) {
+    XwEvent e;
+
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    if (!xw_event_route (xw_fill_event_traced (&e, xcb_event))) {
+        xw_event_backlog_push (&xw_state.backlog, &e);
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    FREE (xcb_event);
+}
+
+/**
+ * @b Pop next event from backlog. While backlog is enabled, everything display server sent so
+ *    far is added to backlog first, so that it's popped in priority order and within limits.
+ *
+ * Backlog is checked even when it's disabled, so events left in it after disabling priority
+ * mode and limits are not lost.
+ *
+ * @param e Where popped event is stored.
+ *
+ * @return True if an event was popped.
+ * @return False if backlog is empty.
+ * */
+static Bool xw_take_backlog_event (XwEvent *e) {
+    if (xw_event_backlog_enabled()) {
+        xcb_generic_event_t *xcb_event = Null;
+        while ((xcb_event = xcb_poll_for_event (xw_state.connection))) {
+            xw_queue_xcb_event (xcb_event);
+        }
+    }
+
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    Bool popped = xw_event_backlog_pop (&xw_state.backlog, e);
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    return popped;
+}
+
+/**
+ * @b Check window of a posted event is still alive, and route event to a window queue if
+ *    needed.
+ *
+ * @param e Posted event.
+ *
+ * @return True if @c e is to be returned to caller.
+ * @return False if event was routed to a window queue, or dropped.
+ * */
+static Bool xw_take_posted_event (XwEvent *e) {
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+
+    Bool alive = !e->window || xw_window_table_contains (&xw_state.windows, e->window);
+    Bool take  = alive && !xw_event_route (e);
+
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    if (!alive) {
+        XW_LOG_DEBUG ("Window of posted event was destroyed, dropping event\n");
+    }
+    return take;
+}
+
+/**
+ * @b Recompute whether given window is presentable, after it's mapped, obscured or hidden
+ *    state changed. Called with @c xw_state.event_lock held, while converting events.
+ *
+ * @param window
+ * */
+static void xw_window_update_presentable (XwWindow *window) {
+    Bool hidden = !!(XW_LOAD (&window->state) & XW_WINDOW_STATE_MASK_HIDDEN);
+    xw_idle_set_presentable (&window->presentable, window->mapped && !window->obscured && !hidden);
+}
+
+/**
+ * @b Convert value of _NET_WM_STATE property to mask of window states. Atoms not known to
+ *    CrossWindow are ignored.
+ *
+ * @param atoms
+ * @param atom_count
+ * */
+static XwWindowState xw_window_state_from_atoms (const xcb_atom_t *atoms, Size atom_count) {
+    /* create pairing of atom with it's mask */
+    struct {
+        xcb_atom_t        atom;
+        XwWindowStateMask mask;
+    } masks[] = {
+        {            xw_state._NET_WM_STATE_MODAL,             XW_WINDOW_STATE_MASK_MODAL},
+        {           xw_state._NET_WM_STATE_STICKY,            XW_WINDOW_STATE_MASK_STICKY},
+        {   xw_state._NET_WM_STATE_MAXIMIZED_VERT,    XW_WINDOW_STATE_MASK_MAXIMIZED_VERT},
+        {   xw_state._NET_WM_STATE_MAXIMIZED_HORZ,    XW_WINDOW_STATE_MASK_MAXIMIZED_HORZ},
+        {           xw_state._NET_WM_STATE_SHADED,            XW_WINDOW_STATE_MASK_SHADED},
+        {     xw_state._NET_WM_STATE_SKIP_TASKBAR,      XW_WINDOW_STATE_MASK_SKIP_TASKBAR},
+        {       xw_state._NET_WM_STATE_SKIP_PAGER,        XW_WINDOW_STATE_MASK_SKIP_PAGER},
+        {           xw_state._NET_WM_STATE_HIDDEN,            XW_WINDOW_STATE_MASK_HIDDEN},
+        {       xw_state._NET_WM_STATE_FULLSCREEN,        XW_WINDOW_STATE_MASK_FULLSCREEN},
+        {            xw_state._NET_WM_STATE_ABOVE,             XW_WINDOW_STATE_MASK_ABOVE},
+        {            xw_state._NET_WM_STATE_BELOW,             XW_WINDOW_STATE_MASK_BELOW},
+        {xw_state._NET_WM_STATE_DEMANDS_ATTENTION, XW_WINDOW_STATE_MASK_DEMANDS_ATTENTION},
+        {          xw_state._NET_WM_STATE_FOCUSED,           XW_WINDOW_STATE_MASK_FOCUSED},
+    };
+
+    XwWindowState state = XW_WINDOW_STATE_MASK_CLEAR;
+    for (Size a = 0; a < atom_count; a++) {
+        for (Size m = 0; m < ARRAY_SIZE (masks); m++) {
+            if (atoms[a] == masks[m].atom) {
+                state |= masks[m].mask;
+                break;
+            }
+        }
+    }
+
+    return state;
+}
+
+/**
+ * @b Turn a reply to a request made while converting an earlier event into an event : state
+ *    of a window whose _NET_WM_STATE changed, or latest pointer position of a window that got
+ *    a motion hint. Never waits for a reply.
+ *
+ * @param e Where event is stored.
+ *
+ * @return True if @c e is to be returned to caller.
+ * @return False otherwise.
+ * */
+static Bool xw_take_reply_event (XwEvent *e) {
+    return xw_take_state_reply (e) || xw_take_pointer_reply (e);
+}
+
+/**
+ * @b Turn reply to a _NET_WM_STATE property request into a state change event, and route it
+ *    to a window queue if needed.
+ *
+ * @param e Where state change event is stored.
+ *
+ * @return True if @c e is to be returned to caller.
+ * @return False if no reply has arrived, request failed, or event was routed.
+ * */
+static Bool xw_take_state_reply (XwEvent *e) {
+    if (!XW_LOAD (&xw_state.state_pending)) {
+        return False;
+    }
+
+    Bool take = False;
+
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    for (Size s = 0; slots && s < slots->capacity && !take; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (!win || !win->state_query) {
+            continue;
+        }
+
+        xcb_get_property_reply_t *reply = Null;
+        xcb_generic_error_t      *error = Null;
+        if (!xcb_poll_for_reply (xw_state.connection, win->state_query, (void **)&reply, &error)) {
+            continue;
+        }
+
+        win->state_query = 0;
+        XW_STORE (&xw_state.state_pending, xw_state.state_pending - 1);
+
+        if (reply) {
+            /* value length is in bytes, and value is released along with reply */
+            Size          count     = xcb_get_property_value_length (reply) / sizeof (xcb_atom_t);
+            XwWindowState new_state = xw_window_state_from_atoms (
+                (const xcb_atom_t *)xcb_get_property_value (reply),
+                count
+            );
+
+            XW_STORE (&win->state, new_state);
+            xw_window_update_presentable (win);
+            xw_event_make_state_change (e, new_state, win);
+
+            take = !xw_event_route (e);
+        }
+
+        FREE (reply);
+        FREE (error);
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    return take;
+}
+
+/**
+ * @b Turn reply to a pointer query of a hinted window into a mouse move event, and route it
+ *    to a window queue if needed.
+ *
+ * @param e Where mouse move event is stored.
+ *
+ * @return True if @c e is to be returned to caller.
+ * @return False if no reply has arrived, pointer did not move, or event was routed.
+ * */
+static Bool xw_take_pointer_reply (XwEvent *e) {
+    if (!XW_LOAD (&xw_state.motion_pending)) {
+        return False;
+    }
+
+    Bool take = False;
+
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    for (Size s = 0; slots && s < slots->capacity && !take; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (!win || !win->motion_query) {
+            continue;
+        }
+
+        xcb_query_pointer_reply_t *reply = Null;
+        xcb_generic_error_t       *error = Null;
+        if (!xcb_poll_for_reply (xw_state.connection, win->motion_query, (void **)&reply, &error)) {
+            continue;
+        }
+
+        win->motion_query = 0;
+        if (!win->motion_hinted) {
+            XW_STORE (&xw_state.motion_pending, xw_state.motion_pending - 1);
+        }
+
+        if (reply && reply->same_screen &&
+            (reply->root_x != (Int32)win->last_cursor_pos_x ||
+             reply->root_y != (Int32)win->last_cursor_pos_y)) {
+            Int32 dx = reply->root_x - win->last_cursor_pos_x;
+            Int32 dy = reply->root_y - win->last_cursor_pos_y;
+
+            xw_event_make_mouse_move (e, reply->root_x, reply->root_y, dx, dy, win);
+            win->last_cursor_pos_x = reply->root_x;
+            win->last_cursor_pos_y = reply->root_y;
+
+            take = !xw_event_route (e);
+        }
+
+        FREE (reply);
+        FREE (error);
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    return take;
+}
+
+/**
+ * @b Query pointer of windows that got a motion hint, unless it was queried less than a
+ *    frame ago. Querying pointer also makes display server send next hint.
+ *
+ * @return Time at which pointer of a hinted window can be queried next.
+ * @return 0 if no hinted window is waiting.
+ * */
+static Uint64 xw_query_hinted_pointers (void) {
+    if (!XW_LOAD (&xw_state.motion_pending)) {
+        return 0;
+    }
+
+    Uint64 now  = xw_timer_now_ns();
+    Uint64 next = 0;
+    Bool   sent = False;
+
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    for (Size s = 0; slots && s < slots->capacity; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (!win || !win->motion_hinted || win->motion_query) {
+            continue;
+        }
+
+        Uint64 due = win->motion_query_ns + XW_MOTION_HINT_INTERVAL_NS;
+        if (now < due) {
+            next = next ? MIN (next, due) : due;
+            continue;
+        }
+
+        win->motion_query    = xcb_query_pointer (xw_state.connection, win->xcb_window_id).sequence;
+        win->motion_query_ns = now;
+        win->motion_hinted   = False;
+        sent                 = True;
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    if (sent) {
+        XW_FLUSH (xw_state.connection);
+    }
+    return next;
 }
@@ -0,0 +1,471 @@
+/**
+ * @file Framebuffer.c
+ * @time 18/10/2026 12:28:30
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Framebuffer.h>
+
+/* local headers */
+#include "Common/Allocator.h"
+#include "State.h"
+#include "Window.h"
+
+/* libc headers */
+#include <string.h>
+
+/* shared memory */
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+/* xcb related headers */
+#include <xcb/shm.h>
+#include <xcb/xcb.h>
+#include <xcb/xproto.h>
+
+extern XwState xw_state;
+
+static XwWindow     *xw_window_create_framebuffer (XwWindow *self);
+static Bool          xw_window_create_shm_segment (XwWindow *self, Size size);
+static void          xw_window_wait_framebuffer_idle (XwWindow *self);
+static void          xw_window_put_rect (XwWindow *self, XwRect rect);
+static Bool          xw_shm_is_available (void);
+static XwPixelFormat xw_get_pixel_format (Uint8 *depth, Uint8 *bits_per_pixel, Uint8 *scanline_pad);
+
+/**
+ * @b Get CPU accessible pixel buffer of window.
+ *
+ * Framebuffer is created on first call, in MIT-SHM shared memory when available, so
+ * presenting it does not copy any pixels. If window got resized since last call, the
+ * framebuffer is re-created with new size and it's previous contents are lost, so
+ * this must be called again after every @c XW_EVENT_TYPE_RESIZE event.
+ *
+ * If last present is still being read by display server, this waits for it to finish
+ * so that pixels can be overwritten safely.
+ *
+ * @param self
+ * @param fb Where framebuffer info will be stored.
+ *
+ * @return @c fb on success.
+ * @return Null otherwise.
+ * */
+XwFramebuffer *xw_window_get_framebuffer (XwWindow *self, XwFramebuffer *fb) {
+    RETURN_VALUE_IF (!self || !fb, Null, ERR_INVALID_ARGUMENTS);
+
+    XwFramebuffer *current = &self->framebuffer.info;
+    XwWindowSize   size    = XW_LOAD (&self->size);
+    if (!self->framebuffer.data || current->width != size.width || current->height != size.height) {
+        xw_window_release_framebuffer (self);
+        RETURN_VALUE_IF (
+            !xw_window_create_framebuffer (self),
+            Null,
+            "Failed to create framebuffer\n"
+        );
+    }
+
+    xw_window_wait_framebuffer_idle (self);
+
+    *fb = *current;
+    return fb;
+}
+
+/**
+ * @b Show given regions of framebuffer in window.
+ *
+ * With shared memory, display server reads pixels directly from framebuffer. Otherwise
+ * pixels are sent with as few @c PutImage requests as maximum request length allows,
+ * and in that case all rows covered by a region are sent in full.
+ *
+ * @param self
+ * @param rects Regions to be updated. Parts outside of framebuffer are ignored.
+ * @param n Number of rects. Pass 0 to present whole framebuffer.
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+XwWindow *xw_window_present_region (XwWindow *self, const XwRect *rects, Size n) {
+    RETURN_VALUE_IF (!self || (n && !rects), Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (
+        !self->framebuffer.data,
+        Null,
+        "Framebuffer is not created yet. Call xw_window_get_framebuffer() first\n"
+    );
+
+    xcb_connection_t *conn = xw_state.connection;
+    XwFramebuffer    *fb   = &self->framebuffer.info;
+
+    XwRect full = {0, 0, fb->width, fb->height};
+    if (!n) {
+        rects = &full;
+        n     = 1;
+    }
+
+    for (Size s = 0; s < n; s++) {
+        XwRect rect = rects[s];
+
+        /* clip to framebuffer */
+        if (rect.x >= fb->width || rect.y >= fb->height) {
+            continue;
+        }
+        rect.width  = MIN (rect.width, fb->width - rect.x);
+        rect.height = MIN (rect.height, fb->height - rect.y);
+        if (!rect.width || !rect.height) {
+            continue;
+        }
+
+        if (!self->framebuffer.shm_seg) {
+            xw_window_put_rect (self, rect);
+            continue;
+        }
+
+        xcb_void_cookie_t cookie = xcb_shm_put_image (
+            conn,                      /* xcb connection */
+            self->xcb_window_id,       /* drawable */
+            self->framebuffer.gc,      /* graphics context */
+            fb->width,                 /* total width of image in shared memory */
+            fb->height,                /* total height of image in shared memory */
+            rect.x,                    /* src x */
+            rect.y,                    /* src y */
+            rect.width,                /* src width */
+            rect.height,               /* src height */
+            rect.x,                    /* dst x */
+            rect.y,                    /* dst y */
+            self->framebuffer.depth,   /* depth */
+            XCB_IMAGE_FORMAT_Z_PIXMAP, /* format */
+            0,                         /* don't send completion event */
+            self->framebuffer.shm_seg, /* shared memory segment */
+            0                          /* offset of image in segment */
+        );
+        xw_track_request (cookie.sequence, self);
+    }
+
+    /* server processes requests in order, so once reply to this arrives, server is done
+     * reading from shared memory for all of above requests */
+    if (self->framebuffer.shm_seg) {
+        if (self->framebuffer.fence_pending) {
+            xcb_discard_reply (conn, self->framebuffer.fence.sequence);
+        }
+        self->framebuffer.fence         = xcb_get_input_focus (conn);
+        self->framebuffer.fence_pending = True;
+    }
+
+    XW_FLUSH (conn);
+
+    return self;
+}
+
+/**
+ * @b Release framebuffer of window if it has one.
+ *
+ * Used by Window.c when window is being de-initialized.
+ *
+ * @param self
+ * */
+void xw_window_release_framebuffer (XwWindow *self) {
+    RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
+
+    if (!self->framebuffer.data) {
+        return;
+    }
+
+    xcb_connection_t *conn = xw_state.connection;
+
+    /* segment stays alive till server detaches, so there's no need to wait */
+    if (self->framebuffer.fence_pending) {
+        xcb_discard_reply (conn, self->framebuffer.fence.sequence);
+    }
+
+    if (self->framebuffer.shm_seg) {
+        xcb_shm_detach (conn, self->framebuffer.shm_seg);
+        shmdt (self->framebuffer.data);
+    } else {
+        XW_FREE (XW_ALLOC_CATEGORY_FRAMEBUFFER, self->framebuffer.data);
+    }
+
+    xcb_free_gc (conn, self->framebuffer.gc);
+
+    memset (&self->framebuffer, 0, sizeof (self->framebuffer));
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Create framebuffer of same size as window.
+ *
+ * @param self
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+static XwWindow *xw_window_create_framebuffer (XwWindow *self) {
+    xcb_connection_t *conn = xw_state.connection;
+    RETURN_VALUE_IF (!conn, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    Uint8         depth = 0, bits_per_pixel = 0, scanline_pad = 0;
+    XwPixelFormat format = xw_get_pixel_format (&depth, &bits_per_pixel, &scanline_pad);
+    RETURN_VALUE_IF (
+        format == XW_PIXEL_FORMAT_UNKNOWN,
+        Null,
+        "Window visual is not supported for software rendering\n"
+    );
+
+    /* rows are padded the way server expects, so they can be sent without re-packing */
+    XwWindowSize window_size = XW_LOAD (&self->size);
+    Size         row_bits    = (Size)window_size.width * bits_per_pixel;
+    Size         row_pad     = scanline_pad;
+
+    XwFramebuffer *fb   = &self->framebuffer.info;
+    fb->width           = window_size.width;
+    fb->height          = window_size.height;
+    fb->bytes_per_pixel = bits_per_pixel / 8;
+    fb->stride          = ((row_bits + row_pad - 1) / row_pad) * (row_pad / 8);
+    fb->format          = format;
+
+    Size size = (Size)fb->stride * fb->height;
+    RETURN_VALUE_IF (!size, Null, ERR_INVALID_SIZE);
+
+    if (!xw_shm_is_available() || !xw_window_create_shm_segment (self, size)) {
+        self->framebuffer.data = XW_ALLOCATE (XW_ALLOC_CATEGORY_FRAMEBUFFER, Uint8, size);
+        RETURN_VALUE_IF (!self->framebuffer.data, Null, ERR_OUT_OF_MEMORY);
+    }
+
+    fb->pixels              = self->framebuffer.data;
+    self->framebuffer.depth = depth;
+
+    /* graphics context for putting images, without generating exposure events */
+    Uint32 gc_values[]   = {0};
+    self->framebuffer.gc = xcb_generate_id (conn);
+
+    xcb_void_cookie_t cookie = xcb_create_gc (
+        conn,                      /* xcb connection */
+        self->framebuffer.gc,      /* id of graphics context */
+        self->xcb_window_id,       /* drawable */
+        XCB_GC_GRAPHICS_EXPOSURES, /* value mask */
+        gc_values                  /* value list */
+    );
+    xw_track_request (cookie.sequence, self);
+
+    return self;
+}
+
+/**
+ * @b Create shared memory segment of given size and attach it to display server.
+ *
+ * If display server fails to attach it (eg: when it's running on another machine),
+ * shared memory is marked as unavailable for all future framebuffers.
+ *
+ * @param self
+ * @param size
+ *
+ * @return True on success.
+ * @return False otherwise.
+ * */
+static Bool xw_window_create_shm_segment (XwWindow *self, Size size) {
+    xcb_connection_t *conn = xw_state.connection;
+
+    Int32 shm_id = shmget (IPC_PRIVATE, size, IPC_CREAT | 0600);
+    RETURN_VALUE_IF (shm_id < 0, False, "Failed to create shared memory segment\n");
+
+    void *data = shmat (shm_id, Null, 0);
+    GOTO_HANDLER_IF (data == (void *)-1, SHMAT_FAILED, "Failed to map shared memory segment\n");
+
+    /* this is the only place where we wait for server, and it happens only when framebuffer
+     * is (re)created */
+    xcb_shm_seg_t     seg    = xcb_generate_id (conn);
+    xcb_void_cookie_t cookie = xcb_shm_attach_checked (conn, seg, shm_id, 1 /* read only */);
+
+    xcb_generic_error_t *err =
+        XW_ROUND_TRIP ("xcb_request_check:ShmAttach", xcb_request_check (conn, cookie));
+    GOTO_HANDLER_IF (err, ATTACH_FAILED, "Display server failed to attach shared memory\n");
+
+    /* segment is destroyed as soon as both of us detach it, even if we crash */
+    shmctl (shm_id, IPC_RMID, Null);
+
+    self->framebuffer.data    = data;
+    self->framebuffer.shm_seg = seg;
+
+    return True;
+
+ATTACH_FAILED:
+    FREE (err);
+    shmdt (data);
+    xw_state.shm_available = False;
+SHMAT_FAILED: {
+    shmctl (shm_id, IPC_RMID, Null);
+    return False;
+}
+}
+
+/**
+ * @b Wait for display server to finish reading framebuffer after last present.
+ *
+ * @param self
+ * */
+static void xw_window_wait_framebuffer_idle (XwWindow *self) {
+    if (!self->framebuffer.fence_pending) {
+        return;
+    }
+
+    xcb_generic_error_t         *err   = Null;
+    xcb_get_input_focus_reply_t *reply = XW_ROUND_TRIP (
+        "xcb_get_input_focus_reply:FramebufferFence",
+        xcb_get_input_focus_reply (xw_state.connection, self->framebuffer.fence, &err)
+    );
+
+    /* replies are allocated by xcb */
+    FREE (reply);
+    FREE (err);
+
+    self->framebuffer.fence_pending = False;
+}
+
+/**
+ * @b Send rows covered by given rect using @c PutImage, split into as many requests as
+ * needed to stay within maximum request length.
+ *
+ * @param self
+ * @param rect Already clipped to framebuffer.
+ * */
+static void xw_window_put_rect (XwWindow *self, XwRect rect) {
+    xcb_connection_t *conn = xw_state.connection;
+    XwFramebuffer    *fb   = &self->framebuffer.info;
+
+    /* maximum request length is in units of 4 bytes, and includes the request header */
+    Size max_bytes      = (Size)xcb_get_maximum_request_length (conn) * 4;
+    Size max_data_bytes = max_bytes - sizeof (xcb_put_image_request_t);
+    Size rows_per_chunk = MAX (max_data_bytes / fb->stride, 1);
+
+    Uint32 end_row = rect.y + rect.height;
+    for (Uint32 row = rect.y; row < end_row; row += rows_per_chunk) {
+        Uint32 num_rows = MIN (rows_per_chunk, end_row - row);
+
+        xcb_void_cookie_t cookie = xcb_put_image (
+            conn,                                      /* xcb connection */
+            XCB_IMAGE_FORMAT_Z_PIXMAP,                 /* format */
+            self->xcb_window_id,                       /* drawable */
+            self->framebuffer.gc,                      /* graphics context */
+            fb->width,                                 /* width */
+            num_rows,                                  /* height */
+            0,                                         /* dst x */
+            row,                                       /* dst y */
+            0,                                         /* left pad */
+            self->framebuffer.depth,                   /* depth */
+            num_rows * fb->stride,                     /* length of data */
+            self->framebuffer.data + row * fb->stride  /* data */
+        );
+        xw_track_request (cookie.sequence, self);
+    }
+}
+
+/**
+ * @b Check whether display server supports MIT-SHM extension.
+ *
+ * @return True if it does.
+ * @return False otherwise.
+ * */
+static Bool xw_shm_is_available (void) {
+    if (!xw_state.shm_checked) {
+        const xcb_query_extension_reply_t *ext = XW_ROUND_TRIP (
+            "xcb_get_extension_data:MIT-SHM",
+            xcb_get_extension_data (xw_state.connection, &xcb_shm_id)
+        );
+
+        xw_state.shm_available = ext && ext->present;
+        xw_state.shm_checked   = True;
+    }
+
+    return xw_state.shm_available;
+}
+
+/**
+ * @b Find out how pixels of windows created by CrossWindow are stored in memory.
+ *
+ * Windows are created with root visual, so that's the one we look for.
+ *
+ * @param depth Where depth of root visual will be stored.
+ * @param bits_per_pixel Where bits per pixel for that depth will be stored.
+ * @param scanline_pad Where row padding in bits for that depth will be stored.
+ *
+ * @return @c XwPixelFormat of root visual.
+ * @return @c XW_PIXEL_FORMAT_UNKNOWN if format is not supported.
+ * */
+static XwPixelFormat
+    xw_get_pixel_format (Uint8 *depth, Uint8 *bits_per_pixel, Uint8 *scanline_pad) {
+    const xcb_setup_t *setup  = xcb_get_setup (xw_state.connection);
+    xcb_screen_t      *screen = xw_state.screen_iterator.data;
+
+    /* find root visual and it's depth */
+    xcb_visualtype_t    *visual = Null;
+    xcb_depth_iterator_t depths = xcb_screen_allowed_depths_iterator (screen);
+    for (; depths.rem && !visual; xcb_depth_next (&depths)) {
+        xcb_visualtype_iterator_t visuals = xcb_depth_visuals_iterator (depths.data);
+        for (; visuals.rem; xcb_visualtype_next (&visuals)) {
+            if (visuals.data->visual_id == screen->root_visual) {
+                visual = visuals.data;
+                *depth = depths.data->depth;
+                break;
+            }
+        }
+    }
+    RETURN_VALUE_IF (!visual, XW_PIXEL_FORMAT_UNKNOWN, "Failed to find root visual\n");
+
+    if (visual->_class != XCB_VISUAL_CLASS_TRUE_COLOR) {
+        return XW_PIXEL_FORMAT_UNKNOWN;
+    }
+
+    /* find how images of that depth are laid out */
+    *bits_per_pixel               = 0;
+    xcb_format_iterator_t formats = xcb_setup_pixmap_formats_iterator (setup);
+    for (; formats.rem; xcb_format_next (&formats)) {
+        if (formats.data->depth == *depth) {
+            *bits_per_pixel = formats.data->bits_per_pixel;
+            *scanline_pad   = formats.data->scanline_pad;
+            break;
+        }
+    }
+
+    Bool   lsb_first = setup->image_byte_order == XCB_IMAGE_ORDER_LSB_FIRST;
+    Uint32 r = visual->red_mask, g = visual->green_mask, b = visual->blue_mask;
+
+    if (*bits_per_pixel == 32 && r == 0xff0000 && g == 0xff00 && b == 0xff) {
+        return lsb_first ? XW_PIXEL_FORMAT_BGRX8888 : XW_PIXEL_FORMAT_XRGB8888;
+    }
+
+    if (*bits_per_pixel == 32 && r == 0xff && g == 0xff00 && b == 0xff0000) {
+        return lsb_first ? XW_PIXEL_FORMAT_RGBX8888 : XW_PIXEL_FORMAT_XBGR8888;
+    }
+
+    if (*bits_per_pixel == 16 && r == 0xf800 && g == 0x7e0 && b == 0x1f && lsb_first) {
+        return XW_PIXEL_FORMAT_RGB565;
+    }
+
+    return XW_PIXEL_FORMAT_UNKNOWN;
+}
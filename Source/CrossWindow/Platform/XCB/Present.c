@@ -0,0 +1,192 @@
+/**
+ * @file Present.c
+ * @time 18/10/2026 12:33:49
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Present.h>
+
+/* local headers */
+#include "State.h"
+#include "Window.h"
+
+/* xcb related headers */
+#include <xcb/present.h>
+#include <xcb/xcb.h>
+
+extern XwState xw_state;
+
+static Bool xw_present_is_available (void);
+
+/**
+ * @b Start receiving @c XW_EVENT_TYPE_FRAME_COMPLETE and @c XW_EVENT_TYPE_FRAME_IDLE
+ * events for given window.
+ *
+ * Events are delivered for every frame presented to the window, including frames
+ * presented by Vulkan, so this can also be used to measure timing of a swapchain.
+ * Calling this more than once does nothing.
+ *
+ * @param self
+ *
+ * @return True on success.
+ * @return False if display server does not support Present extension.
+ * */
+Bool xw_window_enable_frame_events (XwWindow *self) {
+    RETURN_VALUE_IF (!self, False, ERR_INVALID_ARGUMENTS);
+
+    if (self->frame_events_enabled) {
+        return True;
+    }
+
+    RETURN_VALUE_IF (!xw_present_is_available(), False, "Present extension is not available\n");
+
+    /* event context is destroyed along with the window, so it's not stored */
+    xcb_void_cookie_t cookie = xcb_present_select_input (
+        xw_state.connection,
+        xcb_generate_id (xw_state.connection),
+        self->xcb_window_id,
+        XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY | XCB_PRESENT_EVENT_MASK_IDLE_NOTIFY
+    );
+    xw_track_request (cookie.sequence, self);
+
+    self->frame_events_enabled = True;
+    return True;
+}
+
+/**
+ * @b Schedule given pixmap to be shown in window at given media stream counter.
+ *
+ * Frame events are enabled for window if not already. Once the frame reaches the screen,
+ * @c XW_EVENT_TYPE_FRAME_COMPLETE is delivered with returned serial, and once display server
+ * is done reading the pixmap @c XW_EVENT_TYPE_FRAME_IDLE is delivered. Pixmap must not be
+ * drawn into before that.
+ *
+ * @param self
+ * @param pixmap XCB pixmap of same depth as window.
+ * @param target_msc Media stream counter (vblank count) to show the frame at. Pass 0 to show
+ *        it at next vblank.
+ * @param flags Bitwise OR of @c XwPresentFlagBits.
+ *
+ * @return Non-zero serial identifying this frame in frame events on success.
+ * @return 0 otherwise.
+ * */
+Uint32 xw_window_present_pixmap (
+    XwWindow      *self,
+    Uint32         pixmap,
+    Uint64         target_msc,
+    XwPresentFlags flags
+) {
+    RETURN_VALUE_IF (!self || !pixmap, 0, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_window_enable_frame_events (self), 0, "Failed to enable frame events\n");
+
+    Uint32 options = XCB_PRESENT_OPTION_NONE;
+    if (flags & XW_PRESENT_FLAG_ASYNC) {
+        options |= XCB_PRESENT_OPTION_ASYNC;
+    }
+    if (flags & XW_PRESENT_FLAG_COPY) {
+        options |= XCB_PRESENT_OPTION_COPY;
+    }
+
+    /* 0 is reserved for failure */
+    if (!++self->present_serial) {
+        self->present_serial = 1;
+    }
+
+    xcb_void_cookie_t cookie = xcb_present_pixmap (
+        xw_state.connection,  /* xcb connection */
+        self->xcb_window_id,  /* window */
+        pixmap,               /* pixmap */
+        self->present_serial, /* serial */
+        XCB_NONE,             /* valid region: whole pixmap */
+        XCB_NONE,             /* update region: whole pixmap */
+        0,                    /* x offset */
+        0,                    /* y offset */
+        XCB_NONE,             /* target crtc: let server decide */
+        XCB_NONE,             /* wait fence */
+        XCB_NONE,             /* idle fence */
+        options,              /* options */
+        target_msc,           /* target msc */
+        0,                    /* divisor */
+        0,                    /* remainder */
+        0,                    /* number of notifies */
+        Null                  /* notifies */
+    );
+    xw_track_request (cookie.sequence, self);
+    XW_FLUSH (xw_state.connection);
+
+    return self->present_serial;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Check whether display server supports Present extension.
+ *
+ * Protocol requires version to be queried before extension is used, which takes a
+ * round trip, so this is done only once.
+ *
+ * @return True if it does.
+ * @return False otherwise.
+ * */
+static Bool xw_present_is_available (void) {
+    if (xw_state.present_checked) {
+        return xw_state.present_available;
+    }
+
+    xcb_connection_t *conn = xw_state.connection;
+    RETURN_VALUE_IF (!conn, False, ERR_XW_STATE_NOT_INITIALIZED);
+
+    xw_state.present_checked   = True;
+    xw_state.present_available = False;
+
+    const xcb_query_extension_reply_t *ext = XW_ROUND_TRIP (
+        "xcb_get_extension_data:Present",
+        xcb_get_extension_data (conn, &xcb_present_id)
+    );
+    if (!ext || !ext->present) {
+        return False;
+    }
+
+    xcb_present_query_version_cookie_t cookie = xcb_present_query_version (conn, 1, 0);
+    xcb_present_query_version_reply_t *reply = XW_ROUND_TRIP (
+        "xcb_present_query_version_reply",
+        xcb_present_query_version_reply (conn, cookie, Null)
+    );
+    if (!reply) {
+        return False;
+    }
+    FREE (reply);
+
+    xw_state.present_opcode    = ext->major_opcode;
+    xw_state.present_available = True;
+
+    return True;
+}
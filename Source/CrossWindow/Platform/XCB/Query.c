@@ -0,0 +1,437 @@
+/**
+ * @file Query.c
+ * @time 18/10/2026 12:20:47
+ * @author Siddharth Mishra (admin@brightprogrammer.in)
+ * @copyright Copyright (c) 2024 Siddharth Mishra
+ * @copyright Copyright (c) 2024 Anvie Labs
+ *
+ * Copyright 2024 Siddharth Mishra, Anvie Labs
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted 
+ * provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions
+ *    and the following disclaimer in the documentation and/or other materials provided with the
+ *    distribution.
+ * 
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse
+ *    or promote products derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND 
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * */
+
+
+#include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Query.h>
+
+/* local headers */
+#include "State.h"
+#include "Window.h"
+
+/* xcb related headers */
+#include <xcb/xcb.h>
+#include <xcb/xcbext.h> /* for waiting/polling on replies with only sequence number */
+#include <xcb/xproto.h>
+
+#define ERR_QUERY_FAILED "Display server failed to answer query (X error code %u)\n"
+
+extern XwState xw_state;
+
+static XwQuery xw_query_init (XwQueryType type, XwWindow *win, Uint32 sequence);
+static XwQueryResult *
+    xw_query_complete (XwQuery *query, XwQueryResult *result, void *reply, xcb_generic_error_t *err);
+static XwWindowState xw_window_state_from_xcb_atoms (const xcb_atom_t *atoms, Size atom_count);
+static XwWindowActionPermissions
+    xw_window_action_permissions_from_xcb_atoms (const xcb_atom_t *atoms, Size atom_count);
+
+/**
+ * @b Request geometry (position, size and border width) of given window.
+ *
+ * This does not wait for the display server to reply.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_GEOMETRY on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_geometry (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwQuery) {0}), ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, ((XwQuery) {0}), ERR_XW_STATE_NOT_INITIALIZED);
+
+    xcb_get_geometry_cookie_t cookie = xcb_get_geometry (xw_state.connection, self->xcb_window_id);
+
+    return xw_query_init (XW_QUERY_TYPE_GEOMETRY, self, cookie.sequence);
+}
+
+/**
+ * @b Request current window state (maximized, hidden, etc...) of given window.
+ *
+ * Unlike @c xw_window_get_state, which returns the last state seen in events, this asks
+ * the window manager directly. This does not wait for the display server to reply.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_STATE on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_state (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwQuery) {0}), ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, ((XwQuery) {0}), ERR_XW_STATE_NOT_INITIALIZED);
+
+    xcb_get_property_cookie_t cookie = xcb_get_property (
+        xw_state.connection,    /* connection */
+        False,                  /* delete */
+        self->xcb_window_id,    /* window */
+        xw_state._NET_WM_STATE, /* property */
+        XCB_ATOM_ATOM,          /* type */
+        0,                      /* offset */
+        UINT32_MAX              /* length */
+    );
+
+    return xw_query_init (XW_QUERY_TYPE_STATE, self, cookie.sequence);
+}
+
+/**
+ * @b Request size of decorations the window manager added around given window.
+ *
+ * If there's no window manager running, or it does not support _NET_FRAME_EXTENTS then
+ * all extents in result will be zero. This does not wait for the display server to reply.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_FRAME_EXTENTS on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_frame_extents (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwQuery) {0}), ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, ((XwQuery) {0}), ERR_XW_STATE_NOT_INITIALIZED);
+
+    xcb_get_property_cookie_t cookie = xcb_get_property (
+        xw_state.connection,         /* connection */
+        False,                       /* delete */
+        self->xcb_window_id,         /* window */
+        xw_state._NET_FRAME_EXTENTS, /* property */
+        XCB_ATOM_CARDINAL,           /* type */
+        0,                           /* offset */
+        4                            /* length : left, right, top, bottom */
+    );
+
+    return xw_query_init (XW_QUERY_TYPE_FRAME_EXTENTS, self, cookie.sequence);
+}
+
+/**
+ * @b Request bitmask of actions the window manager currently allows on given window.
+ *
+ * This does not wait for the display server to reply.
+ *
+ * @param self
+ *
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_ACTION_PERMISSIONS on success.
+ * @return @c XwQuery of type @c XW_QUERY_TYPE_NONE otherwise.
+ * */
+XwQuery xw_window_query_action_permissions (XwWindow *self) {
+    RETURN_VALUE_IF (!self, ((XwQuery) {0}), ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, ((XwQuery) {0}), ERR_XW_STATE_NOT_INITIALIZED);
+
+    xcb_get_property_cookie_t cookie = xcb_get_property (
+        xw_state.connection,              /* connection */
+        False,                            /* delete */
+        self->xcb_window_id,              /* window */
+        xw_state._NET_WM_ALLOWED_ACTIONS, /* property */
+        XCB_ATOM_ATOM,                    /* type */
+        0,                                /* offset */
+        UINT32_MAX                        /* length */
+    );
+
+    return xw_query_init (XW_QUERY_TYPE_ACTION_PERMISSIONS, self, cookie.sequence);
+}
+
+/**
+ * @b Block until the display server answers given query.
+ *
+ * Waiting on the first of many queries costs one round trip, all queries made before it
+ * will already be answered by the time it returns. The query is consumed after this call,
+ * and it's type is set to @c XW_QUERY_TYPE_NONE.
+ *
+ * @param query Query to wait on.
+ * @param result Where result will be stored.
+ *
+ * @return @c result on success.
+ * @return @c Null otherwise.
+ * */
+XwQueryResult *xw_query_wait (XwQuery *query, XwQueryResult *result) {
+    RETURN_VALUE_IF (
+        !query || !result || query->type == XW_QUERY_TYPE_NONE,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+    RETURN_VALUE_IF (!xw_state.connection, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    /* each query type is counted as a separate round trip site */
+    static const CString round_trip_names[XW_QUERY_TYPE_MAX] = {
+        [XW_QUERY_TYPE_GEOMETRY]           = "xcb_wait_for_reply:Geometry",
+        [XW_QUERY_TYPE_STATE]              = "xcb_wait_for_reply:State",
+        [XW_QUERY_TYPE_FRAME_EXTENTS]      = "xcb_wait_for_reply:FrameExtents",
+        [XW_QUERY_TYPE_ACTION_PERMISSIONS] = "xcb_wait_for_reply:ActionPermissions",
+    };
+    CString name = query->type < XW_QUERY_TYPE_MAX ? round_trip_names[query->type] : Null;
+    name         = name ? name : "xcb_wait_for_reply";
+
+    xcb_generic_error_t *err   = Null;
+    void                *reply = XW_ROUND_TRIP (
+        name,
+        xcb_wait_for_reply (xw_state.connection, query->sequence, &err)
+    );
+
+    return xw_query_complete (query, result, reply, err);
+}
+
+/**
+ * @b Check whether display server has answered given query, without blocking.
+ *
+ * A pending query is left untouched, so it can be polled again later. Once answered
+ * (successfully or not) the query is consumed and it's type is set to @c XW_QUERY_TYPE_NONE.
+ * This means if this returns @c Null, and @c query->type is still valid, then the query
+ * is just not answered yet.
+ *
+ * @param query Query to poll.
+ * @param result Where result will be stored.
+ *
+ * @return @c result if query was answered successfully.
+ * @return @c Null if query is still pending or failed.
+ * */
+XwQueryResult *xw_query_poll (XwQuery *query, XwQueryResult *result) {
+    RETURN_VALUE_IF (
+        !query || !result || query->type == XW_QUERY_TYPE_NONE,
+        Null,
+        ERR_INVALID_ARGUMENTS
+    );
+    RETURN_VALUE_IF (!xw_state.connection, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    /* request might still be sitting in output buffer, and then it'll never be answered */
+    XW_FLUSH (xw_state.connection);
+
+    void                *reply = Null;
+    xcb_generic_error_t *err   = Null;
+
+    Bool answered = xcb_poll_for_reply (xw_state.connection, query->sequence, &reply, &err);
+
+#ifdef XW_THREAD_SAFE
+    /* reading from connection may have queued events, wake thread waiting for them */
+    xw_post_wakeup();
+#endif
+
+    if (!answered) {
+        return Null;
+    }
+
+    return xw_query_complete (query, result, reply, err);
+}
+
+/**
+ * @b Tell display server connection that we don't care about answer to given query anymore.
+ *
+ * The reply will be thrown away as soon as it arrives. This never blocks.
+ *
+ * @param query
+ * */
+void xw_query_discard (XwQuery *query) {
+    RETURN_IF (!query, ERR_INVALID_ARGUMENTS);
+
+    if (query->type != XW_QUERY_TYPE_NONE && xw_state.connection) {
+        xcb_discard_reply (xw_state.connection, query->sequence);
+    }
+
+    query->type = XW_QUERY_TYPE_NONE;
+}
+
+/************************************** PRIVATE METHODS **************************************/
+
+/**
+ * @b Create a new query object from sent request's sequence number.
+ *
+ * @param type
+ * @param win
+ * @param sequence Sequence number of request (from xcb cookie).
+ *
+ * @return XwQuery
+ * */
+static XwQuery xw_query_init (XwQueryType type, XwWindow *win, Uint32 sequence) {
+    return (XwQuery) {.type = type, .window = win, .sequence = sequence};
+}
+
+/**
+ * @b Convert reply of a finished query to @c XwQueryResult.
+ *
+ * This takes ownership of @c reply and @c err, and consumes the @c query.
+ *
+ * @param query
+ * @param result
+ * @param reply Reply received from xcb. Can be @c Null on failure.
+ * @param err Error received from xcb. @c Null on success.
+ *
+ * @return @c result on success.
+ * @return @c Null otherwise.
+ * */
+static XwQueryResult *
+    xw_query_complete (XwQuery *query, XwQueryResult *result, void *reply, xcb_generic_error_t *err) {
+    XwQueryType type = query->type;
+    query->type      = XW_QUERY_TYPE_NONE;
+
+    GOTO_HANDLER_IF (err, QUERY_FAILED, ERR_QUERY_FAILED, err->error_code);
+    GOTO_HANDLER_IF (!reply, QUERY_FAILED, ERR_QUERY_FAILED, 0);
+
+    result->type   = type;
+    result->window = query->window;
+
+    switch (type) {
+        case XW_QUERY_TYPE_GEOMETRY : {
+            xcb_get_geometry_reply_t *geometry = reply;
+
+            result->geometry.pos          = (XwWindowPos) {geometry->x, geometry->y};
+            result->geometry.size         = (XwWindowSize) {geometry->width, geometry->height};
+            result->geometry.border_width = geometry->border_width;
+            break;
+        }
+
+        case XW_QUERY_TYPE_STATE : {
+            xcb_get_property_reply_t *property = reply;
+
+            result->state = xw_window_state_from_xcb_atoms (
+                xcb_get_property_value (property),
+                xcb_get_property_value_length (property) / sizeof (xcb_atom_t)
+            );
+            break;
+        }
+
+        case XW_QUERY_TYPE_FRAME_EXTENTS : {
+            xcb_get_property_reply_t *property = reply;
+
+            result->frame_extents = (XwFrameExtents) {0, 0, 0, 0};
+
+            /* property won't be present if there's no window manager */
+            if (property->format == 32 && property->value_len >= 4) {
+                Uint32 *extents              = xcb_get_property_value (property);
+                result->frame_extents.left   = extents[0];
+                result->frame_extents.right  = extents[1];
+                result->frame_extents.top    = extents[2];
+                result->frame_extents.bottom = extents[3];
+            }
+            break;
+        }
+
+        case XW_QUERY_TYPE_ACTION_PERMISSIONS : {
+            xcb_get_property_reply_t *property = reply;
+
+            result->action_permissions = xw_window_action_permissions_from_xcb_atoms (
+                xcb_get_property_value (property),
+                xcb_get_property_value_length (property) / sizeof (xcb_atom_t)
+            );
+            break;
+        }
+
+        default :
+            FREE (reply);
+            RETURN_VALUE_IF_REACHED (Null, "Invalid query type\n");
+    }
+
+    FREE (reply);
+    return result;
+
+QUERY_FAILED: {
+    FREE (err);
+    FREE (reply);
+    return Null;
+}
+}
+
+/**
+ * @b Create @c XwWindowState mask from atoms present in _NET_WM_STATE property.
+ *
+ * @param atoms
+ * @param atom_count
+ *
+ * @return XwWindowState
+ * */
+static XwWindowState xw_window_state_from_xcb_atoms (const xcb_atom_t *atoms, Size atom_count) {
+    struct {
+        xcb_atom_t        atom;
+        XwWindowStateMask mask;
+    } states[] = {
+        {            xw_state._NET_WM_STATE_MODAL,             XW_WINDOW_STATE_MASK_MODAL},
+        {           xw_state._NET_WM_STATE_STICKY,            XW_WINDOW_STATE_MASK_STICKY},
+        {   xw_state._NET_WM_STATE_MAXIMIZED_VERT,    XW_WINDOW_STATE_MASK_MAXIMIZED_VERT},
+        {   xw_state._NET_WM_STATE_MAXIMIZED_HORZ,    XW_WINDOW_STATE_MASK_MAXIMIZED_HORZ},
+        {           xw_state._NET_WM_STATE_SHADED,            XW_WINDOW_STATE_MASK_SHADED},
+        {     xw_state._NET_WM_STATE_SKIP_TASKBAR,      XW_WINDOW_STATE_MASK_SKIP_TASKBAR},
+        {       xw_state._NET_WM_STATE_SKIP_PAGER,        XW_WINDOW_STATE_MASK_SKIP_PAGER},
+        {           xw_state._NET_WM_STATE_HIDDEN,            XW_WINDOW_STATE_MASK_HIDDEN},
+        {       xw_state._NET_WM_STATE_FULLSCREEN,        XW_WINDOW_STATE_MASK_FULLSCREEN},
+        {            xw_state._NET_WM_STATE_ABOVE,             XW_WINDOW_STATE_MASK_ABOVE},
+        {            xw_state._NET_WM_STATE_BELOW,             XW_WINDOW_STATE_MASK_BELOW},
+        {xw_state._NET_WM_STATE_DEMANDS_ATTENTION, XW_WINDOW_STATE_MASK_DEMANDS_ATTENTION},
+        {          xw_state._NET_WM_STATE_FOCUSED,           XW_WINDOW_STATE_MASK_FOCUSED},
+    };
+
+    XwWindowState state = XW_WINDOW_STATE_MASK_CLEAR;
+    for (Size s = 0; s < atom_count; s++) {
+        for (Size a = 0; a < ARRAY_SIZE (states); a++) {
+            if (atoms[s] == states[a].atom) {
+                state |= states[a].mask;
+            }
+        }
+    }
+
+    return state;
+}
+
+/**
+ * @b Create @c XwWindowActionPermissions mask from atoms present in
+ *    _NET_WM_ALLOWED_ACTIONS property.
+ *
+ * @param atoms
+ * @param atom_count
+ *
+ * @return XwWindowActionPermissions
+ * */
+static XwWindowActionPermissions
+    xw_window_action_permissions_from_xcb_atoms (const xcb_atom_t *atoms, Size atom_count) {
+    struct {
+        xcb_atom_t                atom;
+        XwWindowActionPermissions mask;
+    } actions[] = {
+        {          xw_state._NET_WM_ACTION_MOVE,           XW_WINDOW_ACTION_PERMISSION_MASK_MOVE},
+        {        xw_state._NET_WM_ACTION_RESIZE,         XW_WINDOW_ACTION_PERMISSION_MASK_RESIZE},
+        {      xw_state._NET_WM_ACTION_MINIMIZE,       XW_WINDOW_ACTION_PERMISSION_MASK_MINIMIZE},
+        {         xw_state._NET_WM_ACTION_SHADE,          XW_WINDOW_ACTION_PERMISSION_MASK_SHADE},
+        {         xw_state._NET_WM_ACTION_STICK,          XW_WINDOW_ACTION_PERMISSION_MASK_STICK},
+        { xw_state._NET_WM_ACTION_MAXIMIZE_HORZ,  XW_WINDOW_ACTION_PERMISSION_MASK_MAXIMIZE_HORZ},
+        { xw_state._NET_WM_ACTION_MAXIMIZE_VERT,  XW_WINDOW_ACTION_PERMISSION_MASK_MAXIMIZE_VERT},
+        {    xw_state._NET_WM_ACTION_FULLSCREEN,     XW_WINDOW_ACTION_PERMISSION_MASK_FULLSCREEN},
+        {xw_state._NET_WM_ACTION_CHANGE_DESKTOP, XW_WINDOW_ACTION_PERMISSION_MASK_CHANGE_DESKTOP},
+        {         xw_state._NET_WM_ACTION_CLOSE,          XW_WINDOW_ACTION_PERMISSION_MASK_CLOSE},
+        {         xw_state._NET_WM_ACTION_ABOVE,          XW_WINDOW_ACTION_PERMISSION_MASK_ABOVE},
+        {         xw_state._NET_WM_ACTION_BELOW,          XW_WINDOW_ACTION_PERMISSION_MASK_BELOW},
+    };
+
+    XwWindowActionPermissions permissions = XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR;
+    for (Size s = 0; s < atom_count; s++) {
+        for (Size a = 0; a < ARRAY_SIZE (actions); a++) {
+            if (atoms[s] == actions[a].atom) {
+                permissions |= actions[a].mask;
+            }
+        }
+    }
+
+    return permissions;
+}
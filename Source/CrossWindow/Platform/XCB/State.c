@@ -35,6 +35,7 @@
 #include <Anvie/CrossWindow/Window.h>
 
 /* local includes */
+#include "Common/Allocator.h"
 #include "State.h"
 
 /* libc includes */
@@ -44,6 +45,7 @@
 /* xcb/x11 includes */
 #include <xcb/xcb.h>
 #include <xcb/xcb_keysyms.h>
+#include <xcb/xcbext.h> /* for polling on replies with only sequence number */
 #include <xcb/xproto.h>
 
 /* for xk-definitions */
@@ -103,6 +105,8 @@ XwState xw_state = {0};
 
 #define _MOTIF_WM_HINTS_ATOM_NAME "_MOTIF_WM_HINTS"
 
+#define _NET_FRAME_EXTENTS_ATOM_NAME "_NET_FRAME_EXTENTS"
+
 #define _NET_WM_WINDOW_TYPE_ATOM_NAME         "_NET_WM_WINDOW_TYPE"
 #define _NET_WM_WINDOW_TYPE_DESKTOP_ATOM_NAME "_NET_WM_WINDOW_TYPE_DESKTOP"
 #define _NET_WM_WINDOW_TYPE_DOCK_ATOM_NAME    "_NET_WM_WINDOW_TYPE_DOCK"
@@ -114,22 +118,47 @@ XwState xw_state = {0};
 #define _NET_WM_WINDOW_TYPE_NORMAL_ATOM_NAME  "_NET_WM_WINDOW_TYPE_NORMAL"
 
 static xcb_atom_t xw_get_xcb_atom (CString atom_name);
+static Bool       xw_display_is_remote (void);
+static Bool       xw_build_keyboard (const xcb_get_keyboard_mapping_reply_t *reply);
 
 /**
  * @b Initialize CrossWindow.
  *
+ * This is called automatically when library is loaded. Calling it again does nothing
+ * unless @c xw_deinit is called first, or the first call failed (eg: because there was
+ * no display available at that time).
+ *
  * @return True if initialization is successful.
  * @return False otherwise.
  * */
 CONSTRUCTOR Bool xw_init (void) {
+    if (xw_state.connection) {
+        return True;
+    }
+
     memset (&xw_state, 0, sizeof (xw_state));
 
+    XW_TRACE_BEGIN ("xw_init");
+
+    GOTO_HANDLER_IF (
+        !xw_window_table_init (&xw_state.windows) || XW_MUTEX_INIT (&xw_state.event_lock) ||
+            XW_MUTEX_INIT (&xw_state.requests_lock),
+        CONNECT_FAILED,
+        "Failed to create locks\n"
+    );
+    GOTO_HANDLER_IF (!xw_post_init(), CONNECT_FAILED, "Failed to create posted event queue\n");
+    GOTO_HANDLER_IF (!xw_timer_wheel_init(), CONNECT_FAILED, "Failed to create timer wheel\n");
+
     /* open a new connection to xcb */
     xcb_connection_t *conn = xcb_connect (
         Null /* displayname : Use the one provided in environment variable */,
         Null /* screenp     : Screen pointer */
     );
-    RETURN_VALUE_IF (!conn, EXIT_FAILURE, CONNECTION_FAILED);
+    GOTO_HANDLER_IF (!conn, CONNECT_FAILED, CONNECTION_FAILED);
+
+    /* xcb never returns Null, a failed connection is reported through error state instead.
+     * No display is not fatal, every call just fails till a display is available. */
+    GOTO_HANDLER_IF (xcb_connection_has_error (conn), GET_SETUP_FAILED, CONNECTION_FAILED);
 
     /* get xcb setup to help us get screen iterator */
     const xcb_setup_t *setup = xcb_get_setup (conn);
@@ -142,6 +171,8 @@ CONSTRUCTOR Bool xw_init (void) {
     xw_state.screen_iterator = screen_iter;
     xw_state.connection      = conn;
 
+    XW_TRACE_BEGIN ("xw_init:intern_atoms");
+
     /* get protocol atom */
     xw_state.WM_PROTOCOLS     = xw_get_xcb_atom (WM_PROTOCOLS_ATOM_NAME);
     xw_state.WM_DELETE_WINDOW = xw_get_xcb_atom (WM_DELETE_WINDOW_ATOM_NAME);
@@ -187,6 +218,8 @@ CONSTRUCTOR Bool xw_init (void) {
 
     xw_state._MOTIF_WM_HINTS = xw_get_xcb_atom (_MOTIF_WM_HINTS_ATOM_NAME);
 
+    xw_state._NET_FRAME_EXTENTS = xw_get_xcb_atom (_NET_FRAME_EXTENTS_ATOM_NAME);
+
     /* get atoms for setting windows state */
     xw_state._NET_WM_WINDOW_TYPE         = xw_get_xcb_atom (_NET_WM_WINDOW_TYPE_ATOM_NAME);
     xw_state._NET_WM_WINDOW_TYPE_DESKTOP = xw_get_xcb_atom (_NET_WM_WINDOW_TYPE_DESKTOP_ATOM_NAME);
@@ -198,10 +231,19 @@ CONSTRUCTOR Bool xw_init (void) {
     xw_state._NET_WM_WINDOW_TYPE_DIALOG  = xw_get_xcb_atom (_NET_WM_WINDOW_TYPE_DIALOG_ATOM_NAME);
     xw_state._NET_WM_WINDOW_TYPE_NORMAL  = xw_get_xcb_atom (_NET_WM_WINDOW_TYPE_NORMAL_ATOM_NAME);
 
+    XW_TRACE_END ("xw_init:intern_atoms");
+
+    /* every pointer motion crosses the network when display is remote */
+    CString motion_hints  = getenv ("XW_MOTION_HINTS");
+    xw_state.motion_hints = motion_hints ? !strcmp (motion_hints, "1") : xw_display_is_remote();
+    XW_TRACE_END ("xw_init");
+
     return True;
 
-GET_SETUP_FAILED: {
+GET_SETUP_FAILED:
     xcb_disconnect (conn);
+CONNECT_FAILED: {
+    XW_TRACE_END ("xw_init");
     return False;
 }
 }
@@ -219,10 +261,19 @@ DESTRUCTOR Bool xw_deinit (void) {
     }
 
     if (xw_state.keyboard) {
-        FREE (xw_state.keyboard);
+        XW_FREE (XW_ALLOC_CATEGORY_KEYMAP, xw_state.keyboard);
         xw_state.keyboard      = Null;
         xw_state.keyboard_size = 0;
     }
+    xw_state.keymap_query = 0;
+
+    xw_event_backlog_deinit (&xw_state.backlog);
+    xw_window_table_deinit (&xw_state.windows);
+    XW_MUTEX_DEINIT (&xw_state.event_lock);
+    XW_MUTEX_DEINIT (&xw_state.requests_lock);
+
+    xw_post_deinit();
+    xw_timer_wheel_deinit();
 
     return True;
 }
@@ -353,95 +404,152 @@ static struct {
 };
 
 /**
- * @b Initialize keyboard in global XwState object.
+ * @b Initialize keyboard in global XwState object, waiting for keyboard mapping if it has not
+ *    arrived yet.
  * */
 Bool xw_init_keyboard (void) {
-    const xcb_setup_t *setup = xcb_get_setup (xw_state.connection);
-    GOTO_HANDLER_IF (!setup, GET_SETUP_FAILED, SETUP_FAILED);
+    XW_TRACE_BEGIN ("xw_init_keyboard");
 
-    xcb_key_symbols_t *syms = xcb_key_symbols_alloc (xw_state.connection);
-    RETURN_VALUE_IF (!syms, False, "Failed to allocate symbols\n");
+    if (!xw_state.keymap_query) {
+        xw_request_keyboard();
+    }
 
-    xw_state.keyboard_size = setup->max_keycode;
-    xw_state.keyboard      = ALLOCATE (XwKey, setup->max_keycode);
-    GOTO_HANDLER_IF (!xw_state.keyboard, ALLOC_FAILED, ERR_OUT_OF_MEMORY);
+    xcb_get_keyboard_mapping_cookie_t cookie = {xw_state.keymap_query};
+    xcb_get_keyboard_mapping_reply_t *reply  = XW_ROUND_TRIP (
+        "xcb_get_keyboard_mapping_reply",
+        xcb_get_keyboard_mapping_reply (xw_state.connection, cookie, Null)
+    );
+    xw_state.keymap_query = 0;
 
-    Size num_keymap = ARRAY_SIZE (xwkeymap);
+    Bool built = xw_build_keyboard (reply);
+    FREE (reply);
 
-    for (xcb_keycode_t xk = setup->min_keycode; xk < setup->max_keycode; xk++) {
-        xcb_keysym_t keysym = xcb_key_symbols_get_keysym (syms, xk, 0);
+    XW_TRACE_END ("xw_init_keyboard");
+    return built;
+}
 
-        XwKey key = XWK_UNKNOWN;
-        for (Size s = 0; s < num_keymap; s++) {
-            if (xwkeymap[s].keysym == keysym) {
-                key = xwkeymap[s].key;
-                break;
-            }
-        }
+/**
+ * @b Ask display server for keyboard mapping without waiting for it. Keymap is rebuilt from it
+ *    by @c xw_poll_keyboard once it arrives, and a request already in flight is forgotten.
+ * */
+void xw_request_keyboard (void) {
+    const xcb_setup_t *setup = xcb_get_setup (xw_state.connection);
+    RETURN_IF (!setup, SETUP_FAILED);
 
-        xw_state.keyboard[xk] = key;
+    if (xw_state.keymap_query) {
+        xcb_discard_reply (xw_state.connection, xw_state.keymap_query);
     }
 
+    xcb_get_keyboard_mapping_cookie_t cookie = xcb_get_keyboard_mapping (
+        xw_state.connection,
+        setup->min_keycode,
+        setup->max_keycode - setup->min_keycode + 1
+    );
+    xw_state.keymap_query = cookie.sequence;
+    XW_FLUSH (xw_state.connection);
+}
 
-    xcb_key_symbols_free (syms);
+/**
+ * @b Rebuild keymap if reply to keyboard mapping request sent by @c xw_request_keyboard
+ *    has arrived. Never waits.
+ *
+ * Replies and events arrive in order they're sent by display server, so once a key event
+ * sent after request was handled is read, reply is read as well.
+ * */
+void xw_poll_keyboard (void) {
+    if (!xw_state.keymap_query) {
+        return;
+    }
 
-    return True;
+    xcb_get_keyboard_mapping_reply_t *reply = Null;
+    xcb_generic_error_t              *error = Null;
+    if (!xcb_poll_for_reply (
+            xw_state.connection,
+            xw_state.keymap_query,
+            (void **)&reply,
+            &error
+        )) {
+        return;
+    }
+    xw_state.keymap_query = 0;
 
-ALLOC_FAILED:
-GET_SETUP_FAILED: {
-    xcb_disconnect (xw_state.connection);
-    xw_state.connection = Null;
-    return False;
-}
+    /* keep old keymap if request failed */
+    if (reply) {
+        xw_build_keyboard (reply);
+    }
+
+    FREE (reply);
+    FREE (error);
 }
 
 /**
- * @b Goes through the windows array and finds an entry that is Null.
+ * @b Remember which window a request was made for.
+ *
+ * None of the requests are checked synchronously, so when one fails, the error
+ * arrives later in event queue with only the request's sequence number. Only last
+ * @c XW_TRACKED_REQUEST_COUNT requests are remembered, which is more than enough
+ * because errors are sent as soon as display server processes the request.
  *
- * CrossWindow ID helps in pairing events with the window they correspond to.
- * Once the window is destroyed, they set the corresponding entry in XwState to Null.
- * This way a new ID can be generated for the same position which was Nulled out before.
+ * @param sequence Sequence number of request (from xcb cookie).
+ * @param win Window request was made for.
+ * */
+void xw_track_request (Uint32 sequence, XwWindow *win) {
+    Size slot = sequence % XW_TRACKED_REQUEST_COUNT;
+
+    XW_MUTEX_LOCK (&xw_state.requests_lock);
+    xw_state.requests[slot].sequence = sequence;
+    xw_state.requests[slot].window   = win;
+    XW_MUTEX_UNLOCK (&xw_state.requests_lock);
+}
+
+/**
+ * @b Get window for which request with given sequence number was made.
  *
- * @param win Window to generate new ID for.
+ * @param sequence
  *
- * @return New window ID on success.
- * @return SIZE_MAX on failure.
+ * @return @c XwWindow* if request is still remembered.
+ * @return @c Null otherwise.
  * */
-Size xw_create_new_window_id (XwWindow *win) {
-    RETURN_VALUE_IF (!win, SIZE_MAX, ERR_INVALID_ARGUMENTS);
+XwWindow *xw_get_window_by_request (Uint32 sequence) {
+    Size      slot = sequence % XW_TRACKED_REQUEST_COUNT;
+    XwWindow *win  = Null;
 
-    for (Size s = 0; s < ARRAY_SIZE (xw_state.windows); s++) {
-        if (xw_state.windows[s] == Null) {
-            xw_state.windows[s] = win;
-            return s;
-        }
+    XW_MUTEX_LOCK (&xw_state.requests_lock);
+    if (xw_state.requests[slot].sequence == sequence) {
+        win = xw_state.requests[slot].window;
     }
+    XW_MUTEX_UNLOCK (&xw_state.requests_lock);
 
-    return SIZE_MAX;
+    return win;
 }
 
 /**
- * @b Mark a window to be free for use for new windows.
+ * @b Forget all requests made for given window.
  *
- * This is used only by Window.c when it's destroying or de-initing the window.
+ * Must be called when window is being destroyed, so errors arriving late
+ * don't refer to a dangling window.
  *
- * @param window_id CrossWindow ID of window.
+ * @param win
  * */
-void xw_remove_window_id (Size window_id) {
-    RETURN_IF (window_id >= ARRAY_SIZE (xw_state.windows), ERR_INVALID_ARGUMENTS);
-    xw_state.windows[window_id] = Null;
+void xw_untrack_window_requests (XwWindow *win) {
+    XW_MUTEX_LOCK (&xw_state.requests_lock);
+    for (Size s = 0; s < XW_TRACKED_REQUEST_COUNT; s++) {
+        if (xw_state.requests[s].window == win) {
+            xw_state.requests[s].window = Null;
+        }
+    }
+    XW_MUTEX_UNLOCK (&xw_state.requests_lock);
 }
 
 /****************************** PRIVATE METHODS ************************************/
 
 /**
  * @b Get atom with given name. If atom is not present then it will be created.
- * 
- * This method will call exit if returned atom is @c XCB_ATOM_NONE.
  *  
  * @param atom_name.
  *
- * @return xcb_atom_t
+ * @return xcb_atom_t on success.
+ * @return XCB_ATOM_NONE otherwise.
  * */
 static xcb_atom_t xw_get_xcb_atom (CString atom_name) {
     /* make a request to create a new atom with given name */
@@ -449,8 +557,10 @@ static xcb_atom_t xw_get_xcb_atom (CString atom_name) {
         xcb_intern_atom_unchecked (xw_state.connection, False, strlen (atom_name), atom_name);
 
     /* wait for reply */
-    xcb_intern_atom_reply_t *reply = Null;
-    reply                          = xcb_intern_atom_reply (xw_state.connection, cookie, Null);
+    xcb_intern_atom_reply_t *reply = XW_ROUND_TRIP (
+        "xcb_intern_atom_reply",
+        xcb_intern_atom_reply (xw_state.connection, cookie, Null)
+    );
     GOTO_HANDLER_IF (!reply, ATOM_REPLY_FAILED, "Atom reply failed (got Null)\n");
 
     /* set the atom and free reply */
@@ -465,5 +575,81 @@ static xcb_atom_t xw_get_xcb_atom (CString atom_name) {
 ATOM_IS_NONE:
     FREE (reply);
 ATOM_REPLY_FAILED:
-    exit (EXIT_FAILURE);
+    return XCB_ATOM_NONE;
+}
+
+/**
+ * @b Check whether display named by @c DISPLAY environment variable is on another host.
+ *
+ * Any display reached over TCP counts as remote, including "localhost:10", which is what
+ * X11 forwarding over SSH sets. Local displays have no host, a "unix" host, or a socket
+ * path (as launchd sets on macOS).
+ *
+ * @return True if display is remote.
+ * @return False otherwise.
+ * */
+static Bool xw_display_is_remote (void) {
+    char *host    = Null;
+    int   display = 0;
+    if (!xcb_parse_display (Null, &host, &display, Null)) {
+        return False;
+    }
+
+    Bool remote = host[0] && host[0] != '/' && !!strcmp (host, "unix");
+    FREE (host);
+
+    return remote;
+}
+
+/**
+ * @b Replace keymap with one built from given keyboard mapping.
+ *
+ * @param reply Reply to keyboard mapping request made by @c xw_request_keyboard.
+ *
+ * @return True on success.
+ * @return False otherwise, old keymap (if any) is kept.
+ * */
+static Bool xw_build_keyboard (const xcb_get_keyboard_mapping_reply_t *reply) {
+    RETURN_VALUE_IF (!reply, False, KEYBOARD_FAILED);
+
+    const xcb_setup_t *setup = xcb_get_setup (xw_state.connection);
+    RETURN_VALUE_IF (!setup, False, SETUP_FAILED);
+
+    Size   keyboard_size = setup->max_keycode + 1;
+    XwKey *keyboard      = XW_ALLOCATE (XW_ALLOC_CATEGORY_KEYMAP, XwKey, keyboard_size);
+    RETURN_VALUE_IF (!keyboard, False, ERR_OUT_OF_MEMORY);
+
+    const xcb_keysym_t *keysyms    = xcb_get_keyboard_mapping_keysyms (reply);
+    Size                per        = reply->keysyms_per_keycode;
+    Size                num_keymap = ARRAY_SIZE (xwkeymap);
+
+    for (Size xk = setup->min_keycode; per && xk <= setup->max_keycode; xk++) {
+        const xcb_keysym_t *syms = keysyms + (xk - setup->min_keycode) * per;
+
+        /* like first column of xcb_key_symbols_get_keysym, letters of keys with a single
+         * keysym are looked up in lower case */
+        xcb_keysym_t keysym = syms[0];
+        if ((per == 1 || (per == 2 && syms[1] == XCB_NO_SYMBOL)) && keysym >= XK_A &&
+            keysym <= XK_Z) {
+            keysym += XK_a - XK_A;
+        }
+
+        XwKey key = XWK_UNKNOWN;
+        for (Size s = 0; s < num_keymap; s++) {
+            if (xwkeymap[s].keysym == keysym) {
+                key = xwkeymap[s].key;
+                break;
+            }
+        }
+
+        keyboard[xk] = key;
+    }
+
+    if (xw_state.keyboard) {
+        XW_FREE (XW_ALLOC_CATEGORY_KEYMAP, xw_state.keyboard);
+    }
+    xw_state.keyboard      = keyboard;
+    xw_state.keyboard_size = keyboard_size;
+
+    return True;
 }
@@ -35,6 +35,18 @@
 
 #include <Anvie/CrossWindow/Event.h>
 
+/* local headers */
+#include "Common/Backlog.h"
+#include "Common/Event.h"
+#include "Common/Idle.h"
+#include "Common/Lock.h"
+#include "Common/Log.h"
+#include "Common/Post.h"
+#include "Common/Stats.h"
+#include "Common/Timer.h"
+#include "Common/Trace.h"
+#include "Common/WindowTable.h"
+
 /* xcb related headers */
 #include <xcb/xcb.h>
 
@@ -42,12 +54,35 @@
     "It looks like CrossWindow is not yet initialized. Please call xw_init() before using "        \
     "CrossWindow\n"
 
+/** @b Flush pending requests to X server. All flushes go through this so they show in traces. */
+#define XW_FLUSH(conn)                                                                             \
+    do {                                                                                           \
+        XW_TRACE_BEGIN ("xcb_flush");                                                              \
+        xcb_flush (conn);                                                                          \
+        XW_TRACE_END ("xcb_flush");                                                                \
+    } while (0)
+
+/** @b Number of recently sent requests remembered to pair errors with windows. */
+#define XW_TRACKED_REQUEST_COUNT 256
+
 typedef struct XwState {
     xcb_connection_t     *connection;
     Size                  keyboard_size; /**< @b Number of entries in @c keyboard array */
     XwKey                *keyboard;      /**< @b Mapping of keysyms to @c XwKey */
+    Uint32                keymap_query;  /**< @b Sequence of keyboard mapping request, 0 if none */
     xcb_screen_iterator_t screen_iterator;
 
+    /**
+     * @b Held while an event is converted, and while a window is being unregistered. Makes
+     *    sure windows found during conversion are not destroyed under it by other threads.
+     *    Keyboard mapping is created lazily and replaced during conversion, so this guards
+     *    it as well.
+     * */
+    XwMutex event_lock;
+
+    /** @b Events waiting to be returned in priority mode. Guarded by @c event_lock. */
+    XwEventBacklog backlog;
+
     /** @b Atom to be used to set other created atoms. */
     xcb_atom_t WM_PROTOCOLS;
     /** @b Atom we receive in client message events to recognize for close window events. */
@@ -94,6 +129,9 @@ typedef struct XwState {
     /* to remove window borders */
     xcb_atom_t _MOTIF_WM_HINTS;
 
+    /**< @b _NET_FRAME_EXTENTS : https://specifications.freedesktop.org/wm-spec/1.4/ar01s05.html */
+    xcb_atom_t _NET_FRAME_EXTENTS;
+
     /* atoms to manage window type 
      * https://specifications.freedesktop.org/wm-spec/wm-spec-1.3.html#idm45821695774192 */
     xcb_atom_t _NET_WM_WINDOW_TYPE;
@@ -106,17 +144,53 @@ typedef struct XwState {
     xcb_atom_t _NET_WM_WINDOW_TYPE_DIALOG;
     xcb_atom_t _NET_WM_WINDOW_TYPE_NORMAL;
 
+    /** @b Whether MIT-SHM extension is usable, checked when first framebuffer is created. */
+    Bool shm_checked;
+    Bool shm_available;
+
+    /** @b Whether Present extension is usable, checked when frame events are first enabled. */
+    Bool  present_checked;
+    Bool  present_available;
+    Uint8 present_opcode; /**< @b Major opcode, used to recognize Present events. */
+
+    /** @b Whether RandR 1.3 is usable, checked when refresh rate is first asked for. */
+    Bool randr_checked;
+    Bool randr_available;
+
+    /**
+     * @b Windows ask for pointer motion hints instead of every motion, see
+     *    @c xw_event_set_motion_hints. Enabled at init when display is on another host.
+     * */
+    Bool motion_hints;
+    Size motion_pending; /**< @b Windows hinted or querying pointer. Guarded by @c event_lock. */
+
+    /** @b Windows reading their _NET_WM_STATE property. Guarded by @c event_lock. */
+    Size state_pending;
+
     /** 
      * @b A mapping from CrossWindow Id to the window itself.
      * This is used by event poll and wait methods to get the window for which
      * the xcb event was generated.
      * */
-    struct XwWindow *windows[64];
-    Size             window_count;
+    XwWindowTable windows;
+
+    /**
+     * @b Window for which each recently sent request was made, indexed by lower bits of
+     * request sequence number. Used to find out which window an error belongs to.
+     * */
+    struct {
+        Uint32           sequence;
+        struct XwWindow *window;
+    } requests[XW_TRACKED_REQUEST_COUNT];
+    XwMutex requests_lock; /**< @b Requests are sent and tracked from any thread. */
 } XwState;
 
 Bool xw_init_keyboard (void);
-Size xw_create_new_window_id (struct XwWindow *win);
-void xw_remove_window_id (Size window_id);
+void xw_request_keyboard (void);
+void xw_poll_keyboard (void);
+
+void             xw_track_request (Uint32 sequence, struct XwWindow *win);
+struct XwWindow *xw_get_window_by_request (Uint32 sequence);
+void             xw_untrack_window_requests (struct XwWindow *win);
 
 #endif // ANVIE_CROSSWINDOW_PLATFORM_XCB_STATE_H
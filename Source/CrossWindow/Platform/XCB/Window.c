@@ -31,9 +31,11 @@
  * */
 
 #include <Anvie/Common.h>
+#include <Anvie/CrossWindow/Query.h>
 #include <Anvie/CrossWindow/Window.h>
 
 /* local headers */
+#include "Common/Allocator.h"
 #include "State.h"
 #include "Window.h"
 
@@ -41,13 +43,29 @@
 #include <string.h>
 
 /* xcb related headers */
+#include <xcb/randr.h>
 #include <xcb/xcb.h>
 #include <xcb/xcb_icccm.h>
 #include <xcb/xproto.h>
 
+/** @b Most CRTCs looked at to find which one shows a window. */
+#define XW_RANDR_MAX_CRTCS 32
+
 
 extern XwState xw_state;
 
+static XwWindow *xw_window_send_create_requests (
+    XwWindow *self,
+    CString   title,
+    Uint32    width,
+    Uint32    height,
+    Uint32    xpos,
+    Uint32    ypos
+);
+static void    xw_window_send_title (XwWindow *self);
+static Bool    xw_randr_is_available (void);
+static Float64 xw_randr_mode_refresh_rate (const xcb_randr_mode_info_t *mode);
+
 /**
  * @b Create a new @x XwWindow object.
  *
@@ -63,7 +81,7 @@ extern XwState xw_state;
 XwWindow *xw_window_create (CString title, Uint32 width, Uint32 height, Uint32 xpos, Uint32 ypos) {
     RETURN_VALUE_IF (!width || !height, Null, ERR_INVALID_ARGUMENTS);
 
-    XwWindow *self = NEW (XwWindow);
+    XwWindow *self = XW_NEW (XW_ALLOC_CATEGORY_WINDOW, XwWindow);
     RETURN_VALUE_IF (!self, Null, ERR_OUT_OF_MEMORY);
 
     XwWindow *iself = xw_window_init (self, title, width, height, xpos, ypos);
@@ -78,6 +96,73 @@ INIT_FAILED: {
 }
 }
 
+/**
+ * @b Create many windows at once.
+ *
+ * Window objects are allocated in a single contiguous block, and requests for all
+ * windows are pipelined and sent to display server with a single flush at the end,
+ * instead of one flush per window like @c xw_window_create does. This makes a big
+ * difference when opening hundreds of windows.
+ *
+ * Each created window is still destroyed individually using @c xw_window_destroy.
+ *
+ * @param infos Array of @c n create infos, one for each window.
+ * @param n Number of windows to create. Cannot be 0.
+ * @param out Array with space for @c n window pointers. Created windows are stored here
+ *        in same order as @c infos.
+ *
+ * @return @c out on success.
+ * @return Null otherwise. No window is created in this case.
+ * */
+XwWindow **xw_window_create_many (const XwWindowCreateInfo *infos, Size n, XwWindow **out) {
+    RETURN_VALUE_IF (!infos || !n || !out, Null, ERR_INVALID_ARGUMENTS);
+    RETURN_VALUE_IF (!xw_state.connection, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    /* validate everything first, so we never have to roll back because of bad arguments */
+    for (Size s = 0; s < n; s++) {
+        RETURN_VALUE_IF (!infos[s].width || !infos[s].height, Null, ERR_INVALID_ARGUMENTS);
+    }
+
+    XwWindow *batch = XW_ALLOCATE (XW_ALLOC_CATEGORY_WINDOW, XwWindow, n);
+    RETURN_VALUE_IF (!batch, Null, ERR_OUT_OF_MEMORY);
+
+    Size num_created = 0;
+    while (num_created < n) {
+        const XwWindowCreateInfo *info = infos + num_created;
+        XwWindow                 *win  = batch + num_created;
+
+        XwWindow *iwin = xw_window_send_create_requests (
+            win,
+            info->title,
+            info->width,
+            info->height,
+            info->xpos,
+            info->ypos
+        );
+        GOTO_HANDLER_IF (!iwin, INIT_FAILED, ERR_OBJECT_INITIALIZATION_FAILED);
+
+        win->batch       = batch;
+        out[num_created] = win;
+        num_created++;
+    }
+
+    batch->batch_refs = n;
+    XW_FLUSH (xw_state.connection);
+
+    return out;
+
+INIT_FAILED: {
+    /* window that failed can be partially initialized as well */
+    for (Size s = 0; s <= num_created; s++) {
+        xw_window_deinit (batch + s);
+        out[s] = Null;
+    }
+    XW_FLUSH (xw_state.connection);
+    XW_FREE (XW_ALLOC_CATEGORY_WINDOW, batch);
+    return Null;
+}
+}
+
 /**
  * @b Create a new @x XwWindow object.
  *
@@ -101,80 +186,10 @@ XwWindow *xw_window_init (
 ) {
     RETURN_VALUE_IF (!self || !width || !height, Null, ERR_INVALID_ARGUMENTS);
 
-    xcb_connection_t *conn   = xw_state.connection;
-    xcb_screen_t     *screen = xw_state.screen_iterator.data;
-    RETURN_VALUE_IF (!conn || !screen, Null, ERR_XW_STATE_NOT_INITIALIZED);
-
-    /* create platform data */
-    self->xcb_window_id = -1;
-
-    /* generate id for new window. */
-    xcb_window_t win_id = xcb_generate_id (conn);
-    RETURN_VALUE_IF (
-        win_id == (xcb_window_t)-1, /* -1 is returned on failure */
-        Null,
-        "Failed to generate new window ID\n"
-    );
-
-    self->xcb_window_id = win_id;
-    self->border_width  = 0;
-    self->min_size      = (XwWindowSize) {0, 0};
-    self->max_size      = (XwWindowSize) {screen->width_in_pixels, screen->height_in_pixels};
-    self->size.width    = CLAMP (width, 0, self->max_size.width);
-    self->size.height   = CLAMP (height, 0, self->max_size.height);
-    self->pos.x         = xpos;
-    self->pos.y         = ypos;
-    self->title         = title ? strdup (title) : Null;
-    self->icon_path     = Null;
-
-    Uint32 win_mask     = XCB_CW_EVENT_MASK;
-    Uint32 win_values[] = {
-        XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE |
-        XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_ENTER_WINDOW |
-        XCB_EVENT_MASK_LEAVE_WINDOW | XCB_EVENT_MASK_FOCUS_CHANGE |
-        XCB_EVENT_MASK_VISIBILITY_CHANGE | XCB_EVENT_MASK_STRUCTURE_NOTIFY |
-        XCB_EVENT_MASK_PROPERTY_CHANGE | XCB_EVENT_MASK_POINTER_MOTION |
-        XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY
-    };
-
-    /* create window corresponding to window id */
-    xcb_create_window (
-        conn,                          /* connection */
-        XCB_COPY_FROM_PARENT,          /* depth: Copy depth info from parent */
-        win_id,                        /* wid: id of window object to be created */
-        screen->root,                  /* parent: parent window of this window */
-        self->pos.x,                   /* x */
-        self->pos.y,                   /* y */
-        self->size.width,              /* width */
-        self->size.height,             /* height */
-        self->border_width,            /* border width */
-        XCB_WINDOW_CLASS_INPUT_OUTPUT, /* window class */
-        screen->root_visual,           /* visual data */
-        win_mask,                      /* value mask */
-        win_values                     /* value mask array */
-    );
-
-    /* create new atom to help us detect close window event messages */
-    xcb_change_property (
-        conn,                      /* xcb connection */
-        XCB_PROP_MODE_REPLACE,     /* replace the property with new value */
-        self->xcb_window_id,       /* xcb id of window object */
-        xw_state.WM_PROTOCOLS,     /* change something in protocl */
-        XCB_ATOM_ATOM,             /* change an atom */
-        32,                        /* process data in chunks of 32 bits */
-        1,                         /* length of data */
-        &xw_state.WM_DELETE_WINDOW /* data */
-    );
-
-    if (title) {
-        xw_window_set_title (self, title);
-    }
+    XwWindow *iself = xw_window_send_create_requests (self, title, width, height, xpos, ypos);
+    RETURN_VALUE_IF (!iself, Null, ERR_OBJECT_INITIALIZATION_FAILED);
 
-    /* register this window to global state. */
-    self->xw_id = xw_create_new_window_id (self);
-
-    xcb_map_window (conn, win_id);
-    xcb_flush (conn);
+    XW_FLUSH (xw_state.connection);
     return self;
 }
 
@@ -189,8 +204,37 @@ XwWindow *xw_window_init (
 XwWindow *xw_window_deinit (XwWindow *self) {
     RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
 
-    /* unregister this window from xw_state */
-    xw_remove_window_id (self->xw_id);
+    /* unregister this window from xw_state, waiting for event being converted (if any) in
+     * some other thread, as it may have found this window already */
+    XW_MUTEX_LOCK (&xw_state.event_lock);
+    if (self->xw_id != SIZE_MAX) {
+        xw_window_table_remove (&xw_state.windows, self->xw_id);
+        self->xw_id = SIZE_MAX;
+    }
+    xw_idle_set_presentable (&self->presentable, False);
+    xw_untrack_window_requests (self);
+    xw_event_backlog_forget_window (&xw_state.backlog, self);
+    if (self->motion_query && xw_state.connection) {
+        xcb_discard_reply (xw_state.connection, self->motion_query);
+    }
+    if (self->motion_hinted || self->motion_query) {
+        XW_STORE (&xw_state.motion_pending, xw_state.motion_pending - 1);
+    }
+    if (self->state_query && xw_state.connection) {
+        xcb_discard_reply (xw_state.connection, self->state_query);
+    }
+    if (self->state_query) {
+        XW_STORE (&xw_state.state_pending, xw_state.state_pending - 1);
+    }
+    XW_MUTEX_UNLOCK (&xw_state.event_lock);
+
+    /* no more events can be routed to this window now */
+    if (self->queue) {
+        xw_event_queue_destroy (self->queue);
+        self->queue = Null;
+    }
+
+    xw_window_release_framebuffer (self);
 
     /* if window was created then destroy it */
     if (self->xcb_window_id != (xcb_window_t)-1) {
@@ -203,23 +247,27 @@ XwWindow *xw_window_deinit (XwWindow *self) {
 
     /* destroy strdup-ed string */
     if (self->title) {
-        FREE (self->title);
+        XW_FREE (XW_ALLOC_CATEGORY_TITLE, self->title);
         self->title = Null;
     }
 
     /* destroy strdup-ed string */
     if (self->icon_path) {
-        FREE (self->icon_path);
+        XW_FREE (XW_ALLOC_CATEGORY_TITLE, self->icon_path);
         self->icon_path = Null;
     }
 
+    XW_MUTEX_DEINIT (&self->lock);
+
     return self;
 }
 
 /**
  * @b Destroy window.
  *
- * This will also free the given @c XwWindow object.
+ * This will also free the given @c XwWindow object. For windows created using
+ * @c xw_window_create_many, memory is released once every window of the batch
+ * is destroyed.
  *
  * @param self @c XwWindow object to be destroyed.
  * */
@@ -227,7 +275,16 @@ void xw_window_destroy (XwWindow *self) {
     RETURN_IF (!self, ERR_INVALID_ARGUMENTS);
 
     xw_window_deinit (self);
-    FREE (self);
+
+    /* windows created by xw_window_create_many share a single allocation */
+    if (self->batch) {
+        if (!__atomic_sub_fetch (&self->batch->batch_refs, 1, __ATOMIC_ACQ_REL)) {
+            XW_FREE (XW_ALLOC_CATEGORY_WINDOW, self->batch);
+        }
+        return;
+    }
+
+    XW_FREE (XW_ALLOC_CATEGORY_WINDOW, self);
 }
 
 /**
@@ -241,8 +298,9 @@ void xw_window_destroy (XwWindow *self) {
 XwWindow *xw_window_show (XwWindow *self) {
     RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
 
-    xcb_map_window (xw_state.connection, self->xcb_window_id);
-    xcb_flush (xw_state.connection);
+    xcb_void_cookie_t cookie = xcb_map_window (xw_state.connection, self->xcb_window_id);
+    xw_track_request (cookie.sequence, self);
+    XW_FLUSH (xw_state.connection);
 
     return self;
 }
@@ -258,8 +316,9 @@ XwWindow *xw_window_show (XwWindow *self) {
 XwWindow *xw_window_hide (XwWindow *self) {
     RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
 
-    xcb_unmap_window (xw_state.connection, self->xcb_window_id);
-    xcb_flush (xw_state.connection);
+    xcb_void_cookie_t cookie = xcb_unmap_window (xw_state.connection, self->xcb_window_id);
+    xw_track_request (cookie.sequence, self);
+    XW_FLUSH (xw_state.connection);
 
     return self;
 }
@@ -278,7 +337,11 @@ XwWindow *xw_window_hide (XwWindow *self) {
  * */
 CString xw_window_get_title (XwWindow *self) {
     RETURN_VALUE_IF (!self, Null, ERR_INVALID_ARGUMENTS);
+
+    XW_MUTEX_LOCK (&self->lock);
     CString title = self->title ? strdup (self->title) : Null;
+    XW_MUTEX_UNLOCK (&self->lock);
+
     RETURN_VALUE_IF (!title, Null, ERR_OUT_OF_MEMORY);
     return title;
 }
@@ -292,7 +355,7 @@ CString xw_window_get_title (XwWindow *self) {
  * */
 XwWindowSize xw_window_get_size (XwWindow *self) {
     RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
-    return self->size;
+    return XW_LOAD (&self->size);
 }
 
 /**
@@ -304,7 +367,7 @@ XwWindowSize xw_window_get_size (XwWindow *self) {
  * */
 XwWindowSize xw_window_get_min_size (XwWindow *self) {
     RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
-    return self->min_size;
+    return XW_LOAD (&self->min_size);
 }
 
 /**
@@ -316,7 +379,7 @@ XwWindowSize xw_window_get_min_size (XwWindow *self) {
  * */
 XwWindowSize xw_window_get_max_size (XwWindow *self) {
     RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
-    return self->max_size;
+    return XW_LOAD (&self->max_size);
 }
 
 /**
@@ -328,7 +391,121 @@ XwWindowSize xw_window_get_max_size (XwWindow *self) {
  * */
 XwWindowPos xw_window_get_pos (XwWindow *self) {
     RETURN_VALUE_IF (!self, ((XwWindowPos) {0, 0}), ERR_INVALID_ARGUMENTS);
-    return self->pos;
+    return XW_LOAD (&self->pos);
+}
+
+/**
+ * @b Get refresh rate of monitor showing given window, using RandR.
+ *
+ * Monitor is the CRTC containing center of window, or first active one if window is
+ * off-screen. This makes a few round trips, so it's meant to be called once, not per frame.
+ *
+ * @param self
+ *
+ * @return Refresh rate in Hz on success.
+ * @return 0 if it cannot be known.
+ * */
+Float64 xw_window_get_refresh_rate (XwWindow *self) {
+    RETURN_VALUE_IF (!self, 0, ERR_INVALID_ARGUMENTS);
+
+    if (!xw_randr_is_available()) {
+        XW_LOG_INFO ("RandR is not available, refresh rate is not known\n");
+        return 0;
+    }
+
+    xcb_connection_t *conn = xw_state.connection;
+    xcb_window_t      root = self->screen->root;
+    XwWindowSize      size = XW_LOAD (&self->size);
+
+    /* send both requests before waiting for either reply */
+    xcb_translate_coordinates_cookie_t center_cookie = xcb_translate_coordinates (
+        conn,
+        self->xcb_window_id,
+        root,
+        size.width / 2,
+        size.height / 2
+    );
+    xcb_randr_get_screen_resources_current_cookie_t res_cookie =
+        xcb_randr_get_screen_resources_current (conn, root);
+
+    xcb_translate_coordinates_reply_t *center = XW_ROUND_TRIP (
+        "xcb_translate_coordinates_reply",
+        xcb_translate_coordinates_reply (conn, center_cookie, Null)
+    );
+    xcb_randr_get_screen_resources_current_reply_t *res = XW_ROUND_TRIP (
+        "xcb_randr_get_screen_resources_current_reply",
+        xcb_randr_get_screen_resources_current_reply (conn, res_cookie, Null)
+    );
+    GOTO_HANDLER_IF (!res, RESOURCES_FAILED, "Failed to get RandR screen resources\n");
+
+    Int32 cx = center ? center->dst_x : 0;
+    Int32 cy = center ? center->dst_y : 0;
+
+    xcb_randr_crtc_t *crtcs      = xcb_randr_get_screen_resources_current_crtcs (res);
+    Size              crtc_count = xcb_randr_get_screen_resources_current_crtcs_length (res);
+    crtc_count                   = MIN (crtc_count, XW_RANDR_MAX_CRTCS);
+
+    xcb_randr_get_crtc_info_cookie_t crtc_cookies[XW_RANDR_MAX_CRTCS];
+    for (Size c = 0; c < crtc_count; c++) {
+        crtc_cookies[c] = xcb_randr_get_crtc_info (conn, crtcs[c], res->config_timestamp);
+    }
+
+    /* replies of all CRTCs must be taken, even after finding the one showing window */
+    xcb_randr_mode_t mode_id = 0;
+    for (Size c = 0; c < crtc_count; c++) {
+        xcb_randr_get_crtc_info_reply_t *crtc = XW_ROUND_TRIP (
+            "xcb_randr_get_crtc_info_reply",
+            xcb_randr_get_crtc_info_reply (conn, crtc_cookies[c], Null)
+        );
+        if (!crtc) {
+            continue;
+        }
+
+        Bool contains = cx >= crtc->x && cx < crtc->x + crtc->width && cy >= crtc->y &&
+                        cy < crtc->y + crtc->height;
+        /* prefer CRTC showing center of window, else first active one */
+        if (crtc->mode && (contains || !mode_id)) {
+            mode_id = crtc->mode;
+        }
+        FREE (crtc);
+    }
+
+    Float64                rate       = 0;
+    xcb_randr_mode_info_t *modes      = xcb_randr_get_screen_resources_current_modes (res);
+    Size                   mode_count = xcb_randr_get_screen_resources_current_modes_length (res);
+    for (Size m = 0; mode_id && m < mode_count; m++) {
+        if (modes[m].id == mode_id) {
+            rate = xw_randr_mode_refresh_rate (&modes[m]);
+            break;
+        }
+    }
+
+    FREE (res);
+    if (center) {
+        FREE (center);
+    }
+    return rate;
+
+RESOURCES_FAILED:
+    if (center) {
+        FREE (center);
+    }
+    return 0;
+}
+
+/**
+ * @b Check whether anything rendered to given window can be seen, meaning window is mapped,
+ *    not minimized and not fully obscured. Rendering can be skipped otherwise.
+ *
+ * Updated as events are polled, so this is only as fresh as the last @c xw_event_poll.
+ *
+ * @param win Window to check. Null checks whether any window is presentable.
+ *
+ * @return True if rendering is worth it.
+ * @return False otherwise.
+ * */
+Bool xw_should_render (XwWindow *win) {
+    return win ? XW_LOAD (&win->presentable) : xw_idle_any_presentable();
 }
 
 /**
@@ -341,12 +518,15 @@ XwWindowPos xw_window_get_pos (XwWindow *self) {
  * */
 XwWindowState xw_window_get_state (XwWindow *self) {
     RETURN_VALUE_IF (!self, XW_WINDOW_STATE_MASK_CLEAR, ERR_INVALID_ARGUMENTS);
-    return self->state;
+    return XW_LOAD (&self->state);
 }
 
 /**
  * @b Get bitmask of currently allowed window permissions.
  *
+ * This waits for a round trip to display server. Use @c xw_window_query_action_permissions
+ * to fetch permissions of many windows at once without blocking.
+ *
  * @param self 
  *
  * @return @c XwWindowActionPermissions on success.
@@ -356,57 +536,15 @@ XwWindowActionPermissions xw_window_get_action_permissions (XwWindow *self) {
     RETURN_VALUE_IF (!self, XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR, ERR_INVALID_ARGUMENTS);
 
     /* unlike window state, it's better to get this everytime */
-
-    struct {
-        xcb_atom_t                atom;
-        XwWindowActionPermissions mask;
-    } atoms[] = {
-        {          xw_state._NET_WM_ACTION_MOVE,           XW_WINDOW_ACTION_PERMISSION_MASK_MOVE},
-        {        xw_state._NET_WM_ACTION_RESIZE,         XW_WINDOW_ACTION_PERMISSION_MASK_RESIZE},
-        {      xw_state._NET_WM_ACTION_MINIMIZE,       XW_WINDOW_ACTION_PERMISSION_MASK_MINIMIZE},
-        {         xw_state._NET_WM_ACTION_SHADE,          XW_WINDOW_ACTION_PERMISSION_MASK_SHADE},
-        {         xw_state._NET_WM_ACTION_STICK,          XW_WINDOW_ACTION_PERMISSION_MASK_STICK},
-        { xw_state._NET_WM_ACTION_MAXIMIZE_HORZ,  XW_WINDOW_ACTION_PERMISSION_MASK_MAXIMIZE_HORZ},
-        { xw_state._NET_WM_ACTION_MAXIMIZE_VERT,  XW_WINDOW_ACTION_PERMISSION_MASK_MAXIMIZE_VERT},
-        {    xw_state._NET_WM_ACTION_FULLSCREEN,     XW_WINDOW_ACTION_PERMISSION_MASK_FULLSCREEN},
-        {xw_state._NET_WM_ACTION_CHANGE_DESKTOP, XW_WINDOW_ACTION_PERMISSION_MASK_CHANGE_DESKTOP},
-        {         xw_state._NET_WM_ACTION_CLOSE,          XW_WINDOW_ACTION_PERMISSION_MASK_CLOSE},
-        {         xw_state._NET_WM_ACTION_ABOVE,          XW_WINDOW_ACTION_PERMISSION_MASK_ABOVE},
-        {         xw_state._NET_WM_ACTION_BELOW,          XW_WINDOW_ACTION_PERMISSION_MASK_BELOW},
-    };
-
-    xcb_get_property_cookie_t cookie = xcb_get_property (
-        xw_state.connection,              /* connection */
-        False,                            /* delete */
-        self->xcb_window_id,              /* window */
-        xw_state._NET_WM_ALLOWED_ACTIONS, /* property */
-        XCB_ATOM_ATOM,                    /* type */
-        0,                                /* offset */
-        UINT32_MAX                        /* length */
-    );
-
-    xcb_get_property_reply_t *reply = xcb_get_property_reply (xw_state.connection, cookie, Null);
+    XwQuery       query = xw_window_query_action_permissions (self);
+    XwQueryResult result;
     RETURN_VALUE_IF (
-        !reply,
+        !xw_query_wait (&query, &result),
         XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR,
         "Failed to get action permissions from window.\n"
     );
 
-    Size        atom_count = xcb_get_property_value_length (reply);
-    xcb_atom_t *actions    = xcb_get_property_value (reply);
-
-    /* create flag out of retrieved property */
-    XwWindowActionPermissions permissions = XW_WINDOW_ACTION_PERMISSION_MASK_CLEAR;
-    for (Size s = 0; s < atom_count; s++) {
-        for (Size a = 0; a < ARRAY_SIZE (atoms); a++) {
-            if (actions[s] == atoms[a].atom) {
-                permissions |= atoms[a].mask;
-            }
-        }
-    }
-
-    FREE (reply);
-    return permissions;
+    return result.action_permissions;
 }
 
 /**
@@ -421,26 +559,18 @@ XwWindowActionPermissions xw_window_get_action_permissions (XwWindow *self) {
 CString xw_window_set_title (XwWindow *self, CString title) {
     RETURN_VALUE_IF (!self || !title, Null, ERR_INVALID_ARGUMENTS);
 
-    CString set_title = strdup (title);
+    CString set_title = XW_STRDUP (XW_ALLOC_CATEGORY_TITLE, title);
     RETURN_VALUE_IF (!set_title, Null, ERR_OUT_OF_MEMORY);
 
+    XW_MUTEX_LOCK (&self->lock);
     if (self->title) {
-        FREE (self->title);
+        XW_FREE (XW_ALLOC_CATEGORY_TITLE, self->title);
     }
     self->title = set_title;
-    /* set title */
-    xcb_change_property (
-        xw_state.connection,   /* xcb connection */
-        XCB_PROP_MODE_REPLACE, /* replace the property with new value */
-        self->xcb_window_id,   /* id of object */
-        XCB_ATOM_WM_NAME,      /* property is window name */
-        XCB_ATOM_STRING,       /* atom type is string */
-        8,                     /* process data in chunks of 8 bits */
-        strlen (self->title),  /* length of data */
-        self->title            /* data */
-    );
+    xw_window_send_title (self);
+    XW_MUTEX_UNLOCK (&self->lock);
 
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
 
     return title;
 }
@@ -461,24 +591,27 @@ XwWindowSize xw_window_set_size (XwWindow *self, XwWindowSize size) {
     RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
 
     /* make sure the size is in bounds */
-    if (size.width < self->min_size.width || size.width > self->max_size.width ||
-        size.height < self->min_size.height || size.height > self->max_size.height) {
-        return self->size;
+    XwWindowSize min_size = XW_LOAD (&self->min_size);
+    XwWindowSize max_size = XW_LOAD (&self->max_size);
+    if (size.width < min_size.width || size.width > max_size.width ||
+        size.height < min_size.height || size.height > max_size.height) {
+        return XW_LOAD (&self->size);
     }
 
     /* store new size */
-    self->size = size;
+    XW_STORE (&self->size, size);
 
     /* set new size */
-    xcb_configure_window (
+    xcb_void_cookie_t cookie = xcb_configure_window (
         xw_state.connection,
         self->xcb_window_id,
         XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT,
         &size
     );
+    xw_track_request (cookie.sequence, self);
 
     /* commit changes */
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
 
     return size;
 }
@@ -494,8 +627,9 @@ XwWindowSize xw_window_set_size (XwWindow *self, XwWindowSize size) {
  * */
 XwWindowSize xw_window_set_min_size (XwWindow *self, XwWindowSize size) {
     RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    XwWindowSize max_size = XW_LOAD (&self->max_size);
     RETURN_VALUE_IF (
-        size.width > self->max_size.width || size.height > self->max_size.height,
+        size.width > max_size.width || size.height > max_size.height,
         ((XwWindowSize) {0, 0}),
         "Min size bound cannot be greater than max size bound of window\n"
     );
@@ -505,16 +639,18 @@ XwWindowSize xw_window_set_min_size (XwWindow *self, XwWindowSize size) {
     xcb_icccm_size_hints_set_min_size (&hints, size.width, size.height);
 
     /* set hints */
-    xcb_icccm_set_wm_size_hints (
+    xcb_void_cookie_t cookie = xcb_icccm_set_wm_size_hints (
         xw_state.connection,
         self->xcb_window_id,
         XCB_ATOM_WM_NORMAL_HINTS,
         &hints
     );
+    xw_track_request (cookie.sequence, self);
 
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
+    XW_STORE (&self->min_size, size);
 
-    return (self->min_size = size);
+    return size;
 }
 
 /**
@@ -526,8 +662,9 @@ XwWindowSize xw_window_set_min_size (XwWindow *self, XwWindowSize size) {
  * */
 XwWindowSize xw_window_set_max_size (XwWindow *self, XwWindowSize size) {
     RETURN_VALUE_IF (!self, ((XwWindowSize) {0, 0}), ERR_INVALID_ARGUMENTS);
+    XwWindowSize min_size = XW_LOAD (&self->min_size);
     RETURN_VALUE_IF (
-        size.width < self->min_size.width || size.height < self->min_size.height,
+        size.width < min_size.width || size.height < min_size.height,
         ((XwWindowSize) {0, 0}),
         "Max size bound cannot be less than min size bound of window\n"
     );
@@ -537,16 +674,18 @@ XwWindowSize xw_window_set_max_size (XwWindow *self, XwWindowSize size) {
     xcb_icccm_size_hints_set_max_size (&hints, size.width, size.height);
 
     /* set hints */
-    xcb_icccm_set_wm_size_hints (
+    xcb_void_cookie_t cookie = xcb_icccm_set_wm_size_hints (
         xw_state.connection,
         self->xcb_window_id,
         XCB_ATOM_WM_NORMAL_HINTS,
         &hints
     );
+    xw_track_request (cookie.sequence, self);
 
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
+    XW_STORE (&self->max_size, size);
 
-    return (self->max_size = size);
+    return size;
 }
 
 /**
@@ -560,16 +699,17 @@ XwWindowSize xw_window_set_max_size (XwWindow *self, XwWindowSize size) {
 XwWindowPos xw_window_set_pos (XwWindow *self, XwWindowPos pos) {
     RETURN_VALUE_IF (!self, ((XwWindowPos) {0, 0}), ERR_INVALID_ARGUMENTS);
 
-    self->pos = pos;
+    XW_STORE (&self->pos, pos);
 
-    xcb_configure_window (
+    xcb_void_cookie_t cookie = xcb_configure_window (
         xw_state.connection,
         self->xcb_window_id,
         XCB_CONFIG_WINDOW_X | XCB_CONFIG_WINDOW_Y,
         &pos
     );
+    xw_track_request (cookie.sequence, self);
 
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
 
     return pos;
 }
@@ -608,7 +748,7 @@ XwWindowState xw_window_set_state (XwWindow *self, XwWindowState state) {
     };
 
     /* reset _NET_WM_STATE atom array */
-    xcb_change_property (
+    xcb_void_cookie_t cookie = xcb_change_property (
         xw_state.connection,    /* conn*/
         XCB_PROP_MODE_REPLACE,  /* mode */
         self->xcb_window_id,    /* window */
@@ -618,11 +758,12 @@ XwWindowState xw_window_set_state (XwWindow *self, XwWindowState state) {
         0,                      /* length */
         Null                    /* data */
     );
+    xw_track_request (cookie.sequence, self);
 
     for (Size i = 0; i < ARRAY_SIZE (atoms); i++) {
         /* append to state if mask is set */
         if (state & atoms[i].mask) {
-            xcb_change_property (
+            cookie = xcb_change_property (
                 xw_state.connection,    /* conn*/
                 XCB_PROP_MODE_APPEND,   /* mode */
                 self->xcb_window_id,    /* window */
@@ -632,6 +773,7 @@ XwWindowState xw_window_set_state (XwWindow *self, XwWindowState state) {
                 1,                      /* length */
                 &atoms[i].atom          /* data */
             );
+            xw_track_request (cookie.sequence, self);
         }
 
         /* fill data array */
@@ -648,17 +790,18 @@ XwWindowState xw_window_set_state (XwWindow *self, XwWindowState state) {
             .window        = self->xcb_window_id,
             .data          = data
         };
-        xcb_send_event (
+        cookie = xcb_send_event (
             xw_state.connection,
             False,               /* whether to propagate the event or not */
             self->xcb_window_id, /* destination window */
             XCB_EVENT_MASK_STRUCTURE_NOTIFY,
             (CString)&payload
         );
+        xw_track_request (cookie.sequence, self);
     }
 
-    xcb_flush (xw_state.connection);
-    self->state = state;
+    XW_FLUSH (xw_state.connection);
+    XW_STORE (&self->state, state);
 
     return state;
 }
@@ -699,7 +842,7 @@ XwWindowActionPermissions
     };
 
     /* reset _NET_WM_ALLOWED_ACTIONS atom array */
-    xcb_change_property (
+    xcb_void_cookie_t cookie = xcb_change_property (
         xw_state.connection,              /* conn*/
         XCB_PROP_MODE_REPLACE,            /* mode */
         self->xcb_window_id,              /* window */
@@ -709,11 +852,12 @@ XwWindowActionPermissions
         0,                                /* length */
         Null                              /* data */
     );
+    xw_track_request (cookie.sequence, self);
 
     /* append permissions to permissions array */
     for (Size i = 0; i < ARRAY_SIZE (atoms); i++) {
         if (permissions & atoms[i].mask) {
-            xcb_change_property (
+            cookie = xcb_change_property (
                 xw_state.connection,              /* conn*/
                 XCB_PROP_MODE_APPEND,             /* mode */
                 self->xcb_window_id,              /* window */
@@ -723,10 +867,11 @@ XwWindowActionPermissions
                 1,                                /* length */
                 &atoms[i].atom                    /* data */
             );
+            xw_track_request (cookie.sequence, self);
         }
     }
 
-    xcb_flush (xw_state.connection);
+    XW_FLUSH (xw_state.connection);
 
     return permissions;
 }
@@ -760,7 +905,7 @@ XwWindow *xw_window_set_bordered (XwWindow *self, Bool border) {
         unsigned long status;
     } MWMHints = {(1L << 1), 0, border & 1, 0, 0};
 
-    xcb_change_property (
+    xcb_void_cookie_t cookie = xcb_change_property (
         xw_state.connection,
         XCB_PROP_MODE_REPLACE,
         self->xcb_window_id,
@@ -770,6 +915,7 @@ XwWindow *xw_window_set_bordered (XwWindow *self, Bool border) {
         sizeof (MWMHints) / sizeof (long),
         &MWMHints
     );
+    xw_track_request (cookie.sequence, self);
 
     return self;
 }
@@ -787,11 +933,213 @@ XwWindow *xw_window_set_bordered (XwWindow *self, Bool border) {
  * @return Null otherwise.
  * */
 XwWindow *xw_get_window_by_xcb_id (xcb_window_t xcb_win_id) {
-    for (Size s = 0; s < ARRAY_SIZE (xw_state.windows); s++) {
-        if (xw_state.windows[s] && xw_state.windows[s]->xcb_window_id == xcb_win_id) {
-            return xw_state.windows[s];
+    XwWindowSlots *slots = xw_window_table_slots (&xw_state.windows);
+    if (!slots) {
+        return Null;
+    }
+
+    for (Size s = 0; s < slots->capacity; s++) {
+        XwWindow *win = xw_window_slots_get (slots, s);
+        if (win && win->xcb_window_id == xcb_win_id) {
+            return win;
         }
     }
 
     return Null;
 }
+
+/**
+ * @b Send all requests needed to create and map a window, without flushing them.
+ *
+ * This is where @c xw_window_init and @c xw_window_create_many do their actual work.
+ * Keeping the flush out of here lets @c xw_window_create_many pipeline requests of
+ * all windows and send them to display server in one go.
+ *
+ * @param self
+ * @param title Can be @c Null.
+ * @param width Cannot be 0.
+ * @param height Cannot be 0.
+ * @param xpos
+ * @param ypos
+ *
+ * @return @c self on success.
+ * @return Null otherwise.
+ * */
+static XwWindow *xw_window_send_create_requests (
+    XwWindow *self,
+    CString   title,
+    Uint32    width,
+    Uint32    height,
+    Uint32    xpos,
+    Uint32    ypos
+) {
+    RETURN_VALUE_IF (!self || !width || !height, Null, ERR_INVALID_ARGUMENTS);
+
+    xcb_connection_t *conn   = xw_state.connection;
+    xcb_screen_t     *screen = xw_state.screen_iterator.data;
+    RETURN_VALUE_IF (!conn || !screen, Null, ERR_XW_STATE_NOT_INITIALIZED);
+
+    /* create platform data */
+    self->xcb_window_id = -1;
+    self->xw_id         = SIZE_MAX;
+    RETURN_VALUE_IF (XW_MUTEX_INIT (&self->lock), Null, "Failed to create window lock\n");
+
+    /* generate id for new window. */
+    xcb_window_t win_id = xcb_generate_id (conn);
+    RETURN_VALUE_IF (
+        win_id == (xcb_window_t)-1, /* -1 is returned on failure */
+        Null,
+        "Failed to generate new window ID\n"
+    );
+
+    self->xcb_window_id = win_id;
+    self->border_width  = 0;
+    self->min_size      = (XwWindowSize) {0, 0};
+    self->max_size      = (XwWindowSize) {screen->width_in_pixels, screen->height_in_pixels};
+    self->size.width    = CLAMP (width, 0, self->max_size.width);
+    self->size.height   = CLAMP (height, 0, self->max_size.height);
+    self->pos.x         = xpos;
+    self->pos.y         = ypos;
+    self->title         = Null;
+    self->icon_path     = Null;
+
+    Uint32 win_mask     = XCB_CW_EVENT_MASK;
+    Uint32 win_values[] = {
+        XW_WINDOW_EVENT_MASK |
+        (XW_LOAD (&xw_state.motion_hints) ? XCB_EVENT_MASK_POINTER_MOTION_HINT : 0)
+    };
+
+    /* create window corresponding to window id */
+    xcb_void_cookie_t cookie = xcb_create_window (
+        conn,                          /* connection */
+        XCB_COPY_FROM_PARENT,          /* depth: Copy depth info from parent */
+        win_id,                        /* wid: id of window object to be created */
+        screen->root,                  /* parent: parent window of this window */
+        self->pos.x,                   /* x */
+        self->pos.y,                   /* y */
+        self->size.width,              /* width */
+        self->size.height,             /* height */
+        self->border_width,            /* border width */
+        XCB_WINDOW_CLASS_INPUT_OUTPUT, /* window class */
+        screen->root_visual,           /* visual data */
+        win_mask,                      /* value mask */
+        win_values                     /* value mask array */
+    );
+    xw_track_request (cookie.sequence, self);
+
+    /* create new atom to help us detect close window event messages */
+    cookie = xcb_change_property (
+        conn,                      /* xcb connection */
+        XCB_PROP_MODE_REPLACE,     /* replace the property with new value */
+        self->xcb_window_id,       /* xcb id of window object */
+        xw_state.WM_PROTOCOLS,     /* change something in protocl */
+        XCB_ATOM_ATOM,             /* change an atom */
+        32,                        /* process data in chunks of 32 bits */
+        1,                         /* length of data */
+        &xw_state.WM_DELETE_WINDOW /* data */
+    );
+    xw_track_request (cookie.sequence, self);
+
+    if (title) {
+        self->title = XW_STRDUP (XW_ALLOC_CATEGORY_TITLE, title);
+        RETURN_VALUE_IF (!self->title, Null, ERR_OUT_OF_MEMORY);
+        xw_window_send_title (self);
+    }
+
+    /* register this window to global state. */
+    self->xw_id = xw_window_table_insert (&xw_state.windows, self);
+    RETURN_VALUE_IF (self->xw_id == SIZE_MAX, Null, "Failed to register window\n");
+
+    cookie = xcb_map_window (conn, win_id);
+    xw_track_request (cookie.sequence, self);
+
+    return self;
+}
+
+/**
+ * @b Send request to change window title to @c self->title, without flushing it.
+ *
+ * @param self
+ * */
+static void xw_window_send_title (XwWindow *self) {
+    xcb_void_cookie_t cookie = xcb_change_property (
+        xw_state.connection,   /* xcb connection */
+        XCB_PROP_MODE_REPLACE, /* replace the property with new value */
+        self->xcb_window_id,   /* id of object */
+        XCB_ATOM_WM_NAME,      /* property is window name */
+        XCB_ATOM_STRING,       /* atom type is string */
+        8,                     /* process data in chunks of 8 bits */
+        strlen (self->title),  /* length of data */
+        self->title            /* data */
+    );
+    xw_track_request (cookie.sequence, self);
+}
+
+/**
+ * @b Check whether display server supports RandR 1.3, needed to get screen resources
+ *    without probing monitors again.
+ *
+ * Protocol requires version to be queried before extension is used, which takes a
+ * round trip, so this is done only once.
+ *
+ * @return True if it does.
+ * @return False otherwise.
+ * */
+static Bool xw_randr_is_available (void) {
+    if (xw_state.randr_checked) {
+        return xw_state.randr_available;
+    }
+
+    xcb_connection_t *conn = xw_state.connection;
+    RETURN_VALUE_IF (!conn, False, ERR_XW_STATE_NOT_INITIALIZED);
+
+    xw_state.randr_checked   = True;
+    xw_state.randr_available = False;
+
+    const xcb_query_extension_reply_t *ext = XW_ROUND_TRIP (
+        "xcb_get_extension_data:RandR",
+        xcb_get_extension_data (conn, &xcb_randr_id)
+    );
+    if (!ext || !ext->present) {
+        return False;
+    }
+
+    xcb_randr_query_version_cookie_t cookie = xcb_randr_query_version (conn, 1, 3);
+    xcb_randr_query_version_reply_t *reply  = XW_ROUND_TRIP (
+        "xcb_randr_query_version_reply",
+        xcb_randr_query_version_reply (conn, cookie, Null)
+    );
+    if (!reply) {
+        return False;
+    }
+
+    xw_state.randr_available = reply->major_version > 1 ||
+                               (reply->major_version == 1 && reply->minor_version >= 3);
+    FREE (reply);
+
+    return xw_state.randr_available;
+}
+
+/**
+ * @b Compute vertical refresh rate of a display mode from it's timings.
+ *
+ * @param mode
+ *
+ * @return Refresh rate in Hz, 0 if mode has no timings.
+ * */
+static Float64 xw_randr_mode_refresh_rate (const xcb_randr_mode_info_t *mode) {
+    Float64 vtotal = mode->vtotal;
+
+    /* each line is scanned twice, or every other line once per field */
+    if (mode->mode_flags & XCB_RANDR_MODE_FLAG_DOUBLE_SCAN) {
+        vtotal *= 2;
+    }
+    if (mode->mode_flags & XCB_RANDR_MODE_FLAG_INTERLACE) {
+        vtotal /= 2;
+    }
+
+    if (!mode->htotal || !vtotal) {
+        return 0;
+    }
+    return mode->dot_clock / (mode->htotal * vtotal);
+}
@@ -33,9 +33,25 @@
 #ifndef CROSSWINDOW_PRIVATE_WINDOW_H
 #define CROSSWINDOW_PRIVATE_WINDOW_H
 
+#include <Anvie/CrossWindow/Framebuffer.h>
 #include <Anvie/CrossWindow/Window.h>
+
+/* local headers */
+#include "Common/EventQueue.h"
+#include "Common/Lock.h"
+
+#include <xcb/shm.h>
 #include <xcb/xcb.h>
 
+/** @b Events selected on every window. Motion hint mode adds pointer motion hint to these. */
+#define XW_WINDOW_EVENT_MASK                                                                       \
+    (XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE |             \
+     XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_ENTER_WINDOW |   \
+     XCB_EVENT_MASK_LEAVE_WINDOW | XCB_EVENT_MASK_FOCUS_CHANGE |                                   \
+     XCB_EVENT_MASK_VISIBILITY_CHANGE | XCB_EVENT_MASK_STRUCTURE_NOTIFY |                          \
+     XCB_EVENT_MASK_PROPERTY_CHANGE | XCB_EVENT_MASK_POINTER_MOTION |                              \
+     XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY)
+
 typedef struct XwWindow {
     /* platform specific data */
     xcb_window_t  xcb_window_id;
@@ -52,11 +68,55 @@ typedef struct XwWindow {
 
     CString title;
     CString icon_path;
+    XwMutex lock; /**< @b Guards @c title and @c icon_path, these are freed when replaced. */
 
     XwWindowState state; /* bitmask of current window state. */
 
+    Bool mapped;      /**< @b Window is mapped, as last told by display server. */
+    Bool obscured;    /**< @b Window is mapped but fully covered by other windows. */
+    Bool presentable; /**< @b Mapped, not hidden and not obscured. Changed with event lock held. */
+
     Uint32 last_cursor_pos_x;
     Uint32 last_cursor_pos_y;
+
+    /* in motion hint mode, display server sends a single hint after pointer moves, and nothing
+     * more till pointer is queried. These are changed with event lock held. */
+    Bool   motion_hinted;   /**< @b A hint arrived, pointer is to be queried. */
+    Uint32 motion_query;    /**< @b Sequence of pointer query in flight, 0 if none. */
+    Uint64 motion_query_ns; /**< @b When pointer was last queried. */
+
+    /** @b Sequence of _NET_WM_STATE property request in flight, 0 if none. Property is read
+     * without waiting, and changed with event lock held. */
+    Uint32 state_query;
+
+    Bool   frame_events_enabled; /**< @b Present complete and idle events are selected. */
+    Uint32 present_serial;       /**< @b Serial of last frame presented using Present extension. */
+
+    /* software framebuffer, created on first call to xw_window_get_framebuffer */
+    struct {
+        XwFramebuffer  info;
+        Uint8         *data;    /**< @b Shared memory, or heap memory if shm is not available. */
+        xcb_shm_seg_t  shm_seg; /**< @b Shared memory segment, 0 if not using shared memory. */
+        xcb_gcontext_t gc;
+        Uint8          depth;
+
+        /** @b Reply to request sent after last present. Until it arrives, server may still
+         * be reading from shared memory. */
+        xcb_get_input_focus_cookie_t fence;
+        Bool                         fence_pending;
+    } framebuffer;
+
+    /**
+     * @b Events of this window are routed here instead of being returned by @c xw_event_poll.
+     *    Set by @c xw_window_enable_event_queue, Null otherwise.
+     * */
+    XwEventQueue *queue;
+
+    /* only for windows created with xw_window_create_many */
+    struct XwWindow *batch;      /**< @b First window of the block this window is allocated in. */
+    Size             batch_refs; /**< @b Windows still alive in block. Used only in first window. */
 } XwWindow;
 
+void xw_window_release_framebuffer (XwWindow *self);
+
 #endif // CROSSWINDOW_PRIVATE_WINDOW_H
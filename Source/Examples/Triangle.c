@@ -2,6 +2,7 @@
 
 /* crosswindow */
 #include <Anvie/CrossWindow/Event.h>
+#include <Anvie/CrossWindow/FramePacer.h>
 #include <Anvie/CrossWindow/Vulkan.h>
 #include <Anvie/CrossWindow/Window.h>
 
@@ -38,22 +39,12 @@ typedef struct Surface {
 
     VkSurfaceKHR surface;            /**< @b Surface created for corrsponding XwWindow. */
 
-    VkSwapchainKHR swapchain;        /**< @b Swapchain created for the window. */
-    VkExtent2D     swapchain_image_extent; /**< @b Current swapchain image extent */
-    VkFormat swapchain_image_format;    /**< @b Format of image stored during swapchain creation. */
-    Uint32   swapchain_image_count;     /**< @b Number of images in swapchain. */
-    VkImage *swapchain_images;          /**< @b Handle to images inside swapchain. */
-    VkImageView *swapchain_image_views; /**< @b Image views created for images in swapchain. */
+    XwVkSurfaceInfo   *surface_info;   /**< @b Formats and present modes supported by surface. */
+    VkSurfaceFormatKHR surface_format; /**< @b Format of swapchain images. */
+    XwVkSwapchain     *swapchain;      /**< @b Swapchain, it's image views and framebuffers. */
+    XwVkFrameRing     *frames;         /**< @b Command buffers and sync objects of each frame. */
 
-    VkCommandPool   cmd_pool;
-    VkCommandBuffer cmd_buffer;
-
-    VkRenderPass   render_pass;
-    VkFramebuffer *framebuffers;
-
-    VkSemaphore render_semaphore;
-    VkSemaphore present_semaphore;
-    VkFence     render_fence;
+    VkRenderPass render_pass;
 
     VkPipeline       pipeline;
     VkPipelineLayout pipeline_layout;
@@ -63,8 +54,6 @@ Surface *surface_create (Vulkan *vk, XwWindow *xw_win);
 Surface *surface_init (Surface *surf, Vulkan *vk, XwWindow *xw_win);
 Surface *surface_deinit (Surface *surf, Vulkan *vk);
 void     surface_destroy (Surface *surf, Vulkan *vk);
-Surface *surface_recreate_swapchain (Surface *surf, XwWindow *win);
-Surface *surface_wait_for_pending_operations (Surface *surface);
 
 /**************************************************************************************************/
 /********************************************** Math **********************************************/
@@ -142,93 +131,35 @@ int main() {
         sizeof (triangle_vertices)
     );
 
+    /* paced to refresh rate of monitor, sleeping in between instead of spinning on events */
+    XwFramePacer *pacer = xw_frame_pacer_create (win, 0);
+    GOTO_HANDLER_IF (!pacer, PACER_FAILED, "Failed to create frame pacer\n");
+
     /* event handlign looop */
     Bool    is_running = True;
     XwEvent e;
     Uint64  framenum = 0;
     while (is_running) {
-        Bool resized = False;
-        while (xw_event_poll (&e)) {
-            switch (e.type) {
-                case XW_EVENT_TYPE_CLOSE_WINDOW : {
-                    is_running = False;
-                    break;
-                }
-                case XW_EVENT_TYPE_RESIZE : {
-                    resized = True;
-                    break;
-                }
-                default :
-                    break;
+        while (xw_frame_pacer_wait (pacer, &e)) {
+            if (e.type == XW_EVENT_TYPE_CLOSE_WINDOW) {
+                is_running = False;
             }
-        }
 
-        VkFence fences[] = {surface->render_fence};
-
-        /* wait for all gpu rendering to complete */
-        VkResult res = vkWaitForFences (surface->device, ARRAY_SIZE (fences), fences, True, 1e9);
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Timeout (1s) while waiting for fences. RET = %d\n",
-            res
-        );
+            /* swapchain is recreated at-most once in next acquire, no matter how many resizes */
+            xw_vk_swapchain_handle_event (surface->swapchain, &e);
+        }
 
-        /* get next image index */
-        Uint32 next_image_index = -1;
+        /* waits only if GPU is a whole ring of frames behind */
+        XwVkFrame *frame = Null;
+        VkResult   res   = xw_vk_frame_begin (surface->frames, &frame);
 
-        res = vkAcquireNextImageKHR (
-            surface->device,
-            surface->swapchain,
-            1e9,
-            surface->present_semaphore,
-            Null,
-            &next_image_index
-        );
-        if (resized || res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR) {
-            GOTO_HANDLER_IF (
-                !surface_recreate_swapchain (surface, win),
-                DRAW_ERROR,
-                "Failed to recreate swapchain\n"
-            );
+        /* window is minimized, or swapchain needs another recreate. skip this frame. */
+        if (res == VK_NOT_READY || res == VK_ERROR_OUT_OF_DATE_KHR) {
             continue;
-            res = VK_SUCCESS; /* to pass upcoming check */
         }
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Failed to get next image index from swapchain. RET = %d\n",
-            res
-        );
-
-        /* need to reset fence before we use it again */
-        res = vkResetFences (surface->device, ARRAY_SIZE (fences), fences);
-        GOTO_HANDLER_IF (res != VK_SUCCESS, DRAW_ERROR, "Failed to reset fences. RET = %d\n", res);
+        GOTO_HANDLER_IF (res != VK_SUCCESS, DRAW_ERROR, "Failed to begin frame. RET = %d\n", res);
 
-        /* reset command buffer and record draw commands again */
-        res = vkResetCommandBuffer (surface->cmd_buffer, 0);
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Failed to reset command buffer for recording new commands. RET = %d\n",
-            res
-        );
-
-        VkCommandBuffer          cmd            = surface->cmd_buffer;
-        VkCommandBufferBeginInfo cmd_begin_info = {
-            .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
-            .pNext            = Null,
-            .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
-            .pInheritanceInfo = Null
-        };
-
-        res = vkBeginCommandBuffer (cmd, &cmd_begin_info);
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Failed to begin command buffer recording. RET = %d\n",
-            res
-        );
+        VkCommandBuffer cmd = frame->cmd_buffer;
 
         VkClearValue clear_value = {
             .color =
@@ -242,79 +173,49 @@ int main() {
             .sType       = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
             .pNext       = Null,
             .renderPass  = surface->render_pass,
-            .renderArea  = {.offset = {.x = 0, .y = 0}, .extent = surface->swapchain_image_extent},
-            .framebuffer = surface->framebuffers[next_image_index],
+            .renderArea  = {.offset = {.x = 0, .y = 0}, .extent = surface->swapchain->extent},
+            .framebuffer = surface->swapchain->framebuffers[frame->image_index],
             .clearValueCount = 1,
             .pClearValues    = &clear_value
         };
 
         vkCmdBeginRenderPass (cmd, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
         vkCmdBindPipeline (cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, surface->pipeline);
+
+        /* viewport and scissor are dynamic, so pipeline is not rebuilt on resize */
+        VkExtent2D extent   = surface->swapchain->extent;
+        VkViewport viewport = {0, 0, extent.width, extent.height, 0.f, 1.f};
+        VkRect2D   scissor  = {.offset = {0, 0}, .extent = extent};
+        vkCmdSetViewport (cmd, 0, 1, &viewport);
+        vkCmdSetScissor (cmd, 0, 1, &scissor);
+
         Size offset = 0;
         vkCmdBindVertexBuffers (cmd, 0, 1, &vbo.buffer, &offset);
         vkCmdDraw (cmd, 3, 1, 0, 0);
         vkCmdEndRenderPass (cmd);
 
-        res = vkEndCommandBuffer (cmd);
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Failed to end command buffer recording. RET = %d\n",
-            res
-        );
-
-        /* wait when rendered image is being presented */
-        VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
-        VkSubmitInfo submit_info = {
-            .sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-            .pNext                = Null,
-            .waitSemaphoreCount   = 1,
-            .pWaitSemaphores      = &surface->present_semaphore,
-            .pWaitDstStageMask    = &wait_stage,
-            .signalSemaphoreCount = 1,
-            .pSignalSemaphores    = &surface->render_semaphore,
-            .commandBufferCount   = 1,
-            .pCommandBuffers      = &cmd
-        };
-
-        res = vkQueueSubmit (surface->graphics_queue, 1, &submit_info, surface->render_fence);
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Failed to submit command buffers for execution. RET = %d\n",
-            res
-        );
-
-        VkPresentInfoKHR present_info = {
-            .sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-            .pNext              = Null,
-            .swapchainCount     = 1,
-            .pSwapchains        = &surface->swapchain,
-            .waitSemaphoreCount = 1,
-            .pWaitSemaphores    = &surface->render_semaphore,
-            .pImageIndices      = &next_image_index
-        };
-
-        res = vkQueuePresentKHR (surface->graphics_queue, &present_info);
-        if (res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR) {
-            GOTO_HANDLER_IF (
-                !surface_recreate_swapchain (surface, win),
-                DRAW_ERROR,
-                "Failed to recreate swapchain\n"
-            );
-            res = VK_SUCCESS; /* so that next check does not fail */
-        }
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            DRAW_ERROR,
-            "Failed to present rendered images to surface. RET = %d\n",
-            res
-        );
+        /* submits and presents, out of date swapchain is recreated in next begin */
+        res = xw_vk_frame_end (surface->frames, frame);
+        GOTO_HANDLER_IF (res != VK_SUCCESS, DRAW_ERROR, "Failed to end frame. RET = %d\n", res);
 
         framenum++;
     }
 
+    /* last frames may still be in flight */
+    vkDeviceWaitIdle (surface->device);
+
+    XwFramePacerStats stats;
+    xw_frame_pacer_get_stats (pacer, &stats);
+    printf (
+        "%llu frames at %.1f Hz, %llu missed, jitter %.1f us (max %.1f us)\n",
+        (unsigned long long)stats.frames,
+        xw_frame_pacer_get_rate (pacer),
+        (unsigned long long)stats.missed,
+        stats.jitter_ns / 1e3,
+        stats.max_jitter_ns / 1e3
+    );
+    xw_frame_pacer_destroy (pacer);
+
     buffer_object_destroy (vbo, surface->device);
     surface_destroy (surface, vk);
     vk_destroy (vk);
@@ -323,6 +224,8 @@ int main() {
     return EXIT_SUCCESS;
 
 DRAW_ERROR:
+    xw_frame_pacer_destroy (pacer);
+PACER_FAILED:
     surface_destroy (surface, vk);
 SURFACE_FAILED:
     vk_destroy (vk);
@@ -344,13 +247,10 @@ static inline Surface *surface_create_surface (Surface *surface, Vulkan *vk, XwW
 static inline Surface *surface_select_gpu (Surface *surface, Vulkan *vk);
 static inline Surface *surface_fetch_queue_family_indices (Surface *surface);
 static inline Surface *surface_create_logical_device (Surface *surface);
+static inline Surface *surface_select_surface_format (Surface *surface, XwWindow *win);
 static inline Surface *surface_create_swapchain (Surface *surface, XwWindow *win);
-static inline Surface *surface_fetch_swapchain_images (Surface *surface);
-static inline Surface *surface_create_swapchain_image_views (Surface *surface);
-static inline Surface *surface_create_command_objects (Surface *surface);
 static inline Surface *surface_create_renderpass (Surface *surface);
-static inline Surface *surface_create_framebuffers (Surface *surface);
-static inline Surface *surface_create_sync_objects (Surface *surface);
+static inline Surface *surface_create_frame_ring (Surface *surface);
 static inline Surface *surface_create_pipeline_layout (Surface *surface);
 static inline Surface *surface_create_pipeline (Surface *surface);
 
@@ -490,11 +390,9 @@ Surface *surface_init (Surface *surface, Vulkan *vk, XwWindow *win) {
     GOTO_HANDLER_IF (
         !surface_create_surface (surface, vk, win) || !surface_select_gpu (surface, vk) ||
             !surface_fetch_queue_family_indices (surface) ||
-            !surface_create_logical_device (surface) || !surface_create_swapchain (surface, win) ||
-            !surface_fetch_swapchain_images (surface) ||
-            !surface_create_swapchain_image_views (surface) ||
-            !surface_create_command_objects (surface) || !surface_create_renderpass (surface) ||
-            !surface_create_framebuffers (surface) || !surface_create_sync_objects (surface) ||
+            !surface_create_logical_device (surface) ||
+            !surface_select_surface_format (surface, win) || !surface_create_renderpass (surface) ||
+            !surface_create_swapchain (surface, win) || !surface_create_frame_ring (surface) ||
             !surface_create_pipeline_layout (surface) || !surface_create_pipeline (surface),
         INIT_FAILED,
         "Failed to initialize Surface object\n"
@@ -530,45 +428,26 @@ Surface *surface_deinit (Surface *surface, Vulkan *vk) {
             vkDestroyPipeline (surface->device, surface->pipeline, Null);
         }
 
-        if (surface->render_semaphore) {
-            vkDestroySemaphore (surface->device, surface->render_semaphore, Null);
+        if (surface->frames) {
+            xw_vk_frame_ring_destroy (surface->frames);
+            surface->frames = Null;
         }
-        if (surface->present_semaphore) {
-            vkDestroySemaphore (surface->device, surface->present_semaphore, Null);
-        }
-        if (surface->render_fence) {
-            vkDestroyFence (surface->device, surface->render_fence, Null);
+
+        /* framebuffers are destroyed along with swapchain */
+        if (surface->swapchain) {
+            xw_vk_swapchain_destroy (surface->swapchain);
+            surface->swapchain = Null;
         }
 
-        if (surface->framebuffers) {
-            for (Size s = 0; s < surface->swapchain_image_count; s++) {
-                if (surface->framebuffers[s]) {
-                    vkDestroyFramebuffer (surface->device, surface->framebuffers[s], Null);
-                }
-            }
+        if (surface->surface_info) {
+            xw_vk_surface_info_destroy (surface->surface_info);
+            surface->surface_info = Null;
         }
 
         if (surface->render_pass) {
             vkDestroyRenderPass (surface->device, surface->render_pass, Null);
         }
 
-        if (surface->cmd_pool) {
-            vkDestroyCommandPool (surface->device, surface->cmd_pool, Null);
-        }
-
-        if (surface->swapchain_image_views) {
-            for (Size s = 0; s < surface->swapchain_image_count; s++) {
-                if (surface->swapchain_image_views[s]) {
-                    vkDestroyImageView (surface->device, surface->swapchain_image_views[s], Null);
-                    surface->swapchain_image_views[s] = VK_NULL_HANDLE;
-                }
-            }
-        }
-
-        if (surface->swapchain) {
-            vkDestroySwapchainKHR (surface->device, surface->swapchain, Null);
-        }
-
         vkDestroyDevice (surface->device, Null);
     }
 
@@ -576,22 +455,6 @@ Surface *surface_deinit (Surface *surface, Vulkan *vk) {
         vkDestroySurfaceKHR (vk->instance, surface->surface, Null);
     }
 
-    /* all memory deallocations out of if statements, having their own checks */
-    if (surface->framebuffers) {
-        FREE (surface->framebuffers);
-        surface->framebuffers = Null;
-    }
-
-    if (surface->swapchain_image_views) {
-        FREE (surface->swapchain_image_views);
-        surface->swapchain_image_views = Null;
-    }
-
-    if (surface->swapchain_images) {
-        FREE (surface->swapchain_images);
-        surface->swapchain_images = Null;
-    }
-
     return surface;
 }
 
@@ -608,75 +471,6 @@ void surface_destroy (Surface *surf, Vulkan *vk) {
     FREE (surf);
 }
 
-/**
- * @b Recreate swapchain for this surface, by using old swapchain.
- *
- * @param surface 
- *
- * @return @c surface on success.
- * @return @c Null otherwise.
- * */
-Surface *surface_recreate_swapchain (Surface *surface, XwWindow *win) {
-    RETURN_VALUE_IF (!surface || !win, Null, ERR_INVALID_ARGUMENTS);
-
-    RETURN_VALUE_IF (
-        !surface->swapchain_image_views || !surface->framebuffers,
-        Null,
-        "Swapchain recreate called but, previous images/views/framebuffers are invalid\n"
-    );
-
-    surface_wait_for_pending_operations (surface);
-
-    vkDestroySemaphore (surface->device, surface->present_semaphore, Null);
-    vkDestroySemaphore (surface->device, surface->render_semaphore, Null);
-    vkDestroyFence (surface->device, surface->render_fence, Null);
-
-    vkDestroyCommandPool (surface->device, surface->cmd_pool, Null);
-
-    /* destroy image views and framebuffers because they need to be recreated */
-    for (Size s = 0; s < surface->swapchain_image_count; s++) {
-        vkDestroyImageView (surface->device, surface->swapchain_image_views[s], Null);
-        vkDestroyFramebuffer (surface->device, surface->framebuffers[s], Null);
-
-        surface->swapchain_image_views[s] = VK_NULL_HANDLE;
-        surface->framebuffers[s]          = VK_NULL_HANDLE;
-    }
-
-    /* store handle of old swapchain */
-    VkSwapchainKHR old_swapchain = surface->swapchain;
-
-    /* create new swapchain */
-    RETURN_VALUE_IF (
-        !surface_create_swapchain (surface, win) || !surface_fetch_swapchain_images (surface) ||
-            !surface_create_swapchain_image_views (surface) ||
-            !surface_create_framebuffers (surface) || !surface_create_sync_objects (surface) ||
-            !surface_create_command_objects (surface),
-        Null,
-        "Failed to recreate swapchain\n"
-    );
-
-    /* destroy old swapchain after recreation */
-    vkDestroySwapchainKHR (surface->device, old_swapchain, Null);
-
-    return surface;
-}
-
-/**
- * @b Wait for all pending operations related to provided surface to end.
- *
- * @param surface 
- * 
- * @return @c surface on Success.
- * @return @c Null otherwise.
- * */
-Surface *surface_wait_for_pending_operations (Surface *surface) {
-    RETURN_VALUE_IF (!surface, Null, ERR_INVALID_ARGUMENTS);
-
-    vkDeviceWaitIdle (surface->device);
-
-    return surface;
-}
-
 /**************************************************************************************************/
 /********************************** BUFFER OBJECT PUBLIC METHODS **********************************/
 /**************************************************************************************************/
@@ -1014,297 +808,64 @@ static inline Surface *surface_create_logical_device (Surface *surface) {
     return surface;
 }
 
-static inline Surface *surface_create_swapchain (Surface *surface, XwWindow *win) {
-    RETURN_VALUE_IF (!surface || !win, VK_NULL_HANDLE, ERR_INVALID_ARGUMENTS);
-
-    /* get surface capabilities */
-    VkSurfaceCapabilitiesKHR capabilities;
-    vkGetPhysicalDeviceSurfaceCapabilitiesKHR (
-        surface->selected_gpu,
-        surface->surface,
-        &capabilities
-    );
-
-    VkExtent2D image_extent;
-    if (capabilities.currentExtent.width == UINT32_MAX) {
-        XwWindowSize win_size = xw_window_get_size (win);
-        image_extent          = (VkExtent2D) {.width = win_size.width, .height = win_size.height};
-    } else {
-        image_extent = (VkExtent2D
-        ) {.width = CLAMP (
-               capabilities.currentExtent.width,
-               capabilities.minImageExtent.width,
-               capabilities.maxImageExtent.width
-           ),
-           .height = CLAMP (
-               capabilities.currentExtent.height,
-               capabilities.minImageExtent.height,
-               capabilities.maxImageExtent.height
-           )};
-    }
-
-    /* get number of available present modes */
-    Uint32   present_mode_count = 0;
-    VkResult res                = vkGetPhysicalDeviceSurfacePresentModesKHR (
-        surface->selected_gpu,
-        surface->surface,
-        &present_mode_count,
-        Null
-    );
-    RETURN_VALUE_IF (
-        res != VK_SUCCESS,
-        Null,
-        "Failed to get number of present modes. RET = %d\n",
-        res
-    );
-
-    /* get list of present modes */
-    VkPresentModeKHR present_modes[present_mode_count];
-    res = vkGetPhysicalDeviceSurfacePresentModesKHR (
-        surface->selected_gpu,
-        surface->surface,
-        &present_mode_count,
-        present_modes
-    );
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to get present modes. RET = %d\n", res);
-
-    /* select the best present mode out of all available. */
-    VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
-    for (Size s = 0; s < present_mode_count; s++) {
-        if (present_modes[s] == VK_PRESENT_MODE_MAILBOX_KHR) {
-            present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
-        }
-    }
-
-    /* get number of available surface formats */
-    Uint32 surface_format_count = 0;
-    res                         = vkGetPhysicalDeviceSurfaceFormatsKHR (
-        surface->selected_gpu,
-        surface->surface,
-        &surface_format_count,
-        Null
-    );
-    RETURN_VALUE_IF (
-        res != VK_SUCCESS,
-        Null,
-        "Failed to get number of surface formats. RET = %d\n",
-        res
-    );
-
-    /* get list of surface formats */
-    VkSurfaceFormatKHR surface_formats[surface_format_count];
-    res = vkGetPhysicalDeviceSurfaceFormatsKHR (
-        surface->selected_gpu,
-        surface->surface,
-        &surface_format_count,
-        surface_formats
-    );
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to get surface formats. RET = %d\n", res);
-
-    /* the first format is the best format for now */
-    VkSurfaceFormatKHR surface_format = surface_formats[0];
-
-    /* only graphics family will be using our images */
-    const Uint32 queue_family_indices[] = {surface->graphics_family_index};
-
-    VkSwapchainCreateInfoKHR swapchain_create_info = {
-        .sType         = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
-        .pNext         = Null,
-        .flags         = 0,
-        .surface       = surface->surface,
-        .minImageCount = CLAMP (
-            capabilities.minImageCount,
-            capabilities.minImageCount + 1,
-            capabilities.maxImageCount ? capabilities.maxImageCount : capabilities.minImageCount + 1
-        ),
-        .imageFormat           = surface_format.format,
-        .imageColorSpace       = surface_format.colorSpace,
-        .imageExtent           = image_extent,
-        .imageArrayLayers      = 1,
-        .imageUsage            = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
-        .imageSharingMode      = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = ARRAY_SIZE (queue_family_indices),
-        .pQueueFamilyIndices   = queue_family_indices,
-        .preTransform   = capabilities.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR,
-        .compositeAlpha = capabilities.supportedCompositeAlpha & VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
-        .presentMode    = present_mode,
-        .clipped        = VK_TRUE,
-        .oldSwapchain   = surface->swapchain /* use old swapchain, will be destroyed after this */
-    };
-
-    res = vkCreateSwapchainKHR (surface->device, &swapchain_create_info, Null, &surface->swapchain);
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to create Vulkan swapchain. RET = %d\n", res);
-
-    /* store required data in surface after swapchin creation */
-    surface->swapchain_image_format = surface_format.format;
-    surface->swapchain_image_extent = image_extent;
-
-    return surface;
-}
-
 /**
- * @b Get images from swapchain and store them in Surface object.
+ * @b Select format of swapchain images. This is needed before creating swapchain, because
+ *    render pass is created using this format and swapchain framebuffers need the render pass.
  *
- * @param surface @c Surface which contains the valid swapchain.
+ * @param surface
+ * @param win Window this surface is created for.
  *
- * @return @c surf on success.
+ * @return @c surface on success.
  * @return @c Null otherwise.
  * */
-static inline Surface *surface_fetch_swapchain_images (Surface *surface) {
-    RETURN_VALUE_IF (!surface, Null, ERR_INVALID_ARGUMENTS);
+static inline Surface *surface_select_surface_format (Surface *surface, XwWindow *win) {
+    RETURN_VALUE_IF (!surface || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    /* get number of swapchain images */
-    surface->swapchain_image_count = 0;
-    VkResult res                   = vkGetSwapchainImagesKHR (
-        surface->device,
-        surface->swapchain,
-        &surface->swapchain_image_count,
-        Null
-    );
+    /* shared with swapchain, so surface formats are queried only once */
+    surface->surface_info =
+        xw_vk_surface_info_create (surface->selected_gpu, surface->surface, win);
+    RETURN_VALUE_IF (!surface->surface_info, Null, "Failed to create surface info\n");
+
+    VkSurfaceFormatKHR preferred = {VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+    surface->surface_format      = xw_vk_choose_surface_format (surface->surface_info, preferred);
     RETURN_VALUE_IF (
-        res != VK_SUCCESS,
+        surface->surface_format.format == VK_FORMAT_UNDEFINED,
         Null,
-        "Failed to get number of swapchain images. RET = %d\n",
-        res
-    );
-
-    /* create space for images */
-    surface->swapchain_images =
-        REALLOCATE (surface->swapchain_images, VkImage, surface->swapchain_image_count);
-    RETURN_VALUE_IF (!surface->swapchain_images, Null, ERR_OUT_OF_MEMORY);
-
-    /* get swapchain image handles s */
-    res = vkGetSwapchainImagesKHR (
-        surface->device,
-        surface->swapchain,
-        &surface->swapchain_image_count,
-        surface->swapchain_images
-    );
-    GOTO_HANDLER_IF (
-        res != VK_SUCCESS,
-        IMAGE_GET_FAILED,
-        "Failed to get all swapchain image handles. RET = %d\n",
-        res
+        "Failed to select surface format\n"
     );
 
     return surface;
-
-IMAGE_GET_FAILED:
-    FREE (surface->swapchain_images);
-    return Null;
 }
 
 /**
- * @b Create color attachments (image views) for swapchain images.
- *
- * @param surface
- * 
- * @return @c surface on success.
- * @return @c Null otherwise.
- * */
-static inline Surface *surface_create_swapchain_image_views (Surface *surface) {
-    RETURN_VALUE_IF (!surface, Null, ERR_INVALID_ARGUMENTS);
-
-    /* Create space to store image views in surface object.
-     * Reallocate will reuse the memory if it's already allocated */
-    surface->swapchain_image_views =
-        REALLOCATE (surface->swapchain_image_views, VkImageView, surface->swapchain_image_count);
-    RETURN_VALUE_IF (!surface->swapchain_image_views, Null, ERR_OUT_OF_MEMORY);
-
-    /* template for creating image views */
-    VkImageViewCreateInfo image_view_create_info = {
-        .sType    = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-        .pNext    = Null,
-        .flags    = 0,
-        .image    = VK_NULL_HANDLE,
-        .viewType = VK_IMAGE_VIEW_TYPE_2D,
-        .format   = surface->swapchain_image_format,
-        .components =
-            {.r = VK_COMPONENT_SWIZZLE_IDENTITY,
-                         .g = VK_COMPONENT_SWIZZLE_IDENTITY,
-                         .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-                         .a = VK_COMPONENT_SWIZZLE_IDENTITY},
-        .subresourceRange =
-            {.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-                         .layerCount     = 1,
-                         .baseArrayLayer = 0,
-                         .levelCount     = 1,
-                         .baseMipLevel   = 0}
-    };
-
-    /* create image view handles corresponding to each image in swapchain */
-    for (Size s = 0; s < surface->swapchain_image_count; s++) {
-        image_view_create_info.image = surface->swapchain_images[s];
-        VkResult res                 = vkCreateImageView (
-            surface->device,
-            &image_view_create_info,
-            Null,
-            &surface->swapchain_image_views[s]
-        );
-        GOTO_HANDLER_IF (
-            res != VK_SUCCESS,
-            IMAGE_VIEW_CREATE_FAILED,
-            "Failed to create Image view. RET = %d\n",
-            res
-        );
-    }
-
-    return surface;
-
-IMAGE_VIEW_CREATE_FAILED:
-    for (Size s = 0; s < surface->swapchain_image_count; s++) {
-        if (surface->swapchain_image_views[s]) {
-            vkDestroyImageView (surface->device, surface->swapchain_image_views[s], Null);
-        }
-    }
-    FREE (surface->swapchain_image_views);
-    surface->swapchain_image_views = Null;
-    return Null;
-}
-
-/**
- * @b Create command pool and allocate command buffers here.
+ * @b Create swapchain, along with image views and framebuffers for it's images.
  *
  * @param surface
+ * @param win Window this surface is created for.
  *
  * @return @c surface on success.
- * @return @c Null otherwise
+ * @return @c Null otherwise.
  * */
-static inline Surface *surface_create_command_objects (Surface *surface) {
-    RETURN_VALUE_IF (!surface, Null, ERR_INVALID_ARGUMENTS);
-
-    VkCommandPoolCreateInfo command_pool_create_info = {
-        .sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
-        .pNext            = Null,
-        .flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
-        .queueFamilyIndex = surface->graphics_family_index
-    };
+static inline Surface *surface_create_swapchain (Surface *surface, XwWindow *win) {
+    RETURN_VALUE_IF (!surface || !win, Null, ERR_INVALID_ARGUMENTS);
 
-    /* create command pool */
-    VkResult res =
-        vkCreateCommandPool (surface->device, &command_pool_create_info, Null, &surface->cmd_pool);
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to create Command Pool. RET = %d\n", res);
-
-    VkCommandBufferAllocateInfo command_buffer_allocate_info = {
-        .sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .pNext              = Null,
-        .commandPool        = surface->cmd_pool,
-        .level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandBufferCount = 1
+    XwWindowSize            size                  = xw_window_get_size (win);
+    XwVkSwapchainCreateInfo swapchain_create_info = {
+        .gpu             = surface->selected_gpu,
+        .device          = surface->device,
+        .surface         = surface->surface,
+        .window          = win,
+        .extent          = {size.width, size.height},
+        .surface_info    = surface->surface_info,
+        .surface_format  = surface->surface_format,
+        .latency_policy  = XW_VK_LATENCY_POLICY_TEAR_FREE_LOW_LATENCY,
+        .min_image_count = 0,
+        .image_usage     = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+        .render_pass     = surface->render_pass
     };
 
-    /* allocate command buffer(s) */
-    res = vkAllocateCommandBuffers (
-        surface->device,
-        &command_buffer_allocate_info,
-        &surface->cmd_buffer
-    );
-    RETURN_VALUE_IF (
-        res != VK_SUCCESS,
-        Null,
-        "Failed to allocate Command Buffers. RET = %d\n",
-        res
-    );
+    surface->swapchain = xw_vk_swapchain_create (&swapchain_create_info);
+    RETURN_VALUE_IF (!surface->swapchain, Null, "Failed to create Vulkan swapchain\n");
 
     return surface;
 }
@@ -1317,7 +878,7 @@ static inline Surface *surface_create_renderpass (Surface *surface) {
 
     VkAttachmentDescription color_attachment = {
         .flags          = 0,
-        .format         = surface->swapchain_image_format,
+        .format         = surface->surface_format.format,
         .samples        = VK_SAMPLE_COUNT_1_BIT,
         .loadOp         = VK_ATTACHMENT_LOAD_OP_CLEAR,
         .storeOp        = VK_ATTACHMENT_STORE_OP_STORE,
@@ -1374,85 +935,26 @@ static inline Surface *surface_create_renderpass (Surface *surface) {
 }
 
 /**
- * @b Create framebuffers for the swapchain inside surface.
- *
- * @param surface 
- *
- * @return @c surface on Success 
- * @return @c Null otherwise.
- * */
-static inline Surface *surface_create_framebuffers (Surface *surface) {
-    RETURN_VALUE_IF (!surface, Null, ERR_INVALID_ARGUMENTS);
-
-    surface->framebuffers =
-        REALLOCATE (surface->framebuffers, VkFramebuffer, surface->swapchain_image_count);
-    RETURN_VALUE_IF (!surface->framebuffers, Null, ERR_OUT_OF_MEMORY);
-
-    VkFramebufferCreateInfo framebuffer_create_info = {
-        .sType           = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-        .pNext           = Null,
-        .flags           = 0,
-        .renderPass      = surface->render_pass,
-        .attachmentCount = 1, /* only color attachment for now */
-        .pAttachments    = Null,
-        .width           = surface->swapchain_image_extent.width,
-        .height          = surface->swapchain_image_extent.height,
-        .layers          = 1
-    };
-
-    for (Size s = 0; s < surface->swapchain_image_count; s++) {
-        framebuffer_create_info.pAttachments = &surface->swapchain_image_views[s];
-        VkResult res                         = vkCreateFramebuffer (
-            surface->device,
-            &framebuffer_create_info,
-            Null,
-            &surface->framebuffers[s]
-        );
-        RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to create framebuffer. RET = %d\n", res);
-    }
-
-    return surface;
-}
-
-/**
- * @b Create synchronization objects like semaphores, fences, etc.... and store in surface.
+ * @b Create command buffers and synchronization objects for frames in flight.
  *
- * @param surface 
+ * @param surface
  *
  * @return @c surface on success.
  * @return @c Null otherwise,
  * */
-static inline Surface *surface_create_sync_objects (Surface *surface) {
+static inline Surface *surface_create_frame_ring (Surface *surface) {
     RETURN_VALUE_IF (!surface, Null, ERR_INVALID_ARGUMENTS);
 
-    VkFenceCreateInfo fence_create_info = {
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-        .pNext = 0,
-        .flags = VK_FENCE_CREATE_SIGNALED_BIT
+    XwVkFrameRingCreateInfo frame_ring_create_info = {
+        .swapchain          = surface->swapchain,
+        .queue              = surface->graphics_queue,
+        .queue_family_index = surface->graphics_family_index,
+        .frame_count        = 2,
+        .wait_stage         = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
     };
 
-    VkResult res =
-        vkCreateFence (surface->device, &fence_create_info, Null, &surface->render_fence);
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to create Fence. RET = %d\n", res);
-
-    VkSemaphoreCreateInfo semaphore_create_info =
-        {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, .pNext = Null, .flags = 0};
-
-    res = vkCreateSemaphore (
-        surface->device,
-        &semaphore_create_info,
-        Null,
-        &surface->render_semaphore
-    );
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to create Semaphore. RET = %d\n", res);
-
-    res = vkCreateSemaphore (
-        surface->device,
-        &semaphore_create_info,
-        Null,
-        &surface->present_semaphore
-    );
-    RETURN_VALUE_IF (res != VK_SUCCESS, Null, "Failed to create Semaphore. RET = %d\n", res);
+    surface->frames = xw_vk_frame_ring_create (&frame_ring_create_info);
+    RETURN_VALUE_IF (!surface->frames, Null, "Failed to create frame ring\n");
 
     return surface;
 }
@@ -1558,16 +1060,20 @@ static inline Surface *surface_create_pipeline (Surface *surface) {
         .pNext         = Null,
         .flags         = 0,
         .viewportCount = 1,
-        .pViewports    = (VkViewport[]
-        ) {{.x        = 0,
-               .y        = 0,
-               .width    = surface->swapchain_image_extent.width,
-               .height   = surface->swapchain_image_extent.height,
-               .minDepth = 0.f,
-               .maxDepth = 1.f}},
+        .pViewports    = Null, /* dynamic */
         .scissorCount  = 1,
-        .pScissors =
-            (VkRect2D[]) {{.offset = {.x = 0, .y = 0}, .extent = surface->swapchain_image_extent}}
+        .pScissors     = Null  /* dynamic */
+    };
+
+    /* viewport and scissor change with swapchain extent */
+    VkDynamicState dynamic_states[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+
+    VkPipelineDynamicStateCreateInfo dynamic_state = {
+        .sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .pNext             = Null,
+        .flags             = 0,
+        .dynamicStateCount = ARRAY_SIZE (dynamic_states),
+        .pDynamicStates    = dynamic_states
     };
 
     /* describe rasterization state */
@@ -1629,7 +1135,7 @@ static inline Surface *surface_create_pipeline (Surface *surface) {
         .pMultisampleState   = &multisample_state,
         .pDepthStencilState  = &depth_stencil_state,
         .pColorBlendState    = &color_blend_state,
-        .pDynamicState       = Null,
+        .pDynamicState       = &dynamic_state,
         .layout              = surface->pipeline_layout,
         .renderPass          = surface->render_pass,
         .subpass             = 0,